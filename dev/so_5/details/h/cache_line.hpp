@@ -0,0 +1,61 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Helpers for separation of data on different cache lines.
+ *
+ * \since
+ * v.5.5.17
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace so_5 {
+
+namespace details {
+
+/*!
+ * \brief Assumed size of a cache line.
+ *
+ * \since
+ * v.5.5.17
+ */
+const std::size_t cache_line_size = 64;
+
+/*!
+ * \brief A padding which guarantees that data members declared before
+ * and after it are not on the same cache line.
+ *
+ * It is used instead of alignas because alignas is not supported by
+ * all compilers and because over-aligned objects are not allocated
+ * properly by operator new before C++17.
+ *
+ * Usage example:
+ * \code
+	class queue_t
+		{
+			// Data written by producers.
+			std::atomic< node_t * > m_head;
+
+			so_5::details::cache_line_padding_t m_head_padding;
+
+			// Data written by the consumer.
+			node_t * m_tail;
+		};
+ * \endcode
+ *
+ * \since
+ * v.5.5.17
+ */
+struct cache_line_padding_t
+	{
+		char m_bytes[ cache_line_size ];
+	};
+
+} /* namespace details */
+
+} /* namespace so_5 */
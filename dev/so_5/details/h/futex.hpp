@@ -0,0 +1,287 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Synchronization primitives based on Linux futexes.
+ *
+ * \note Primitives are available only if SO_5_HAS_FUTEX is defined.
+ */
+
+#pragma once
+
+#if defined( __linux__ )
+	#define SO_5_HAS_FUTEX
+#endif
+
+#if defined( SO_5_HAS_FUTEX )
+
+#include <so_5/h/spinlocks.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace so_5 {
+
+namespace details {
+
+namespace futex {
+
+static_assert( sizeof( std::atomic< std::uint32_t > ) == sizeof( int ),
+		"std::atomic<std::uint32_t> must have the same size as int" );
+
+//! Sleep while value of \a word is equal to \a expected.
+/*!
+ * Can return spuriously.
+ */
+inline void
+wait( std::atomic< std::uint32_t > & word, std::uint32_t expected )
+	{
+		syscall( SYS_futex,
+				reinterpret_cast< int * >( &word ),
+				FUTEX_WAIT_PRIVATE,
+				static_cast< int >( expected ),
+				nullptr, nullptr, 0 );
+	}
+
+//! Sleep while value of \a word is equal to \a expected but no longer
+//! than \a timeout.
+/*!
+ * Can return spuriously.
+ */
+inline void
+wait_for(
+	std::atomic< std::uint32_t > & word,
+	std::uint32_t expected,
+	std::chrono::steady_clock::duration timeout )
+	{
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				timeout ).count();
+
+		timespec ts;
+		ts.tv_sec = static_cast< decltype(ts.tv_sec) >( ns / 1000000000 );
+		ts.tv_nsec = static_cast< decltype(ts.tv_nsec) >( ns % 1000000000 );
+
+		syscall( SYS_futex,
+				reinterpret_cast< int * >( &word ),
+				FUTEX_WAIT_PRIVATE,
+				static_cast< int >( expected ),
+				&ts, nullptr, 0 );
+	}
+
+//! Wake up one thread sleeping on \a word.
+inline void
+wake_one( std::atomic< std::uint32_t > & word )
+	{
+		syscall( SYS_futex,
+				reinterpret_cast< int * >( &word ),
+				FUTEX_WAKE_PRIVATE,
+				1,
+				nullptr, nullptr, 0 );
+	}
+
+//
+// mutex_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A mutex with bounded spinning phase and sleeping on futex.
+ *
+ * This implementation is based on "mutex2" from Ulrich Drepper's paper
+ * "Futexes Are Tricky". FUTEX_WAKE is called on unlock only if there
+ * could be a sleeping thread.
+ */
+class mutex_t
+	{
+	public :
+		mutex_t(
+			//! Count of attempts to acquire the mutex before going to sleep.
+			std::size_t spin_count )
+			:	m_spin_count{ spin_count }
+			{}
+		mutex_t( const mutex_t & ) = delete;
+		mutex_t &
+		operator=( const mutex_t & ) = delete;
+
+		void
+		lock()
+			{
+				pause_backoff_t backoff;
+				for( std::size_t i = 0; i != m_spin_count; ++i )
+					{
+						std::uint32_t c = unlocked;
+						if( m_state.compare_exchange_weak( c, locked,
+								std::memory_order_acquire,
+								std::memory_order_relaxed ) )
+							return;
+						backoff();
+					}
+
+				std::uint32_t c = unlocked;
+				if( !m_state.compare_exchange_strong( c, locked,
+						std::memory_order_acquire,
+						std::memory_order_relaxed ) )
+					{
+						if( contended != c )
+							c = m_state.exchange( contended,
+									std::memory_order_acquire );
+						while( unlocked != c )
+							{
+								futex::wait( m_state, contended );
+								c = m_state.exchange( contended,
+										std::memory_order_acquire );
+							}
+					}
+			}
+
+		void
+		unlock()
+			{
+				if( contended == m_state.exchange( unlocked,
+						std::memory_order_release ) )
+					futex::wake_one( m_state );
+			}
+
+	private :
+		static const std::uint32_t unlocked = 0;
+		static const std::uint32_t locked = 1;
+		static const std::uint32_t contended = 2;
+
+		//! Count of attempts before going to sleep.
+		const std::size_t m_spin_count;
+
+		//! State of the mutex.
+		std::atomic< std::uint32_t > m_state = { unlocked };
+	};
+
+//
+// event_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An auto-reset event for exactly one waiting thread.
+ *
+ * The waiting thread spins for a limited time and then sleeps on futex.
+ * FUTEX_WAKE is called by notify() only if the waiting thread
+ * is really sleeping.
+ */
+class event_t
+	{
+	public :
+		event_t(
+			//! Count of checks of the event before going to sleep.
+			std::size_t spin_count )
+			:	m_spin_count{ spin_count }
+			{}
+		event_t( const event_t & ) = delete;
+		event_t &
+		operator=( const event_t & ) = delete;
+
+		//! Reset event to non-signaled state.
+		void
+		reset()
+			{
+				m_state.store( not_signaled, std::memory_order_relaxed );
+			}
+
+		//! Wait for the event and reset it.
+		void
+		wait()
+			{
+				pause_backoff_t backoff;
+				for( std::size_t i = 0; i != m_spin_count; ++i )
+					{
+						if( signaled == m_state.load( std::memory_order_acquire ) )
+							{
+								reset();
+								return;
+							}
+						backoff();
+					}
+
+				std::uint32_t c = not_signaled;
+				if( m_state.compare_exchange_strong( c, sleeping,
+						std::memory_order_acq_rel,
+						std::memory_order_acquire ) )
+					while( sleeping == m_state.load( std::memory_order_acquire ) )
+						futex::wait( m_state, sleeping );
+
+				reset();
+			}
+
+		//! Wait for the event but no longer than \a timeout.
+		/*!
+		 * Event is reset before return.
+		 *
+		 * \since v.5.5.17
+		 */
+		void
+		wait_for( std::chrono::steady_clock::duration timeout )
+			{
+				const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+				pause_backoff_t backoff;
+				for( std::size_t i = 0; i != m_spin_count; ++i )
+					{
+						if( signaled == m_state.load( std::memory_order_acquire ) )
+							{
+								reset();
+								return;
+							}
+						backoff();
+					}
+
+				std::uint32_t c = not_signaled;
+				if( m_state.compare_exchange_strong( c, sleeping,
+						std::memory_order_acq_rel,
+						std::memory_order_acquire ) )
+					while( sleeping == m_state.load( std::memory_order_acquire ) )
+						{
+							const auto now = std::chrono::steady_clock::now();
+							if( now >= deadline )
+								break;
+							futex::wait_for( m_state, sleeping, deadline - now );
+						}
+
+				// If notify() is called right now it can see the sleeping
+				// state and do an unnecessary FUTEX_WAKE. It is not a problem.
+				reset();
+			}
+
+		//! Set event to signaled state and wake up the waiting thread.
+		void
+		notify()
+			{
+				if( sleeping == m_state.exchange( signaled,
+						std::memory_order_acq_rel ) )
+					futex::wake_one( m_state );
+			}
+
+	private :
+		static const std::uint32_t not_signaled = 0;
+		static const std::uint32_t signaled = 1;
+		static const std::uint32_t sleeping = 2;
+
+		//! Count of checks of the event before going to sleep.
+		const std::size_t m_spin_count;
+
+		//! State of the event.
+		std::atomic< std::uint32_t > m_state = { not_signaled };
+	};
+
+} /* namespace futex */
+
+} /* namespace details */
+
+} /* namespace so_5 */
+
+#endif
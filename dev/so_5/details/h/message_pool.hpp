@@ -0,0 +1,366 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Pools of memory blocks for message instances.
+ *
+ * \since
+ * v.5.5.17
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+#include <so_5/h/spinlocks.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace so_5 {
+
+namespace details {
+
+namespace message_pool {
+
+/*!
+ * \brief Count of blocks in one batch which is moved between
+ * thread local cache and shared part of a pool.
+ *
+ * \since
+ * v.5.5.17
+ */
+const std::size_t batch_size = 64;
+
+/*!
+ * \brief Max count of batches in the shared part of a pool.
+ *
+ * Batches above that limit are returned to the memory allocator.
+ *
+ * \since
+ * v.5.5.17
+ */
+const std::size_t max_shared_batches = 256;
+
+/*!
+ * \brief A header which is placed into a free memory block.
+ *
+ * \since
+ * v.5.5.17
+ */
+struct free_block_t
+	{
+		//! Next block in the same batch.
+		free_block_t * m_next;
+		//! Next batch in the shared part of a pool.
+		/*!
+		 * \note Used only for the first block of a batch.
+		 */
+		free_block_t * m_next_batch;
+	};
+
+/*!
+ * \brief A list of free blocks.
+ *
+ * \since
+ * v.5.5.17
+ */
+struct block_list_t
+	{
+		free_block_t * m_head = nullptr;
+		std::size_t m_size = 0;
+
+		void
+		push( void * p )
+			{
+				auto b = static_cast< free_block_t * >( p );
+				b->m_next = m_head;
+				m_head = b;
+				++m_size;
+			}
+
+		void *
+		pop()
+			{
+				auto b = m_head;
+				m_head = b->m_next;
+				--m_size;
+				return b;
+			}
+
+		bool
+		empty() const
+			{
+				return nullptr == m_head;
+			}
+	};
+
+/*!
+ * \brief Shared part of a pool.
+ *
+ * Holds batches of free blocks released by thread local caches.
+ * Only whole batches are moved in and out, so the lock is held for
+ * a couple of pointer assignments.
+ *
+ * Count of batches is limited by max_shared_batches. So a peak of
+ * message instances doesn't hold the memory forever.
+ *
+ * \since
+ * v.5.5.17
+ */
+class shared_pool_t
+	{
+	public :
+		shared_pool_t() = default;
+		shared_pool_t( const shared_pool_t & ) = delete;
+		shared_pool_t &
+		operator=( const shared_pool_t & ) = delete;
+
+		~shared_pool_t()
+			{
+				while( m_batches )
+					{
+						auto batch = m_batches;
+						m_batches = batch->m_next_batch;
+
+						free_batch( batch );
+					}
+			}
+
+		//! Store a batch of free blocks.
+		/*!
+		 * The batch is returned to the memory allocator if the shared
+		 * part is full.
+		 */
+		void
+		put_batch( const block_list_t & batch )
+			{
+				{
+					std::lock_guard< default_spinlock_t > lock{ m_lock };
+
+					if( m_batches_count < max_shared_batches )
+						{
+							batch.m_head->m_next_batch = m_batches;
+							m_batches = batch.m_head;
+							++m_batches_count;
+							return;
+						}
+				}
+
+				free_batch( batch.m_head );
+			}
+
+		//! Take a batch of free blocks.
+		/*!
+		 * \return false if there is no free blocks.
+		 */
+		bool
+		take_batch( block_list_t & receiver )
+			{
+				free_block_t * head = nullptr;
+				{
+					std::lock_guard< default_spinlock_t > lock{ m_lock };
+					head = m_batches;
+					if( head )
+						{
+							m_batches = head->m_next_batch;
+							--m_batches_count;
+						}
+				}
+
+				if( !head )
+					return false;
+
+				// Size of the batch is calculated outside of the lock.
+				receiver.m_head = head;
+				receiver.m_size = 0;
+				for( auto b = head; b; b = b->m_next )
+					++receiver.m_size;
+
+				return true;
+			}
+
+	private :
+		default_spinlock_t m_lock;
+
+		//! Stack of batches.
+		free_block_t * m_batches = nullptr;
+
+		//! Count of batches in the stack.
+		std::size_t m_batches_count = 0;
+
+		//! Return all blocks of a batch to the memory allocator.
+		static void
+		free_batch( free_block_t * batch )
+			{
+				while( batch )
+					{
+						auto b = batch;
+						batch = b->m_next;
+						::operator delete( b );
+					}
+			}
+	};
+
+/*!
+ * \brief Thread local cache of free blocks.
+ *
+ * Blocks released by the current thread go to the current list. When it
+ * becomes full it is swapped with the spare list and the previous spare
+ * list goes to the shared part of the pool. A thread which only
+ * allocates takes whole batches from the shared part.
+ *
+ * A message can be destroyed after the destruction of the cache
+ * (for example by a destructor of another thread local object).
+ * Because of that the cache sets a flag in its destructor. That flag
+ * must be checked before any access to the cache.
+ *
+ * \since
+ * v.5.5.17
+ */
+class thread_cache_t
+	{
+	public :
+		thread_cache_t(
+			//! Shared part of the pool.
+			shared_pool_t & shared,
+			//! Flag to be set on destruction of the cache.
+			/*!
+			 * \note It must be a thread local object without destructor.
+			 */
+			bool & destroyed )
+			:	m_shared( shared )
+			,	m_destroyed( destroyed )
+			{}
+		thread_cache_t( const thread_cache_t & ) = delete;
+		thread_cache_t &
+		operator=( const thread_cache_t & ) = delete;
+
+		//! All cached blocks are returned to the shared part on thread exit.
+		~thread_cache_t()
+			{
+				m_destroyed = true;
+
+				if( !m_current.empty() )
+					m_shared.put_batch( m_current );
+				if( !m_spare.empty() )
+					m_shared.put_batch( m_spare );
+			}
+
+		void *
+		allocate( std::size_t block_size )
+			{
+				if( m_current.empty() )
+					{
+						if( !m_spare.empty() )
+							{
+								m_current = m_spare;
+								m_spare = block_list_t{};
+							}
+						else if( !m_shared.take_batch( m_current ) )
+							return ::operator new( block_size );
+					}
+
+				return m_current.pop();
+			}
+
+		void
+		deallocate( void * p )
+			{
+				m_current.push( p );
+				if( batch_size == m_current.m_size )
+					{
+						if( !m_spare.empty() )
+							m_shared.put_batch( m_spare );
+
+						m_spare = m_current;
+						m_current = block_list_t{};
+					}
+			}
+
+	private :
+		shared_pool_t & m_shared;
+		bool & m_destroyed;
+
+		block_list_t m_current;
+		block_list_t m_spare;
+	};
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+
+/*!
+ * \brief A pool of memory blocks for objects of type T.
+ *
+ * \note Thread local caches require thread_local objects with
+ * destructors. Because of that this pool is not defined (and message
+ * pools are not used at all) if thread_local keyword is not supported.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename T >
+struct pool_t
+	{
+		//! Size of one block.
+		static const std::size_t block_size =
+				sizeof(T) < sizeof(free_block_t) ? sizeof(free_block_t) : sizeof(T);
+
+		static void *
+		allocate()
+			{
+				// The cache of the current thread is already destroyed.
+				if( cache_destroyed() )
+					return ::operator new( block_size );
+
+				return cache().allocate( block_size );
+			}
+
+		static void
+		deallocate( void * p )
+			{
+				// The cache of the current thread is already destroyed.
+				if( cache_destroyed() )
+					::operator delete( p );
+				else
+					cache().deallocate( p );
+			}
+
+	private :
+		static shared_pool_t &
+		shared()
+			{
+				static shared_pool_t pool;
+				return pool;
+			}
+
+		static thread_cache_t &
+		cache()
+			{
+				static thread_local thread_cache_t c{
+						shared(), cache_destroyed() };
+				return c;
+			}
+
+		//! Flag of destruction of the cache of the current thread.
+		/*!
+		 * It is a trivial object without dynamic initialization and
+		 * destructor. So it can be accessed until the end of the thread.
+		 */
+		static bool &
+		cache_destroyed()
+			{
+				static thread_local bool destroyed = false;
+				return destroyed;
+			}
+	};
+
+#endif
+
+} /* namespace message_pool */
+
+} /* namespace details */
+
+} /* namespace so_5 */
+
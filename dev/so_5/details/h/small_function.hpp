@@ -0,0 +1,427 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A function wrapper with a small internal buffer.
+ *
+ * \since
+ * v.5.5.17
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace so_5 {
+
+namespace details {
+
+namespace small_function_details {
+
+/*!
+ * \brief Can an object of type F be copied by memcpy?
+ *
+ * \note libstdc++ before GCC 5 has no std::is_trivially_copyable
+ * (and no _GLIBCXX_USE_CXX11_ABI which was introduced at the same time).
+ * All objects require a manager for such standard library.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename F >
+struct is_memcpy_copyable_t
+#if defined( __GLIBCXX__ ) && !defined( _GLIBCXX_USE_CXX11_ABI )
+	:	public std::false_type
+#else
+	:	public std::integral_constant< bool,
+			std::is_trivially_copyable< F >::value >
+#endif
+	{};
+
+/*!
+ * \brief Check that an object of type F can be called with ARGS.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename F, typename... ARGS >
+struct is_callable_t
+	{
+	private :
+		template< typename U >
+		static auto
+		check( int ) -> decltype(
+				std::declval< U & >()( std::declval< ARGS >()... ),
+				std::true_type() );
+
+		template< typename U >
+		static std::false_type
+		check( ... );
+
+	public :
+		static const bool value = decltype( check< F >( 0 ) )::value;
+	};
+
+/*!
+ * \brief Call \a f and return its result.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename R, typename F, typename... ARGS >
+R
+invoke( std::false_type /*R is not void*/, F & f, ARGS &&... args )
+	{
+		return f( std::forward< ARGS >( args )... );
+	}
+
+/*!
+ * \brief Call \a f and discard its result.
+ *
+ * It allows to store a function which returns a value in
+ * small_function_t with void result type (like std::function does).
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename R, typename F, typename... ARGS >
+R
+invoke( std::true_type /*R is void*/, F & f, ARGS &&... args )
+	{
+		static_cast< void >( f( std::forward< ARGS >( args )... ) );
+	}
+
+} /* namespace small_function_details */
+
+template< typename SIGNATURE, std::size_t BUFFER_SIZE = 4 * sizeof(void *) >
+class small_function_t;
+
+/*!
+ * \brief A replacement of std::function for event handlers.
+ *
+ * A function object which fits into the internal buffer is stored
+ * in that buffer without any dynamic allocation. Bigger objects are
+ * allocated in the heap.
+ *
+ * A trivially copyable function object (for example a lambda which
+ * captures only a pointer to an agent and a pointer to agent's method)
+ * is copied by memcpy and requires no destruction. The call to any
+ * stored object is performed via one pointer to a function.
+ *
+ * \note Unlike std::function the call of an empty object throws
+ * std::bad_function_call too.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename R, typename... ARGS, std::size_t BUFFER_SIZE >
+class small_function_t< R(ARGS...), BUFFER_SIZE >
+	{
+		//! Type of internal buffer.
+		using buffer_t = typename std::aligned_storage< BUFFER_SIZE >::type;
+
+		//! Type of function which calls the stored object.
+		using invoker_t = R (*)( buffer_t &, ARGS... );
+
+		//! Operations performed by a manager of the stored object.
+		enum class operation_t { copy, move, destroy };
+
+		//! Type of function which copies, moves and destroys the stored object.
+		/*!
+		 * Is null for objects which are trivially copyable and
+		 * are stored in the internal buffer.
+		 */
+		using manager_t = void (*)( operation_t, buffer_t & to, buffer_t & from );
+
+		//! Can an object of type F be stored in the internal buffer?
+		template< typename F >
+		struct is_inline_t
+			:	public std::integral_constant< bool,
+						sizeof(F) <= sizeof(buffer_t) &&
+						std::alignment_of< buffer_t >::value %
+								std::alignment_of< F >::value == 0 &&
+						std::is_nothrow_move_constructible< F >::value >
+			{};
+
+		//! Can small_function_t be constructed from an object of type F?
+		template< typename F >
+		struct is_acceptable_t
+			:	public std::integral_constant< bool,
+						!std::is_same< F, small_function_t >::value &&
+						!std::is_same< F, std::nullptr_t >::value &&
+						small_function_details::is_callable_t< F, ARGS... >::value >
+			{};
+
+	public :
+		//! Create an empty object.
+		small_function_t() SO_5_NOEXCEPT
+			{}
+
+		//! Create an empty object.
+		small_function_t( std::nullptr_t ) SO_5_NOEXCEPT
+			{}
+
+		//! Create an object which holds a copy of \a f.
+		template< typename F,
+				typename D = typename std::decay< F >::type,
+				typename = typename std::enable_if<
+						is_acceptable_t< D >::value >::type >
+		small_function_t( F && f )
+			{
+				init< D >( std::forward< F >( f ), is_inline_t< D >() );
+			}
+
+		small_function_t( const small_function_t & o )
+			:	m_invoker( o.m_invoker )
+			,	m_manager( o.m_manager )
+			{
+				if( m_manager )
+					m_manager( operation_t::copy, m_buffer, o.m_buffer );
+				else
+					std::memcpy( &m_buffer, &o.m_buffer, sizeof( m_buffer ) );
+			}
+
+		small_function_t( small_function_t && o ) SO_5_NOEXCEPT
+			{
+				steal( o );
+			}
+
+		~small_function_t()
+			{
+				reset();
+			}
+
+		small_function_t &
+		operator=( const small_function_t & o )
+			{
+				small_function_t tmp( o );
+				return (*this = std::move( tmp ));
+			}
+
+		small_function_t &
+		operator=( small_function_t && o ) SO_5_NOEXCEPT
+			{
+				if( this != &o )
+					{
+						reset();
+						steal( o );
+					}
+				return *this;
+			}
+
+		small_function_t &
+		operator=( std::nullptr_t ) SO_5_NOEXCEPT
+			{
+				reset();
+				return *this;
+			}
+
+		template< typename F,
+				typename D = typename std::decay< F >::type,
+				typename = typename std::enable_if<
+						is_acceptable_t< D >::value >::type >
+		small_function_t &
+		operator=( F && f )
+			{
+				return (*this = small_function_t( std::forward< F >( f ) ));
+			}
+
+		void
+		swap( small_function_t & o ) SO_5_NOEXCEPT
+			{
+				small_function_t tmp( std::move( o ) );
+				o = std::move( *this );
+				*this = std::move( tmp );
+			}
+
+		//! Is there a stored object?
+		explicit operator bool() const SO_5_NOEXCEPT
+			{
+				return m_invoker != &invoke_empty;
+			}
+
+		//! Call the stored object.
+		/*!
+		 * \throw std::bad_function_call if there is no stored object.
+		 */
+		R
+		operator()( ARGS... args ) const
+			{
+				return m_invoker( m_buffer, std::forward< ARGS >( args )... );
+			}
+
+		friend bool
+		operator==( const small_function_t & f, std::nullptr_t ) SO_5_NOEXCEPT
+			{
+				return !f;
+			}
+
+		friend bool
+		operator==( std::nullptr_t, const small_function_t & f ) SO_5_NOEXCEPT
+			{
+				return !f;
+			}
+
+		friend bool
+		operator!=( const small_function_t & f, std::nullptr_t ) SO_5_NOEXCEPT
+			{
+				return static_cast< bool >( f );
+			}
+
+		friend bool
+		operator!=( std::nullptr_t, const small_function_t & f ) SO_5_NOEXCEPT
+			{
+				return static_cast< bool >( f );
+			}
+
+	private :
+		//! Storage for the object or for the pointer to the object.
+		/*!
+		 * It is mutable because the stored object can have non-const
+		 * operator() (like mutable lambda).
+		 *
+		 * It is value-initialized because it is copied as a whole
+		 * if a small object is copied by memcpy.
+		 */
+		mutable buffer_t m_buffer = buffer_t();
+
+		//! Function for calling the stored object.
+		invoker_t m_invoker = &invoke_empty;
+
+		//! Manager of the stored object.
+		manager_t m_manager = nullptr;
+
+		//! Store the object in the internal buffer.
+		template< typename D, typename F >
+		void
+		init( F && f, std::true_type /*is_inline*/ )
+			{
+				new( &m_buffer ) D( std::forward< F >( f ) );
+
+				m_invoker = &invoke_inline< D >;
+				m_manager =
+						small_function_details::is_memcpy_copyable_t< D >::value ?
+						nullptr : &manage_inline< D >;
+			}
+
+		//! Store the object in the heap.
+		template< typename D, typename F >
+		void
+		init( F && f, std::false_type /*is_inline*/ )
+			{
+				*reinterpret_cast< D ** >( &m_buffer ) =
+						new D( std::forward< F >( f ) );
+
+				m_invoker = &invoke_heap< D >;
+				m_manager = &manage_heap< D >;
+			}
+
+		//! Take the content of \a o and make \a o empty.
+		void
+		steal( small_function_t & o ) SO_5_NOEXCEPT
+			{
+				m_invoker = o.m_invoker;
+				m_manager = o.m_manager;
+
+				if( m_manager )
+					m_manager( operation_t::move, m_buffer, o.m_buffer );
+				else
+					std::memcpy( &m_buffer, &o.m_buffer, sizeof( m_buffer ) );
+
+				o.m_invoker = &invoke_empty;
+				o.m_manager = nullptr;
+			}
+
+		//! Destroy the stored object.
+		void
+		reset() SO_5_NOEXCEPT
+			{
+				if( m_manager )
+					m_manager( operation_t::destroy, m_buffer, m_buffer );
+
+				m_invoker = &invoke_empty;
+				m_manager = nullptr;
+			}
+
+		static R
+		invoke_empty( buffer_t &, ARGS... )
+			{
+				throw std::bad_function_call();
+			}
+
+		template< typename D >
+		static R
+		invoke_inline( buffer_t & buffer, ARGS... args )
+			{
+				return small_function_details::invoke< R >(
+						std::is_void< R >(),
+						*reinterpret_cast< D * >( &buffer ),
+						std::forward< ARGS >( args )... );
+			}
+
+		template< typename D >
+		static R
+		invoke_heap( buffer_t & buffer, ARGS... args )
+			{
+				return small_function_details::invoke< R >(
+						std::is_void< R >(),
+						**reinterpret_cast< D ** >( &buffer ),
+						std::forward< ARGS >( args )... );
+			}
+
+		template< typename D >
+		static void
+		manage_inline( operation_t op, buffer_t & to, buffer_t & from )
+			{
+				D * f = reinterpret_cast< D * >( &from );
+				switch( op )
+					{
+					case operation_t::copy :
+						new( &to ) D( *f );
+					break;
+
+					case operation_t::move :
+						new( &to ) D( std::move( *f ) );
+						f->~D();
+					break;
+
+					case operation_t::destroy :
+						f->~D();
+					break;
+					}
+			}
+
+		template< typename D >
+		static void
+		manage_heap( operation_t op, buffer_t & to, buffer_t & from )
+			{
+				D ** f = reinterpret_cast< D ** >( &from );
+				switch( op )
+					{
+					case operation_t::copy :
+						*reinterpret_cast< D ** >( &to ) = new D( **f );
+					break;
+
+					case operation_t::move :
+						*reinterpret_cast< D ** >( &to ) = *f;
+					break;
+
+					case operation_t::destroy :
+						delete *f;
+					break;
+					}
+			}
+	};
+
+} /* namespace details */
+
+} /* namespace so_5 */
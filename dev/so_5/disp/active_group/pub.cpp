@@ -15,6 +15,7 @@
 
 #include <so_5/disp/reuse/h/disp_binder_helpers.hpp>
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
 
 #include <so_5/disp/reuse/work_thread/h/work_thread.hpp>
 
@@ -226,6 +227,14 @@ class dispatcher_t : public so_5::dispatcher_t
 		//! Parameters for the dispatcher.
 		const disp_params_t m_params;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads.
+		 *
+		 * \note Receives actual value in start() method.
+		 */
+		thread_factory_t * m_thread_factory = { nullptr };
+
 		//! A map of dispatchers for active groups.
 		active_group_map_t m_groups;
 
@@ -280,10 +289,9 @@ dispatcher_t::start( so_5::environment_t & env )
 		m_data_source.start( env.stats_repository() );
 
 		so_5::details::do_with_rollback_on_exception(
-			[this] {
-				// do_with_rollback_on_exception is used in this simple case
-				// just for simplification of extension of that block
-				// in the future.
+			[&] {
+				m_thread_factory = &so_5::disp::reuse::actual_thread_factory(
+						m_params.thread_factory(), env );
 				m_shutdown_started = false;
 			},
 			[this] { m_data_source.stop(); } );
@@ -358,9 +366,9 @@ dispatcher_t::query_thread_for_group( const std::string & group_name )
 		// New thread should be created.
 		using namespace so_5::disp::reuse::work_thread;
 
-		auto lock_factory = m_params.queue_params().lock_factory();
-		work_thread_shptr_t thread( new work_thread_t{ std::move(lock_factory) } );
-		thread->start();
+		work_thread_shptr_t thread(
+				new work_thread_t{ m_params.queue_params() } );
+		thread->start( *m_thread_factory );
 
 		so_5::details::do_with_rollback_on_exception(
 				[&] {
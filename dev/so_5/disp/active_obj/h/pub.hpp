@@ -16,6 +16,8 @@
 #include <so_5/rt/h/disp.hpp>
 #include <so_5/rt/h/disp_binder.hpp>
 
+#include <so_5/h/thread_factory.hpp>
+
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
 
@@ -49,15 +51,18 @@ class disp_params_t
 		//! Copy constructor.
 		disp_params_t( const disp_params_t & o )
 			:	m_queue_params{ o.m_queue_params }
+			,	m_thread_factory{ o.m_thread_factory }
 			{}
 		//! Move constructor.
 		disp_params_t( disp_params_t && o )
 			:	m_queue_params{ std::move(o.m_queue_params) }
+			,	m_thread_factory{ std::move(o.m_thread_factory) }
 			{}
 
 		friend inline void swap( disp_params_t & a, disp_params_t & b )
 			{
 				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_thread_factory, b.m_thread_factory );
 			}
 
 		//! Copy operator.
@@ -111,9 +116,44 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Setter for thread factory.
+		 *
+		 * Allows to specify names, stack sizes and CPU affinity
+		 * for working threads of the dispatcher.
+		 */
+		disp_params_t &
+		thread_factory( thread_factory_shptr_t factory )
+			{
+				m_thread_factory = std::move(factory);
+				return *this;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Getter for thread factory.
+		 *
+		 * \note Can be empty. In that case the factory from the
+		 * SObjectizer Environment is used.
+		 */
+		const thread_factory_shptr_t &
+		thread_factory() const
+			{
+				return m_thread_factory;
+			}
+
 	private :
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
 	};
 
 //
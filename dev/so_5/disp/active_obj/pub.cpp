@@ -16,6 +16,7 @@
 
 #include <so_5/disp/reuse/h/disp_binder_helpers.hpp>
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
 
 #include <so_5/disp/reuse/work_thread/h/work_thread.hpp>
 
@@ -181,6 +182,14 @@ class dispatcher_t : public so_5::dispatcher_t
 		 */
 		disp_params_t m_params;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads.
+		 *
+		 * \note Receives actual value in start() method.
+		 */
+		thread_factory_t * m_thread_factory = { nullptr };
+
 		//! A map from agents to single thread dispatchers.
 		agent_thread_map_t m_agent_threads;
 
@@ -232,7 +241,11 @@ dispatcher_t::start( environment_t & env )
 	m_data_source.start( env.stats_repository() );
 
 	so_5::details::do_with_rollback_on_exception(
-		[this] { m_shutdown_started = false; },
+		[&] {
+			m_thread_factory = &so_5::disp::reuse::actual_thread_factory(
+					m_params.thread_factory(), env );
+			m_shutdown_started = false;
+		},
 		[this] { m_data_source.stop(); } );
 }
 
@@ -299,10 +312,10 @@ dispatcher_t::create_thread_for_agent( const agent_t & agent )
 
 	using namespace so_5::disp::reuse::work_thread;
 
-	auto lock_factory = m_params.queue_params().lock_factory();
-	work_thread_shptr_t thread( new work_thread_t{ std::move(lock_factory) } );
+	work_thread_shptr_t thread(
+			new work_thread_t{ m_params.queue_params() } );
 
-	thread->start();
+	thread->start( *m_thread_factory );
 	so_5::details::do_with_rollback_on_exception(
 			[&] { m_agent_threads[ &agent ] = thread; },
 			[&thread] { shutdown_and_wait( *thread ); } );
@@ -14,6 +14,8 @@
 
 #include <so_5/rt/h/disp_binder.hpp>
 
+#include <so_5/h/thread_factory.hpp>
+
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
 #include <utility>
@@ -49,17 +51,20 @@ class disp_params_t
 		disp_params_t( const disp_params_t & o )
 			:	m_thread_count{ o.m_thread_count }
 			,	m_queue_params{ o.m_queue_params }
+			,	m_thread_factory{ o.m_thread_factory }
 			{}
 		//! Move constructor.
 		disp_params_t( disp_params_t && o )
 			:	m_thread_count{ std::move(o.m_thread_count) }
 			,	m_queue_params{ std::move(o.m_queue_params) }
+			,	m_thread_factory{ std::move(o.m_thread_factory) }
 			{}
 
 		friend inline void swap( disp_params_t & a, disp_params_t & b )
 			{
 				std::swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_thread_factory, b.m_thread_factory );
 			}
 
 		//! Copy operator.
@@ -131,6 +136,37 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		/*!
+		 * \brief Setter for thread factory.
+		 *
+		 * Allows to specify names, stack sizes and CPU affinity
+		 * for working threads of the dispatcher.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		disp_params_t &
+		thread_factory( thread_factory_shptr_t factory )
+			{
+				m_thread_factory = std::move(factory);
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for thread factory.
+		 *
+		 * \note Can be empty. In that case the factory from the
+		 * SObjectizer Environment is used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		const thread_factory_shptr_t &
+		thread_factory() const
+			{
+				return m_thread_factory;
+			}
+
 	private :
 		//! Count of working threads.
 		/*!
@@ -139,6 +175,16 @@ class disp_params_t
 		std::size_t m_thread_count = { 0 };
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		/*!
+		 * \brief Factory for working threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		thread_factory_shptr_t m_thread_factory;
 	};
 
 //
@@ -17,6 +17,7 @@
 #include <map>
 #include <iostream>
 #include <forward_list>
+#include <atomic>
 
 #include <so_5/h/spinlocks.hpp>
 #include <so_5/h/atomic_refcounted.hpp>
@@ -25,6 +26,7 @@
 #include <so_5/rt/h/disp.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demands_freelist.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
@@ -100,15 +102,35 @@ class agent_queue_t
 		static const unsigned int thread_safe_worker = 2;
 		static const unsigned int not_thread_safe_worker = 1;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of pool of nodes shared by all queues of
+		 * a dispatcher.
+		 */
+		using demands_pool_t = so_5::disp::reuse::demands_pool_t< demand_t >;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of pointer to a node removed from the queue
+		 * by worker_started().
+		 *
+		 * The node must be returned to the dispatcher's pool by
+		 * release_removed_demand() on unlocked queue.
+		 */
+		using removed_demand_t = demand_t *;
+
 		//! Constructor.
 		agent_queue_t(
 			//! Dispatcher queue to work with.
 			dispatcher_queue_t & disp_queue,
+			//! Pool of nodes of the dispatcher.
+			demands_pool_t & demands_pool,
 			//! Dummy argument. It is necessary here because of
 			//! common implementation for thread-pool and
 			//! adv-thread-pool dispatchers.
 			const params_t & )
 			:	m_disp_queue( disp_queue )
+			,	m_demands_pool( demands_pool )
 			,	m_tail( &m_head )
 			,	m_active( false )
 			,	m_workers( 0 )
@@ -128,16 +150,27 @@ class agent_queue_t
 			}
 
 		//! Push next demand to queue.
+		/*!
+		 * \note Since v.5.5.17 a node for the demand is taken from
+		 * the dispatcher's pool if it is possible. The node is prepared
+		 * before the acquisition of the queue's lock.
+		 */
 		virtual void
 		push( execution_demand_t demand )
 			{
+				demand_t * new_demand = m_demands_pool.try_take();
+				const bool hit = nullptr != new_demand;
+				if( hit )
+					new_demand->m_demand = std::move( demand );
+				else
+					new_demand = new demand_t( std::move( demand ) );
+
 				bool need_schedule = false;
 				{
-					// Do memory allocation before spinlock locking.
-					auto new_demand = new demand_t( std::move( demand ) );
-
 					std::lock_guard< spinlock_t > lock( m_lock );
 
+					m_pool_counters.add( hit ? 1u : 0u, hit ? 0u : 1u );
+
 					m_tail->m_next = new_demand;
 					m_tail = m_tail->m_next;
 
@@ -164,6 +197,89 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue at once.
+		/*!
+		 * \since v.5.5.17
+		 *
+		 * Nodes are taken from the dispatcher's pool by one locked
+		 * operation. Missing nodes are allocated before the acquisition
+		 * of the queue's lock. The queue is scheduled at most once.
+		 */
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				// New demands are linked into a local chain first.
+				// Nodes from the pool are taken by one locked operation.
+				demand_t * first = nullptr;
+				const std::size_t hits =
+						m_demands_pool.try_take_chain( count, first );
+
+				demand_t * last = nullptr;
+				std::size_t i = 0;
+				for( demand_t * d = first; d; d = d->m_next, ++i )
+					{
+						d->m_demand = std::move( demands[ i ] );
+						last = d;
+					}
+
+				try
+					{
+						for( ; i != count; ++i )
+							{
+								demand_t * d = new demand_t( std::move( demands[ i ] ) );
+								if( last )
+									last->m_next = d;
+								else
+									first = d;
+								last = d;
+							}
+					}
+				catch( ... )
+					{
+						for( demand_t * d = first; d; d = d->m_next )
+							d->m_demand = execution_demand_t{};
+						m_demands_pool.put_chain( first );
+						throw;
+					}
+
+				bool need_schedule = false;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					m_pool_counters.add( hits, count - hits );
+
+					const bool was_empty = (nullptr == m_head.m_next);
+
+					m_tail->m_next = first;
+					m_tail = last;
+
+					m_size += count;
+
+					if( was_empty )
+						{
+							// Need to detect necessity of queue activation.
+							if( !m_active )
+								if( !is_there_not_thread_safe_worker() )
+								{
+									need_schedule = true;
+									m_active = true;
+								}
+						}
+
+					SO_5_CHECK_INVARIANT( !empty(), this )
+					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
+					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
+				}
+
+				if( need_schedule )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the information about the front demand.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -181,6 +297,10 @@ class agent_queue_t
 
 		//! Remove the front demand.
 		/*!
+		 * \note Since v.5.5.17 the node of the removed demand is
+		 * not destroyed. It must be passed to release_removed_demand()
+		 * on unlocked queue.
+		 *
 		 * \retval true queue must be activated.
 		 * \retval false queue must not be activated.
 		 */
@@ -188,12 +308,14 @@ class agent_queue_t
 		worker_started(
 			//! Type of worker.
 			//! Must be thread_safe_worker or not_thread_safe_worker.
-			unsigned int type_of_worker )
+			unsigned int type_of_worker,
+			//! Receiver of the node of the removed demand.
+			removed_demand_t & removed )
 			{
 				SO_5_CHECK_INVARIANT( !empty(), this );
 				SO_5_CHECK_INVARIANT( !m_active, this );
 
-				delete_head();
+				removed = remove_head();
 				if( !m_head.m_next )
 					m_tail = &m_head;
 
@@ -263,11 +385,54 @@ class agent_queue_t
 				return m_size.load( std::memory_order_acquire );
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Return the node of a demand removed by worker_started()
+		 * to the dispatcher's pool.
+		 *
+		 * \note Must be called on unlocked queue.
+		 */
+		void
+		release_removed_demand( removed_demand_t removed )
+			{
+				removed->m_demand = execution_demand_t{};
+				removed->m_next = nullptr;
+				m_demands_pool.put_chain( removed );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the count of demands which nodes were taken
+		 * from the dispatcher's pool.
+		 */
+		std::size_t
+		pool_hits() const
+			{
+				return m_pool_counters.hits();
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the count of demands which nodes were allocated
+		 * by operator new.
+		 */
+		std::size_t
+		pool_misses() const
+			{
+				return m_pool_counters.misses();
+			}
+
 	private :
 		//! Dispatcher queue for scheduling processing of events from
 		//! this queue.
 		dispatcher_queue_t & m_disp_queue;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Pool of nodes shared by all queues of the dispatcher.
+		 */
+		demands_pool_t & m_demands_pool;
+
 		//! Object's lock.
 		spinlock_t m_lock;
 
@@ -298,16 +463,33 @@ class agent_queue_t
 		 */
 		std::atomic< std::size_t > m_size = { 0 };
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Usage of the dispatcher's pool by that queue.
+		 */
+		so_5::disp::reuse::demands_pool_counters_t m_pool_counters;
+
 		//! Helper method for deleting queue's head object.
 		inline void
 		delete_head()
 			{
-				auto to_be_deleted = m_head.m_next;
+				delete remove_head();
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Helper method for removing queue's head object
+		 * without its destruction.
+		 */
+		inline demand_t *
+		remove_head()
+			{
+				auto removed = m_head.m_next;
 				m_head.m_next = m_head.m_next->m_next;
 
 				--m_size;
 
-				delete to_be_deleted;
+				return removed;
 			}
 	};
 
@@ -340,20 +522,45 @@ class work_thread_t
 		void
 		join()
 			{
-				m_thread.join();
+				m_thread->join();
+			}
+
+		/*!
+		 * \brief Has the thread body finished its work?
+		 *
+		 * \note It is used for joining of retired working threads
+		 * in elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		finished() const
+			{
+				return m_finished.load( std::memory_order_acquire );
 			}
 
 		//! Launch work thread.
 		void
-		start()
+		start(
+			//! Factory for the work thread.
+			thread_factory_t & thread_factory )
 			{
-				m_thread = std::thread( [this]() { body(); } );
+				m_thread = thread_factory.start( [this]() { body(); } );
 			}
 
 	private :
 		//! Dispatcher's queue.
 		dispatcher_queue_t * m_disp_queue;
 
+		/*!
+		 * \brief Flag of finishing of the thread body.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< bool > m_finished = { false };
+
 		//! ID of thread.
 		/*!
 		 * Receives actual value inside body().
@@ -361,7 +568,10 @@ class work_thread_t
 		so_5::current_thread_id_t m_thread_id;
 
 		//! Actual thread.
-		std::thread m_thread;
+		/*!
+		 * \note Since v.5.5.17 it is created by a thread factory.
+		 */
+		thread_handle_unique_ptr_t m_thread;
 
 		//! Thread alarm for long waiting.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
@@ -382,6 +592,8 @@ class work_thread_t
 
 						process_queue( *agent_queue );
 					}
+
+				m_finished.store( true, std::memory_order_release );
 			}
 
 		//! Processing of demands from agent queue.
@@ -398,6 +610,7 @@ class work_thread_t
 
 				auto hint = demand.m_receiver->so_create_execution_hint( demand );
 
+				agent_queue_t::removed_demand_t removed = nullptr;
 				bool need_schedule = true;
 				if( !hint.is_thread_safe() )
 				{
@@ -407,12 +620,12 @@ class work_thread_t
 						return;
 					else
 						need_schedule = queue.worker_started(
-								agent_queue_t::not_thread_safe_worker );
+								agent_queue_t::not_thread_safe_worker, removed );
 				}
 				else
 					// Threa-safe worker can be started.
 					need_schedule = queue.worker_started(
-							agent_queue_t::thread_safe_worker );
+							agent_queue_t::thread_safe_worker, removed );
 
 				SO_5_CHECK_INVARIANT( !(need_schedule && queue.empty()), &queue )
 				SO_5_CHECK_INVARIANT(
@@ -422,6 +635,8 @@ class work_thread_t
 				// Next few actions must be done on unlocked queue.
 				lock.unlock();
 
+				queue.release_removed_demand( removed );
+
 				if( need_schedule )
 					m_disp_queue->schedule( &queue );
 
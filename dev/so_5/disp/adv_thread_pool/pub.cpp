@@ -119,7 +119,8 @@ class real_private_dispatcher_t : public private_dispatcher_t
 			:	m_disp{
 					new dispatcher_t{
 						params.thread_count(),
-						params.queue_params() } }
+						params.queue_params(),
+						params.thread_factory() } }
 			{
 				m_disp->set_data_sources_name_base( data_sources_name_base );
 				m_disp->start( env );
@@ -180,7 +181,8 @@ create_disp(
 		return dispatcher_unique_ptr_t{
 				new impl::dispatcher_t{
 						params.thread_count(),
-						params.queue_params() } };
+						params.queue_params(),
+						params.thread_factory() } };
 	}
 
 //
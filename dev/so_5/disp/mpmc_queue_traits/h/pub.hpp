@@ -17,6 +17,7 @@
 #include <functional>
 #include <memory>
 #include <chrono>
+#include <cstddef>
 
 namespace so_5 {
 
@@ -225,6 +226,70 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// default_futex_lock_spin_count
+//
+/*!
+ * \brief Default count of spinning iterations used by futex_lock
+ * before going to sleep.
+ * \since
+ * v.5.5.17
+ */
+inline std::size_t
+default_futex_lock_spin_count()
+	{
+		return 4096;
+	}
+
+/*!
+ * \brief Factory for creation of queue lock based on Linux futexes
+ * with the specified count of spinning iterations.
+ *
+ * Both the common lock and the waiting of every consumer spin
+ * with CPU pause instruction before going to sleep on futex.
+ * A producer wakes a sleeping consumer by just one FUTEX_WAKE call.
+ *
+ * \note On platforms without futexes the combined_lock is used.
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			// Add another thread_pool dispatcher with futex_lock for
+			// event queue protection.
+			using namespace so_5::disp::thread_pool;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory( queue_traits::futex_lock_factory( 1000 ) );
+					} ) ) );
+		} );
+	\endcode
+ *
+ * \since
+ * v.5.5.17
+ */
+SO_5_FUNC lock_factory_t
+futex_lock_factory(
+	//! Count of spinning iterations before going to sleep.
+	std::size_t spin_count );
+
+/*!
+ * \brief Factory for creation of queue lock based on Linux futexes
+ * with the default count of spinning iterations.
+ *
+ * \note On platforms without futexes the combined_lock is used.
+ *
+ * \since
+ * v.5.5.17
+ */
+inline lock_factory_t
+futex_lock_factory()
+	{
+		return futex_lock_factory( default_futex_lock_spin_count() );
+	}
+
 //
 // queue_params_t
 //
@@ -240,23 +305,27 @@ class queue_params_t
 		queue_params_t()
 			:	m_lock_factory{ combined_lock_factory() }
 			,	m_next_thread_wakeup_threshold{ 0 }
+			,	m_work_stealing{ false }
 			{}
 		//! Copy constructor.
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
 			,	m_next_thread_wakeup_threshold{ o.m_next_thread_wakeup_threshold }
+			,	m_work_stealing{ o.m_work_stealing }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
 			,	m_next_thread_wakeup_threshold{
 					std::move(o.m_next_thread_wakeup_threshold) }
+			,	m_work_stealing{ o.m_work_stealing }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				std::swap( a.m_lock_factory, b.m_lock_factory );
 				std::swap( a.m_next_thread_wakeup_threshold, b.m_next_thread_wakeup_threshold );
+				std::swap( a.m_work_stealing, b.m_work_stealing );
 			}
 
 		//! Copy operator.
@@ -338,6 +407,61 @@ class queue_params_t
 				return m_next_thread_wakeup_threshold;
 			}
 
+		/*!
+		 * \brief Setter for work stealing mode.
+		 *
+		 * By default all working threads of thread_pool and adv_thread_pool
+		 * dispatchers take non-empty agent queues from one common queue.
+		 * This queue is protected by one lock and this lock can become
+		 * a point of contention if there are many working threads.
+		 *
+		 * In work stealing mode every working thread has its own local
+		 * queue of non-empty agent queues. An agent queue which becomes
+		 * non-empty on a working thread is stored into the local queue
+		 * of that thread. A working thread with empty local queue tries
+		 * to steal an agent queue from local queues of other threads.
+		 * The common lock is used only for sleeping/waking up of
+		 * working threads.
+		 *
+		 * Usage example:
+		 * \code
+			using namespace so_5;
+			using namespace so_5::disp::thread_pool;
+
+			environment_t & env = ...;
+			auto disp = create_private_disp(
+				env,
+				"my-thread-pool",
+				disp_params_t{}
+					.thread_count( 24 )
+					.tune_queue_params(
+						[]( queue_traits::queue_params_t & qp ) {
+							qp.work_stealing( true );
+						} )
+				);
+		 * \endcode
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		queue_params_t &
+		work_stealing( bool value )
+			{
+				m_work_stealing = value;
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for work stealing mode.
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		work_stealing() const
+			{
+				return m_work_stealing;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
@@ -350,6 +474,14 @@ class queue_params_t
 		 * v.5.5.16
 		 */
 		std::size_t m_next_thread_wakeup_threshold;
+
+		/*!
+		 * \brief Is work stealing mode turned on?
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool m_work_stealing;
 	};
 
 } /* namespace mpmc_queue_traits */
@@ -12,6 +12,8 @@
 
 #include <so_5/h/spinlocks.hpp>
 
+#include <so_5/details/h/futex.hpp>
+
 #include <mutex>
 #include <condition_variable>
 
@@ -275,6 +277,112 @@ class actual_lock_t : public lock_t
 
 } /* namespace simple_lock */
 
+#if defined( SO_5_HAS_FUTEX )
+
+namespace futex_lock
+{
+
+using mutex_t = so_5::details::futex::mutex_t;
+using event_t = so_5::details::futex::event_t;
+
+//
+// actual_cond_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Actual implementation of condition object for the case
+ * of locking on futexes.
+ */
+class actual_cond_t : public condition_t
+	{
+		//! Common mutex from the parent lock.
+		mutex_t & m_mutex;
+		//! Personal event for condition object owner.
+		event_t m_event;
+
+	public :
+		//! Initializing constructor.
+		actual_cond_t(
+			//! Common mutex from the parent lock.
+			mutex_t & mutex,
+			//! Count of spinning iterations before going to sleep.
+			std::size_t spin_count )
+			:	m_mutex{ mutex }
+			,	m_event{ spin_count }
+			{}
+
+		virtual void
+		wait() SO_5_NOEXCEPT override
+			{
+				/*
+				 * NOTE: mutex of the parent lock object is already
+				 * acquired by the current thread.
+				 */
+				m_event.reset();
+
+				m_mutex.unlock();
+
+				m_event.wait();
+
+				// Mutex must be reacquired to return the parent lock
+				// in the state at the call to wait().
+				m_mutex.lock();
+			}
+
+		virtual void
+		notify() SO_5_NOEXCEPT override
+			{
+				m_event.notify();
+			}
+	};
+
+//
+// actual_lock_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Actual implementation of lock object based on futexes.
+ */
+class actual_lock_t : public lock_t
+	{
+		//! Common mutex for all producers and consumers.
+		mutex_t m_mutex;
+		//! Count of spinning iterations before going to sleep.
+		const std::size_t m_spin_count;
+
+	public :
+		//! Initializing constructor.
+		actual_lock_t(
+			//! Count of spinning iterations before going to sleep.
+			std::size_t spin_count )
+			:	m_mutex{ spin_count }
+			,	m_spin_count{ spin_count }
+			{}
+
+		virtual void
+		lock() SO_5_NOEXCEPT override
+			{
+				m_mutex.lock();
+			}
+
+		virtual void
+		unlock() SO_5_NOEXCEPT override
+			{
+				m_mutex.unlock();
+			}
+
+		virtual condition_unique_ptr_t
+		allocate_condition() override
+			{
+				return condition_unique_ptr_t{
+					new actual_cond_t{ m_mutex, m_spin_count } };
+			}
+	};
+
+} /* namespace futex_lock */
+
+#endif
+
 //
 // combined_lock_factory
 //
@@ -299,6 +407,24 @@ simple_lock_factory()
 			};
 	}
 
+//
+// futex_lock_factory
+//
+SO_5_FUNC lock_factory_t
+futex_lock_factory(
+	std::size_t spin_count )
+	{
+#if defined( SO_5_HAS_FUTEX )
+		return [spin_count] {
+				return lock_unique_ptr_t{
+					new futex_lock::actual_lock_t{ spin_count } };
+			};
+#else
+		(void)spin_count;
+		return combined_lock_factory();
+#endif
+	}
+
 } /* namespace mpmc_queue_traits */
 
 } /* namespace disp */
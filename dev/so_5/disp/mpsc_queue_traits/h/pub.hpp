@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <chrono>
+#include <cstddef>
 
 namespace so_5 {
 
@@ -57,6 +58,20 @@ class SO_5_TYPE lock_t
 		virtual void
 		wait_for_notify() SO_5_NOEXCEPT = 0;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Waiting for notification or for expiration of timeout.
+		 *
+		 * \note Can return before timeout without notification.
+		 * The caller must check its condition after return.
+		 *
+		 * \attention Must be called only when object is locked!
+		 */
+		virtual void
+		wait_for_notify_for(
+			//! Max waiting time.
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT = 0;
+
 		//! Notify one waiting thread if it exists.
 		/*!
 		 * \attention Must be called only when object is locked.
@@ -178,6 +193,63 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+//
+// default_futex_lock_spin_count
+//
+/*!
+ * \since v.5.5.17
+ * \brief Default count of spinning iterations used by futex_lock
+ * before going to sleep.
+ */
+inline std::size_t
+default_futex_lock_spin_count()
+	{
+		return 4096;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for creation of queue lock based on Linux futexes
+ * with the specified count of spinning iterations.
+ *
+ * Spinning is done with CPU pause instruction without calls to OS.
+ * Then the consumer sleeps on futex. A producer wakes the consumer
+ * by just one FUTEX_WAKE call.
+ *
+ * \note On platforms without futexes the combined_lock is used.
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			using namespace so_5::disp::one_thread;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory( queue_traits::futex_lock_factory( 1000 ) );
+					} ) ) );
+		} );
+	\endcode
+ */
+SO_5_FUNC lock_factory_t
+futex_lock_factory(
+	//! Count of spinning iterations before going to sleep.
+	std::size_t spin_count );
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for creation of queue lock based on Linux futexes
+ * with the default count of spinning iterations.
+ *
+ * \note On platforms without futexes the combined_lock is used.
+ */
+inline lock_factory_t
+futex_lock_factory()
+	{
+		return futex_lock_factory( default_futex_lock_spin_count() );
+	}
+
 //
 // unique_lock_t
 //
@@ -210,6 +282,16 @@ class unique_lock_t
 				m_lock.wait_for_notify();
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Waiting for notification or for expiration of timeout.
+		 */
+		inline void
+		wait_for_notify_for( std::chrono::steady_clock::duration timeout )
+			{
+				m_lock.wait_for_notify_for( timeout );
+			}
+
 	private :
 		lock_t & m_lock;
 	};
@@ -263,20 +345,24 @@ class queue_params_t
 		//! Default constructor.
 		queue_params_t()
 			:	m_lock_factory{ combined_lock_factory() }
+			,	m_lock_free{ false }
 			{}
 		//! Copy constructor.
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
+			,	m_lock_free{ o.m_lock_free }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
+			,	m_lock_free{ o.m_lock_free }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				using namespace std;
 				swap( a.m_lock_factory, b.m_lock_factory );
+				swap( a.m_lock_free, b.m_lock_free );
 			}
 
 		//! Copy operator.
@@ -310,9 +396,59 @@ class queue_params_t
 				return m_lock_factory;
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Setter for lock-free mode of the queue.
+		 *
+		 * By default demands are stored into a queue protected by a lock
+		 * created by the lock factory. In lock-free mode an intrusive
+		 * lock-free MPSC queue is used. Producers do only one atomic
+		 * exchange operation without acquiring any lock. The lock created
+		 * by the lock factory is used only for parking of the consumer
+		 * thread when the queue is empty.
+		 *
+		 * \note This mode is supported by dispatchers which use
+		 * so_5::disp::reuse::work_thread (one_thread, active_obj,
+		 * active_group and prio_dedicated_threads::one_per_prio). It is
+		 * ignored by other dispatchers.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::one_thread;
+			auto disp = create_private_disp( env,
+				"fast_consumer",
+				disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & p ) {
+						p.lock_free( true );
+					} ) );
+			\endcode
+		 */
+		queue_params_t &
+		lock_free( bool value )
+			{
+				m_lock_free = value;
+				return *this;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Getter for lock-free mode of the queue.
+		 */
+		bool
+		lock_free() const
+			{
+				return m_lock_free;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Should lock-free queue be used?
+		 */
+		bool m_lock_free;
 	};
 
 /*!
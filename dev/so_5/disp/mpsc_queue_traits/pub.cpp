@@ -13,6 +13,7 @@
 #include <so_5/h/spinlocks.hpp>
 
 #include <so_5/details/h/invoke_noexcept_code.hpp>
+#include <so_5/details/h/futex.hpp>
 
 #include <mutex>
 #include <condition_variable>
@@ -101,16 +102,73 @@ class combined_lock_t : public lock_t
 				// Must use heavy std::mutex and std::condition_variable
 				// to allow OS to efficiently use the resources while
 				// we are waiting for signal.
-				std::unique_lock< std::mutex > mlock( m_mutex );
+				{
+					std::unique_lock< std::mutex > mlock( m_mutex );
 
-				m_spinlock.unlock();
+					m_spinlock.unlock();
+
+					m_condition.wait( mlock, [this]{ return m_signaled; } );
+
+					// Mutex must be released before reacquiring the spinlock
+					// because a producer can hold the spinlock and wait
+					// for the mutex.
+				}
 
-				m_condition.wait( mlock, [this]{ return m_signaled; } );
+				m_spinlock.lock();
 
 				// At this point m_signaled must be 'true'.
 
+				m_waiting = false;
+				m_signaled = false;
+			}
+
+		virtual void
+		wait_for_notify_for(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT override
+			{
+				using clock = std::chrono::high_resolution_clock;
+
+				const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+				m_waiting = true;
+				auto stop_point = clock::now() + m_waiting_time;
+
+				do
+					{
+						m_spinlock.unlock();
+
+						std::this_thread::yield();
+
+						m_spinlock.lock();
+
+						if( m_signaled || std::chrono::steady_clock::now() >= deadline )
+							{
+								m_waiting = false;
+								m_signaled = false;
+								return;
+							}
+					}
+				while( stop_point > clock::now() );
+
+				// m_lock is locked now.
+
+				{
+					std::unique_lock< std::mutex > mlock( m_mutex );
+
+					m_spinlock.unlock();
+
+					m_condition.wait_until( mlock, deadline,
+							[this]{ return m_signaled; } );
+
+					// Mutex must be released before reacquiring the spinlock
+					// because a producer can hold the spinlock and wait
+					// for the mutex.
+				}
+
 				m_spinlock.lock();
 
+				// Notification could be received after timeout. It is not
+				// a problem because the caller checks its condition anyway.
 				m_waiting = false;
 				m_signaled = false;
 			}
@@ -182,6 +240,21 @@ class simple_lock_t : public lock_t
 				m_signaled = false;
 			}
 
+		virtual void
+		wait_for_notify_for(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT override
+			{
+				so_5::details::invoke_noexcept_code( [&] {
+					// Mutex already locked. We must not try to reacquire it.
+					std::unique_lock< std::mutex > mlock{ m_mutex, std::adopt_lock };
+					m_condition.wait_for( mlock, timeout,
+							[this]{ return m_signaled; } );
+					mlock.release();
+				} );
+
+				m_signaled = false;
+			}
+
 		virtual void
 		notify_one() SO_5_NOEXCEPT override
 			{
@@ -196,6 +269,95 @@ class simple_lock_t : public lock_t
 		bool m_signaled = { false };
 	};
 
+#if defined( SO_5_HAS_FUTEX )
+
+//
+// futex_lock_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A lock based on Linux futexes.
+ *
+ * Both the lock itself and the notification of the consumer use
+ * futexes with bounded spinning phase. A producer does just one
+ * FUTEX_WAKE and only if the consumer is really sleeping.
+ *
+ * \attention This lock can be used only for single-consumer queues!
+ */
+class futex_lock_t : public lock_t
+	{
+	public :
+		futex_lock_t(
+			//! Count of spinning iterations before going to sleep.
+			std::size_t spin_count )
+			:	m_mutex{ spin_count }
+			,	m_event{ spin_count }
+			{}
+
+		virtual void
+		lock() SO_5_NOEXCEPT override
+			{
+				m_mutex.lock();
+			}
+
+		virtual void
+		unlock() SO_5_NOEXCEPT override
+			{
+				m_mutex.unlock();
+			}
+
+	protected :
+		virtual void
+		wait_for_notify() SO_5_NOEXCEPT override
+			{
+				m_waiting = true;
+				m_event.reset();
+
+				m_mutex.unlock();
+
+				m_event.wait();
+
+				m_mutex.lock();
+
+				m_waiting = false;
+			}
+
+		virtual void
+		wait_for_notify_for(
+			std::chrono::steady_clock::duration timeout ) SO_5_NOEXCEPT override
+			{
+				m_waiting = true;
+				m_event.reset();
+
+				m_mutex.unlock();
+
+				m_event.wait_for( timeout );
+
+				m_mutex.lock();
+
+				m_waiting = false;
+			}
+
+		virtual void
+		notify_one() SO_5_NOEXCEPT override
+			{
+				if( m_waiting )
+					m_event.notify();
+			}
+
+	private :
+		so_5::details::futex::mutex_t m_mutex;
+		so_5::details::futex::event_t m_event;
+
+		//! Is there a waiting consumer?
+		/*!
+		 * \note Protected by m_mutex.
+		 */
+		bool m_waiting = { false };
+	};
+
+#endif
+
 } /* namespace impl */
 
 //
@@ -219,6 +381,23 @@ simple_lock_factory()
 		return [] { return lock_unique_ptr_t{ new impl::simple_lock_t{} }; };
 	}
 
+//
+// futex_lock_factory
+//
+SO_5_FUNC lock_factory_t
+futex_lock_factory(
+	std::size_t spin_count )
+	{
+#if defined( SO_5_HAS_FUTEX )
+		return [spin_count] {
+			return lock_unique_ptr_t{ new impl::futex_lock_t{ spin_count } };
+		};
+#else
+		(void)spin_count;
+		return combined_lock_factory();
+#endif
+	}
+
 } /* namespace mpsc_queue_traits */
 
 } /* namespace disp */
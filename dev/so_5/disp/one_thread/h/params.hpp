@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <so_5/h/thread_factory.hpp>
+#include <so_5/h/timers.hpp>
+
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
 namespace so_5
@@ -46,15 +49,21 @@ class disp_params_t
 		//! Copy constructor.
 		disp_params_t( const disp_params_t & o )
 			:	m_queue_params{ o.m_queue_params }
+			,	m_thread_factory{ o.m_thread_factory }
+			,	m_timer_manager_factory{ o.m_timer_manager_factory }
 			{}
 		//! Move constructor.
 		disp_params_t( disp_params_t && o )
 			:	m_queue_params{ std::move(o.m_queue_params) }
+			,	m_thread_factory{ std::move(o.m_thread_factory) }
+			,	m_timer_manager_factory{ std::move(o.m_timer_manager_factory) }
 			{}
 
 		friend inline void swap( disp_params_t & a, disp_params_t & b )
 			{
 				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_thread_factory, b.m_thread_factory );
+				std::swap( a.m_timer_manager_factory, b.m_timer_manager_factory );
 			}
 
 		//! Copy operator.
@@ -108,9 +117,95 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Setter for thread factory.
+		 *
+		 * Allows to specify names, stack sizes and CPU affinity
+		 * for working threads of the dispatcher.
+		 */
+		disp_params_t &
+		thread_factory( thread_factory_shptr_t factory )
+			{
+				m_thread_factory = std::move(factory);
+				return *this;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Getter for thread factory.
+		 *
+		 * \note Can be empty. In that case the factory from the
+		 * SObjectizer Environment is used.
+		 */
+		const thread_factory_shptr_t &
+		thread_factory() const
+			{
+				return m_thread_factory;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Setter for timer manager factory.
+		 *
+		 * If timer manager factory is specified then the dispatcher
+		 * gets its own timer manager. Elapsed timers of that manager
+		 * are handled by the working thread of the dispatcher between
+		 * processing of demands. Delayed and periodic messages scheduled
+		 * via that timer manager do not go through the timer thread
+		 * of the SObjectizer Environment.
+		 *
+		 * \par Usage example:
+			\code
+			auto disp = so_5::disp::one_thread::create_private_disp( env,
+				"sessions",
+				so_5::disp::one_thread::disp_params_t{}.timer_manager(
+					so_5::timer_list_manager_factory() ) );
+			...
+			// Timer will be handled on the working thread of disp.
+			so_5::send_delayed< msg_session_timeout >(
+				disp->timer_manager(), session_mbox,
+				std::chrono::seconds(30) );
+			\endcode
+		 */
+		disp_params_t &
+		timer_manager( timer_manager_factory_t factory )
+			{
+				m_timer_manager_factory = std::move(factory);
+				return *this;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Getter for timer manager factory.
+		 *
+		 * \note Can be empty. In that case the dispatcher has no
+		 * timer manager.
+		 */
+		const timer_manager_factory_t &
+		timer_manager() const
+			{
+				return m_timer_manager_factory;
+			}
+
 	private :
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for timer manager of the dispatcher.
+		 *
+		 * Empty value means that the dispatcher has no timer manager.
+		 */
+		timer_manager_factory_t m_timer_manager_factory;
 	};
 
 //
@@ -43,6 +43,19 @@ class SO_5_TYPE private_dispatcher_t : public so_5::atomic_refcounted_t
 		//! Create a binder for that private dispatcher.
 		virtual disp_binder_unique_ptr_t
 		binder() = 0;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the timer manager of the dispatcher.
+		 *
+		 * Timers of this manager are handled by the working thread
+		 * of the dispatcher.
+		 *
+		 * \throw so_5::exception_t with rc_disp_has_no_timer_manager
+		 * if timer manager factory wasn't specified in disp_params_t.
+		 */
+		virtual so_5::timer_manager_t &
+		timer_manager() = 0;
 	};
 
 /*!
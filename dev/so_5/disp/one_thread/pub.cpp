@@ -16,6 +16,9 @@
 
 #include <so_5/disp/reuse/h/disp_binder_helpers.hpp>
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
+
+#include <so_5/rt/impl/h/st_env_infrastructure.hpp>
 
 #include <so_5/details/h/rollback_on_exception.hpp>
 
@@ -47,7 +50,9 @@ class dispatcher_t : public so_5::dispatcher_t
 	{
 	public:
 		dispatcher_t( disp_params_t params )
-			:	m_work_thread{ params.queue_params().lock_factory() }
+			:	m_work_thread{ params.queue_params() }
+			,	m_thread_factory{ params.thread_factory() }
+			,	m_timer_manager_factory{ params.timer_manager() }
 			,	m_data_source( m_work_thread, m_agents_bound )
 			{}
 
@@ -56,10 +61,22 @@ class dispatcher_t : public so_5::dispatcher_t
 		virtual void
 		start( environment_t & env ) override
 			{
+				if( m_timer_manager_factory )
+					// The dispatcher lives less than the environment.
+					// So the environment's error logger can be passed
+					// to the timer manager without ownership.
+					m_work_thread.set_timer_manager( m_timer_manager_factory(
+							error_logger_shptr_t{
+									&env.error_logger(), []( error_logger_t * ) {} } ) );
+
 				m_data_source.start( env );
 
 				so_5::details::do_with_rollback_on_exception(
-						[this] { m_work_thread.start(); },
+						[&] {
+							m_work_thread.start(
+									so_5::disp::reuse::actual_thread_factory(
+											m_thread_factory, env ) );
+						},
 						[this] { m_data_source.stop(); } );
 			}
 
@@ -95,6 +112,23 @@ class dispatcher_t : public so_5::dispatcher_t
 				return m_work_thread.get_agent_binding();
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the timer manager of the dispatcher.
+		 *
+		 * \throw so_5::exception_t if there is no timer manager.
+		 */
+		so_5::timer_manager_t &
+		timer_manager()
+			{
+				auto manager = m_work_thread.timer_manager();
+				if( !manager )
+					SO_5_THROW_EXCEPTION( rc_disp_has_no_timer_manager,
+							"one_thread dispatcher has no timer manager" );
+
+				return *manager;
+			}
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief Inform dispatcher about binding of yet another agent.
@@ -212,6 +246,23 @@ class dispatcher_t : public so_5::dispatcher_t
 		//! Working thread for the dispatcher.
 		work_thread::work_thread_t m_work_thread;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for the working thread.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for the timer manager.
+		 *
+		 * Empty value means that the dispatcher has no timer manager.
+		 */
+		timer_manager_factory_t m_timer_manager_factory;
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief Count of agents bound to this dispatcher.
@@ -412,6 +463,12 @@ class real_private_dispatcher_t : public private_dispatcher_t
 								*m_disp ) );
 			}
 
+		virtual so_5::timer_manager_t &
+		timer_manager() override
+			{
+				return m_disp->timer_manager();
+			}
+
 	private :
 		std::unique_ptr< dispatcher_t > m_disp;
 	};
@@ -468,7 +525,11 @@ SO_5_FUNC disp_binder_unique_ptr_t
 create_default_disp_binder()
 {
 	// Dispatcher with empty name means default dispatcher.
-	return so_5::disp::one_thread::create_disp_binder( std::string() );
+	// Since v.5.5.17 the default dispatcher can be a dispatcher of
+	// single-threaded environment.
+	return disp_binder_unique_ptr_t(
+		new so_5::impl::st_env::default_disp_binder_t(
+			so_5::disp::one_thread::create_disp_binder( std::string() ) ) );
 }
 
 } /* namespace so_5 */
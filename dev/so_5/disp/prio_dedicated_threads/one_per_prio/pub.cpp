@@ -15,6 +15,7 @@
 
 #include <so_5/disp/reuse/h/disp_binder_helpers.hpp>
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
 
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
@@ -52,13 +53,12 @@ class dispatcher_t : public so_5::dispatcher_t
 	public:
 		dispatcher_t( disp_params_t params )
 			:	m_data_source{ self() }
+			,	m_thread_factory{ params.thread_factory() }
 			{
 				m_threads.reserve( so_5::prio::total_priorities_count );
 				so_5::prio::for_each_priority( [&]( so_5::priority_t ) {
-						auto lock_factory = params.queue_params().lock_factory();
-
 						std::unique_ptr< work_thread_t > t{
-								new work_thread_t{ std::move(lock_factory) } };
+								new work_thread_t{ params.queue_params() } };
 						m_threads.push_back( std::move(t) );
 					} );
 			}
@@ -71,7 +71,11 @@ class dispatcher_t : public so_5::dispatcher_t
 				m_data_source.start( env.stats_repository() );
 
 				so_5::details::do_with_rollback_on_exception(
-						[this] { launch_work_threads(); },
+						[&] {
+							launch_work_threads(
+									so_5::disp::reuse::actual_thread_factory(
+											m_thread_factory, env ) );
+						},
 						[this] { m_data_source.stop(); } );
 			}
 
@@ -226,6 +230,15 @@ class dispatcher_t : public so_5::dispatcher_t
 		//! Working threads for every priority.
 		std::vector< std::unique_ptr< work_thread_t > > m_threads;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
+
 		//! Counters for agent count for every priority.
 		std::atomic< std::size_t > m_agents_per_priority[ so_5::prio::total_priorities_count ];
 
@@ -240,7 +253,9 @@ class dispatcher_t : public so_5::dispatcher_t
 
 		//! Start all working threads.
 		void
-		launch_work_threads()
+		launch_work_threads(
+			//! Factory for working threads.
+			thread_factory_t & thread_factory )
 			{
 				using namespace std;
 				using namespace so_5::details;
@@ -258,7 +273,7 @@ class dispatcher_t : public so_5::dispatcher_t
 								m_agents_per_priority[ i ].store( 0,
 										std::memory_order_release );
 
-								m_threads[ i ]->start();
+								m_threads[ i ]->start( thread_factory );
 
 								// Thread successfully started. Pointer to it
 								// must be used on rollback.
@@ -0,0 +1,135 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief A bitmap of non-empty subqueues for dispatchers with
+ * support of demands priority.
+ */
+
+#pragma once
+
+#include <so_5/h/priority.hpp>
+
+#include <climits>
+#include <cstddef>
+
+#if defined( _MSC_VER )
+	#include <intrin.h>
+#endif
+
+namespace so_5 {
+
+namespace disp {
+
+namespace prio_one_thread {
+
+namespace reuse {
+
+//
+// priority_bitmap_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A bitmap of non-empty subqueues.
+ *
+ * Bit with index N is set if there is at least one demand with
+ * priority N. It allows to find the non-empty subqueue with the
+ * highest priority by one count-leading-zeros instruction instead
+ * of iteration over all subqueues.
+ *
+ * \attention This class is not thread safe. It must be used only under
+ * the lock of the owner demand queue.
+ */
+class priority_bitmap_t
+	{
+		using bits_t = unsigned int;
+
+		static_assert(
+				so_5::prio::total_priorities_count <= sizeof(bits_t) * CHAR_BIT,
+				"all priorities must fit into priority_bitmap_t" );
+
+	public :
+		//! Mark subqueue with \a index as non-empty.
+		void
+		set( std::size_t index )
+			{
+				m_bits |= bits_t{1} << index;
+			}
+
+		//! Mark subqueue with \a index as empty.
+		void
+		reset( std::size_t index )
+			{
+				m_bits &= ~( bits_t{1} << index );
+			}
+
+		//! Are all subqueues empty?
+		bool
+		empty() const
+			{
+				return 0 == m_bits;
+			}
+
+		//! Get index of the non-empty subqueue with the highest priority.
+		/*!
+		 * \attention Bitmap must not be empty.
+		 */
+		std::size_t
+		highest() const
+			{
+				return highest_bit( m_bits );
+			}
+
+		//! Get index of the non-empty subqueue with the highest priority
+		//! which is lower than \a index.
+		/*!
+		 * If there is no such subqueue then the index of the non-empty
+		 * subqueue with the highest priority is returned.
+		 *
+		 * \attention Bitmap must not be empty.
+		 */
+		std::size_t
+		next_lower_or_highest( std::size_t index ) const
+			{
+				const bits_t lower = m_bits & ( ( bits_t{1} << index ) - 1 );
+				return highest_bit( lower ? lower : m_bits );
+			}
+
+	private :
+		//! Bits of non-empty subqueues.
+		bits_t m_bits = 0;
+
+		//! Index of the most significant non-zero bit.
+		/*!
+		 * \attention \a bits must not be zero.
+		 */
+		static std::size_t
+		highest_bit( bits_t bits )
+			{
+#if defined( __GNUC__ ) || defined( __clang__ )
+				return sizeof(bits_t) * CHAR_BIT - 1 -
+						static_cast< std::size_t >( __builtin_clz( bits ) );
+#elif defined( _MSC_VER )
+				unsigned long index;
+				_BitScanReverse( &index, bits );
+				return index;
+#else
+				std::size_t index = 0;
+				while( bits >>= 1 )
+					++index;
+				return index;
+#endif
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace prio_one_thread */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
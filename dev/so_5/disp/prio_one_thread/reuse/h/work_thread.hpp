@@ -12,8 +12,7 @@
 #pragma once
 
 #include <so_5/h/current_thread_id.hpp>
-
-#include <thread>
+#include <so_5/h/thread_factory.hpp>
 
 namespace so_5 {
 
@@ -41,15 +40,17 @@ class work_thread_t
 			{}
 
 		void
-		start()
+		start(
+			//! Factory for the working thread.
+			thread_factory_t & thread_factory )
 			{
-				m_thread = std::thread( [this]() { body(); } );
+				m_thread = thread_factory.start( [this]() { body(); } );
 			}
 
 		void
 		join()
 			{
-				m_thread.join();
+				m_thread->join();
 			}
 
 	private :
@@ -57,7 +58,10 @@ class work_thread_t
 		DEMAND_QUEUE & m_queue;
 
 		//! Thread object.
-		std::thread m_thread;
+		/*!
+		 * \note Since v.5.5.17 it is created by a thread factory.
+		 */
+		thread_handle_unique_ptr_t m_thread;
 
 		void
 		body()
@@ -66,10 +70,16 @@ class work_thread_t
 
 				try
 					{
+						// Since v.5.5.17 every processed demand is returned
+						// to the queue for reuse.
+						auto d = m_queue.pop( nullptr );
 						for(;;)
 							{
-								auto d = m_queue.pop();
 								d->call_handler( thread_id );
+								// Message must not be held by a free demand.
+								d->m_message_ref.reset();
+
+								d = m_queue.pop( std::move( d ) );
 							}
 					}
 				catch( const typename DEMAND_QUEUE::shutdown_ex_t & )
@@ -21,6 +21,10 @@
 
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
+#include <so_5/disp/prio_one_thread/reuse/h/priority_bitmap.hpp>
+
+#include <so_5/disp/reuse/h/demands_freelist.hpp>
+
 namespace so_5 {
 
 namespace disp {
@@ -100,10 +104,15 @@ class demand_queue_t
 				virtual void
 				push( execution_demand_t exec_demand ) override
 					{
-						demand_unique_ptr_t what{ new demand_t{
-								std::move( exec_demand ) } };
+						m_demand_queue->push( this, std::move( exec_demand ) );
+					}
 
-						m_demand_queue->push( this, std::move( what ) );
+				virtual void
+				push_batch(
+					execution_demand_t * demands,
+					std::size_t count ) override
+					{
+						m_demand_queue->push_batch( this, demands, count );
 					}
 			};
 
@@ -152,10 +161,23 @@ class demand_queue_t
 		//! Pop demand from the queue.
 		/*!
 		 * \throw shutdown_ex_t in the case when queue is shut down.
+		 *
+		 * \note Since v.5.5.17 a previously processed demand can be returned
+		 * to the queue for reuse. It goes to the pool of free demands
+		 * before the acquisition of the queue's lock.
 		 */
 		demand_unique_ptr_t
-		pop()
+		pop(
+			//! Demand which has been processed. Can be nullptr.
+			demand_unique_ptr_t processed )
 			{
+				if( processed )
+					{
+						static_cast< execution_demand_t & >( *processed ) =
+								execution_demand_t();
+						m_demands_pool.put_chain( processed.release() );
+					}
+
 				queue_traits::unique_lock_t lock{ *m_lock };
 
 				while( !m_shutdown && !m_current_priority )
@@ -174,16 +196,14 @@ class demand_queue_t
 					{
 						// Queue become empty.
 						m_current_priority->m_tail = nullptr;
-
-						// A non-empty subqueue with lower priority needs to be found.
-						while( m_current_priority > m_priorities )
-							{
-								--m_current_priority;
-								if( m_current_priority->m_head )
-									return result;
-							}
-
-						m_current_priority = nullptr;
+						m_non_empty.reset(
+								static_cast< std::size_t >(
+										m_current_priority - m_priorities ) );
+
+						// A non-empty subqueue with lower priority is found
+						// without iteration over all subqueues.
+						m_current_priority = m_non_empty.empty() ? nullptr :
+								&m_priorities[ m_non_empty.highest() ];
 					}
 
 				return result;
@@ -242,6 +262,21 @@ class demand_queue_t
 		//! Subqueues for priorities.
 		queue_for_one_priority_t m_priorities[ so_5::prio::total_priorities_count ];
 
+		//! Bitmap of non-empty subqueues.
+		/*!
+		 * \since v.5.5.17
+		 */
+		reuse::priority_bitmap_t m_non_empty;
+
+		//! Free demands for reuse.
+		/*!
+		 * \since v.5.5.17
+		 *
+		 * \note The pool has its own lock. Demands are taken from it and
+		 * returned to it without holding the queue's lock.
+		 */
+		so_5::disp::reuse::demands_pool_t< demand_t > m_demands_pool;
+
 		//! Destroy all demands in the queue specified.
 		void
 		cleanup_queue( queue_for_one_priority_t & queue_info )
@@ -254,17 +289,127 @@ class demand_queue_t
 					}
 			}
 
+		//! Make a new demand from a free one or by operator new.
+		/*!
+		 * \since v.5.5.17
+		 */
+		demand_unique_ptr_t
+		make_demand( execution_demand_t && exec_demand )
+			{
+				demand_unique_ptr_t demand{ m_demands_pool.try_take() };
+				if( demand )
+					static_cast< execution_demand_t & >( *demand ) =
+							std::move( exec_demand );
+				else
+					demand.reset( new demand_t{ std::move( exec_demand ) } );
+
+				return demand;
+			}
+
 		//! Push a new demand to the queue.
+		/*!
+		 * \note Since v.5.5.17 a free demand is reused if possible.
+		 * The demand is prepared before the acquisition of the queue's lock.
+		 */
 		void
 		push(
 			//! Subqueue for the demand.
 			queue_for_one_priority_t * subqueue,
 			//! Demand to be pushed.
-			demand_unique_ptr_t demand )
+			execution_demand_t && exec_demand )
+			{
+				auto demand = make_demand( std::move( exec_demand ) );
+
+				queue_traits::lock_guard_t lock{ *m_lock };
+				push_to_locked_queue( lock, subqueue, std::move( demand ) );
+			}
+
+		//! Push several demands to the same subqueue.
+		/*!
+		 * \since v.5.5.17
+		 *
+		 * Free demands are taken from the pool by one operation. Demands
+		 * for the rest are created by operator new. All of them are linked
+		 * into one chain before the acquisition of the queue's lock. Then
+		 * the chain is added by one locked operation with at most one
+		 * notification of the working thread.
+		 */
+		void
+		push_batch(
+			//! Subqueue for the demands.
+			queue_for_one_priority_t * subqueue,
+			//! Demands to be pushed.
+			execution_demand_t * demands,
+			//! Count of demands.
+			std::size_t count )
 			{
+				if( !count )
+					return;
+
+				queue_for_one_priority_t chain;
+				try
+					{
+						demand_t * free_demand = nullptr;
+						m_demands_pool.try_take_chain( count, free_demand );
+
+						std::size_t i = 0;
+						while( free_demand )
+							{
+								demand_unique_ptr_t d{ free_demand };
+								free_demand = d->m_next;
+								d->m_next = nullptr;
+
+								static_cast< execution_demand_t & >( *d ) =
+										std::move( demands[ i++ ] );
+								add_demand_to_queue( chain, std::move( d ) );
+							}
+
+						for( ; i != count; ++i )
+							add_demand_to_queue( chain,
+									demand_unique_ptr_t{
+											new demand_t{ std::move( demands[ i ] ) } } );
+					}
+				catch( ... )
+					{
+						cleanup_queue( chain );
+						throw;
+					}
+
 				queue_traits::lock_guard_t lock{ *m_lock };
+				add_chain_to_queue( *subqueue, chain );
+				subqueue_extended( lock, subqueue, count );
+			}
 
+		//! Push a new demand to the queue when the queue is already locked.
+		void
+		push_to_locked_queue(
+			//! Acquired queue lock.
+			queue_traits::lock_guard_t & lock,
+			//! Subqueue for the demand.
+			queue_for_one_priority_t * subqueue,
+			//! Demand to be pushed.
+			demand_unique_ptr_t demand )
+			{
 				add_demand_to_queue( *subqueue, std::move( demand ) );
+				subqueue_extended( lock, subqueue, 1 );
+			}
+
+		//! Update the state of the queue after addition of new demands
+		//! to a subqueue.
+		/*!
+		 * \since v.5.5.17
+		 */
+		void
+		subqueue_extended(
+			//! Acquired queue lock.
+			queue_traits::lock_guard_t & lock,
+			//! Subqueue for the demands.
+			queue_for_one_priority_t * subqueue,
+			//! Count of new demands.
+			std::size_t /*count*/ )
+			{
+				m_non_empty.set(
+						static_cast< std::size_t >( subqueue - m_priorities ) );
 
 				if( !m_current_priority )
 					{
@@ -299,6 +444,28 @@ class demand_queue_t
 
 				++(queue.m_demands_count);
 			}
+
+		//! Move all demands from \a chain to the tail of the queue specified.
+		/*!
+		 * \since v.5.5.17
+		 */
+		void
+		add_chain_to_queue(
+			queue_for_one_priority_t & queue,
+			queue_for_one_priority_t & chain )
+			{
+				if( queue.m_tail )
+					queue.m_tail->m_next = chain.m_head;
+				else
+					queue.m_head = chain.m_head;
+				queue.m_tail = chain.m_tail;
+
+				queue.m_demands_count += chain.m_demands_count.load(
+						std::memory_order_relaxed );
+
+				chain.m_head = chain.m_tail = nullptr;
+				chain.m_demands_count = 0;
+			}
 	};
 
 } /* namespace impl */
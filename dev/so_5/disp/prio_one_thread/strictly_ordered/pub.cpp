@@ -16,6 +16,7 @@
 
 #include <so_5/disp/reuse/h/disp_binder_helpers.hpp>
 #include <so_5/disp/reuse/h/data_source_prefix_helpers.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
 
 #include <so_5/rt/stats/h/repository.hpp>
 #include <so_5/rt/stats/h/messages.hpp>
@@ -49,6 +50,7 @@ class dispatcher_t : public so_5::dispatcher_t
 		dispatcher_t( disp_params_t params )
 			:	m_demand_queue{ params.queue_params().lock_factory()() }
 			,	m_work_thread{ m_demand_queue }
+			,	m_thread_factory{ params.thread_factory() }
 			,	m_data_source{ self() }
 			{}
 
@@ -60,7 +62,11 @@ class dispatcher_t : public so_5::dispatcher_t
 				m_data_source.start( env.stats_repository() );
 
 				so_5::details::do_with_rollback_on_exception(
-						[this] { m_work_thread.start(); },
+						[&] {
+							m_work_thread.start(
+									so_5::disp::reuse::actual_thread_factory(
+											m_thread_factory, env ) );
+						},
 						[this] { m_data_source.stop(); } );
 			}
 
@@ -207,6 +213,15 @@ class dispatcher_t : public so_5::dispatcher_t
 		so_5::disp::prio_one_thread::reuse::work_thread_t< demand_queue_t >
 				m_work_thread;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for the working thread.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
+
 		//! Data source for run-time monitoring.
 		disp_data_source_t m_data_source;
 
@@ -0,0 +1,251 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief A pool for nodes of intrusive demand queues.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+#include <so_5/h/spinlocks.hpp>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// default_demands_pool_capacity
+//
+/*!
+ * \since v.5.5.17
+ * \brief Default max count of free nodes to be held by a pool
+ * of a dispatcher.
+ */
+const std::size_t default_demands_pool_capacity = 1024;
+
+//
+// demands_pool_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A thread-safe pool of nodes for intrusive demand queues.
+ *
+ * One pool is shared by all event queues of a dispatcher. So the count
+ * of held nodes doesn't depend on the count of agents.
+ *
+ * Producers take nodes from the pool before acquiring the lock of an
+ * event queue and create missing nodes by operator new without holding
+ * any lock. Working threads return nodes of processed demands by chains
+ * after the release of the queue's lock. The pool's own lock is held only
+ * for relinking of nodes. Nodes which don't fit into the pool are
+ * deleted after the release of that lock.
+ *
+ * \tparam NODE type of node. Must have pointer to the next node
+ * with name m_next.
+ */
+template< typename NODE >
+class demands_pool_t
+	{
+	public :
+		demands_pool_t(
+			std::size_t capacity = default_demands_pool_capacity )
+			:	m_capacity( capacity )
+			{}
+
+		demands_pool_t( const demands_pool_t & ) = delete;
+		demands_pool_t &
+		operator=( const demands_pool_t & ) = delete;
+
+		~demands_pool_t()
+			{
+				delete_chain( m_head );
+			}
+
+		//! Try to get a free node.
+		/*!
+		 * \retval nullptr if there is no free nodes.
+		 */
+		NODE *
+		try_take()
+			{
+				NODE * n = nullptr;
+				{
+					std::lock_guard< default_spinlock_t > lock( m_lock );
+
+					n = m_head;
+					if( n )
+						{
+							m_head = n->m_next;
+							--m_size;
+						}
+				}
+
+				if( n )
+					n->m_next = nullptr;
+
+				return n;
+			}
+
+		//! Try to get several free nodes by one locked operation.
+		/*!
+		 * Taken nodes are linked via m_next. The last one has nullptr
+		 * in m_next.
+		 *
+		 * \return count of taken nodes. It can be less than \a count.
+		 */
+		std::size_t
+		try_take_chain(
+			//! Max count of nodes to be taken.
+			std::size_t count,
+			//! Receiver of the first taken node.
+			NODE *& first )
+			{
+				std::size_t taken = 0;
+				NODE * last = nullptr;
+				{
+					std::lock_guard< default_spinlock_t > lock( m_lock );
+
+					first = m_head;
+					for( NODE * n = m_head; taken != count && n; n = n->m_next )
+						{
+							last = n;
+							++taken;
+						}
+
+					if( last )
+						{
+							m_head = last->m_next;
+							m_size -= taken;
+						}
+				}
+
+				if( last )
+					last->m_next = nullptr;
+				else
+					first = nullptr;
+
+				return taken;
+			}
+
+		//! Return nodes to the pool.
+		/*!
+		 * Nodes must be linked via m_next. The last one must have
+		 * nullptr in m_next.
+		 *
+		 * \attention Demands in nodes must be already destroyed.
+		 */
+		void
+		put_chain( NODE * first )
+			{
+				{
+					std::lock_guard< default_spinlock_t > lock( m_lock );
+
+					while( first && m_size != m_capacity )
+						{
+							NODE * n = first;
+							first = n->m_next;
+
+							n->m_next = m_head;
+							m_head = n;
+							++m_size;
+						}
+				}
+
+				// Nodes which don't fit into the pool.
+				delete_chain( first );
+			}
+
+	private :
+		//! Max count of free nodes.
+		const std::size_t m_capacity;
+
+		//! Object's lock.
+		default_spinlock_t m_lock;
+
+		//! Head of list of free nodes.
+		NODE * m_head = nullptr;
+
+		//! Current count of free nodes.
+		std::size_t m_size = 0;
+
+		static void
+		delete_chain( NODE * n )
+			{
+				while( n )
+					{
+						NODE * next = n->m_next;
+						delete n;
+						n = next;
+					}
+			}
+	};
+
+//
+// demands_pool_counters_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Counters of usage of a pool of nodes by one event queue.
+ *
+ * Counters are modified only under the lock of the owner queue and
+ * can be read without acquiring that lock (for run-time monitoring
+ * purposes).
+ */
+class demands_pool_counters_t
+	{
+	public :
+		//! Count new demands of the owner queue.
+		void
+		add(
+			//! Count of nodes taken from the pool.
+			std::size_t hits,
+			//! Count of nodes created by operator new.
+			std::size_t misses )
+			{
+				if( hits )
+					m_hits.store(
+							m_hits.load( std::memory_order_relaxed ) + hits,
+							std::memory_order_relaxed );
+				if( misses )
+					m_misses.store(
+							m_misses.load( std::memory_order_relaxed ) + misses,
+							std::memory_order_relaxed );
+			}
+
+		//! Count of allocations served from the pool.
+		std::size_t
+		hits() const
+			{
+				return m_hits.load( std::memory_order_relaxed );
+			}
+
+		//! Count of allocations which required operator new.
+		std::size_t
+		misses() const
+			{
+				return m_misses.load( std::memory_order_relaxed );
+			}
+
+	private :
+		//! Count of allocations served from the pool.
+		std::atomic< std::size_t > m_hits = { 0 };
+
+		//! Count of allocations which required operator new.
+		std::atomic< std::size_t > m_misses = { 0 };
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
+
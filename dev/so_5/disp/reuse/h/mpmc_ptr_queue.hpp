@@ -13,7 +13,15 @@
 
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
+#include <so_5/h/compiler_features.hpp>
+#include <so_5/h/spinlocks.hpp>
+
+#include <atomic>
+#include <chrono>
 #include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace so_5
@@ -35,6 +43,23 @@ namespace reuse
  * - waiting on spinlock for the limited period of time;
  * - then waiting on heavy synchronization object.
  *
+ * Since v.5.5.17 there is a work stealing mode (it is turned on by
+ * so_5::disp::mpmc_queue_traits::queue_params_t::work_stealing()).
+ * In this mode every customer thread has its own local queue protected
+ * by its own spinlock. Pointers scheduled from a customer thread go
+ * to its local queue, pointers scheduled from other threads are
+ * distributed between local queues in round-robin manner. A customer
+ * with empty local queue tries to steal a pointer from the tail of
+ * local queues of other customers. The common lock is used only
+ * for sleeping and waking up of customer threads.
+ *
+ * Since v.5.5.17 there is also an elastic mode (it is turned on by
+ * turn_elastic_mode_on()). In this mode count of customer threads
+ * can be changed at run-time. The queue informs about necessity of
+ * a new customer via grow_notificator_t and can retire one of
+ * sleeping customers by request. Elastic mode can't be used
+ * together with work stealing mode.
+ *
  * \tparam T type of object.
  *
  * \since
@@ -44,17 +69,53 @@ template< class T >
 class mpmc_ptr_queue_t
 	{
 	public :
+		/*!
+		 * \brief Type of notificator about necessity of a new customer.
+		 *
+		 * \attention It is called when the queue's lock is acquired.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		using grow_notificator_t = std::function< void() >;
+
+		/*!
+		 * \brief Information about the queue's load for elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		struct load_info_t
+			{
+				//! Count of items waiting for a customer.
+				std::size_t m_backlog;
+				//! Count of sleeping customers.
+				std::size_t m_idle_customers;
+				//! Time since the queue is continuously non-empty.
+				/*!
+				 * Has a meaning only if m_backlog is not zero.
+				 */
+				std::chrono::steady_clock::time_point m_backlog_since;
+			};
+
 		mpmc_ptr_queue_t(
 			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
 			std::size_t thread_count )
 			:	m_lock{ queue_params.lock_factory()() }
-			,	m_max_thread_count{ thread_count }
+			,	m_thread_count{ thread_count }
 			,	m_next_thread_wakeup_threshold{
 					queue_params.next_thread_wakeup_threshold() }
 			{
 				// Reserve some space for storing infos about waiting
 				// customer threads.
 				m_waiting_customers.reserve( thread_count );
+
+				if( queue_params.work_stealing() )
+					{
+						m_local_queues.reserve( thread_count );
+						for( std::size_t i = 0; i != thread_count; ++i )
+							m_local_queues.emplace_back( new local_queue_t{} );
+					}
 			}
 
 		//! Initiate shutdown for working threads.
@@ -63,7 +124,7 @@ class mpmc_ptr_queue_t
 			{
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
-				m_shutdown = true;
+				m_shutdown.store( true, std::memory_order_release );
 
 				while( !m_waiting_customers.empty() )
 					pop_and_notify_one_waiting_customer();
@@ -76,11 +137,14 @@ class mpmc_ptr_queue_t
 		inline T *
 		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
 			{
+				if( is_work_stealing_mode() )
+					return pop_with_stealing( condition );
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				do
 					{
-						if( m_shutdown )
+						if( is_shutdown() )
 							break;
 
 						if( !m_queue.empty() )
@@ -100,6 +164,12 @@ class mpmc_ptr_queue_t
 						// If we are here then the current wakeup procedure is
 						// finished.
 						m_wakeup_in_progress = false;
+
+						if( m_retire_requests )
+							{
+								retire_current_customer();
+								break;
+							}
 					}
 				while( true );
 
@@ -116,9 +186,12 @@ class mpmc_ptr_queue_t
 		inline T *
 		try_switch_to_another( T * current ) SO_5_NOEXCEPT
 			{
+				if( is_work_stealing_mode() )
+					return try_switch_to_another_local( current );
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
-				if( m_shutdown )
+				if( is_shutdown() )
 					return nullptr;
 
 				if( !m_queue.empty() )
@@ -141,10 +214,19 @@ class mpmc_ptr_queue_t
 		void
 		schedule( T * queue )
 			{
+				if( is_work_stealing_mode() )
+					{
+						schedule_to_local_queue( queue );
+						return;
+					}
+
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				m_queue.push_back( queue );
 
+				if( m_grow_notificator )
+					handle_backlog_for_elastic_mode();
+
 				try_wakeup_someone_if_possible();
 			}
 
@@ -154,12 +236,151 @@ class mpmc_ptr_queue_t
 				return m_lock->allocate_condition();
 			}
 
+		/*!
+		 * \brief Turn elastic mode on.
+		 *
+		 * \attention Must be called before the start of customers.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		turn_elastic_mode_on(
+			//! Count of waiting items for a request for a new customer.
+			std::size_t backlog_threshold,
+			//! Notificator to be used for a request for a new customer.
+			grow_notificator_t notificator )
+			{
+				m_backlog_threshold = backlog_threshold;
+				m_grow_notificator = std::move(notificator);
+			}
+
+		/*!
+		 * \brief Get the current load of the queue.
+		 *
+		 * Pending request for a new customer is dropped. The queue
+		 * will make another request if it is still necessary.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		load_info_t
+		query_load()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_grow_requested = false;
+
+				return load_info_t{
+						m_queue.size(),
+						m_waiting_customers.size(),
+						m_backlog_since };
+			}
+
+		/*!
+		 * \brief Inform the queue about a new customer.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		customer_added()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				++m_thread_count;
+			}
+
+		/*!
+		 * \brief Inform the queue that a customer reported by
+		 * customer_added() has not been started.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		customer_not_started()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_thread_count;
+			}
+
+		/*!
+		 * \brief An attempt to retire one of sleeping customers.
+		 *
+		 * The customer retired will receive nullptr from pop().
+		 *
+		 * A customer is not retired while the wakeup of another customer
+		 * is in progress. Otherwise the customer woken up for a new
+		 * item could take the retirement request instead of the item.
+		 *
+		 * \return true if there was a sleeping customer.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		try_retire_one_customer()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( is_shutdown() || m_waiting_customers.empty() ||
+						m_wakeup_in_progress )
+					return false;
+
+				++m_retire_requests;
+				pop_and_notify_one_waiting_customer();
+
+				return true;
+			}
+
 	private :
+		/*!
+		 * \brief Local queue of a customer thread for work stealing mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		struct local_queue_t
+			{
+				//! Lock for the local queue.
+				so_5::default_spinlock_t m_lock;
+
+				//! Queue object.
+				std::deque< T * > m_queue;
+			};
+
+		/*!
+		 * \brief Binding of the current thread to a local queue.
+		 *
+		 * \note Must be a POD-type because it is stored in thread local
+		 * storage.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		struct thread_binding_t
+			{
+				//! The owner of the local queue.
+				/*!
+				 * Value nullptr means that thread is not a customer of any
+				 * queue in work stealing mode.
+				 */
+				const void * m_owner;
+				//! Index of the local queue.
+				std::size_t m_index;
+			};
+
 		//! Object's lock.
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
 
 		//! Shutdown flag.
-		bool	m_shutdown{ false };
+		/*!
+		 * \note It is atomic since v.5.5.17 because in work stealing
+		 * mode it is checked without acquiring m_lock.
+		 */
+		std::atomic< bool > m_shutdown{ false };
 
 		//! Queue object.
 		std::deque< T * > m_queue;
@@ -173,13 +394,16 @@ class mpmc_ptr_queue_t
 		bool	m_wakeup_in_progress{ false };
 
 		/*!
-		 * \brief Maximum count of working threads to be used with
+		 * \brief Count of working threads to be used with
 		 * that mpmc_queue.
 		 *
+		 * \note It was a const value with name m_max_thread_count
+		 * before v.5.5.17. Since v.5.5.17 it is changed in elastic mode.
+		 *
 		 * \since
 		 * v.5.5.16
 		 */
-		const std::size_t m_max_thread_count;
+		std::size_t m_thread_count;
 
 		/*!
 		 * \brief Threshold for wake up next working thread if there are
@@ -193,16 +417,387 @@ class mpmc_ptr_queue_t
 		//! Waiting threads.
 		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
 
+		/*!
+		 * \brief Local queues for work stealing mode.
+		 *
+		 * Empty if work stealing mode is not used.
+		 *
+		 * \note Every local queue is allocated separately to avoid
+		 * placement of locks of different local queues into the same
+		 * cache line.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::vector< std::unique_ptr< local_queue_t > > m_local_queues;
+
+		/*!
+		 * \brief Total count of items in all local queues.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< std::size_t > m_local_items{ 0 };
+
+		/*!
+		 * \brief Count of waiting customers in work stealing mode.
+		 *
+		 * It is a copy of m_waiting_customers.size() which can be
+		 * read without acquiring m_lock.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< std::size_t > m_sleeping_customers{ 0 };
+
+		/*!
+		 * \brief Index of the next local queue to be bound to customer thread.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< std::size_t > m_next_customer_index{ 0 };
+
+		/*!
+		 * \brief Index of the next local queue for scheduling from
+		 * non-customer threads.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< std::size_t > m_next_foreign_index{ 0 };
+
+		/*!
+		 * \brief Notificator about necessity of a new customer.
+		 *
+		 * Empty if elastic mode is not used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		grow_notificator_t m_grow_notificator;
+
+		/*!
+		 * \brief Count of waiting items for a request for a new customer.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t m_backlog_threshold{ 0 };
+
+		/*!
+		 * \brief Is there a pending request for a new customer?
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool m_grow_requested{ false };
+
+		/*!
+		 * \brief Time point when m_queue became non-empty.
+		 *
+		 * Updated only in elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::chrono::steady_clock::time_point m_backlog_since;
+
+		/*!
+		 * \brief Count of pending requests for retirement of customers.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t m_retire_requests{ 0 };
+
 		void
 		pop_and_notify_one_waiting_customer()
 			{
 				auto & condition = *m_waiting_customers.back();
 				m_waiting_customers.pop_back();
+				m_sleeping_customers.store(
+						m_waiting_customers.size(), std::memory_order_seq_cst );
 
 				m_wakeup_in_progress = true;
 				condition.notify();
 			}
 
+		/*!
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		is_shutdown() const
+			{
+				return m_shutdown.load( std::memory_order_acquire );
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		is_work_stealing_mode() const
+			{
+				return !m_local_queues.empty();
+			}
+
+		/*!
+		 * \brief Access to the thread local binding of the current thread.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		static thread_binding_t &
+		current_thread_binding()
+			{
+				static SO_5_THREAD_LOCAL thread_binding_t binding = { nullptr, 0 };
+				return binding;
+			}
+
+		/*!
+		 * \brief Get the index of local queue of the current customer thread.
+		 *
+		 * The current thread is bound to a local queue at the first call.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t
+		customer_local_queue_index()
+			{
+				auto & binding = current_thread_binding();
+				if( binding.m_owner != this )
+					{
+						binding.m_owner = this;
+						binding.m_index = m_next_customer_index.fetch_add(
+								1, std::memory_order_relaxed ) % m_local_queues.size();
+					}
+
+				return binding.m_index;
+			}
+
+		/*!
+		 * \brief Get the index of local queue for scheduling.
+		 *
+		 * If the current thread is a customer of that queue then its
+		 * local queue will be used. Otherwise the next local queue will
+		 * be selected in round-robin manner.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t
+		local_queue_index_for_schedule()
+			{
+				const auto & binding = current_thread_binding();
+				if( binding.m_owner == this )
+					return binding.m_index;
+
+				return m_next_foreign_index.fetch_add(
+						1, std::memory_order_relaxed ) % m_local_queues.size();
+			}
+
+		/*!
+		 * \brief Try to extract an item from the head of the local queue.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		T *
+		try_pop_local( local_queue_t & local )
+			{
+				std::lock_guard< so_5::default_spinlock_t > lock{ local.m_lock };
+				if( local.m_queue.empty() )
+					return nullptr;
+
+				auto r = local.m_queue.front();
+				local.m_queue.pop_front();
+				return r;
+			}
+
+		/*!
+		 * \brief Try to steal an item from the tail of another local queue.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		T *
+		try_steal( std::size_t thief_index )
+			{
+				const auto count = m_local_queues.size();
+				for( std::size_t i = 1; i != count; ++i )
+					{
+						auto & victim = *m_local_queues[ (thief_index + i) % count ];
+
+						std::lock_guard< so_5::default_spinlock_t > lock{ victim.m_lock };
+						if( !victim.m_queue.empty() )
+							{
+								auto r = victim.m_queue.back();
+								victim.m_queue.pop_back();
+								return r;
+							}
+					}
+
+				return nullptr;
+			}
+
+		/*!
+		 * \brief Try to extract an item from local queues.
+		 *
+		 * The local queue of the current customer is checked first.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		T *
+		try_pop_or_steal( std::size_t index )
+			{
+				auto r = try_pop_local( *m_local_queues[ index ] );
+				if( !r )
+					r = try_steal( index );
+
+				if( r )
+					m_local_items.fetch_sub( 1, std::memory_order_seq_cst );
+
+				return r;
+			}
+
+		/*!
+		 * \brief Implementation of pop() for work stealing mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		T *
+		pop_with_stealing(
+			so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				const auto index = customer_local_queue_index();
+
+				while( !is_shutdown() )
+					{
+						auto r = try_pop_or_steal( index );
+						if( r )
+							{
+								// There could be non-empty local queues and
+								// sleeping customers...
+								if( m_sleeping_customers.load( std::memory_order_seq_cst ) )
+									try_wakeup_someone_for_local_items();
+
+								return r;
+							}
+
+						std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+						if( is_shutdown() )
+							break;
+
+						m_waiting_customers.push_back( &condition );
+						m_sleeping_customers.store(
+								m_waiting_customers.size(), std::memory_order_seq_cst );
+
+						// Some item could be scheduled before the increment
+						// of m_sleeping_customers. Its producer could miss
+						// the current customer. So we must check local queues
+						// again before going to sleep.
+						if( m_local_items.load( std::memory_order_seq_cst ) )
+							{
+								m_waiting_customers.pop_back();
+								m_sleeping_customers.store(
+										m_waiting_customers.size(),
+										std::memory_order_seq_cst );
+								continue;
+							}
+
+						condition.wait();
+						// If we are here then the current wakeup procedure is
+						// finished.
+						m_wakeup_in_progress = false;
+					}
+
+				return nullptr;
+			}
+
+		/*!
+		 * \brief Implementation of try_switch_to_another() for work
+		 * stealing mode.
+		 *
+		 * Only local queue of the current customer is checked.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		T *
+		try_switch_to_another_local( T * current ) SO_5_NOEXCEPT
+			{
+				if( is_shutdown() )
+					return nullptr;
+
+				auto & local = *m_local_queues[ customer_local_queue_index() ];
+
+				std::lock_guard< so_5::default_spinlock_t > lock{ local.m_lock };
+				if( !local.m_queue.empty() )
+					{
+						auto r = local.m_queue.front();
+						local.m_queue.pop_front();
+
+						// Old non-empty queue must be stored for further processing.
+						// Count of items is not changed.
+						local.m_queue.push_back( current );
+
+						return r;
+					}
+
+				return current;
+			}
+
+		/*!
+		 * \brief Implementation of schedule() for work stealing mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		schedule_to_local_queue( T * queue )
+			{
+				auto & local = *m_local_queues[ local_queue_index_for_schedule() ];
+				{
+					std::lock_guard< so_5::default_spinlock_t > lock{ local.m_lock };
+					local.m_queue.push_back( queue );
+				}
+
+				m_local_items.fetch_add( 1, std::memory_order_seq_cst );
+
+				if( m_sleeping_customers.load( std::memory_order_seq_cst ) )
+					try_wakeup_someone_for_local_items();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread in work
+		 * stealing mode.
+		 *
+		 * Conditions are the same as for try_wakeup_someone_if_possible()
+		 * but total count of items in all local queues is used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		try_wakeup_someone_for_local_items()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				const auto items = m_local_items.load( std::memory_order_seq_cst );
+				if( items &&
+						!m_waiting_customers.empty() &&
+						!m_wakeup_in_progress &&
+						( items > m_next_thread_wakeup_threshold ||
+						m_thread_count == m_waiting_customers.size() ) )
+					pop_and_notify_one_waiting_customer();
+			}
+
 		/*!
 		 * \since
 		 * v.5.5.15.1
@@ -225,9 +820,52 @@ class mpmc_ptr_queue_t
 						!m_waiting_customers.empty() &&
 						!m_wakeup_in_progress &&
 						( m_queue.size() > m_next_thread_wakeup_threshold ||
-						m_max_thread_count == m_waiting_customers.size() ) )
+						m_thread_count == m_waiting_customers.size() ) )
 					pop_and_notify_one_waiting_customer();
 			}
+
+		/*!
+		 * \brief Detection of necessity of a new customer in elastic mode.
+		 *
+		 * A new customer is requested if there is no sleeping customers
+		 * and count of items in m_queue is greater than
+		 * m_backlog_threshold.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		handle_backlog_for_elastic_mode()
+			{
+				if( 1 == m_queue.size() )
+					m_backlog_since = std::chrono::steady_clock::now();
+
+				if( !m_grow_requested &&
+						m_waiting_customers.empty() &&
+						m_queue.size() > m_backlog_threshold )
+					{
+						m_grow_requested = true;
+						m_grow_notificator();
+					}
+			}
+
+		/*!
+		 * \brief Retirement of the current customer in elastic mode.
+		 *
+		 * Because count of customers is decreased some other customer
+		 * could be woken up.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		void
+		retire_current_customer()
+			{
+				--m_retire_requests;
+				--m_thread_count;
+
+				try_wakeup_someone_if_possible();
+			}
 	};
 
 } /* namespace reuse */
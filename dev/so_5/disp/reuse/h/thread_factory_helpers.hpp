@@ -0,0 +1,65 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Helpers for selection of thread factory for dispatchers.
+ */
+
+#pragma once
+
+#include <so_5/h/thread_factory.hpp>
+
+#include <so_5/rt/h/environment.hpp>
+
+#include <so_5/rt/impl/h/internal_env_iface.hpp>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Get the thread factory to be used by a dispatcher.
+ *
+ * The factory from dispatcher's parameters has the priority.
+ * If it is not set then the factory from the SObjectizer
+ * Environment is used.
+ *
+ * Every dispatcher asks for a thread factory when it starts. Because of
+ * that it is the place where dispatchers other than the default one are
+ * prohibited in single-threaded environment.
+ *
+ * \throw so_5::exception_t if \a env is single-threaded.
+ */
+inline thread_factory_t &
+actual_thread_factory(
+	//! Factory from dispatcher's parameters. Can be empty.
+	const thread_factory_shptr_t & from_params,
+	//! SObjectizer Environment for the dispatcher.
+	environment_t & env )
+	{
+		if( so_5::impl::internal_env_iface_t{ env }.is_single_threaded() )
+			SO_5_THROW_EXCEPTION(
+					rc_disp_not_allowed_in_single_threaded_env,
+					"only the default dispatcher can be used in "
+					"single-threaded environment" );
+
+		if( from_params )
+			return *from_params;
+		else
+			return env.thread_factory();
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
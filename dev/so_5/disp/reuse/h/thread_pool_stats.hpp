@@ -44,6 +44,19 @@ struct queue_description_t
 
 		//! Current queue size.
 		std::size_t m_queue_size;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Count of demands which nodes were reused from
+		 * the dispatcher's pool.
+		 */
+		std::size_t m_pool_hits;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Count of demands which nodes were allocated.
+		 */
+		std::size_t m_pool_misses;
 	};
 
 /*!
@@ -108,6 +121,8 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = agent_count;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_pool_hits = 0;
+		result->m_desc.m_pool_misses = 0;
 
 		return result;
 	}
@@ -132,6 +147,8 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = 1;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_pool_hits = 0;
+		result->m_desc.m_pool_misses = 0;
 
 		return result;
 	}
@@ -152,6 +169,20 @@ class stats_consumer_t
 		virtual void
 		set_thread_count( std::size_t value ) = 0;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Informs consumer about changes of thread count
+		 * in elastic mode.
+		 *
+		 * \note Must be called only for dispatchers in elastic mode.
+		 */
+		virtual void
+		set_elastic_stats(
+			//! Total count of working threads added.
+			std::size_t threads_grown,
+			//! Total count of working threads retired.
+			std::size_t threads_retired ) = 0;
+
 		//! Informs counsumer about yet another event queue.
 		virtual void
 		add_queue(
@@ -223,6 +254,21 @@ class data_source_t : public stats::manually_registered_source_t
 						stats::suffixes::disp_thread_count(),
 						collector.thread_count() );
 
+				if( collector.is_elastic() )
+					{
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::disp_threads_grown(),
+								collector.threads_grown() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::disp_threads_retired(),
+								collector.threads_retired() );
+					}
+
 				so_5::send< stats::messages::quantity< std::size_t > >(
 						mbox,
 						m_prefix,
@@ -242,6 +288,18 @@ class data_source_t : public stats::manually_registered_source_t
 								queue.m_prefix,
 								stats::suffixes::work_thread_queue_size(),
 								queue.m_queue_size );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								queue.m_prefix,
+								stats::suffixes::demands_pool_hits(),
+								queue.m_pool_hits );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								queue.m_prefix,
+								stats::suffixes::demands_pool_misses(),
+								queue.m_pool_misses );
 					} );
 			}
 
@@ -286,6 +344,16 @@ class data_source_t : public stats::manually_registered_source_t
 						m_thread_count = thread_count;
 					}
 
+				virtual void
+				set_elastic_stats(
+					std::size_t threads_grown,
+					std::size_t threads_retired ) override
+					{
+						m_is_elastic = true;
+						m_threads_grown = threads_grown;
+						m_threads_retired = threads_retired;
+					}
+
 				virtual void
 				add_queue(
 					const intrusive_ptr_t< queue_description_holder_t > & info ) override
@@ -316,6 +384,24 @@ class data_source_t : public stats::manually_registered_source_t
 						return m_agent_count;
 					}
 
+				bool
+				is_elastic() const
+					{
+						return m_is_elastic;
+					}
+
+				std::size_t
+				threads_grown() const
+					{
+						return m_threads_grown;
+					}
+
+				std::size_t
+				threads_retired() const
+					{
+						return m_threads_retired;
+					}
+
 				template< typename LAMBDA >
 				void
 				for_each_queue( LAMBDA lambda ) const
@@ -334,6 +420,10 @@ class data_source_t : public stats::manually_registered_source_t
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
 
+				bool m_is_elastic = { false };
+				std::size_t m_threads_grown = { 0 };
+				std::size_t m_threads_retired = { 0 };
+
 				intrusive_ptr_t< queue_description_holder_t > m_queue_desc_head;
 				intrusive_ptr_t< queue_description_holder_t > m_queue_desc_tail;
 			};
@@ -11,6 +11,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -19,6 +20,10 @@
 
 #include <so_5/h/declspec.hpp>
 #include <so_5/h/current_thread_id.hpp>
+#include <so_5/h/thread_factory.hpp>
+#include <so_5/h/timers.hpp>
+
+#include <so_5/details/h/cache_line.hpp>
 
 #include <so_5/rt/h/event_queue.hpp>
 
@@ -73,6 +78,11 @@ class demand_queue_t : public event_queue_t
 		virtual void
 		push(
 			execution_demand_t demand );
+
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override;
 		/*!
 		 * \}
 		 */
@@ -105,6 +115,40 @@ class demand_queue_t : public event_queue_t
 			/*! External demands counter to be updated. */
 			demands_counter_t & external_counter );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Try to extract demands from the queue with limited
+		 * waiting time.
+		 *
+		 * If there is no demands in queue then current thread
+		 * will sleep until:
+		 * - the new demand is put in the queue;
+		 * - a shutdown signal;
+		 * - expiration of \a max_wait;
+		 * - a call to wakeup().
+		 *
+		 * \retval no_demands if there is no demands after the waiting.
+		 */
+		int
+		pop(
+			/*! Receiver for extracted demands. */
+			demand_container_t & queue_item,
+			/*! External demands counter to be updated. */
+			demands_counter_t & external_counter,
+			/*! Max waiting time for a new demand. */
+			std::chrono::steady_clock::duration max_wait );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Wake up the consumer sleeping inside pop() with
+		 * limited waiting time.
+		 *
+		 * If the consumer is not sleeping now then the next pop()
+		 * with limited waiting time will return without waiting.
+		 */
+		void
+		wakeup();
+
 		//! Start demands processing.
 		void
 		start_service();
@@ -143,6 +187,398 @@ class demand_queue_t : public event_queue_t
 			false -- the service is stopped or will be stopped.
 		*/
 		bool m_in_service;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has wakeup() been called?
+		 */
+		bool m_wakeup_requested = { false };
+};
+
+//
+// lock_free_demand_queue_t
+//
+
+/*!
+ * \since v.5.5.17
+ * \brief Intrusive lock-free multi-producer/single-consumer queue
+ * of demands.
+ *
+ * It is an implementation of the queue described by Dmitry Vyukov:
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+ *
+ * A producer takes a node from the pool of free nodes by one CAS
+ * and then links it to the queue by one atomic exchange of the queue's
+ * head. Both atomics are located in the same cache line.
+ * The consumer extracts demands from the tail without any lock.
+ *
+ * The lock object is used only for parking of the consumer when
+ * the queue is empty. A producer acquires that lock only if the
+ * consumer is parked (or is going to be parked).
+ *
+ * Nodes of extracted demands are collected by the consumer in its own
+ * cache and are returned to the pool by chains. The pool is a lock-free
+ * stack of indexes of nodes. A tag is stored together with the index
+ * of the top node. It is incremented by every removal of a node from
+ * the stack. It prevents ABA problem and it is also used as the count
+ * of pushed demands for run-time monitoring. The size of the pool is
+ * limited, nodes which don't fit into it are allocated and deallocated
+ * by new/delete.
+ *
+ * \note The queue doesn't track producers which are inside push
+ * operation. Producers access the queue only via pointer from
+ * an agent and hold agent's event_queue_lock during the push.
+ * That pointer is removed under exclusive lock in
+ * agent_t::shutdown_agent() before the agent is unbound from its
+ * dispatcher. So the queue can't be destroyed while some producer
+ * works with it. A demand pushed after the stop of the service
+ * is destroyed by clear() or by the destructor of the queue.
+ */
+class lock_free_demand_queue_t : public event_queue_t
+{
+	public:
+		lock_free_demand_queue_t(
+			//! Lock object to be used for parking of the consumer.
+			queue_traits::lock_unique_ptr_t lock );
+		~lock_free_demand_queue_t();
+
+		/*!
+		 * \name Implementation of event_queue interface.
+		 * \{
+		 */
+		virtual void
+		push(
+			execution_demand_t demand ) override;
+
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override;
+		/*!
+		 * \}
+		 */
+
+		//! Extract the next demand from the queue.
+		/*!
+		 * If there is no demands in queue then current thread
+		 * will sleep until:
+		 * - the new demand is put in the queue;
+		 * - a shutdown signal.
+		 *
+		 * \attention The returned demand object is owned by the queue.
+		 * It remains valid until the next call to pop() or clear().
+		 *
+		 * \retval nullptr in the case of shutdown.
+		 */
+		execution_demand_t *
+		pop();
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Extract the next demand from the queue with limited
+		 * waiting time.
+		 *
+		 * If there is no demands in queue then current thread
+		 * will sleep until:
+		 * - the new demand is put in the queue;
+		 * - a shutdown signal;
+		 * - expiration of \a max_wait;
+		 * - a call to wakeup().
+		 *
+		 * \attention The returned demand object is owned by the queue.
+		 * It remains valid until the next call to pop() or clear().
+		 *
+		 * \retval nullptr in the case of shutdown or if there is no
+		 * demands after the waiting.
+		 */
+		execution_demand_t *
+		pop(
+			//! Max waiting time for a new demand.
+			std::chrono::steady_clock::duration max_wait );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Extract the next demand from the queue without waiting.
+		 *
+		 * \attention The returned demand object is owned by the queue.
+		 * It remains valid until the next call to pop() or clear().
+		 *
+		 * \retval nullptr in the case of shutdown or if there is no
+		 * demands in the queue (including the case when a producer is
+		 * in the middle of push operation).
+		 */
+		execution_demand_t *
+		try_pop();
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Wake up the consumer sleeping inside pop() with
+		 * limited waiting time.
+		 *
+		 * If the consumer is not sleeping now then the next pop()
+		 * with limited waiting time will return without waiting.
+		 */
+		void
+		wakeup();
+
+		//! Start demands processing.
+		void
+		start_service();
+
+		//! Stop demands processing.
+		void
+		stop_service();
+
+		//! Clear demands queue.
+		/*!
+		 * \attention Must be called only by the consumer thread or
+		 * when the consumer thread is finished.
+		 */
+		void
+		clear();
+
+		//! Get the count of demands in the queue.
+		/*!
+		 * \note This value is an approximation. It is intended to be
+		 * used only for run-time monitoring.
+		 */
+		std::size_t
+		demands_count() const;
+
+	private:
+		//! Value of node_t::m_pool_index for a node outside of the pool.
+		static const std::uint32_t not_in_pool = 0xFFFFFFFFu;
+
+		//! Node of the queue.
+		struct node_t
+		{
+			//! Actual demand.
+			execution_demand_t m_demand;
+			//! Next node in the queue.
+			std::atomic< node_t * > m_next = { nullptr };
+
+			//! Index of the node in the pool.
+			/*!
+			 * It is not_in_pool if the node is not a part of the pool.
+			 *
+			 * \note Is changed only by the consumer before the node
+			 * is added to the pool for the first time.
+			 */
+			std::uint32_t m_pool_index = { not_in_pool };
+			//! Next node in the stack of free nodes.
+			/*!
+			 * It is an index of the node plus one. Zero means that
+			 * there is no next node.
+			 */
+			std::atomic< std::uint32_t > m_next_free = { 0 };
+
+			node_t() {}
+
+			node_t( execution_demand_t && demand )
+				:	m_demand( std::move( demand ) )
+				{}
+		};
+
+		//! \name Producers' data.
+		//! \{
+		//! The last pushed node.
+		std::atomic< node_t * > m_head;
+
+		//! The top of the stack of free nodes.
+		/*!
+		 * The lower half is an index of the top node plus one
+		 * (zero for the empty stack). The upper half is a count of
+		 * removals from the stack.
+		 */
+		std::atomic< std::uint64_t > m_free_top = { 0 };
+		//! \}
+
+		//! Separator of producers' data from consumer's data.
+		so_5::details::cache_line_padding_t m_producers_data_padding;
+
+		//! \name Consumer's data.
+		//! \{
+		//! The stub node with already extracted demand.
+		/*!
+		 * The next node after that one is the first demand in the queue.
+		 */
+		node_t * m_tail;
+
+		//! Count of extracted demands.
+		/*!
+		 * Only for run-time monitoring. Is modified only by the consumer.
+		 */
+		std::atomic< std::uint32_t > m_extracted = { 0 };
+
+		//! Is the consumer parked or going to be parked?
+		std::atomic< bool > m_sleeping = { false };
+
+		//! Count of nodes in the pool.
+		std::uint32_t m_pool_size = { 0 };
+
+		//! The first node in the consumer's cache of free nodes.
+		/*!
+		 * Nodes of the cache are linked via node_t::m_next_free.
+		 */
+		node_t * m_cached_first = { nullptr };
+		//! The last node in the consumer's cache of free nodes.
+		node_t * m_cached_last = { nullptr };
+		//! Count of nodes in the consumer's cache of free nodes.
+		std::size_t m_cached_count = { 0 };
+		//! \}
+
+		//! Separator of consumer's data from data shared by all threads.
+		so_5::details::cache_line_padding_t m_consumer_data_padding;
+
+		//! Service flag.
+		/*!
+			true -- shall do the service, methods push/pop must work.
+			false -- the service is stopped or will be stopped.
+		*/
+		std::atomic< bool > m_in_service = { false };
+
+		//! Lock for parking of the consumer.
+		queue_traits::lock_unique_ptr_t m_lock;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has wakeup() been called?
+		 *
+		 * \note Protected by m_lock.
+		 */
+		bool m_wakeup_requested = { false };
+
+		//! Nodes of the pool.
+		/*!
+		 * An item is set by the consumer before the node is added
+		 * to the pool for the first time and isn't changed after that.
+		 */
+		std::unique_ptr< std::atomic< node_t * >[] > m_pool;
+
+		//! Correction of the count of pushed demands.
+		/*!
+		 * Count of nodes taken not from the pool minus count of nodes
+		 * which have been taken but haven't been pushed because of
+		 * an exception. Only for run-time monitoring.
+		 */
+		std::atomic< std::uint32_t > m_pushed_correction = { 0 };
+
+		//! Try to extract the next node without waiting.
+		/*!
+		 * \retval nullptr if there is no more nodes.
+		 */
+		node_t *
+		try_extract();
+
+		//! Get a free node from the pool or create a new one.
+		node_t *
+		take_node();
+
+		//! Make a chain of nodes for several demands.
+		/*!
+		 * \return the first and the last nodes of the chain.
+		 */
+		std::pair< node_t *, node_t * >
+		make_chain(
+			execution_demand_t * demands,
+			std::size_t count );
+
+		//! Return a chain of nodes linked via node_t::m_next_free
+		//! to the stack of free nodes.
+		void
+		return_to_pool(
+			node_t * first,
+			node_t * last );
+
+		//! Return the node of already handled demand to
+		//! the consumer's cache.
+		/*!
+		 * The node is destroyed if it is not a part of the pool and
+		 * the pool is full.
+		 */
+		void
+		release_node( node_t * node );
+
+		//! Return all nodes from the consumer's cache to the pool.
+		void
+		flush_cached_nodes();
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Append a chain of already linked nodes to the queue.
+		 */
+		void
+		push_chain(
+			//! The first node of the chain.
+			node_t * first,
+			//! The last node of the chain.
+			node_t * last );
+
+		//! Is the queue empty?
+		/*!
+		 * \note The queue isn't empty if some producer is in the middle
+		 * of push operation.
+		 */
+		bool
+		empty() const;
+};
+
+class work_thread_t;
+
+//
+// timer_manager_for_work_thread_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A timer manager which is served by a working thread.
+ *
+ * It is a wrapper around an actual timer manager. The working thread
+ * handles elapsed timers between processing of demands. If a new timer
+ * is scheduled while the working thread is sleeping on the empty
+ * demand queue then the working thread is woken up to recalculate
+ * its waiting time.
+ */
+class timer_manager_for_work_thread_t : public so_5::timer_manager_t
+{
+	public:
+		timer_manager_for_work_thread_t(
+			//! Owner of the timer manager.
+			work_thread_t & owner,
+			//! Actual timer manager.
+			so_5::timer_manager_unique_ptr_t actual );
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override;
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override;
+
+		virtual void
+		process_expired_timers() override;
+
+		virtual std::chrono::steady_clock::duration
+		timeout_before_nearest_timer(
+			std::chrono::steady_clock::duration default_timeout ) override;
+
+		virtual timer_thread_stats_t
+		query_stats() override;
+
+	private:
+		//! Owner of the timer manager.
+		work_thread_t & m_owner;
+
+		//! Actual timer manager.
+		so_5::timer_manager_unique_ptr_t m_actual;
 };
 
 //
@@ -162,9 +598,23 @@ class work_thread_t
 			//! Factory for creation of lock object for demand queue.
 			queue_traits::lock_factory_t queue_lock_factory );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Constructor for the case when the type of demand queue
+		 * is specified by queue parameters.
+		 */
+		work_thread_t(
+			//! Parameters for demand queue.
+			const queue_traits::queue_params_t & queue_params );
+
 		//! Start the working thread.
+		/*!
+		 * \note Since v.5.5.17 the thread is created by \a thread_factory.
+		 */
 		void
-		start();
+		start(
+			//! Factory for the working thread.
+			thread_factory_t & thread_factory );
 
 		//! Send the shutdown signal to the working thread.
 		void
@@ -199,6 +649,26 @@ class work_thread_t
 		std::size_t
 		demands_count();
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Set a timer manager to be served by the working thread.
+		 *
+		 * \attention Must be called before start().
+		 */
+		void
+		set_timer_manager(
+			//! Actual timer manager.
+			so_5::timer_manager_unique_ptr_t manager );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the timer manager served by the working thread.
+		 *
+		 * \retval nullptr if there is no timer manager.
+		 */
+		so_5::timer_manager_t *
+		timer_manager();
+
 	protected:
 		//! Main working thread body.
 		void
@@ -210,9 +680,65 @@ class work_thread_t
 			//! Bunch of demands to be processed.
 			demand_container_t & executed_demands );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Main working thread body for the case of lock-free
+		 * demand queue.
+		 */
+		void
+		lock_free_body();
+
 	private:
+		friend class timer_manager_for_work_thread_t;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Handle elapsed timers and get the max waiting time
+		 * for the next demand.
+		 *
+		 * Also calculates the time of the next check of timers.
+		 *
+		 * \note If \a going_to_wait is true then sets m_waiting_for_timers
+		 * to true. It must be reset after the waiting.
+		 */
+		std::chrono::steady_clock::duration
+		handle_timers(
+			//! Will the working thread wait for demands after that call?
+			bool going_to_wait );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Should timers be handled before the next demand?
+		 *
+		 * It is true if the nearest timer is elapsed or if a new timer
+		 * has been scheduled since the last handling of timers.
+		 */
+		bool
+		timers_check_needed() const;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Notification about a new timer.
+		 *
+		 * Wakes up the working thread if it is waiting for demands.
+		 */
+		void
+		timer_scheduled();
+
 		//! Demands queue.
-		demand_queue_t m_queue;
+		/*!
+		 * \note Since v.5.5.17 it is created dynamically.
+		 * It is nullptr if m_lock_free_queue is used.
+		 */
+		std::unique_ptr< demand_queue_t > m_queue;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Lock-free demands queue.
+		 *
+		 * It is nullptr if m_queue is used.
+		 */
+		std::unique_ptr< lock_free_demand_queue_t > m_lock_free_queue;
 
 		//! Thread status flag.
 		enum
@@ -230,7 +756,10 @@ class work_thread_t
 		std::atomic_long m_continue_work;
 
 		//! Actual working thread.
-		std::unique_ptr< std::thread > m_thread;
+		/*!
+		 * \note Since v.5.5.17 it is created by a thread factory.
+		 */
+		thread_handle_unique_ptr_t m_thread;
 
 		/*!
 		 * \since v.5.4.0
@@ -240,14 +769,64 @@ class work_thread_t
 		 */
 		so_5::current_thread_id_t m_thread_id;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Separator of the data read by producers from
+		 * m_demands_count.
+		 */
+		so_5::details::cache_line_padding_t m_demands_count_head_padding;
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief A counter for calculating count of demands in
 		 * the queue.
 		 *
 		 * \note Will be used for run-time monitoring.
+		 *
+		 * \note Since v.5.5.17 it is placed on a separate cache line
+		 * because it is changed by the working thread after every demand.
 		 */
 		demands_counter_t m_demands_count = { 0 };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Separator of m_demands_count from the data which follows.
+		 */
+		so_5::details::cache_line_padding_t m_demands_count_tail_padding;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Timer manager served by the working thread.
+		 *
+		 * It is nullptr if there is no timer manager.
+		 */
+		std::unique_ptr< timer_manager_for_work_thread_t > m_timer_manager;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Is the working thread going to wait for demands
+		 * with timeout calculated from timers?
+		 *
+		 * If this flag is set then scheduling of a new timer leads
+		 * to wakeup of the working thread.
+		 */
+		std::atomic< bool > m_waiting_for_timers = { false };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has a new timer been scheduled since the last
+		 * handling of timers?
+		 */
+		std::atomic< bool > m_timers_changed = { false };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Time of the next handling of timers while there are
+		 * demands in the queue.
+		 *
+		 * \note Is used only by the working thread.
+		 */
+		std::chrono::steady_clock::time_point m_next_timers_check;
 };
 
 /*!
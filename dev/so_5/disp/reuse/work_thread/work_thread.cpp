@@ -59,6 +59,29 @@ demand_queue_t::push(
 	}
 }
 
+void
+demand_queue_t::push_batch(
+	execution_demand_t * demands,
+	std::size_t count )
+{
+	if( !count )
+		return;
+
+	queue_traits::lock_guard_t guard{ *m_lock };
+
+	if( m_in_service )
+	{
+		const bool demands_empty_before_service = m_demands.empty();
+
+		for( std::size_t i = 0; i != count; ++i )
+			m_demands.push_back( std::move( demands[ i ] ) );
+
+		if( demands_empty_before_service )
+			// The only notification for the whole batch.
+			guard.notify_one();
+	}
+}
+
 int
 demand_queue_t::pop(
 	demand_container_t & demands,
@@ -89,6 +112,44 @@ demand_queue_t::pop(
 	return demand_extracted;
 }
 
+int
+demand_queue_t::pop(
+	demand_container_t & demands,
+	demands_counter_t & external_counter,
+	std::chrono::steady_clock::duration max_wait )
+{
+	queue_traits::unique_lock_t lock{ *m_lock };
+
+	if( m_in_service && m_demands.empty() && !m_wakeup_requested )
+		// Queue is empty. We should wait for a demand, a shutdown signal
+		// or for the expiration of the nearest timer.
+		lock.wait_for_notify_for( max_wait );
+
+	m_wakeup_requested = false;
+
+	if( !m_in_service )
+		return shutting_down;
+
+	if( m_demands.empty() )
+		return no_demands;
+
+	demands.swap( m_demands );
+
+	// It's time to update external counter.
+	external_counter.store( demands.size(), std::memory_order_release );
+
+	return demand_extracted;
+}
+
+void
+demand_queue_t::wakeup()
+{
+	queue_traits::lock_guard_t lock{ *m_lock };
+
+	m_wakeup_requested = true;
+	lock.notify_one();
+}
+
 void
 demand_queue_t::start_service()
 {
@@ -125,30 +186,553 @@ demand_queue_t::demands_count( const demands_counter_t & external_counter )
 	return m_demands.size() + external_counter.load( std::memory_order_acquire );
 }
 
+//
+// lock_free_demand_queue_t
+//
+namespace
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Max count of nodes in the pool of lock_free_demand_queue.
+ */
+const std::uint32_t max_pool_nodes = 256;
+
+/*!
+ * \since v.5.5.17
+ * \brief Count of nodes in the consumer's cache which are returned
+ * to the pool at once.
+ */
+const std::size_t cached_nodes_threshold = 16;
+
+/*!
+ * \since v.5.5.17
+ * \brief Make a value for the top of the stack of free nodes.
+ */
+inline std::uint64_t
+make_free_top( std::uint32_t index, std::uint32_t tag )
+{
+	return (static_cast< std::uint64_t >( tag ) << 32) | index;
+}
+
+/*!
+ * \since v.5.5.17
+ * \brief Get an index of the top node (plus one) from the top
+ * of the stack of free nodes.
+ */
+inline std::uint32_t
+free_top_index( std::uint64_t top )
+{
+	return static_cast< std::uint32_t >( top );
+}
+
+/*!
+ * \since v.5.5.17
+ * \brief Get a tag from the top of the stack of free nodes.
+ */
+inline std::uint32_t
+free_top_tag( std::uint64_t top )
+{
+	return static_cast< std::uint32_t >( top >> 32 );
+}
+
+} /* namespace anonymous */
+
+lock_free_demand_queue_t::lock_free_demand_queue_t(
+	queue_traits::lock_unique_ptr_t lock )
+	:	m_lock{ std::move(lock) }
+	,	m_pool{ new std::atomic< node_t * >[ max_pool_nodes ]() }
+{
+	m_tail = new node_t();
+	m_head.store( m_tail, std::memory_order_release );
+}
+
+lock_free_demand_queue_t::~lock_free_demand_queue_t()
+{
+	// Nodes of the pool are destroyed separately.
+	while( m_tail )
+	{
+		auto next = m_tail->m_next.load( std::memory_order_acquire );
+		if( not_in_pool == m_tail->m_pool_index )
+			delete m_tail;
+		m_tail = next;
+	}
+
+	for( std::uint32_t i = 0; i != m_pool_size; ++i )
+		delete m_pool[ i ].load( std::memory_order_relaxed );
+}
+
+void
+lock_free_demand_queue_t::push(
+	execution_demand_t demand )
+{
+	// It is only an optimization. A demand pushed after the stop
+	// of the service will be destroyed by clear() or by the destructor.
+	if( !m_in_service.load( std::memory_order_acquire ) )
+		return;
+
+	node_t * node = take_node();
+	node->m_demand = std::move( demand );
+
+	push_chain( node, node );
+}
+
+void
+lock_free_demand_queue_t::push_batch(
+	execution_demand_t * demands,
+	std::size_t count )
+{
+	if( !count || !m_in_service.load( std::memory_order_acquire ) )
+		return;
+
+	const auto chain = make_chain( demands, count );
+
+	push_chain( chain.first, chain.second );
+}
+
+execution_demand_t *
+lock_free_demand_queue_t::pop()
+{
+	while( true )
+	{
+		if( !m_in_service.load( std::memory_order_acquire ) )
+			return nullptr;
+
+		auto node = try_extract();
+		if( node )
+			return &(node->m_demand);
+
+		if( !empty() )
+		{
+			// Some producer is in the middle of push operation.
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Free nodes must be available to producers while
+		// the consumer is sleeping.
+		flush_cached_nodes();
+
+		// Queue is empty. We should wait for a demand or
+		// a shutdown signal.
+		queue_traits::unique_lock_t lock{ *m_lock };
+
+		m_sleeping.store( true, std::memory_order_seq_cst );
+		while( m_in_service.load( std::memory_order_acquire ) && empty() )
+			lock.wait_for_notify();
+		m_sleeping.store( false, std::memory_order_release );
+	}
+}
+
+execution_demand_t *
+lock_free_demand_queue_t::try_pop()
+{
+	if( !m_in_service.load( std::memory_order_acquire ) )
+		return nullptr;
+
+	auto node = try_extract();
+	return node ? &(node->m_demand) : nullptr;
+}
+
+execution_demand_t *
+lock_free_demand_queue_t::pop(
+	std::chrono::steady_clock::duration max_wait )
+{
+	while( true )
+	{
+		if( !m_in_service.load( std::memory_order_acquire ) )
+			return nullptr;
+
+		auto node = try_extract();
+		if( node )
+			return &(node->m_demand);
+
+		if( !empty() )
+		{
+			// Some producer is in the middle of push operation.
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Free nodes must be available to producers while
+		// the consumer is sleeping.
+		flush_cached_nodes();
+
+		// Queue is empty. We should wait for a demand, a shutdown signal
+		// or for the expiration of the nearest timer.
+		{
+			queue_traits::unique_lock_t lock{ *m_lock };
+
+			m_sleeping.store( true, std::memory_order_seq_cst );
+			if( m_in_service.load( std::memory_order_acquire ) && empty() &&
+					!m_wakeup_requested )
+				lock.wait_for_notify_for( max_wait );
+			m_sleeping.store( false, std::memory_order_release );
+
+			m_wakeup_requested = false;
+		}
+
+		if( empty() )
+			return nullptr;
+	}
+}
+
+void
+lock_free_demand_queue_t::wakeup()
+{
+	queue_traits::lock_guard_t lock{ *m_lock };
+
+	m_wakeup_requested = true;
+	lock.notify_one();
+}
+
+void
+lock_free_demand_queue_t::start_service()
+{
+	queue_traits::lock_guard_t lock{ *m_lock };
+
+	m_in_service.store( true, std::memory_order_release );
+}
+
+void
+lock_free_demand_queue_t::stop_service()
+{
+	queue_traits::lock_guard_t lock{ *m_lock };
+
+	m_in_service.store( false, std::memory_order_release );
+	// The consumer could wait for new demands inside pop().
+	lock.notify_one();
+}
+
+void
+lock_free_demand_queue_t::clear()
+{
+	while( try_extract() )
+		;
+
+	// Message instance from the last extracted demand must be
+	// released too.
+	m_tail->m_demand = execution_demand_t();
+
+	flush_cached_nodes();
+}
+
+std::size_t
+lock_free_demand_queue_t::demands_count() const
+{
+	// All counters are wrapped around. So the difference between
+	// them is calculated in modulo 2^32 arithmetic.
+	const std::uint32_t pushed =
+			free_top_tag( m_free_top.load( std::memory_order_relaxed ) ) +
+			m_pushed_correction.load( std::memory_order_relaxed );
+	const std::uint32_t count =
+			pushed - m_extracted.load( std::memory_order_relaxed );
+
+	// Counters are read not at once. So the count of extracted
+	// demands can be greater than the count of pushed ones.
+	return count < 0x80000000u ? count : 0u;
+}
+
+lock_free_demand_queue_t::node_t *
+lock_free_demand_queue_t::try_extract()
+{
+	auto next = m_tail->m_next.load( std::memory_order_acquire );
+	if( next )
+	{
+		// The old stub node is not needed anymore.
+		// The extracted node becomes the new stub.
+		release_node( m_tail );
+		m_tail = next;
+
+		m_extracted.store(
+				m_extracted.load( std::memory_order_relaxed ) + 1,
+				std::memory_order_relaxed );
+	}
+
+	return next;
+}
+
+lock_free_demand_queue_t::node_t *
+lock_free_demand_queue_t::take_node()
+{
+	// Acquire operations on the top of the stack synchronize with
+	// return_to_pool() because all modifications of the top are
+	// read-modify-write operations.
+	auto top = m_free_top.load( std::memory_order_acquire );
+	while( const auto index = free_top_index( top ) )
+	{
+		node_t * node = m_pool[ index - 1 ].load( std::memory_order_relaxed );
+
+		// The node can be taken by another producer at this moment.
+		// The value of m_next_free doesn't matter in that case because
+		// the tag of the top is changed and CAS will fail.
+		const auto next = node->m_next_free.load( std::memory_order_relaxed );
+		if( m_free_top.compare_exchange_weak(
+				top,
+				make_free_top( next, free_top_tag( top ) + 1 ),
+				std::memory_order_acquire,
+				std::memory_order_acquire ) )
+			return node;
+	}
+
+	// The pool is empty.
+	node_t * node = new node_t();
+	m_pushed_correction.fetch_add( 1, std::memory_order_relaxed );
+
+	return node;
+}
+
+std::pair<
+	lock_free_demand_queue_t::node_t *,
+	lock_free_demand_queue_t::node_t * >
+lock_free_demand_queue_t::make_chain(
+	execution_demand_t * demands,
+	std::size_t count )
+{
+	// The chain is built before publishing. Nodes of the chain are
+	// not visible to the consumer yet so they can be linked without
+	// any synchronization.
+	node_t * first = nullptr;
+	node_t * last = nullptr;
+	std::size_t taken = 0;
+	try
+	{
+		for( ; taken != count; ++taken )
+		{
+			node_t * node = take_node();
+			node->m_demand = std::move( demands[ taken ] );
+
+			if( last )
+				last->m_next.store( node, std::memory_order_relaxed );
+			else
+				first = node;
+			last = node;
+		}
+	}
+	catch( ... )
+	{
+		// Taken nodes won't be pushed.
+		m_pushed_correction.fetch_sub(
+				static_cast< std::uint32_t >( taken ),
+				std::memory_order_relaxed );
+
+		while( first )
+		{
+			node_t * next = first->m_next.load( std::memory_order_relaxed );
+			if( not_in_pool == first->m_pool_index )
+				delete first;
+			else
+			{
+				first->m_demand = execution_demand_t();
+				first->m_next.store( nullptr, std::memory_order_relaxed );
+				return_to_pool( first, first );
+			}
+			first = next;
+		}
+		throw;
+	}
+
+	return std::make_pair( first, last );
+}
+
+void
+lock_free_demand_queue_t::return_to_pool(
+	node_t * first,
+	node_t * last )
+{
+	const std::uint32_t index = first->m_pool_index + 1;
+
+	// The tag is not changed. A removal of a node changes it so
+	// a producer which has read the old top can't remove a node
+	// which has been removed and returned to the pool.
+	auto top = m_free_top.load( std::memory_order_relaxed );
+	do
+		last->m_next_free.store(
+				free_top_index( top ), std::memory_order_relaxed );
+	while( !m_free_top.compare_exchange_weak(
+			top,
+			make_free_top( index, free_top_tag( top ) ),
+			std::memory_order_release,
+			std::memory_order_relaxed ) );
+}
+
+void
+lock_free_demand_queue_t::release_node( node_t * node )
+{
+	node->m_demand = execution_demand_t();
+	node->m_next.store( nullptr, std::memory_order_relaxed );
+
+	if( not_in_pool == node->m_pool_index )
+	{
+		if( max_pool_nodes == m_pool_size )
+		{
+			delete node;
+			return;
+		}
+
+		// The node becomes a part of the pool. The item of m_pool
+		// will be visible to producers after return_to_pool().
+		node->m_pool_index = m_pool_size;
+		m_pool[ m_pool_size ].store( node, std::memory_order_relaxed );
+		++m_pool_size;
+	}
+
+	node->m_next_free.store(
+			m_cached_first ? m_cached_first->m_pool_index + 1 : 0u,
+			std::memory_order_relaxed );
+	if( !m_cached_first )
+		m_cached_last = node;
+	m_cached_first = node;
+
+	if( cached_nodes_threshold == ++m_cached_count )
+		flush_cached_nodes();
+}
+
+void
+lock_free_demand_queue_t::flush_cached_nodes()
+{
+	if( m_cached_first )
+	{
+		return_to_pool( m_cached_first, m_cached_last );
+
+		m_cached_first = m_cached_last = nullptr;
+		m_cached_count = 0;
+	}
+}
+
+bool
+lock_free_demand_queue_t::empty() const
+{
+	return m_head.load( std::memory_order_seq_cst ) == m_tail;
+}
+
+void
+lock_free_demand_queue_t::push_chain(
+	node_t * first,
+	node_t * last )
+{
+	// Exchange of the head is the only operation which
+	// synchronizes producers. The prev node can't be destroyed until
+	// the link to the new node is set. So it is safe to access it.
+	node_t * prev = m_head.exchange( last, std::memory_order_seq_cst );
+
+	// Links inside the chain become visible to the consumer
+	// together with that link.
+	prev->m_next.store( first, std::memory_order_release );
+
+	if( m_sleeping.load( std::memory_order_seq_cst ) )
+	{
+		// The consumer is parked or is going to be parked.
+		queue_traits::lock_guard_t guard{ *m_lock };
+		guard.notify_one();
+	}
+}
+
+//
+// timer_manager_for_work_thread_t
+//
+timer_manager_for_work_thread_t::timer_manager_for_work_thread_t(
+	work_thread_t & owner,
+	so_5::timer_manager_unique_ptr_t actual )
+	:	m_owner( owner )
+	,	m_actual( std::move( actual ) )
+{
+}
+
+timer_id_t
+timer_manager_for_work_thread_t::schedule(
+	const std::type_index & type_index,
+	const mbox_t & mbox,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+{
+	auto result = m_actual->schedule( type_index, mbox, msg, pause, period );
+	m_owner.timer_scheduled();
+
+	return result;
+}
+
+void
+timer_manager_for_work_thread_t::schedule_anonymous(
+	const std::type_index & type_index,
+	const mbox_t & mbox,
+	const message_ref_t & msg,
+	std::chrono::steady_clock::duration pause,
+	std::chrono::steady_clock::duration period )
+{
+	m_actual->schedule_anonymous( type_index, mbox, msg, pause, period );
+	m_owner.timer_scheduled();
+}
+
+void
+timer_manager_for_work_thread_t::process_expired_timers()
+{
+	m_actual->process_expired_timers();
+}
+
+std::chrono::steady_clock::duration
+timer_manager_for_work_thread_t::timeout_before_nearest_timer(
+	std::chrono::steady_clock::duration default_timeout )
+{
+	return m_actual->timeout_before_nearest_timer( default_timeout );
+}
+
+timer_thread_stats_t
+timer_manager_for_work_thread_t::query_stats()
+{
+	return m_actual->query_stats();
+}
+
 //
 // work_thread_t
 //
 work_thread_t::work_thread_t(
 	queue_traits::lock_factory_t queue_lock_factory )
-	:	m_queue{ queue_lock_factory() }
+	:	m_queue{ new demand_queue_t{ queue_lock_factory() } }
 {
 	m_continue_work = WORK_THREAD_STOP;
 }
 
+work_thread_t::work_thread_t(
+	const queue_traits::queue_params_t & queue_params )
+{
+	if( queue_params.lock_free() )
+		m_lock_free_queue.reset( new lock_free_demand_queue_t{
+				queue_params.lock_factory()() } );
+	else
+		m_queue.reset( new demand_queue_t{
+				queue_params.lock_factory()() } );
+
+	m_continue_work = WORK_THREAD_STOP;
+}
+
 void
-work_thread_t::start()
+work_thread_t::start( thread_factory_t & thread_factory )
 {
-	m_queue.start_service();
 	m_continue_work = WORK_THREAD_CONTINUE;
 
-	m_thread.reset( new std::thread( [this]() { body(); } ) );
+	if( m_lock_free_queue )
+	{
+		m_lock_free_queue->start_service();
+		m_thread = thread_factory.start( [this]() { lock_free_body(); } );
+	}
+	else
+	{
+		m_queue->start_service();
+		m_thread = thread_factory.start( [this]() { body(); } );
+	}
 }
 
 void
 work_thread_t::shutdown()
 {
 	m_continue_work = WORK_THREAD_STOP;
-	m_queue.stop_service();
+
+	if( m_lock_free_queue )
+		m_lock_free_queue->stop_service();
+	else
+		m_queue->stop_service();
 }
 
 void
@@ -156,13 +740,19 @@ work_thread_t::wait()
 {
 	m_thread->join();
 
-	m_queue.clear();
+	if( m_lock_free_queue )
+		m_lock_free_queue->clear();
+	else
+		m_queue->clear();
 }
 
 event_queue_t &
 work_thread_t::event_queue()
 {
-	return m_queue;
+	if( m_lock_free_queue )
+		return *m_lock_free_queue;
+
+	return *m_queue;
 }
 
 event_queue_t *
@@ -174,7 +764,24 @@ work_thread_t::get_agent_binding()
 std::size_t
 work_thread_t::demands_count()
 {
-	return m_queue.demands_count( m_demands_count );
+	if( m_lock_free_queue )
+		return m_lock_free_queue->demands_count();
+
+	return m_queue->demands_count( m_demands_count );
+}
+
+void
+work_thread_t::set_timer_manager(
+	so_5::timer_manager_unique_ptr_t manager )
+{
+	m_timer_manager.reset(
+			new timer_manager_for_work_thread_t( *this, std::move( manager ) ) );
+}
+
+so_5::timer_manager_t *
+work_thread_t::timer_manager()
+{
+	return m_timer_manager.get();
 }
 
 void
@@ -194,7 +801,17 @@ work_thread_t::body()
 		// If the local queue is empty then we should try
 		// to get new demands.
 		if( demands.empty() )
-			result = m_queue.pop( demands, m_demands_count );
+		{
+			if( m_timer_manager )
+			{
+				// Elapsed timers are handled between blocks of demands.
+				const auto max_wait = handle_timers( true );
+				result = m_queue->pop( demands, m_demands_count, max_wait );
+				m_waiting_for_timers.store( false, std::memory_order_release );
+			}
+			else
+				result = m_queue->pop( demands, m_demands_count );
+		}
 
 		// Serve demands if any.
 		if( demand_queue_t::demand_extracted == result )
@@ -202,6 +819,98 @@ work_thread_t::body()
 	}
 }
 
+void
+work_thread_t::lock_free_body()
+{
+	// Store current thread ID to attribute to avoid thread ID
+	// request on every event execution.
+	m_thread_id = so_5::query_current_thread_id();
+
+	execution_demand_t * demand;
+	if( m_timer_manager )
+	{
+		while( m_continue_work == WORK_THREAD_CONTINUE )
+		{
+			demand = m_lock_free_queue->try_pop();
+			if( demand )
+			{
+				// While there are demands in the queue timers are handled
+				// only if the nearest of them is elapsed or a new one
+				// has been scheduled.
+				if( timers_check_needed() )
+					handle_timers( false );
+			}
+			else
+			{
+				// The queue is empty. Elapsed timers must be handled
+				// before the parking of the working thread.
+				const auto max_wait = handle_timers( true );
+				demand = m_lock_free_queue->pop( max_wait );
+				m_waiting_for_timers.store( false, std::memory_order_release );
+			}
+
+			if( demand )
+			{
+				demand->call_handler( m_thread_id );
+				demand->m_message_ref.reset();
+			}
+		}
+	}
+	else
+		while( m_continue_work == WORK_THREAD_CONTINUE &&
+				nullptr != (demand = m_lock_free_queue->pop()) )
+		{
+			demand->call_handler( m_thread_id );
+
+			// Message instance must not be held until the next demand.
+			demand->m_message_ref.reset();
+		}
+}
+
+std::chrono::steady_clock::duration
+work_thread_t::handle_timers( bool going_to_wait )
+{
+	// A timer scheduled after that will be noticed by
+	// timers_check_needed().
+	m_timers_changed.store( false, std::memory_order_seq_cst );
+
+	m_timer_manager->process_expired_timers();
+
+	// This flag must be set before calculation of the waiting time.
+	// A timer scheduled after that will wake the working thread up.
+	// A timer scheduled before that will be taken into account
+	// in calculation of the waiting time.
+	if( going_to_wait )
+		m_waiting_for_timers.store( true, std::memory_order_seq_cst );
+
+	const auto timeout = m_timer_manager->timeout_before_nearest_timer(
+			std::chrono::hours( 24 ) );
+	m_next_timers_check = std::chrono::steady_clock::now() + timeout;
+
+	return timeout;
+}
+
+inline bool
+work_thread_t::timers_check_needed() const
+{
+	return m_timers_changed.load( std::memory_order_acquire ) ||
+			std::chrono::steady_clock::now() >= m_next_timers_check;
+}
+
+void
+work_thread_t::timer_scheduled()
+{
+	m_timers_changed.store( true, std::memory_order_seq_cst );
+
+	if( m_waiting_for_timers.load( std::memory_order_seq_cst ) )
+	{
+		if( m_lock_free_queue )
+			m_lock_free_queue->wakeup();
+		else
+			m_queue->wakeup();
+	}
+}
+
 inline void
 work_thread_t::serve_demands_block(
 	demand_container_t & demands )
@@ -15,9 +15,12 @@
 
 #include <so_5/rt/h/disp_binder.hpp>
 
+#include <so_5/h/thread_factory.hpp>
+
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
 #include <utility>
+#include <chrono>
 
 namespace so_5
 {
@@ -35,6 +38,156 @@ namespace thread_pool
  */
 namespace queue_traits = so_5::disp::mpmc_queue_traits;
 
+//
+// elastic_params_t
+//
+/*!
+ * \brief Parameters for elastic mode of %thread_pool dispatcher.
+ *
+ * In elastic mode the dispatcher starts with min_threads() working
+ * threads. A new working thread is added (but no more than
+ * max_threads()) if all working threads are busy and:
+ * - count of non-empty agent queues waiting for a working thread
+ *   exceeds backlog_threshold();
+ * - or there are agent queues waiting for a working thread
+ *   without a pause for more than wait_time_threshold().
+ *
+ * A working thread is retired (but no less than min_threads() threads
+ * remain) if there was at least one idle working thread during
+ * the whole idle_timeout() period.
+ *
+ * \note Parameters are checked by the constructor of the dispatcher.
+ * min_threads() must be greater than 0 and max_threads() must not be
+ * less than min_threads(). Otherwise so_5::exception_t with
+ * rc_disp_create_failed is thrown.
+ *
+ * \par Usage example:
+	\code
+	using namespace so_5::disp::thread_pool;
+	create_private_disp( env,
+		disp_params_t{}
+			.elastic( elastic_params_t{}
+				.min_threads( 2 )
+				.max_threads( 32 )
+				.wait_time_threshold( std::chrono::milliseconds(20) )
+				.idle_timeout( std::chrono::minutes(5) ) ),
+		"elastic_pool" );
+	\endcode
+ *
+ * \since
+ * v.5.5.17
+ */
+class elastic_params_t
+	{
+	public :
+		//! Type for time thresholds.
+		using duration_t = std::chrono::steady_clock::duration;
+
+		//! Setter for minimal count of working threads.
+		elastic_params_t &
+		min_threads( std::size_t v )
+			{
+				m_min_threads = v;
+				return *this;
+			}
+
+		//! Getter for minimal count of working threads.
+		std::size_t
+		min_threads() const
+			{
+				return m_min_threads;
+			}
+
+		//! Setter for maximal count of working threads.
+		/*!
+		 * Value 0 means that elastic mode is not used.
+		 */
+		elastic_params_t &
+		max_threads( std::size_t v )
+			{
+				m_max_threads = v;
+				return *this;
+			}
+
+		//! Getter for maximal count of working threads.
+		std::size_t
+		max_threads() const
+			{
+				return m_max_threads;
+			}
+
+		//! Setter for the threshold of count of waiting agent queues.
+		elastic_params_t &
+		backlog_threshold( std::size_t v )
+			{
+				m_backlog_threshold = v;
+				return *this;
+			}
+
+		//! Getter for the threshold of count of waiting agent queues.
+		std::size_t
+		backlog_threshold() const
+			{
+				return m_backlog_threshold;
+			}
+
+		//! Setter for the threshold of waiting time of agent queues.
+		elastic_params_t &
+		wait_time_threshold( duration_t v )
+			{
+				m_wait_time_threshold = v;
+				return *this;
+			}
+
+		//! Getter for the threshold of waiting time of agent queues.
+		duration_t
+		wait_time_threshold() const
+			{
+				return m_wait_time_threshold;
+			}
+
+		//! Setter for the idle period before retirement of a working thread.
+		elastic_params_t &
+		idle_timeout( duration_t v )
+			{
+				m_idle_timeout = v;
+				return *this;
+			}
+
+		//! Getter for the idle period before retirement of a working thread.
+		duration_t
+		idle_timeout() const
+			{
+				return m_idle_timeout;
+			}
+
+		//! Is elastic mode used?
+		bool
+		is_elastic() const
+			{
+				return 0 != m_max_threads;
+			}
+
+	private :
+		//! Minimal count of working threads.
+		std::size_t m_min_threads = { 1 };
+		//! Maximal count of working threads.
+		/*!
+		 * Value 0 means that elastic mode is not used.
+		 */
+		std::size_t m_max_threads = { 0 };
+		//! Threshold of count of waiting agent queues.
+		std::size_t m_backlog_threshold = { 16 };
+		//! Threshold of waiting time of agent queues.
+		duration_t m_wait_time_threshold =
+				std::chrono::duration_cast< duration_t >(
+						std::chrono::milliseconds( 100 ) );
+		//! Idle period before retirement of a working thread.
+		duration_t m_idle_timeout =
+				std::chrono::duration_cast< duration_t >(
+						std::chrono::seconds( 60 ) );
+	};
+
 //
 // disp_params_t
 //
@@ -52,17 +205,23 @@ class disp_params_t
 		disp_params_t( const disp_params_t & o )
 			:	m_thread_count{ o.m_thread_count }
 			,	m_queue_params{ o.m_queue_params }
+			,	m_thread_factory{ o.m_thread_factory }
+			,	m_elastic_params{ o.m_elastic_params }
 			{}
 		//! Move constructor.
 		disp_params_t( disp_params_t && o )
 			:	m_thread_count{ std::move(o.m_thread_count) }
 			,	m_queue_params{ std::move(o.m_queue_params) }
+			,	m_thread_factory{ std::move(o.m_thread_factory) }
+			,	m_elastic_params{ std::move(o.m_elastic_params) }
 			{}
 
 		friend inline void swap( disp_params_t & a, disp_params_t & b )
 			{
 				std::swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_thread_factory, b.m_thread_factory );
+				std::swap( a.m_elastic_params, b.m_elastic_params );
 			}
 
 		//! Copy operator.
@@ -134,6 +293,66 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		/*!
+		 * \brief Setter for thread factory.
+		 *
+		 * Allows to specify names, stack sizes and CPU affinity
+		 * for working threads of the dispatcher.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		disp_params_t &
+		thread_factory( thread_factory_shptr_t factory )
+			{
+				m_thread_factory = std::move(factory);
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for thread factory.
+		 *
+		 * \note Can be empty. In that case the factory from the
+		 * SObjectizer Environment is used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		const thread_factory_shptr_t &
+		thread_factory() const
+			{
+				return m_thread_factory;
+			}
+
+		/*!
+		 * \brief Setter for elastic mode parameters.
+		 *
+		 * \note If elastic mode is used then value of thread_count()
+		 * is ignored. Work stealing mode of the queue is not used
+		 * in elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		disp_params_t &
+		elastic( elastic_params_t params )
+			{
+				m_elastic_params = std::move(params);
+				return *this;
+			}
+
+		/*!
+		 * \brief Getter for elastic mode parameters.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		const elastic_params_t &
+		elastic_params() const
+			{
+				return m_elastic_params;
+			}
+
 	private :
 		//! Count of working threads.
 		/*!
@@ -142,6 +361,23 @@ class disp_params_t
 		std::size_t m_thread_count = { 0 };
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		/*!
+		 * \brief Factory for working threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		thread_factory_shptr_t m_thread_factory;
+		/*!
+		 * \brief Parameters for elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		elastic_params_t m_elastic_params;
 	};
 
 //
@@ -12,13 +12,23 @@
 
 #include <so_5/rt/h/event_queue.hpp>
 #include <so_5/rt/h/disp.hpp>
+#include <so_5/rt/h/environment.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <so_5/disp/thread_pool/h/pub.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
 #include <so_5/disp/reuse/h/thread_pool_stats.hpp>
+#include <so_5/disp/reuse/h/thread_factory_helpers.hpp>
 
 #include <so_5/details/h/rollback_on_exception.hpp>
 
 #include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <iterator>
 
 namespace so_5 {
 
@@ -37,6 +47,11 @@ namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
 /*!
  * \since v.5.5.4
  * \brief Reusable common implementation for thread-pool-like dispatchers.
+ *
+ * \note Since v.5.5.17 there is an elastic mode. In this mode an
+ * additional manager thread is started. This thread adds new working
+ * threads when the dispatcher's queue is overloaded and retires
+ * working threads when they are idle for a long time.
  */
 template<
 	typename WORK_THREAD,
@@ -93,6 +108,8 @@ class dispatcher_t
 					{
 						m_queue_desc->m_desc.m_agent_count = m_agents;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_pool_hits = m_queue->pool_hits();
+						m_queue_desc->m_desc.m_pool_misses = m_queue->pool_misses();
 					}
 			};
 
@@ -160,6 +177,8 @@ class dispatcher_t
 					{
 						m_queue_desc->m_desc.m_agent_count = 1;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_pool_hits = m_queue->pool_hits();
+						m_queue_desc->m_desc.m_pool_misses = m_queue->pool_misses();
 					}
 			};
 
@@ -173,16 +192,32 @@ class dispatcher_t
 		//! Constructor.
 		dispatcher_t(
 			std::size_t thread_count,
-			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params )
-			:	m_queue{ queue_params, thread_count }
-			,	m_thread_count( thread_count )
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			//! Factory for working threads.
+			//! Empty value means the factory from SObjectizer Environment.
+			thread_factory_shptr_t thread_factory,
+			//! Parameters for elastic mode.
+			//! Elastic mode is not used by default.
+			const elastic_params_t & elastic_params = elastic_params_t{} )
+			:	m_queue{
+					queue_params_for( queue_params, elastic_params ),
+					initial_thread_count( thread_count, elastic_params ) }
+			,	m_thread_count(
+					initial_thread_count( thread_count, elastic_params ) )
+			,	m_thread_factory( std::move( thread_factory ) )
+			,	m_elastic_params( elastic_params )
 			,	m_data_source( stats_supplier() )
 			{
-				m_threads.reserve( thread_count );
+				m_threads.reserve( m_thread_count );
 
 				for( std::size_t i = 0; i != m_thread_count; ++i )
 					m_threads.emplace_back( std::unique_ptr< WORK_THREAD >(
 								new WORK_THREAD( m_queue ) ) );
+
+				if( m_elastic_params.is_elastic() )
+					m_queue.turn_elastic_mode_on(
+							m_elastic_params.backlog_threshold(),
+							[this] { notify_manager_about_backlog(); } );
 			}
 
 		virtual void
@@ -190,19 +225,41 @@ class dispatcher_t
 			{
 				m_data_source.start( env.stats_repository() );
 
+				auto & thread_factory = so_5::disp::reuse::actual_thread_factory(
+						m_thread_factory, env );
 				for( auto & t : m_threads )
-					t->start();
+					t->start( thread_factory );
+
+				if( m_elastic_params.is_elastic() )
+					{
+						m_env = &env;
+						m_actual_thread_factory = &thread_factory;
+						m_manager_thread = thread_factory.start(
+								[this] { manager_body(); } );
+					}
 			}
 
 		virtual void
 		shutdown() override
 			{
 				m_queue.shutdown();
+
+				if( m_manager_thread )
+					{
+						std::lock_guard< std::mutex > lock{ m_manager_lock };
+						m_manager_shutdown = true;
+						m_manager_cond.notify_one();
+					}
 			}
 
 		virtual void
 		wait() override
 			{
+				// Manager thread must be finished first because
+				// it modifies the list of working threads.
+				if( m_manager_thread )
+					m_manager_thread->join();
+
 				for( auto & t : m_threads )
 					t->join();
 
@@ -271,15 +328,109 @@ class dispatcher_t
 			}
 
 	private :
+		/*!
+		 * \since v.5.5.17
+		 * \brief Pool of nodes for demands of all agent's queues.
+		 *
+		 * \note It is declared before any agent's queue because
+		 * queues hold references to it.
+		 */
+		typename AGENT_QUEUE::demands_pool_t m_demands_pool;
+
 		//! Queue for active agent's queues.
 		DISPATCHER_QUEUE m_queue;
 
 		//! Count of working threads.
-		const std::size_t m_thread_count;
+		/*!
+		 * \note Since v.5.5.17 it is changed in elastic mode.
+		 * It is protected by m_lock.
+		 */
+		std::size_t m_thread_count;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for work threads.
+		 *
+		 * Empty value means that the factory from the SObjectizer
+		 * Environment must be used.
+		 */
+		thread_factory_shptr_t m_thread_factory;
 
 		//! Pool of work threads.
+		/*!
+		 * \note Since v.5.5.17 it is changed in elastic mode by
+		 * the manager thread. Modification is performed under m_lock.
+		 */
 		std::vector< std::unique_ptr< WORK_THREAD > > m_threads;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Parameters for elastic mode.
+		 */
+		const elastic_params_t m_elastic_params;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief SObjectizer Environment to work in.
+		 *
+		 * Receives actual value in start() only in elastic mode.
+		 */
+		environment_t * m_env = { nullptr };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for working threads started by manager thread.
+		 *
+		 * Receives actual value in start() only in elastic mode.
+		 */
+		thread_factory_t * m_actual_thread_factory = { nullptr };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Manager thread for elastic mode.
+		 */
+		thread_handle_unique_ptr_t m_manager_thread;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Lock for the manager thread.
+		 */
+		std::mutex m_manager_lock;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Condition for sleeping of the manager thread.
+		 */
+		std::condition_variable m_manager_cond;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Shutdown flag for the manager thread.
+		 */
+		bool m_manager_shutdown = { false };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has the queue requested a new working thread?
+		 */
+		bool m_backlog_signaled = { false };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Count of working threads added in elastic mode.
+		 *
+		 * \note It is protected by m_lock.
+		 */
+		std::size_t m_threads_grown = { 0 };
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Count of working threads retired in elastic mode.
+		 *
+		 * \note It is protected by m_lock.
+		 */
+		std::size_t m_threads_retired = { 0 };
+
 		//! Object's lock.
 		std::mutex m_lock;
 
@@ -361,7 +512,7 @@ class dispatcher_t
 			const PARAMS & params )
 			{
 				return agent_queue_ref_t(
-						new AGENT_QUEUE{ m_queue, params } );
+						new AGENT_QUEUE{ m_queue, m_demands_pool, params } );
 			}
 
 		/*!
@@ -384,7 +535,10 @@ class dispatcher_t
 				// Statics must be collected on locked object.
 				std::lock_guard< std::mutex > lock( m_lock );
 
-				consumer.set_thread_count( m_threads.size() );
+				consumer.set_thread_count( m_thread_count );
+
+				if( m_elastic_params.is_elastic() )
+					consumer.set_elastic_stats( m_threads_grown, m_threads_retired );
 
 				for( auto & q : m_cooperations )
 					{
@@ -403,6 +557,270 @@ class dispatcher_t
 							}
 					}
 			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Detection of the initial count of working threads.
+		 *
+		 * \note Parameters of elastic mode are checked here because
+		 * it is the first action of the constructor.
+		 *
+		 * \throw so_5::exception_t with rc_disp_create_failed if
+		 * parameters of elastic mode are invalid.
+		 */
+		static std::size_t
+		initial_thread_count(
+			std::size_t thread_count,
+			const elastic_params_t & elastic_params )
+			{
+				if( !elastic_params.is_elastic() )
+					return thread_count;
+
+				ensure_valid_elastic_params( elastic_params );
+
+				return elastic_params.min_threads();
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Check parameters of elastic mode.
+		 *
+		 * There must be at least one working thread and max_threads
+		 * must not be less than min_threads.
+		 *
+		 * \throw so_5::exception_t with rc_disp_create_failed if
+		 * parameters are invalid.
+		 */
+		static void
+		ensure_valid_elastic_params( const elastic_params_t & elastic_params )
+			{
+				if( !elastic_params.min_threads() )
+					SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+							"min_threads for elastic thread_pool dispatcher "
+							"must be greater than 0" );
+
+				if( elastic_params.max_threads() < elastic_params.min_threads() )
+					SO_5_THROW_EXCEPTION( rc_disp_create_failed,
+							"max_threads for elastic thread_pool dispatcher "
+							"must not be less than min_threads, min_threads: " +
+							std::to_string( elastic_params.min_threads() ) +
+							", max_threads: " +
+							std::to_string( elastic_params.max_threads() ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Detection of actual queue parameters.
+		 *
+		 * Work stealing mode is not used in elastic mode.
+		 */
+		static so_5::disp::mpmc_queue_traits::queue_params_t
+		queue_params_for(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			const elastic_params_t & elastic_params )
+			{
+				auto result = queue_params;
+				if( elastic_params.is_elastic() )
+					result.work_stealing( false );
+
+				return result;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Reaction to a request for a new working thread
+		 * from the queue.
+		 *
+		 * \note It is called when the queue's lock is acquired.
+		 */
+		void
+		notify_manager_about_backlog()
+			{
+				std::lock_guard< std::mutex > lock{ m_manager_lock };
+				m_backlog_signaled = true;
+				m_manager_cond.notify_one();
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Period of checking the load of the queue by
+		 * the manager thread.
+		 */
+		std::chrono::steady_clock::duration
+		manager_check_period() const
+			{
+				using namespace std::chrono;
+
+				const auto period = std::min(
+						m_elastic_params.wait_time_threshold(),
+						m_elastic_params.idle_timeout() ) / 4;
+
+				return std::max( period,
+						duration_cast< steady_clock::duration >( milliseconds(1) ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Body of the manager thread for elastic mode.
+		 */
+		void
+		manager_body()
+			{
+				const auto period = manager_check_period();
+
+				// Information about idle working threads.
+				bool idle = false;
+				std::chrono::steady_clock::time_point idle_since;
+
+				std::unique_lock< std::mutex > lock{ m_manager_lock };
+				while( !m_manager_shutdown )
+					{
+						if( !m_backlog_signaled )
+							m_manager_cond.wait_for( lock, period );
+
+						if( m_manager_shutdown )
+							break;
+
+						m_backlog_signaled = false;
+
+						// Manager lock must not be held because the queue
+						// calls notify_manager_about_backlog() under its own lock.
+						lock.unlock();
+						join_retired_threads();
+						manage_thread_count( idle, idle_since );
+						lock.lock();
+					}
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Detection of necessity of changing working threads count.
+		 */
+		void
+		manage_thread_count(
+			bool & idle,
+			std::chrono::steady_clock::time_point & idle_since )
+			{
+				const auto load = m_queue.query_load();
+				const auto now = std::chrono::steady_clock::now();
+
+				const auto thread_count = current_thread_count();
+
+				if( load.m_backlog && !load.m_idle_customers &&
+						thread_count < m_elastic_params.max_threads() &&
+						( load.m_backlog > m_elastic_params.backlog_threshold() ||
+						now - load.m_backlog_since >=
+								m_elastic_params.wait_time_threshold() ) )
+					{
+						idle = false;
+						add_thread();
+					}
+				else if( load.m_idle_customers )
+					{
+						if( !idle )
+							{
+								idle = true;
+								idle_since = now;
+							}
+						else if( now - idle_since >= m_elastic_params.idle_timeout() &&
+								thread_count > m_elastic_params.min_threads() )
+							{
+								// Next thread can be retired only after
+								// another idle period.
+								idle_since = now;
+								retire_thread();
+							}
+					}
+				else
+					idle = false;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the current count of working threads.
+		 */
+		std::size_t
+		current_thread_count()
+			{
+				std::lock_guard< std::mutex > lock( m_lock );
+				return m_thread_count;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Start yet another working thread.
+		 *
+		 * An exception during start of the thread is logged and ignored.
+		 */
+		void
+		add_thread()
+			{
+				try
+					{
+						std::unique_ptr< WORK_THREAD > t{ new WORK_THREAD( m_queue ) };
+
+						// The queue must know about the new customer before
+						// its start. Otherwise the new thread can be retired
+						// before it is counted.
+						m_queue.customer_added();
+						so_5::details::do_with_rollback_on_exception(
+								[&] { t->start( *m_actual_thread_factory ); },
+								[this] { m_queue.customer_not_started(); } );
+
+						std::lock_guard< std::mutex > lock( m_lock );
+						m_threads.push_back( std::move(t) );
+						++m_thread_count;
+						++m_threads_grown;
+					}
+				catch( const std::exception & x )
+					{
+						SO_5_LOG_ERROR( *m_env, log_stream )
+						{
+							log_stream << "unable to start yet another working thread "
+									"for elastic thread pool: " << x.what();
+						}
+					}
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Retire one of idle working threads.
+		 */
+		void
+		retire_thread()
+			{
+				if( m_queue.try_retire_one_customer() )
+					{
+						std::lock_guard< std::mutex > lock( m_lock );
+						--m_thread_count;
+						++m_threads_retired;
+					}
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Join and remove working threads which have finished
+		 * their work.
+		 */
+		void
+		join_retired_threads()
+			{
+				std::vector< std::unique_ptr< WORK_THREAD > > finished;
+
+				{
+					std::lock_guard< std::mutex > lock( m_lock );
+
+					auto it = std::partition( m_threads.begin(), m_threads.end(),
+							[]( const std::unique_ptr< WORK_THREAD > & t ) {
+								return !t->finished();
+							} );
+					std::move( it, m_threads.end(), std::back_inserter( finished ) );
+					m_threads.erase( it, m_threads.end() );
+				}
+
+				for( auto & t : finished )
+					t->join();
+			}
 	};
 
 } /* namespace common_implementation */
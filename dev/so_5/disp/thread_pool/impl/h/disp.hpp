@@ -23,9 +23,12 @@
 #include <so_5/rt/h/disp.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demands_freelist.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
+#include <so_5/details/h/cache_line.hpp>
+
 namespace so_5
 {
 
@@ -78,13 +81,25 @@ class agent_queue_t
 			};
 
 	public :
+		/*!
+		 * \brief Type of pool of nodes shared by all queues of
+		 * a dispatcher.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		using demands_pool_t = so_5::disp::reuse::demands_pool_t< demand_t >;
+
 		//! Constructor.
 		agent_queue_t(
 			//! Dispatcher queue to work with.
 			dispatcher_queue_t & disp_queue,
+			//! Pool of nodes of the dispatcher.
+			demands_pool_t & demands_pool,
 			//! Parameters for the queue.
 			const params_t & params )
 			:	m_disp_queue( disp_queue )
+			,	m_demands_pool( demands_pool )
 			,	m_max_demands_at_once( params.query_max_demands_at_once() )
 			,	m_tail( &m_head )
 			{}
@@ -92,24 +107,41 @@ class agent_queue_t
 		~agent_queue_t()
 			{
 				while( m_head.m_next )
-					remove_head();
+					{
+						std::unique_ptr< demand_t > old{ m_head.m_next };
+						m_head.m_next = old->m_next;
+					}
 			}
 
 		//! Push next demand to queue.
+		/*!
+		 * \note Since v.5.5.17 a node for the demand is taken from
+		 * the dispatcher's pool if it is possible. The node is prepared
+		 * before the acquisition of the queue's lock.
+		 */
 		virtual void
 		push( execution_demand_t demand )
 			{
-				std::unique_ptr< demand_t > tail_demand{
-						new demand_t( std::move( demand ) ) };
+				demand_t * tail_demand = m_demands_pool.try_take();
+				const bool hit = nullptr != tail_demand;
+				if( hit )
+					static_cast< execution_demand_t & >( *tail_demand ) =
+							std::move( demand );
+				else
+					tail_demand = new demand_t( std::move( demand ) );
 
 				bool was_empty;
 
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
-					was_empty = (nullptr == m_head.m_next);
+					m_pool_counters.add( hit ? 1u : 0u, hit ? 0u : 1u );
+
+					// Queue must not be scheduled again while a batch
+					// of its demands is being processed.
+					was_empty = (nullptr == m_head.m_next) && !m_batch_in_processing;
 
-					m_tail->m_next = tail_demand.release();
+					m_tail->m_next = tail_demand;
 					m_tail = m_tail->m_next;
 
 					++m_size;
@@ -121,16 +153,98 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
-		//! Get the front demand from queue.
 		/*!
-		 * \attention This method must be called only on non-empty queue.
+		 * \brief Push several demands to queue at once.
+		 *
+		 * Nodes are taken from the dispatcher's pool by one locked
+		 * operation. Missing nodes are allocated before the acquisition
+		 * of the queue's lock. All demands are appended by one locked
+		 * operation.
+		 *
+		 * The queue is scheduled at most once.
+		 *
+		 * \since
+		 * v.5.5.17
 		 */
-		execution_demand_t &
-		front()
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
 			{
-				return *(m_head.m_next);
+				if( !count )
+					return;
+
+				// New demands are linked into a local chain first.
+				// Nodes from the pool are taken by one locked operation.
+				demand_t * first = nullptr;
+				const std::size_t hits =
+						m_demands_pool.try_take_chain( count, first );
+
+				demand_t * last = nullptr;
+				std::size_t i = 0;
+				for( demand_t * d = first; d; d = d->m_next, ++i )
+					{
+						static_cast< execution_demand_t & >( *d ) =
+								std::move( demands[ i ] );
+						last = d;
+					}
+
+				try
+					{
+						for( ; i != count; ++i )
+							{
+								demand_t * d = new demand_t( std::move( demands[ i ] ) );
+								if( last )
+									last->m_next = d;
+								else
+									first = d;
+								last = d;
+							}
+					}
+				catch( ... )
+					{
+						for( demand_t * d = first; d; d = d->m_next )
+							static_cast< execution_demand_t & >( *d ) =
+									execution_demand_t();
+						m_demands_pool.put_chain( first );
+						throw;
+					}
+
+				bool was_empty;
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					m_pool_counters.add( hits, count - hits );
+
+					was_empty = (nullptr == m_head.m_next) && !m_batch_in_processing;
+
+					m_tail->m_next = first;
+					m_tail = last;
+
+					m_size += count;
+				}
+
+				if( was_empty )
+					m_disp_queue.schedule( this );
 			}
 
+		/*!
+		 * \brief A batch of demands detached from the queue for processing.
+		 *
+		 * Demands are linked via m_next field. The last demand in
+		 * the batch has nullptr in m_next.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		struct batch_t
+			{
+				//! The first demand in the batch.
+				demand_t * m_head;
+				//! Count of demands in the batch.
+				std::size_t m_size;
+			};
+
 		/*!
 		 * \brief Queue emptyness indication.
 		 *
@@ -170,35 +284,80 @@ class agent_queue_t
 				emptyness_t m_emptyness;
 			};
 
-		//! Remove the front demand.
+		//! Detach the first batch of demands for processing.
+		/*!
+		 * Up to m_max_demands_at_once demands are detached by one
+		 * locked operation.
+		 *
+		 * \attention This method must be called only on non-empty queue.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		batch_t
+		take_first_batch()
+			{
+				std::lock_guard< spinlock_t > lock( m_lock );
+
+				// At least one demand must be processed even if
+				// m_max_demands_at_once is zero.
+				return detach_batch(
+						m_max_demands_at_once ? m_max_demands_at_once : 1 );
+			}
+
+		//! Finish processing of the batch and detach the next one.
 		/*!
+		 * Nodes of processed demands are returned to the dispatcher's
+		 * pool after the release of the queue's lock.
+		 * If processing can be continued then the next batch is
+		 * detached and stored into \a batch by one locked operation.
+		 *
 		 * \note Return processing_continuation_t::disabled if
 		 * \a demands_processed exceeds m_max_demands_at_once or if
 		 * event queue is empty.
+		 *
+		 * \attention Message instances must be released by the caller
+		 * before the call to that method.
+		 *
+		 * \note It is a replacement for the pop() method which was
+		 * used before v.5.5.17 for every demand.
+		 *
+		 * \since
+		 * v.5.5.17
 		 */
 		pop_result_t
-		pop(
+		complete_batch(
+			//! Processed batch. Receives the next batch to be processed.
+			batch_t & batch,
 			//! Count of consequently processed demands from that queue.
 			std::size_t demands_processed )
 			{
-				// Actual deletion of old head must be performed
+				// Nodes of processed demands are returned to the pool
 				// when m_lock will be released.
-				std::unique_ptr< demand_t > old_head;
+				demand_t * const processed = batch.m_head;
+				pop_result_t result;
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
-					old_head = remove_head();
+					m_size -= batch.m_size;
+					m_batch_in_processing = false;
+					batch = batch_t{ nullptr, 0 };
 
 					const auto emptyness = m_head.m_next ?
 							emptyness_t::not_empty : emptyness_t::empty;
 
-					if( emptyness_t::empty == emptyness )
-						m_tail = &m_head;
-
-					return pop_result_t{
+					result = pop_result_t{
 							detect_continuation( emptyness, demands_processed ),
 							emptyness };
+
+					if( processing_continuation_t::enabled == result.m_continuation )
+						batch = detach_batch(
+								m_max_demands_at_once - demands_processed );
 				}
+
+				m_demands_pool.put_chain( processed );
+
+				return result;
 			}
 
 		/*!
@@ -220,7 +379,8 @@ class agent_queue_t
 					{
 						{
 							std::lock_guard< spinlock_t > lock( m_lock );
-							empty = (nullptr == m_head.m_next);
+							empty = (nullptr == m_head.m_next) &&
+									!m_batch_in_processing;
 						}
 
 						if( !empty )
@@ -240,14 +400,57 @@ class agent_queue_t
 				return m_size.load( std::memory_order_acquire );
 			}
 
+		/*!
+		 * \brief Get the count of demands which nodes were taken
+		 * from the dispatcher's pool.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t
+		pool_hits() const
+			{
+				return m_pool_counters.hits();
+			}
+
+		/*!
+		 * \brief Get the count of demands which nodes were allocated
+		 * by operator new.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::size_t
+		pool_misses() const
+			{
+				return m_pool_counters.misses();
+			}
+
 	private :
 		//! Dispatcher queue for scheduling processing of events from
 		//! this queue.
 		dispatcher_queue_t & m_disp_queue;
 
+		/*!
+		 * \brief Pool of nodes shared by all queues of the dispatcher.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		demands_pool_t & m_demands_pool;
+
 		//! Maximum count of demands to be processed consequently.
 		const std::size_t m_max_demands_at_once;
 
+		/*!
+		 * \brief Separator of read-only data from the data changed by
+		 * producers and by a working thread.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		so_5::details::cache_line_padding_t m_read_only_data_padding;
+
 		//! Object's lock.
 		spinlock_t m_lock;
 
@@ -270,16 +473,69 @@ class agent_queue_t
 		 */
 		std::atomic< std::size_t > m_size = { 0 };
 
-		//! Helper method for deleting queue's head object.
-		inline std::unique_ptr< demand_t >
-		remove_head()
+		/*!
+		 * \brief Usage of the dispatcher's pool by that queue.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		so_5::disp::reuse::demands_pool_counters_t m_pool_counters;
+
+		/*!
+		 * \brief Is there a batch of demands in processing?
+		 *
+		 * Demands of the batch are already detached from the queue
+		 * but the queue must be treated as non-empty.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool m_batch_in_processing = { false };
+
+		/*!
+		 * \brief Separator of the data protected by m_lock from the data
+		 * of the next object in the heap.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		so_5::details::cache_line_padding_t m_locked_data_padding;
+
+		//! Helper method for detaching of a batch from the queue's head.
+		/*!
+		 * \note Must be called only when m_lock is acquired.
+		 *
+		 * \note Count of demands in the queue is not changed. It will be
+		 * changed when processing of the batch will be completed.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		batch_t
+		detach_batch( std::size_t max_size )
 			{
-				std::unique_ptr< demand_t > to_be_deleted{ m_head.m_next };
-				m_head.m_next = m_head.m_next->m_next;
+				batch_t result{ m_head.m_next, 0 };
+
+				demand_t * last = nullptr;
+				demand_t * n = m_head.m_next;
+				while( n && result.m_size != max_size )
+					{
+						last = n;
+						n = n->m_next;
+						++result.m_size;
+					}
 
-				--m_size;
+				if( last )
+					{
+						last->m_next = nullptr;
+						m_head.m_next = n;
+						if( !n )
+							m_tail = &m_head;
+
+						m_batch_in_processing = true;
+					}
 
-				return to_be_deleted;
+				return result;
 			}
 
 		//! Can processing be continued?
@@ -316,20 +572,45 @@ class work_thread_t
 		void
 		join()
 			{
-				m_thread.join();
+				m_thread->join();
+			}
+
+		/*!
+		 * \brief Has the thread body finished its work?
+		 *
+		 * \note It is used for joining of retired working threads
+		 * in elastic mode.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		bool
+		finished() const
+			{
+				return m_finished.load( std::memory_order_acquire );
 			}
 
 		//! Launch work thread.
 		void
-		start()
+		start(
+			//! Factory for the work thread.
+			thread_factory_t & thread_factory )
 			{
-				m_thread = std::thread( [this]() { body(); } );
+				m_thread = thread_factory.start( [this]() { body(); } );
 			}
 
 	private :
 		//! Dispatcher's queue.
 		dispatcher_queue_t * m_disp_queue;
 
+		/*!
+		 * \brief Flag of finishing of the thread body.
+		 *
+		 * \since
+		 * v.5.5.17
+		 */
+		std::atomic< bool > m_finished = { false };
+
 		//! ID of thread.
 		/*!
 		 * Receives actual value inside body().
@@ -337,7 +618,10 @@ class work_thread_t
 		so_5::current_thread_id_t m_thread_id;
 
 		//! Actual thread.
-		std::thread m_thread;
+		/*!
+		 * \note Since v.5.5.17 it is created by a thread factory.
+		 */
+		thread_handle_unique_ptr_t m_thread;
 
 		//! Waiting object for long wait.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
@@ -354,6 +638,8 @@ class work_thread_t
 					{
 						do_queue_processing( agent_queue );
 					}
+
+				m_finished.store( true, std::memory_order_release );
 			}
 
 		/*!
@@ -396,14 +682,22 @@ class work_thread_t
 				std::size_t demands_processed = 0;
 				agent_queue_t::pop_result_t pop_result;
 
+				// Since v.5.5.17 demands are detached from the queue
+				// by batches. The queue's lock is acquired once per batch.
+				auto batch = queue.take_first_batch();
 				do
 					{
-						auto & d = queue.front();
+						for( auto d = batch.m_head; d; d = d->m_next )
+							{
+								d->call_handler( m_thread_id );
 
-						d.call_handler( m_thread_id );
+								// Message instance must be released when
+								// the queue's lock is not acquired.
+								d->m_message_ref.reset();
+							}
 
-						++demands_processed;
-						pop_result = queue.pop( demands_processed );
+						demands_processed += batch.m_size;
+						pop_result = queue.complete_batch( batch, demands_processed );
 					}
 				while( agent_queue_t::processing_continuation_t::enabled ==
 						pop_result.m_continuation );
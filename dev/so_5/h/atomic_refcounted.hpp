@@ -59,6 +59,19 @@ class SO_5_TYPE atomic_refcounted_t
 			++m_ref_counter;
 		}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Increments reference count by \a count at once.
+		 *
+		 * It is intended to be used with intrusive_ptr_t constructor
+		 * for already counted references.
+		 */
+		inline void
+		inc_ref_count( unsigned long count )
+		{
+			m_ref_counter += count;
+		}
+
 		//! Decrement reference count.
 		/*!
 		 * \return Value of reference counter *after* decrement.
@@ -74,6 +87,16 @@ class SO_5_TYPE atomic_refcounted_t
 		atomic_counter_t m_ref_counter;
 };
 
+//
+// already_counted_ref_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A type of indicator that the reference counter of an object
+ * is already incremented for a new intrusive_ptr_t.
+ */
+struct already_counted_ref_t {};
+
 //
 // intrusive_ptr_t
 //
@@ -110,6 +133,20 @@ class intrusive_ptr_t
 			ensure_right_T();
 			take_object();
 		}
+		/*!
+		 * \since v.5.5.17
+		 * \brief Constructor for a raw pointer which reference counter
+		 * is already incremented for that reference.
+		 *
+		 * Allows to create N references by only one atomic operation
+		 * (see atomic_refcounted_t::inc_ref_count(unsigned long)).
+		 */
+		intrusive_ptr_t( T * obj, already_counted_ref_t )
+			:	m_obj( obj )
+		{
+			ensure_right_T();
+		}
+
 		//! Copy constructor.
 		intrusive_ptr_t( const intrusive_ptr_t & o )
 			:	m_obj( o.m_obj )
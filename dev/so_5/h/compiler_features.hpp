@@ -32,6 +32,21 @@
 	// and move-operators.
 	#define SO_5_NO_DEFAULTS_FOR_MOVE_CONSTRUCTOR
 
+	// Visual C++ 2013 doesn't support thread_local keyword.
+	#if _MSC_VER < 1900
+		#define SO_5_NO_THREAD_LOCAL_KEYWORD
+	#endif
+
+#endif
+
+/*!
+ * \since v.5.5.17
+ * \brief A specifier for thread local storage for POD-like objects.
+ */
+#if defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+	#define SO_5_THREAD_LOCAL __declspec(thread)
+#else
+	#define SO_5_THREAD_LOCAL thread_local
 #endif
 
 #if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1900)) 
@@ -137,6 +137,19 @@ const int rc_disp_type_mismatch = 32;
  */
 const int rc_disp_cannot_be_added = 34;
 
+/*!
+ * \since v.5.5.17
+ * \brief Dispatcher has no timer manager.
+ */
+const int rc_disp_has_no_timer_manager = 35;
+
+/*!
+ * \since v.5.5.17
+ * \brief A dispatcher other than the default one cannot be used
+ * in single-threaded environment.
+ */
+const int rc_disp_not_allowed_in_single_threaded_env = 36;
+
 //! \}
 
 //! \name Error codes for event handlers and message interceptors registration.
@@ -192,6 +205,24 @@ const int rc_message_has_no_limit_defined = 48;
  */
 const int rc_several_limits_for_one_message_type = 49;
 
+/*!
+ * \since v.5.5.17
+ * \brief Invalid parameters of a rate-based message limit.
+ */
+const int rc_invalid_rate_limit = 50;
+
+/*!
+ * \since v.5.5.17
+ * \brief An attempt to deliver a mutable message via MPMC mbox.
+ */
+const int rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox = 51;
+
+/*!
+ * \since v.5.5.17
+ * \brief An attempt to handle an immutable message as a mutable one.
+ */
+const int rc_immutable_msg_cannot_be_handled_as_mutable = 52;
+
 //! \}
 
 //! \name Error codes for mboxes.
@@ -314,6 +345,16 @@ const int rc_priority_quote_illegal_value = 120;
 //! Message delivery tracing is disabled and cannot be used.
 const int rc_msg_tracing_disabled = 140;
 
+/*!
+ * \since v.5.5.17
+ * \brief An action requires an additional thread and cannot be done
+ * in single-threaded environment.
+ *
+ * For example: the run-time monitoring cannot be turned on or
+ * a custom timer thread cannot be used.
+ */
+const int rc_not_allowed_in_single_threaded_env = 141;
+
 //! \}
 
 //! \name Error codes for message chains.
@@ -340,6 +381,17 @@ const int rc_several_handlers_for_one_message_type = 165;
 
 //! \}
 
+//! \name Error codes for threads.
+//! \{
+
+/*!
+ * \since v.5.5.17
+ * \brief A new thread cannot be started by thread_factory.
+ */
+const int rc_unable_to_start_thread = 180;
+
+//! \}
+
 //! \name Common error codes.
 //! \{
 
@@ -14,6 +14,10 @@
 #include <thread>
 #include <cstdint>
 
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+	#include <intrin.h>
+#endif
+
 namespace so_5
 {
 
@@ -34,6 +38,35 @@ class yield_backoff_t
 			}
 	};
 
+//
+// pause_backoff_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A implementation of backoff object with usage of CPU pause
+ * instruction.
+ *
+ * Unlike yield_backoff_t it doesn't give control to OS. It is intended
+ * to be used in short busy waiting loops.
+ */
+class pause_backoff_t
+	{
+	public :
+		inline void
+		operator()()
+			{
+#if defined( _MSC_VER ) && ( defined( _M_IX86 ) || defined( _M_X64 ) )
+				_mm_pause();
+#elif defined( __i386__ ) || defined( __x86_64__ )
+				__builtin_ia32_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+				__asm__ __volatile__( "yield" );
+#else
+				std::atomic_signal_fence( std::memory_order_seq_cst );
+#endif
+			}
+	};
+
 //
 // spinlock_t
 //
@@ -181,6 +214,93 @@ class rw_spinlock_t
 
 typedef rw_spinlock_t< yield_backoff_t > default_rw_spinlock_t;
 
+//
+// null_rw_spinlock_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A lock with interface of rw_spinlock_t which does nothing.
+ *
+ * It is used by objects which are created for single-threaded
+ * SObjectizer Environment.
+ */
+class null_rw_spinlock_t
+	{
+	public :
+		inline void lock_shared() {}
+		inline void unlock_shared() {}
+		inline void lock() {}
+		inline void unlock() {}
+	};
+
+//
+// switchable_rw_lock_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A wrapper around multi-readers/single-writer lock which can be
+ * turned off.
+ *
+ * It is used by objects which type does not depend on the kind of
+ * SObjectizer Environment (agents, for example). Such objects turn the lock
+ * off at the construction time if they are created for single-threaded
+ * SObjectizer Environment.
+ *
+ * \attention turn_off() must be called before the first usage of the lock.
+ */
+template< class LOCK >
+class switchable_rw_lock_t
+	{
+	public :
+		switchable_rw_lock_t() = default;
+		switchable_rw_lock_t( const switchable_rw_lock_t & ) = delete;
+
+		switchable_rw_lock_t & operator=( const switchable_rw_lock_t & ) = delete;
+
+		//! Turn the lock off.
+		inline void
+		turn_off()
+			{
+				m_enabled = false;
+			}
+
+		//! Lock object in shared mode.
+		inline void
+		lock_shared()
+			{
+				if( m_enabled )
+					m_lock.lock_shared();
+			}
+
+		//! Unlock object locked in shared mode.
+		inline void
+		unlock_shared()
+			{
+				if( m_enabled )
+					m_lock.unlock_shared();
+			}
+
+		//! Lock object in exclusive mode.
+		inline void
+		lock()
+			{
+				if( m_enabled )
+					m_lock.lock();
+			}
+
+		//! Unlock object locked in exclusive mode.
+		inline void
+		unlock()
+			{
+				if( m_enabled )
+					m_lock.unlock();
+			}
+
+	private :
+		LOCK m_lock;
+		bool m_enabled = { true };
+	};
+
 //
 // read_lock_guard_t
 //
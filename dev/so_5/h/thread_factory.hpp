@@ -0,0 +1,257 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Tools for creation of threads for dispatchers and other
+ * parts of SObjectizer.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <so_5/h/declspec.hpp>
+
+namespace so_5
+{
+
+//
+// thread_handle_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An interface of a handle for a thread started by thread_factory.
+ *
+ * \attention Every started thread must be joined by join() method
+ * before the destruction of the handle.
+ */
+class SO_5_TYPE thread_handle_t
+	{
+		thread_handle_t( const thread_handle_t & ) = delete;
+		thread_handle_t &
+		operator=( const thread_handle_t & ) = delete;
+
+	public :
+		thread_handle_t();
+		virtual ~thread_handle_t();
+
+		//! Wait for the completion of the thread.
+		virtual void
+		join() = 0;
+	};
+
+//
+// thread_handle_unique_ptr_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An alias for unique_ptr to thread_handle.
+ */
+using thread_handle_unique_ptr_t = std::unique_ptr< thread_handle_t >;
+
+//
+// thread_body_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Type of function to be executed on a new thread.
+ */
+using thread_body_t = std::function< void() >;
+
+//
+// thread_factory_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An interface for creation of threads.
+ *
+ * All dispatchers, the final deregistration thread, the
+ * run-time monitoring distribution thread and the timer thread
+ * create their threads via an object of that type.
+ *
+ * A user can provide his own implementation (for example if threads
+ * must be created by some external library).
+ */
+class SO_5_TYPE thread_factory_t
+	{
+		thread_factory_t( const thread_factory_t & ) = delete;
+		thread_factory_t &
+		operator=( const thread_factory_t & ) = delete;
+
+	public :
+		thread_factory_t();
+		virtual ~thread_factory_t();
+
+		//! Start a new thread.
+		/*!
+		 * \throw so_5::exception_t if the thread cannot be started.
+		 */
+		virtual thread_handle_unique_ptr_t
+		start(
+			//! Function to be executed on the new thread.
+			thread_body_t body ) = 0;
+	};
+
+//
+// thread_factory_shptr_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An alias for shared_ptr to thread_factory.
+ */
+using thread_factory_shptr_t = std::shared_ptr< thread_factory_t >;
+
+//
+// affinity_mode_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief How a set of CPUs is applied to threads.
+ */
+enum class affinity_mode_t
+	{
+		//! Every thread can be run on every CPU from the set.
+		whole_set,
+		//! The N-th created thread is bound to the (N % cpus.size())-th
+		//! CPU from the set.
+		round_robin
+	};
+
+//
+// thread_params_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Parameters for the standard thread factory.
+ *
+ * \note Only platforms with pthreads support all of these parameters.
+ * On other platforms parameters are ignored and threads are created
+ * by std::thread.
+ *
+ * \par Usage sample
+	\code
+	so_5::launch( &init, []( so_5::environment_params_t & params ) {
+			params.thread_factory(
+				so_5::create_std_thread_factory(
+					so_5::thread_params_t{}
+						.name( "so5" )
+						.stack_size( 256 * 1024 )
+						.cpu_affinity( { 2, 3 }, so_5::affinity_mode_t::round_robin ) ) );
+		} );
+	\endcode
+ */
+class thread_params_t
+	{
+	public :
+		//! Set prefix for names of threads.
+		/*!
+		 * The name of a thread is constructed as prefix plus ordinal
+		 * number of the thread. The name is truncated to the length
+		 * allowed by the platform.
+		 *
+		 * Empty prefix means that names of threads are not changed.
+		 */
+		thread_params_t &
+		name( std::string v )
+			{
+				m_name = std::move(v);
+				return *this;
+			}
+
+		//! Get prefix for names of threads.
+		const std::string &
+		name() const
+			{
+				return m_name;
+			}
+
+		//! Set size of stack for threads.
+		/*!
+		 * Zero value means the default stack size for the platform.
+		 */
+		thread_params_t &
+		stack_size( std::size_t v )
+			{
+				m_stack_size = v;
+				return *this;
+			}
+
+		//! Get size of stack for threads.
+		std::size_t
+		stack_size() const
+			{
+				return m_stack_size;
+			}
+
+		//! Set CPU affinity for threads.
+		/*!
+		 * Empty set of CPUs means that CPU affinity is not changed.
+		 */
+		thread_params_t &
+		cpu_affinity(
+			std::vector< unsigned int > cpus,
+			affinity_mode_t mode = affinity_mode_t::whole_set )
+			{
+				m_cpus = std::move(cpus);
+				m_affinity_mode = mode;
+				return *this;
+			}
+
+		//! Get set of CPUs for threads.
+		const std::vector< unsigned int > &
+		cpus() const
+			{
+				return m_cpus;
+			}
+
+		//! Get the mode of applying set of CPUs to threads.
+		affinity_mode_t
+		affinity_mode() const
+			{
+				return m_affinity_mode;
+			}
+
+	private :
+		//! Prefix for names of threads.
+		std::string m_name;
+
+		//! Size of stack for threads.
+		std::size_t m_stack_size = 0;
+
+		//! CPUs for threads.
+		std::vector< unsigned int > m_cpus;
+
+		//! The mode of applying m_cpus to threads.
+		affinity_mode_t m_affinity_mode = affinity_mode_t::whole_set;
+	};
+
+//
+// create_std_thread_factory
+//
+/*!
+ * \since v.5.5.17
+ * \brief A factory for creating the standard thread_factory implementation.
+ */
+SO_5_FUNC thread_factory_shptr_t
+create_std_thread_factory(
+	//! Parameters for new threads.
+	thread_params_t params );
+
+/*!
+ * \since v.5.5.17
+ * \brief A factory for creating the standard thread_factory implementation
+ * which creates threads with default parameters.
+ */
+inline thread_factory_shptr_t
+create_std_thread_factory()
+	{
+		return create_std_thread_factory( thread_params_t{} );
+	}
+
+} /* namespace so_5 */
@@ -24,6 +24,8 @@
 namespace so_5
 {
 
+class thread_factory_t;
+
 #if defined( SO_5_MSVC )
 	#pragma warning(push)
 	#pragma warning(disable: 4251)
@@ -159,6 +161,18 @@ class SO_5_TYPE timer_thread_t
 		virtual void
 		start() = 0;
 
+		//! Launch timer with creation of its thread by thread factory.
+		/*!
+		 * \since v.5.5.17
+		 *
+		 * Default implementation simply calls start(). It is appropriate
+		 * for timers without dedicated threads.
+		 */
+		virtual void
+		start_with_factory(
+			//! Factory for creation of the timer thread.
+			thread_factory_t & factory );
+
 		//! Finish timer and wait for full stop.
 		virtual void
 		finish() = 0;
@@ -278,6 +292,28 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer thread.
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -364,6 +400,358 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for hierarchical timer_wheel thread with
+ * default parameters.
+ *
+ * This timer thread is intended for the cases where there are
+ * a lot of timers with very different pauses (from milliseconds to days).
+ * Activation and deactivation of timers are O(1) operations.
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_thread;
+		return f;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory(
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_thread;
+
+		using namespace std;
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, granularity );
+	}
+/*!
+ * \}
+ */
+
+//
+// timer_manager_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Timer manager interface.
+ *
+ * Unlike timer_thread_t a timer manager has no thread of its own.
+ * Elapsed timers are handled by a thread which calls
+ * process_expired_timers() (for example by a working thread of
+ * a dispatcher between processing of demands). Timer messages are
+ * delivered on the context of that thread. There is no hop to
+ * a separate timer thread.
+ *
+ * \note All methods are thread safe. But process_expired_timers() and
+ * timeout_before_nearest_timer() are intended to be called by just
+ * one thread which serves the manager.
+ */
+class SO_5_TYPE timer_manager_t
+	{
+		timer_manager_t( const timer_manager_t & ) = delete;
+		timer_manager_t &
+		operator=( const timer_manager_t & ) = delete;
+
+	public:
+		timer_manager_t();
+		virtual ~timer_manager_t();
+
+		//! Push delayed/periodic message to the timer queue.
+		/*!
+		 * A timer can be deactivated later by using returned timer_id.
+		 */
+		virtual timer_id_t
+		schedule(
+			//! Type of message to be sheduled.
+			const std::type_index & type_index,
+			//! Mbox for message delivery.
+			const mbox_t & mbox,
+			//! Message to be sent.
+			const message_ref_t & msg,
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period ) = 0;
+
+		//! Push anonymous delayed/periodic message to the timer queue.
+		/*!
+		 * A timer cannot be deactivated later.
+		 */
+		virtual void
+		schedule_anonymous(
+			//! Type of message to be sheduled.
+			const std::type_index & type_index,
+			//! Mbox for message delivery.
+			const mbox_t & mbox,
+			//! Message to be sent.
+			const message_ref_t & msg,
+			//! Pause before first message delivery.
+			std::chrono::steady_clock::duration pause,
+			//! Period for message repetition.
+			//! Zero value means single shot delivery.
+			std::chrono::steady_clock::duration period ) = 0;
+
+		//! Handle all elapsed timers.
+		/*!
+		 * Messages of elapsed timers are delivered on the context
+		 * of the caller.
+		 */
+		virtual void
+		process_expired_timers() = 0;
+
+		//! Get the time before the expiration of the nearest timer.
+		/*!
+		 * \return \a default_timeout if there is no timers.
+		 */
+		virtual std::chrono::steady_clock::duration
+		timeout_before_nearest_timer(
+			//! Value to be returned if there is no timers.
+			std::chrono::steady_clock::duration default_timeout ) = 0;
+
+		//! Get statistics for run-time monitoring.
+		virtual timer_thread_stats_t
+		query_stats() = 0;
+	};
+
+//! Auxiliary typedef for timer_manager autopointer.
+/*!
+ * \since v.5.5.17
+ */
+using timer_manager_unique_ptr_t = std::unique_ptr< timer_manager_t >;
+
+//
+// timer_manager_factory_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Type of factory for creating timer_manager objects.
+ */
+using timer_manager_factory_t = std::function<
+		timer_manager_unique_ptr_t( error_logger_shptr_t ) >;
+
+/*!
+ * \name Tools for creating timer managers.
+ * \{
+ */
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! Size of the wheel.
+	unsigned int wheel_size,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granuality );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on timer_heap mechanism.
+ * \note Default parameters will be used for timer manager.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_heap_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on timer_heap mechanism.
+ * \note Parameters must be specified explicitely.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_heap_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! Initical capacity of heap array.
+	std::size_t initial_heap_capacity );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on timer_list mechanism.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_list_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger );
+
+/*!
+ * \since v.5.5.17
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity );
+/*!
+ * \}
+ */
+
+/*!
+ * \name Standard timer manager factories.
+ * \{
+ */
+/*!
+ * \since v.5.5.17
+ * \brief Factory for timer_wheel manager with default parameters.
+ */
+inline timer_manager_factory_t
+timer_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_wheel_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_wheel_manager;
+		return f;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for timer_wheel manager with explicitely specified parameters.
+ */
+inline timer_manager_factory_t
+timer_wheel_manager_factory(
+	//! Size of the wheel.
+	unsigned int wheel_size,
+	//! A size of one time step for the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_wheel_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						unsigned int,
+						std::chrono::steady_clock::duration ) =
+				create_timer_wheel_manager;
+
+		using namespace std;
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, wheel_size, granularity );
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for timer_heap manager with default parameters.
+ */
+inline timer_manager_factory_t
+timer_heap_manager_factory()
+	{
+		// Use this trick because create_timer_heap_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_heap_manager;
+		return f;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for timer_heap manager with explicitely specified parameters.
+ */
+inline timer_manager_factory_t
+timer_heap_manager_factory(
+	//! Initial capacity of heap array.
+	std::size_t initial_heap_capacity )
+	{
+		// Use this trick because create_timer_heap_manager is overloaded.
+		timer_manager_unique_ptr_t (*f)( error_logger_shptr_t, std::size_t ) =
+				create_timer_heap_manager;
+
+		using namespace std;
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, initial_heap_capacity );
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for timer_list manager with default parameters.
+ */
+inline timer_manager_factory_t
+timer_list_manager_factory()
+	{
+		return &create_timer_list_manager;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for hierarchical timer_wheel manager with
+ * default parameters.
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_manager;
+		return f;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory(
+	//! A size of one time step for the wheels.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_manager;
+
+		using namespace std;
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, granularity );
+	}
 /*!
  * \}
  */
@@ -35,6 +35,24 @@ null_mbox_id()
 		return 0ull;
 	}
 
+/*!
+ * \since v.5.5.17
+ * \brief A type for integer identifier of message type.
+ *
+ * \see so_5::query_msg_type_id()
+ */
+typedef unsigned int msg_type_id_t;
+
+/*!
+ * \since v.5.5.17
+ * \brief Default value for null msg_type_id.
+ */
+inline msg_type_id_t
+null_msg_type_id()
+	{
+		return 0u;
+	}
+
 /*!
  * \since v.5.4.0
  * \brief Thread safety indicator.
@@ -22,6 +22,8 @@ MxxRu::Cpp::dll_target {
 
 	cpp_source 'error_logger.cpp'
 
+	cpp_source 'thread_factory.cpp'
+
 	cpp_source 'timers.cpp'
 
 	cpp_source 'msg_tracing.cpp'
@@ -36,6 +38,7 @@ MxxRu::Cpp::dll_target {
 		cpp_source 'message.cpp'
 
 		cpp_source 'message_limit.cpp'
+		cpp_source 'msg_type_id.cpp'
 
 		cpp_source 'mbox.cpp'
 		cpp_source 'mchain.cpp'
@@ -67,6 +70,7 @@ MxxRu::Cpp::dll_target {
 			cpp_source 'subscr_storage_map_based.cpp'
 			cpp_source 'subscr_storage_hash_table_based.cpp'
 			cpp_source 'subscr_storage_adaptive.cpp'
+			cpp_source 'subscr_storage_perfect_hash.cpp'
 
 			cpp_source 'process_unhandled_exception.cpp'
 
@@ -76,6 +80,8 @@ MxxRu::Cpp::dll_target {
 			cpp_source 'disp_repository.cpp'
 			cpp_source 'layer_core.cpp'
 			cpp_source 'state_listener_controller.cpp'
+			cpp_source 'st_env_infrastructure.cpp'
+			cpp_source 'hazard_ptr.cpp'
 		}
 
 		sources_root( 'stats' ) {
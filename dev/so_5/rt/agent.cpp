@@ -10,6 +10,7 @@
 
 #include <so_5/rt/impl/h/state_listener_controller.hpp>
 #include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+#include <so_5/rt/impl/h/resolved_handlers_cache.hpp>
 #include <so_5/rt/impl/h/process_unhandled_exception.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/delivery_filter_storage.hpp>
@@ -474,6 +475,7 @@ agent_t::agent_t(
 				ctx.options().giveout_message_limits() ) )
 	,	m_env( ctx.env() )
 	,	m_event_queue( nullptr )
+	,	m_bound_to_dispatcher( false )
 	,	m_direct_mbox(
 			impl::internal_env_iface_t{ ctx.env() }.create_mpsc_mbox(
 				self_ptr(),
@@ -484,6 +486,10 @@ agent_t::agent_t(
 	,	m_agent_coop( 0 )
 	,	m_priority( ctx.options().query_priority() )
 {
+	// There is no need to protect the event queue in
+	// single-threaded environment.
+	if( impl::internal_env_iface_t{ ctx.env() }.is_single_threaded() )
+		m_event_queue_lock.turn_off();
 }
 
 agent_t::~agent_t()
@@ -634,7 +640,7 @@ void
 agent_t::so_bind_to_dispatcher(
 	event_queue_t & queue )
 {
-	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	std::lock_guard< event_queue_lock_t > queue_lock{ m_event_queue_lock };
 
 	// Cooperation usage counter should be incremented.
 	// It will be decremented during final agent event execution.
@@ -650,6 +656,13 @@ agent_t::so_bind_to_dispatcher(
 							typeid(void),
 							message_ref_t(),
 							&agent_t::demand_handler_on_start ) );
+
+			// Events pushed before the binding must follow
+			// the starting demand (since v.5.5.17).
+			for( auto & d : m_demands_before_binding )
+				queue.push( std::move( d ) );
+			m_demands_before_binding.clear();
+			m_bound_to_dispatcher = true;
 			
 			// Only then pointer to the queue could be stored.
 			m_event_queue = &queue;
@@ -680,15 +693,32 @@ agent_t::so_create_execution_hint(
 								[handler](
 										execution_demand_t & demand,
 										current_thread_id_t thread_id ) {
+									message_limit::control_block_t::take_latest_message(
+											demand.m_limit,
+											demand.m_mbox_id,
+											demand.m_message_ref );
 									process_message(
 											thread_id,
 											demand,
 											handler->m_method );
 								},
 								handler->m_thread_safety );
-					else
+					else if( !d.m_limit || !d.m_limit->m_conflation )
 						// Handler not found.
 						return execution_hint_t::create_empty_execution_hint( d );
+					else
+						// Handler not found.
+						// But the latest message must be taken anyway
+						// because conflation is used.
+						return execution_hint_t(
+								d,
+								[]( execution_demand_t & demand, current_thread_id_t ) {
+									message_limit::control_block_t::take_latest_message(
+											demand.m_limit,
+											demand.m_mbox_id,
+											demand.m_message_ref );
+								},
+								thread_safe );
 				}
 			else
 				// There must be a special hint for service requests
@@ -750,7 +780,7 @@ agent_t::bind_to_coop( coop_t & coop )
 void
 agent_t::shutdown_agent() SO_5_NOEXCEPT
 {
-	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	std::lock_guard< event_queue_lock_t > queue_lock{ m_event_queue_lock };
 
 	// Since v.5.5.8 shutdown is done by two simple step:
 	// - remove actual value from m_event_queue;
@@ -809,6 +839,8 @@ agent_t::create_event_subscription(
 			target_state,
 			method,
 			thread_safety );
+
+	drop_resolved_handlers();
 }
 
 const message_limit::control_block_t *
@@ -844,6 +876,8 @@ agent_t::do_drop_subscription(
 	// working thread.
 
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
+
+	drop_resolved_handlers();
 }
 
 void
@@ -859,6 +893,8 @@ agent_t::do_drop_subscription_for_all_states(
 			"do_drop_subscription_for_all_states" );
 
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
+
+	drop_resolved_handlers();
 }
 
 void
@@ -868,17 +904,132 @@ agent_t::push_event(
 	std::type_index msg_type,
 	const message_ref_t & message )
 {
-	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	read_lock_guard_t< event_queue_lock_t > queue_lock{ m_event_queue_lock };
 
 	if( m_event_queue )
-		m_event_queue->push(
-				execution_demand_t(
+	{
+		const auto push = [&] {
+				m_event_queue->push(
+						execution_demand_t(
+							this,
+							limit,
+							mbox_id,
+							msg_type,
+							message,
+							&agent_t::demand_handler_on_message ) );
+			};
+
+		if( limit && limit->m_conflation )
+		{
+			// Since v.5.5.17 there can be only one demand for the message
+			// if conflation is used.
+			if( !limit->m_conflation->put( mbox_id, message ) )
+			{
+				// The message of the queued demand was replaced.
+				message_limit::control_block_t::decrement( limit );
+				return;
+			}
+
+			so_5::details::do_with_rollback_on_exception(
+					push,
+					[&] { limit->m_conflation->cancel( mbox_id, message ); } );
+		}
+		else
+			push();
+	}
+}
+
+void
+agent_t::push_event_batch(
+	mbox_id_t mbox_id,
+	std::type_index msg_type,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	// Demands are passed to the event queue by chunks
+	// prepared on the stack.
+	const std::size_t chunk_capacity = 64;
+	execution_demand_t chunk[ chunk_capacity ];
+
+	read_lock_guard_t< event_queue_lock_t > queue_lock{ m_event_queue_lock };
+
+	if( !m_event_queue )
+		return;
+
+	const auto msg_type_id = query_msg_type_id( msg_type );
+
+	while( count )
+	{
+		const auto n = count < chunk_capacity ? count : chunk_capacity;
+		for( std::size_t i = 0; i != n; ++i )
+			chunk[ i ] = execution_demand_t(
+					this,
+					nullptr,
+					mbox_id,
+					msg_type,
+					msg_type_id,
+					messages[ i ],
+					&agent_t::demand_handler_on_message );
+
+		m_event_queue->push_batch( chunk, n );
+
+		messages += n;
+		count -= n;
+	}
+}
+
+void
+agent_t::push_event_allowing_deferral(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	std::type_index msg_type,
+	const message_ref_t & message )
+{
+	{
+		std::lock_guard< event_queue_lock_t > queue_lock{ m_event_queue_lock };
+
+		if( !m_bound_to_dispatcher )
+		{
+			m_demands_before_binding.emplace_back(
 					this,
 					limit,
 					mbox_id,
 					msg_type,
 					message,
-					&agent_t::demand_handler_on_message ) );
+					&agent_t::demand_handler_on_message );
+			return;
+		}
+	}
+
+	push_event( limit, mbox_id, msg_type, message );
+}
+
+void
+agent_t::drop_demands_before_binding() SO_5_NOEXCEPT
+{
+	std::lock_guard< event_queue_lock_t > queue_lock{ m_event_queue_lock };
+
+	for( const auto & d : m_demands_before_binding )
+		message_limit::control_block_t::decrement( d.m_limit );
+	m_demands_before_binding.clear();
+}
+
+event_queue_t *
+agent_t::call_acquire_event_queue( agent_t & agent )
+{
+	agent.m_event_queue_lock.lock_shared();
+
+	if( agent.m_event_queue )
+		return agent.m_event_queue;
+
+	agent.m_event_queue_lock.unlock_shared();
+	return nullptr;
+}
+
+void
+agent_t::call_release_event_queue( agent_t & agent )
+{
+	agent.m_event_queue_lock.unlock_shared();
 }
 
 void
@@ -888,7 +1039,7 @@ agent_t::push_service_request(
 	std::type_index msg_type,
 	const message_ref_t & message )
 {
-	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	read_lock_guard_t< event_queue_lock_t > queue_lock{ m_event_queue_lock };
 
 	if( m_event_queue )
 		m_event_queue->push(
@@ -921,6 +1072,11 @@ agent_t::demand_handler_on_start(
 		impl::process_unhandled_exception(
 				working_thread_id, x, *(d.m_receiver) );
 	}
+
+	// Since v.5.5.17 subscription storage is informed that
+	// initial subscriptions are made.
+	d.m_receiver->m_subscriptions->freeze();
+	d.m_receiver->update_current_state_handlers( true );
 }
 
 void
@@ -980,6 +1136,8 @@ agent_t::demand_handler_on_message(
 	execution_demand_t & d )
 {
 	message_limit::control_block_t::decrement( d.m_limit );
+	message_limit::control_block_t::take_latest_message(
+			d.m_limit, d.m_mbox_id, d.m_message_ref );
 
 	auto handler = d.m_receiver->m_handler_finder(
 			d, "demand_handler_on_message" );
@@ -1151,13 +1309,19 @@ const impl::event_handler_data_t *
 agent_t::find_event_handler_for_current_state(
 	execution_demand_t & d )
 {
+	// Since v.5.5.17 handlers from parent states can be found
+	// by one lookup.
+	if( d.m_receiver->m_current_state_handlers )
+		return d.m_receiver->m_current_state_handlers->find(
+				d.m_mbox_id, d.m_msg_type_id );
+
 	const impl::event_handler_data_t * search_result = nullptr;
 	const state_t * s = &d.m_receiver->so_current_state();
 
 	do {
 		search_result = d.m_receiver->m_subscriptions->find_handler(
 				d.m_mbox_id,
-				d.m_msg_type, 
+				d.m_msg_type_id,
 				*s );
 
 		if( !search_result )
@@ -1216,6 +1380,48 @@ agent_t::do_state_switch(
 	// Now the current state for the agent can be changed.
 	m_current_state_ptr = &state_to_be_set;
 	m_current_state_ptr->update_history_in_parent_states();
+
+	update_current_state_handlers( false );
+}
+
+void
+agent_t::update_current_state_handlers(
+	bool build_immediately ) SO_5_NOEXCEPT
+{
+	m_current_state_handlers = nullptr;
+
+	// There is no need for a table if there is no parent state.
+	if( !m_current_state_ptr->parent_state() )
+		return;
+
+	// All exceptions are ignored because event handlers can be
+	// found without the table.
+	try
+	{
+		if( !m_resolved_handlers )
+			m_resolved_handlers.reset( new impl::resolved_handlers_cache_t() );
+
+		state_t::path_t path;
+		m_current_state_ptr->fill_path( path );
+		const auto level = m_current_state_ptr->nested_level();
+
+		m_current_state_handlers = build_immediately ?
+				m_resolved_handlers->query_table(
+						path, level, *m_subscriptions ) :
+				m_resolved_handlers->on_enter(
+						path, level, *m_subscriptions );
+	}
+	catch( ... )
+	{}
+}
+
+void
+agent_t::drop_resolved_handlers() SO_5_NOEXCEPT
+{
+	m_current_state_handlers = nullptr;
+
+	if( m_resolved_handlers )
+		m_resolved_handlers->invalidate();
 }
 
 void
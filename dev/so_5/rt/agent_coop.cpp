@@ -12,8 +12,10 @@
 #include <so_5/rt/impl/h/internal_env_iface.hpp>
 
 #include <so_5/rt/impl/h/agent_ptr_compare.hpp>
+#include <so_5/rt/impl/h/st_env_infrastructure.hpp>
 
 #include <so_5/details/h/abort_on_fatal_error.hpp>
+#include <so_5/details/h/rollback_on_exception.hpp>
 
 namespace so_5
 {
@@ -256,9 +258,19 @@ coop_t::do_registration_specific_actions(
 {
 	reorder_agents_with_respect_to_priorities();
 	bind_agents_to_coop();
-	define_all_agents();
 
-	bind_agents_to_disp();
+	// Events for retained messages can be stored by agents during
+	// the definition. They must be dropped if agents won't be bound
+	// to dispatchers.
+	so_5::details::do_with_rollback_on_exception(
+			[this] {
+				define_all_agents();
+				bind_agents_to_disp();
+			},
+			[this] {
+				for( auto & info : m_agent_array )
+					info.m_agent_ref->drop_demands_before_binding();
+			} );
 
 	m_parent_coop_ptr = parent_coop;
 	if( m_parent_coop_ptr )
@@ -331,6 +343,19 @@ coop_t::bind_agents_to_disp()
 	// bound to its dispatchers.
 	std::lock_guard< std::mutex > binding_lock{ m_binding_lock };
 
+	// Only the default dispatcher can be used in single-threaded
+	// environment. A binder to any other dispatcher would bind agents
+	// to an ordinary worker thread.
+	if( impl::internal_env_iface_t{ m_env }.is_single_threaded() )
+		for( const auto & info : m_agent_array )
+			if( !dynamic_cast< const impl::st_env::default_disp_binder_t * >(
+					info.m_binder.get() ) )
+				SO_5_THROW_EXCEPTION(
+						rc_disp_not_allowed_in_single_threaded_env,
+						"only the default dispatcher can be used in "
+						"single-threaded environment, cooperation: '" +
+						m_coop_name + "'" );
+
 	std::vector< disp_binding_activator_t > activators;
 	activators.reserve( m_agent_array.size() );
 
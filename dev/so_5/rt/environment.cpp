@@ -12,6 +12,9 @@
 #include <so_5/rt/impl/h/agent_core.hpp>
 #include <so_5/rt/impl/h/disp_repository.hpp>
 #include <so_5/rt/impl/h/layer_core.hpp>
+#include <so_5/rt/impl/h/st_env_infrastructure.hpp>
+
+#include <so_5/disp/one_thread/h/pub.hpp>
 
 #include <so_5/rt/stats/impl/h/std_controller.hpp>
 #include <so_5/rt/stats/impl/h/ds_mbox_core_stats.hpp>
@@ -32,6 +35,9 @@ environment_params_t::environment_params_t()
 	,	m_exception_reaction( abort_on_exception )
 	,	m_autoshutdown_disabled( false )
 	,	m_error_logger( create_stderr_logger() )
+	,	m_thread_factory( create_std_thread_factory() )
+	,	m_infrastructure( env_infrastructure_t::multi_threaded )
+	,	m_local_mbox_subscribers( local_mbox_subscribers_t::rw_locked )
 {
 }
 
@@ -45,7 +51,11 @@ environment_params_t::environment_params_t(
 	,	m_exception_reaction( other.m_exception_reaction )
 	,	m_autoshutdown_disabled( other.m_autoshutdown_disabled )
 	,	m_error_logger( std::move( other.m_error_logger ) )
+	,	m_thread_factory( std::move( other.m_thread_factory ) )
 	,	m_message_delivery_tracer( std::move( other.m_message_delivery_tracer ) )
+	,	m_default_disp_params( std::move( other.m_default_disp_params ) )
+	,	m_infrastructure( other.m_infrastructure )
+	,	m_local_mbox_subscribers( other.m_local_mbox_subscribers )
 {}
 
 environment_params_t::~environment_params_t()
@@ -74,7 +84,12 @@ environment_params_t::swap( environment_params_t & other )
 	std::swap( m_autoshutdown_disabled, other.m_autoshutdown_disabled );
 
 	m_error_logger.swap( other.m_error_logger );
+	m_thread_factory.swap( other.m_thread_factory );
 	m_message_delivery_tracer.swap( other.m_message_delivery_tracer );
+
+	std::swap( m_default_disp_params, other.m_default_disp_params );
+	std::swap( m_infrastructure, other.m_infrastructure );
+	std::swap( m_local_mbox_subscribers, other.m_local_mbox_subscribers );
 }
 
 environment_params_t &
@@ -124,16 +139,69 @@ environment_params_t::add_layer(
 namespace 
 {
 
+/*!
+ * \since v.5.5.17
+ * \brief Helper function for creation of infrastructure for
+ * single-threaded environment.
+ *
+ * \return nullptr if environment is multi-threaded.
+ */
+std::unique_ptr< impl::st_env::infrastructure_t >
+create_st_infrastructure_if_necessary(
+	const error_logger_shptr_t & error_logger,
+	const environment_params_t & params )
+{
+	std::unique_ptr< impl::st_env::infrastructure_t > result;
+
+	if( env_infrastructure_t::single_threaded == params.infrastructure() )
+		result.reset( new impl::st_env::infrastructure_t(
+				create_timer_heap_manager( error_logger ) ) );
+
+	return result;
+}
+
+/*!
+ * \since v.5.5.17
+ * \brief Helper function for creation of the default dispatcher.
+ */
+dispatcher_unique_ptr_t
+create_default_dispatcher(
+	impl::st_env::infrastructure_t * st_infrastructure,
+	const so_5::disp::one_thread::disp_params_t & params )
+{
+	if( st_infrastructure )
+		return st_infrastructure->make_default_dispatcher();
+	else
+		return so_5::disp::one_thread::create_disp( params );
+}
+
 /*!
  * \since v.5.5.0
  * \brief Helper function for timer_thread creation.
+ *
+ * \note Since v.5.5.17 timers of single-threaded environment are
+ * handled by the infrastructure of that environment.
+ *
+ * \throw so_5::exception_t if \a user_factory is set for
+ * single-threaded environment.
  */
 timer_thread_unique_ptr_t
 create_appropriate_timer_thread(
 	error_logger_shptr_t error_logger,
-	const timer_thread_factory_t & user_factory )
+	const timer_thread_factory_t & user_factory,
+	impl::st_env::infrastructure_t * st_infrastructure )
 {
-	if( user_factory )
+	if( st_infrastructure )
+		{
+			if( user_factory )
+				SO_5_THROW_EXCEPTION(
+						rc_not_allowed_in_single_threaded_env,
+						"timer_thread factory cannot be used in "
+						"single-threaded environment" );
+
+			return st_infrastructure->make_timer_thread();
+		}
+	else if( user_factory )
 		return user_factory( std::move( error_logger ) );
 	else
 		return create_timer_heap_thread( std::move( error_logger ) );
@@ -185,6 +253,26 @@ struct environment_t::internals_t
 	 */
 	error_logger_shptr_t m_error_logger;
 
+	/*!
+	 * \since v.5.5.17
+	 * \brief Thread factory for this environment.
+	 *
+	 * \attention Must be created before and destroyed after all objects
+	 * which create threads.
+	 */
+	thread_factory_shptr_t m_thread_factory;
+
+	/*!
+	 * \since v.5.5.17
+	 * \brief Infrastructure for single-threaded environment.
+	 *
+	 * Is null for multi-threaded environment.
+	 *
+	 * \attention Must be created before and destroyed after the default
+	 * dispatcher and the timer thread.
+	 */
+	std::unique_ptr< impl::st_env::infrastructure_t > m_st_infrastructure;
+
 	/*!
 	 * \since v.5.5.9
 	 * \brief Tracer object for message delivery tracing.
@@ -250,31 +338,44 @@ struct environment_t::internals_t
 		environment_t & env,
 		environment_params_t && params )
 		:	m_error_logger( params.so5__error_logger() )
+		,	m_thread_factory( params.so5__thread_factory() )
+		,	m_st_infrastructure(
+				create_st_infrastructure_if_necessary( m_error_logger, params ) )
 		,	m_message_delivery_tracer{
 				params.so5__giveout_message_delivery_tracer() }
 		,	m_mbox_core(
-				new impl::mbox_core_t{ m_message_delivery_tracer.get() } )
+				new impl::mbox_core_t{
+						m_message_delivery_tracer.get(),
+						nullptr != m_st_infrastructure,
+						local_mbox_subscribers_t::copy_on_write ==
+								params.local_mbox_subscribers() } )
 		,	m_agent_core(
 				env,
-				params.so5__giveout_coop_listener() )
+				params.so5__giveout_coop_listener(),
+				nullptr == m_st_infrastructure )
 		,	m_dispatchers(
 				env,
 				params.so5__giveout_named_dispatcher_map(),
 				params.so5__giveout_event_exception_logger(),
-				params.default_disp_params() )
+				create_default_dispatcher(
+						m_st_infrastructure.get(),
+						params.default_disp_params() ) )
 		,	m_layer_core(
 				env,
 				params.so5__layers_map() )
 		,	m_timer_thread(
 				create_appropriate_timer_thread(
 						m_error_logger,
-						params.so5__giveout_timer_thread_factory() ) )
+						params.so5__giveout_timer_thread_factory(),
+						m_st_infrastructure.get() ) )
 		,	m_exception_reaction( params.exception_reaction() )
 		,	m_autoshutdown_disabled( params.autoshutdown_disabled() )
 		,	m_stats_controller(
 				// A special mbox for distributing monitoring information
 				// must be created and passed to stats_controller.
-				m_mbox_core->create_mbox() )
+				m_mbox_core->create_mbox(),
+				*m_thread_factory,
+				nullptr != m_st_infrastructure )
 		,	m_core_data_sources(
 				m_stats_controller,
 				*m_mbox_core,
@@ -317,6 +418,12 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( nonempty_name );
 }
 
+mbox_t
+environment_t::create_retained_msg_mbox()
+{
+	return m_impl->m_mbox_core->create_retained_msg_mbox();
+}
+
 mchain_t
 environment_t::create_mchain(
 	const mchain_params_t & params )
@@ -342,6 +449,12 @@ environment_t::add_dispatcher_if_not_exists(
 	const std::string & disp_name,
 	std::function< dispatcher_unique_ptr_t() > disp_factory )
 {
+	if( m_impl->m_st_infrastructure )
+		SO_5_THROW_EXCEPTION(
+				rc_disp_not_allowed_in_single_threaded_env,
+				"dispatcher '" + disp_name + "' cannot be added to "
+				"single-threaded environment" );
+
 	return m_impl->m_dispatchers.add_dispatcher_if_not_exists(
 			disp_name,
 			disp_factory );
@@ -479,8 +592,18 @@ environment_t::run()
 void
 environment_t::stop()
 {
-	// Sends shutdown signal for all agents.
-	m_impl->m_agent_core.start_deregistration();
+	// The environment can be destroyed by another thread as soon as
+	// the deregistration is started. So nothing can be touched after that.
+	auto st = m_impl->m_st_infrastructure.get();
+	if( st )
+		// Working thread of single-threaded environment can sleep.
+		st->stop( [this] {
+				// Sends shutdown signal for all agents.
+				m_impl->m_agent_core.start_deregistration();
+			} );
+	else
+		// Sends shutdown signal for all agents.
+		m_impl->m_agent_core.start_deregistration();
 }
 
 void
@@ -503,6 +626,12 @@ environment_t::error_logger() const
 	return *(m_impl->m_error_logger);
 }
 
+so_5::thread_factory_t &
+environment_t::thread_factory() const
+{
+	return *(m_impl->m_thread_factory);
+}
+
 stats::controller_t &
 environment_t::stats_controller()
 {
@@ -552,7 +681,10 @@ environment_t::impl__run_timer_and_go_further()
 {
 	impl__do_run_stage(
 			"run_timer",
-			[this] { m_impl->m_timer_thread->start(); },
+			[this] {
+				m_impl->m_timer_thread->start_with_factory(
+						*(m_impl->m_thread_factory) );
+			},
 			[this] { m_impl->m_timer_thread->finish(); },
 			[this] { impl__run_agent_core_and_go_further(); } );
 }
@@ -563,7 +695,21 @@ environment_t::impl__run_agent_core_and_go_further()
 	impl__do_run_stage(
 			"run_agent_core",
 			[this] { m_impl->m_agent_core.start(); },
-			[this] { m_impl->m_agent_core.finish(); },
+			[this] {
+				// Deregistration of cooperations in single-threaded
+				// environment must be completed on this thread.
+				auto st = m_impl->m_st_infrastructure.get();
+				if( st )
+				{
+					auto & agent_core = m_impl->m_agent_core;
+					agent_core.deregister_all_coop();
+					st->run_until( [&agent_core] {
+							return agent_core.is_all_coop_deregistered();
+						} );
+				}
+
+				m_impl->m_agent_core.finish();
+			},
 			[this] { impl__run_user_supplied_init_and_wait_for_stop(); } );
 }
 
@@ -631,15 +777,32 @@ environment_t::impl__run_user_supplied_init_and_wait_for_stop()
 					*this,
 					m_impl->m_autoshutdown_disabled );
 
-			m_impl->m_agent_core.wait_for_start_deregistration();
+			impl__wait_for_stop();
 		},
 		[this]
 		{
 			stop();
-			m_impl->m_agent_core.wait_for_start_deregistration();
+			impl__wait_for_stop();
 		} );
 }
 
+void
+environment_t::impl__wait_for_stop()
+{
+	auto st = m_impl->m_st_infrastructure.get();
+	if( st )
+	{
+		// All events and timers must be handled on this thread
+		// until the environment will be stopped.
+		auto & agent_core = m_impl->m_agent_core;
+		st->run_until( [&agent_core] {
+				return agent_core.is_deregistration_started();
+			} );
+	}
+	else
+		m_impl->m_agent_core.wait_for_start_deregistration();
+}
+
 void
 environment_t::impl__do_run_stage(
 	const std::string & stage_name,
@@ -711,7 +874,11 @@ void
 internal_env_iface_t::ready_to_deregister_notify(
 	coop_t * coop )
 {
-	m_env.m_impl->m_agent_core.ready_to_deregister_notify( coop );
+	auto st = m_env.m_impl->m_st_infrastructure.get();
+	if( st )
+		st->ready_to_deregister_notify( coop );
+	else
+		m_env.m_impl->m_agent_core.ready_to_deregister_notify( coop );
 }
 
 void
@@ -731,6 +898,12 @@ internal_env_iface_t::is_msg_tracing_enabled() const
 	return nullptr != m_env.m_impl->m_message_delivery_tracer.get();
 }
 
+bool
+internal_env_iface_t::is_single_threaded() const
+{
+	return nullptr != m_env.m_impl->m_st_infrastructure.get();
+}
+
 so_5::msg_tracing::tracer_t &
 internal_env_iface_t::msg_tracer() const
 {
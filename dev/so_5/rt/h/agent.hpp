@@ -632,6 +632,12 @@ class SO_5_TYPE agent_t
 		 */
 		template< typename T >
 		using mhood_t = so_5::mhood_t< T >;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Short alias for %so_5::mutable_mhood_t.
+		 */
+		template< typename T >
+		using mutable_mhood_t = so_5::mutable_mhood_t< T >;
 		/*!
 		 * \since v.5.5.15
 		 * \brief Short alias for %so_5::initial_substate_of.
@@ -935,6 +941,76 @@ class SO_5_TYPE agent_t
 			agent.push_event( limit, mbox_id, msg_type, message );
 		}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Push an event to the agent's event queue even if
+		 * the agent is not bound to a dispatcher yet.
+		 *
+		 * If the agent is not bound to a dispatcher yet then the event
+		 * is stored inside the agent and will be pushed to the event queue
+		 * right after the start event.
+		 *
+		 * It is used for delivery of retained messages to agents
+		 * which make subscriptions in so_define_agent().
+		 */
+		static inline void
+		call_push_event_allowing_deferral(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t & message )
+		{
+			agent.push_event_allowing_deferral(
+					limit, mbox_id, msg_type, message );
+		}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Push several events to the agent's event queue at once.
+		 *
+		 * \attention This method must be used only for subscriptions
+		 * without message limits.
+		 */
+		static inline void
+		call_push_event_batch(
+			agent_t & agent,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t * messages,
+			std::size_t count )
+		{
+			agent.push_event_batch( mbox_id, msg_type, messages, count );
+		}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Acquire the agent's event queue for direct pushing
+		 * of event demands.
+		 *
+		 * It allows a mbox to group demands for several agents with
+		 * the same event queue and push them by one call to
+		 * event_queue_t::push_batch().
+		 *
+		 * The event queue lock is acquired in read mode. It must be
+		 * released by call_release_event_queue() if the return value
+		 * is not nullptr.
+		 *
+		 * \retval nullptr if the agent has no event queue (it is not
+		 * bound to a dispatcher yet or is already shut down). The lock
+		 * is not held in that case.
+		 */
+		static event_queue_t *
+		call_acquire_event_queue( agent_t & agent );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Release the agent's event queue acquired by
+		 * call_acquire_event_queue().
+		 */
+		static void
+		call_release_event_queue( agent_t & agent );
+
 		/*!
 		 * \since v.5.3.0
 		 * \brief Push service request to the agent's event queue.
@@ -1782,6 +1858,24 @@ class SO_5_TYPE agent_t
 		 */
 		impl::subscription_storage_unique_ptr_t m_subscriptions;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Tables of event handlers for states with parent states.
+		 *
+		 * Is created when the agent enters a state with a parent state.
+		 */
+		std::unique_ptr< impl::resolved_handlers_cache_t > m_resolved_handlers;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Table of event handlers for the current state.
+		 *
+		 * It contains handlers inherited from parent states.
+		 * Value nullptr means that event handler must be searched by walking
+		 * through the current state and all its parents.
+		 */
+		const impl::resolved_handlers_table_t * m_current_state_handlers = nullptr;
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief Run-time information for message limits.
@@ -1800,6 +1894,13 @@ class SO_5_TYPE agent_t
 		//! SObjectizer Environment for which the agent is belong.
 		environment_t & m_env;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of lock for protection of m_event_queue.
+		 */
+		using event_queue_lock_t =
+				switchable_rw_lock_t< default_rw_spinlock_t >;
+
 		/*!
 		 * \since v.5.5.8
 		 * \brief Event queue operation protector.
@@ -1819,8 +1920,11 @@ class SO_5_TYPE agent_t
 		 * acquires it in write-mode. It means that shutdown_agent() cannot
 		 * get access to m_event_queue until there is working
 		 * push_event()/push_service_request().
+		 *
+		 * \note Since v.5.5.17 this lock is turned off in the constructor
+		 * if the agent is created for single-threaded environment.
 		 */
-		default_rw_spinlock_t	m_event_queue_lock;
+		event_queue_lock_t m_event_queue_lock;
 
 		/*!
 		 * \since v.5.5.8
@@ -1836,6 +1940,24 @@ class SO_5_TYPE agent_t
 		 */
 		event_queue_t * m_event_queue;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Events pushed before the binding to a dispatcher.
+		 *
+		 * \attention Access to this value must be done only
+		 * under acquired m_event_queue_lock.
+		 */
+		std::vector< execution_demand_t > m_demands_before_binding;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has the agent been bound to a dispatcher?
+		 *
+		 * \attention Access to this value must be done only
+		 * under acquired m_event_queue_lock.
+		 */
+		bool m_bound_to_dispatcher;
+
 		/*!
 		 * \since v.5.4.0
 		 * \brief A direct mbox for the agent.
@@ -1981,6 +2103,51 @@ class SO_5_TYPE agent_t
 			//! Event message.
 			const message_ref_t & message );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Push several events into the event queue.
+		 *
+		 * The event queue lock is acquired only once and demands are
+		 * passed to the dispatcher by event_queue_t::push_batch().
+		 */
+		void
+		push_event_batch(
+			//! ID of mbox for these events.
+			mbox_id_t mbox_id,
+			//! Message type for events.
+			std::type_index msg_type,
+			//! Pointer to the first event message.
+			const message_ref_t * messages,
+			//! Count of event messages.
+			std::size_t count );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Push event into the event queue or store it until
+		 * the binding to a dispatcher.
+		 */
+		void
+		push_event_allowing_deferral(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for this event.
+			mbox_id_t mbox_id,
+			//! Message type for event.
+			std::type_index msg_type,
+			//! Event message.
+			const message_ref_t & message );
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Drop events stored by push_event_allowing_deferral().
+		 *
+		 * It is called if the registration of agent's cooperation fails
+		 * before the binding to a dispatcher. Counters of message limits
+		 * are decremented for the dropped events.
+		 */
+		void
+		drop_demands_before_binding() SO_5_NOEXCEPT;
+
 		/*!
 		 * \since v.5.3.0
 		 * \brief Push service request to event queue.
@@ -2171,6 +2338,28 @@ class SO_5_TYPE agent_t
 		find_event_handler_for_current_state(
 			execution_demand_t & demand );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Select the table of event handlers for the current state.
+		 *
+		 * If \a build_immediately is false then the table will be built
+		 * only after several entries to the current state.
+		 *
+		 * \note The table is just an optimization. If it can't be built then
+		 * event handlers will be searched by walking through parent states.
+		 */
+		void
+		update_current_state_handlers( bool build_immediately ) SO_5_NOEXCEPT;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Destroy all tables of event handlers.
+		 *
+		 * Must be called after every change of subscriptions.
+		 */
+		void
+		drop_resolved_handlers() SO_5_NOEXCEPT;
+
 		/*!
 		 * \since v.5.5.15
 		 * \brief Actual action for switching agent state.
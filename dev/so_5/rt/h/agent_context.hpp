@@ -193,6 +193,36 @@ operator+(
 		return ctx;
 	};
 
+template< class M >
+agent_context_t
+operator+(
+	agent_context_t ctx,
+	message_limit::rate_drop_indicator_t< M > limit )
+	{
+		ctx.options().message_limits( limit );
+		return ctx;
+	};
+
+template< class M, class L >
+agent_context_t
+operator+(
+	agent_context_t ctx,
+	message_limit::rate_redirect_indicator_t< M, L > limit )
+	{
+		ctx.options().message_limits( std::move( limit ) );
+		return ctx;
+	};
+
+template< class M >
+agent_context_t
+operator+(
+	agent_context_t ctx,
+	message_limit::conflate_indicator_t< M > limit )
+	{
+		ctx.options().message_limits( std::move( limit ) );
+		return ctx;
+	};
+
 inline agent_context_t
 operator+(
 	agent_context_t ctx,
@@ -18,6 +18,7 @@
 #include <so_5/h/declspec.hpp>
 #include <so_5/h/exception.hpp>
 #include <so_5/h/error_logger.hpp>
+#include <so_5/h/thread_factory.hpp>
 #include <so_5/h/compiler_features.hpp>
 #include <so_5/h/msg_tracing.hpp>
 
@@ -60,6 +61,46 @@ struct autoname_indicator_t {};
 inline autoname_indicator_t
 autoname() { return autoname_indicator_t(); }
 
+//
+// env_infrastructure_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Type of infrastructure for SObjectizer Environment.
+ *
+ * \see environment_params_t::infrastructure()
+ */
+enum class env_infrastructure_t
+	{
+		//! The default dispatcher, the timer and the final deregistration
+		//! of cooperations work on their own threads.
+		multi_threaded,
+		//! Agents bound to the default dispatcher, timers and the final
+		//! deregistration of cooperations are served on the thread where
+		//! environment_t::run() is called. Mboxes and event queues of agents
+		//! do not use locks.
+		single_threaded
+	};
+
+//
+// local_mbox_subscribers_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Type of storage for subscribers of local mboxes.
+ *
+ * \see environment_params_t::local_mbox_subscribers()
+ */
+enum class local_mbox_subscribers_t
+	{
+		//! Subscribers are protected by a rw-spinlock. Every delivery
+		//! acquires the lock in shared mode.
+		rw_locked,
+		//! Delivery uses an immutable snapshot of subscribers and does not
+		//! acquire any lock. Every subscription change makes a new snapshot.
+		copy_on_write
+	};
+
 //
 // environment_params_t
 //
@@ -120,6 +161,11 @@ class SO_5_TYPE environment_params_t
 		/*!
 		 * If \a factory is a null then the default timer thread
 		 * will be used.
+		 *
+		 * \attention A factory cannot be set for single-threaded
+		 * environment (see infrastructure()). An exception with
+		 * rc_not_allowed_in_single_threaded_env will be thrown by
+		 * the environment's constructor.
 		 */
 		environment_params_t &
 		timer_thread(
@@ -248,6 +294,31 @@ class SO_5_TYPE environment_params_t
 			return *this;
 		}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Set thread factory for the environment.
+		 *
+		 * This factory is used by dispatchers which have no factory
+		 * in their own parameters and by internal threads of
+		 * the environment.
+		 *
+		 * \par Usage example:
+			\code
+			so_5::launch( []( so_5::environment_t & env ) { ... },
+				[]( so_5::environment_params_t & env_params ) {
+					env_params.thread_factory( so_5::create_std_thread_factory(
+						so_5::thread_params_t{}.name( "so5-" ).stack_size( 512 * 1024 ) ) );
+				} );
+			\endcode
+		 */
+		environment_params_t &
+		thread_factory( thread_factory_shptr_t factory )
+		{
+			if( factory )
+				m_thread_factory = std::move( factory );
+			return *this;
+		}
+
 		/*!
 		 * \since v.5.5.9
 		 * \brief Set message delivery tracer for the environment.
@@ -293,6 +364,96 @@ class SO_5_TYPE environment_params_t
 			return m_default_disp_params;
 		}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Set the type of infrastructure for the environment.
+		 *
+		 * By default the multi-threaded infrastructure is used.
+		 *
+		 * If env_infrastructure_t::single_threaded is used then there is
+		 * no working thread for the default dispatcher and no timer thread.
+		 * All events of agents bound to the default dispatcher and all
+		 * timers are handled on the thread where so_5::launch() is called.
+		 * Mboxes and event queues of agents do not use locks in that case.
+		 *
+		 * \attention In single-threaded environment all agents must be bound
+		 * to the default dispatcher. Messages must not be sent from other
+		 * threads. The only thing which can be done from another thread is
+		 * a call to environment_t::stop(). Timers are created by
+		 * so_5::timer_heap_manager_factory(), an exception is thrown if
+		 * a factory is set by timer_thread(). An exception is also thrown
+		 * on an attempt to turn the run-time monitoring on.
+		 *
+		 * \par Usage example:
+			\code
+			so_5::launch( []( so_5::environment_t & env ) { ... },
+				[]( so_5::environment_params_t & env_params ) {
+					env_params.infrastructure(
+							so_5::env_infrastructure_t::single_threaded );
+				} );
+			\endcode
+		 */
+		environment_params_t &
+		infrastructure( env_infrastructure_t type )
+		{
+			m_infrastructure = type;
+			return *this;
+		}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the type of infrastructure for the environment.
+		 */
+		env_infrastructure_t
+		infrastructure() const
+		{
+			return m_infrastructure;
+		}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Set the type of storage for subscribers of local mboxes.
+		 *
+		 * By default local_mbox_subscribers_t::rw_locked is used.
+		 *
+		 * The local_mbox_subscribers_t::copy_on_write can be used if
+		 * messages are sent to the same mbox from many threads at the same
+		 * time and subscriptions are changed rarely. Delivery of a message
+		 * does not modify any data shared between threads in that case.
+		 * But every subscription and unsubscription copies the whole list
+		 * of subscribers of the mbox and waits while current deliveries
+		 * which use the old list are finished.
+		 *
+		 * \note This value is ignored in single-threaded environment.
+		 * It is also ignored if the compiler doesn't support thread_local
+		 * keyword.
+		 *
+		 * \par Usage example:
+			\code
+			so_5::launch( []( so_5::environment_t & env ) { ... },
+				[]( so_5::environment_params_t & env_params ) {
+					env_params.local_mbox_subscribers(
+							so_5::local_mbox_subscribers_t::copy_on_write );
+				} );
+			\endcode
+		 */
+		environment_params_t &
+		local_mbox_subscribers( local_mbox_subscribers_t type )
+		{
+			m_local_mbox_subscribers = type;
+			return *this;
+		}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the type of storage for subscribers of local mboxes.
+		 */
+		local_mbox_subscribers_t
+		local_mbox_subscribers() const
+		{
+			return m_local_mbox_subscribers;
+		}
+
 
 		/*!
 		 * \name Methods for internal use only.
@@ -340,6 +501,16 @@ class SO_5_TYPE environment_params_t
 			return m_error_logger;
 		}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get thread factory for the environment.
+		 */
+		const thread_factory_shptr_t &
+		so5__thread_factory() const
+		{
+			return m_thread_factory;
+		}
+
 		/*!
 		 * \since v.5.5.9
 		 * \brief Get message delivery tracer for the environment.
@@ -402,6 +573,12 @@ class SO_5_TYPE environment_params_t
 		 */
 		error_logger_shptr_t m_error_logger;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Thread factory for the environment.
+		 */
+		thread_factory_shptr_t m_thread_factory;
+
 		/*!
 		 * \since v.5.5.9
 		 * \brief Tracer for message delivery.
@@ -413,6 +590,18 @@ class SO_5_TYPE environment_params_t
 		 * \brief Parameters for the default dispatcher.
 		 */
 		so_5::disp::one_thread::disp_params_t m_default_disp_params;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of infrastructure for the environment.
+		 */
+		env_infrastructure_t m_infrastructure;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of storage for subscribers of local mboxes.
+		 */
+		local_mbox_subscribers_t m_local_mbox_subscribers;
 };
 
 //
@@ -559,6 +748,41 @@ class SO_5_TYPE environment_t
 			//! Mbox name.
 			const nonempty_name_t & mbox_name );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Create an anonymous mbox which retains the last message
+		 * of every type.
+		 *
+		 * The last message (or signal) of every type sent to the mbox
+		 * is stored inside the mbox. It is delivered to a new subscriber
+		 * immediately after the subscription. If the subscription is made
+		 * in so_define_agent() the message is handled right after
+		 * so_evt_start().
+		 *
+		 * \par Usage example:
+			\code
+			class a_late_subscriber_t : public so_5::agent_t
+			{
+			public :
+				a_late_subscriber_t( context_t ctx, so_5::mbox_t config_mbox )
+					:	so_5::agent_t( ctx )
+					{
+						// The current config will be received even if
+						// it was sent before the creation of the agent.
+						so_subscribe( config_mbox ).event( &a_late_subscriber_t::evt_config );
+					}
+				...
+			};
+			...
+			auto config_mbox = env.create_retained_msg_mbox();
+			so_5::send< current_config >( config_mbox, ... );
+			\endcode
+		 *
+		 * \note Service requests are not retained.
+		 */
+		mbox_t
+		create_retained_msg_mbox();
+
 		/*!
 		 * \deprecated Will be removed in v.5.6.0. Use create_mbox() instead.
 		 */
@@ -1333,6 +1557,16 @@ class SO_5_TYPE environment_t
 		error_logger_t &
 		error_logger() const;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the thread factory object.
+		 *
+		 * This factory is used by dispatchers which have no factory
+		 * in their own parameters.
+		 */
+		so_5::thread_factory_t &
+		thread_factory() const;
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief Helper method for simplification of agents creation.
@@ -1520,6 +1754,16 @@ class SO_5_TYPE environment_t
 		void
 		impl__run_user_supplied_init_and_wait_for_stop();
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Wait for start of deregistration procedure.
+		 *
+		 * Events and timers are handled on the current thread
+		 * during waiting if environment is single-threaded.
+		 */
+		void
+		impl__wait_for_stop();
+
 		/*!
 		 * \brief Templated implementation of one run stage.
 		 */
@@ -209,6 +209,73 @@ public :
 template< typename M >
 class mhood_t< user_type_message_t< M > >;
 
+/*!
+ * \since v.5.5.17
+ * \brief A mutable message wrapped to be used as type of argument for
+ * event handlers.
+ *
+ * A mutable message is sent by so_5::send_mutable() and has the only
+ * receiver. Because of that the receiver can modify the message and
+ * forward the same message object further without copying.
+ *
+ * \tparam M type of message. Must be derived from so_5::message_t.
+ * Signals can't be mutable.
+ *
+ * \note An attempt to handle an immutable message by an event handler
+ * with %mutable_mhood_t argument leads to an exception.
+ *
+ * \par Usage example:
+	\code
+	class pipeline_stage : public so_5::agent_t
+	{
+		...
+		void on_snapshot( mutable_mhood_t< order_book_snapshot > cmd ) {
+			// The message can be modified...
+			cmd->m_stage_results.push_back( ... );
+			// ...and forwarded to the next stage without a copy.
+			m_next_stage->deliver_message( cmd.make_reference() );
+		}
+	};
+	\endcode
+ */
+template< typename M >
+class mutable_mhood_t
+{
+public :
+	using payload_type = typename message_payload_type< M >::payload_type;
+	using envelope_type = typename message_payload_type< M >::envelope_type;
+
+	mutable_mhood_t( message_ref_t & mf )
+		: m_msg{ message_payload_type< M >::extract_payload_ptr( mf ) }
+		{
+			if( message_mutability_t::mutable_message !=
+					m_msg->so5_message_mutability() )
+				SO_5_THROW_EXCEPTION(
+						rc_immutable_msg_cannot_be_handled_as_mutable,
+						std::string( "an attempt to handle immutable message "
+								"as mutable one, msg_type=" ) + typeid(M).name() );
+		}
+
+	//! Access to the message.
+	payload_type *
+	get() const { return m_msg; }
+
+	//! Create a smart pointer for the message envelope.
+	intrusive_ptr_t< envelope_type >
+	make_reference() const { return intrusive_ptr_t< envelope_type >{m_msg}; }
+
+	//! Access to the message.
+	payload_type &
+	operator * () const { return *get(); }
+
+	//! Access to the message via pointer.
+	payload_type *
+	operator->() const { return get(); }
+
+private :
+	M * m_msg;
+};
+
 /*!
  * \brief An alias for compatibility with previous versions.
  * \deprecated Will be removed in v.5.6.0.
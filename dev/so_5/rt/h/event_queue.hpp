@@ -27,6 +27,24 @@ class SO_5_TYPE event_queue_t
 		//! Enqueue new event to the queue.
 		virtual void
 		push( execution_demand_t demand ) = 0;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Enqueue several events to the queue at once.
+		 *
+		 * Demands are moved out of the \a demands array.
+		 *
+		 * Default implementation calls push() for every demand.
+		 * Queues of dispatchers redefine this method to do all
+		 * the work under one lock and with at most one notification
+		 * of a working thread.
+		 */
+		virtual void
+		push_batch(
+			//! Pointer to the first demand.
+			execution_demand_t * demands,
+			//! Count of demands.
+			std::size_t count );
 	};
 
 namespace rt
@@ -13,9 +13,12 @@
 #include <so_5/h/types.hpp>
 #include <so_5/h/current_thread_id.hpp>
 
+#include <so_5/details/h/small_function.hpp>
+
 #include <so_5/rt/h/fwd.hpp>
 
 #include <so_5/rt/h/message.hpp>
+#include <so_5/rt/h/msg_type_id.hpp>
 
 namespace so_5
 {
@@ -26,8 +29,12 @@ namespace so_5
 /*!
  * \since v.5.3.0
  * \brief Type of event handler method.
+ *
+ * \note Since v.5.5.17 it is not std::function but a wrapper which
+ * stores small handlers (like handlers for agent's methods) without
+ * dynamic allocation.
  */
-typedef std::function< void(invocation_type_t, message_ref_t &) >
+typedef details::small_function_t< void(invocation_type_t, message_ref_t &) >
 		event_handler_method_t;
 
 struct execution_demand_t;
@@ -59,7 +66,16 @@ struct execution_demand_t
 	//! ID of mbox.
 	mbox_id_t m_mbox_id;
 	//! Type of the message.
+	/*!
+	 * \note Since v.5.5.17 it is used only for diagnostic purposes.
+	 * Handlers are searched by m_msg_type_id.
+	 */
 	std::type_index m_msg_type;
+	/*!
+	 * \since v.5.5.17
+	 * \brief Integer identifier of the message type.
+	 */
+	msg_type_id_t m_msg_type_id;
 	//! Event incident.
 	message_ref_t m_message_ref;
 	//! Demand handler.
@@ -71,6 +87,7 @@ struct execution_demand_t
 		,	m_limit( nullptr )
 		,	m_mbox_id( 0 )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_msg_type_id() )
 		,	m_demand_handler( nullptr )
 		{}
 
@@ -85,6 +102,29 @@ struct execution_demand_t
 		,	m_limit( limit )
 		,	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( query_msg_type_id( msg_type ) )
+		,	m_message_ref( std::move( message_ref ) )
+		,	m_demand_handler( demand_handler )
+		{}
+
+	/*!
+	 * \since v.5.5.17
+	 * \brief Initializing constructor for the case when identifier
+	 * of message type is already known.
+	 */
+	execution_demand_t(
+		agent_t * receiver,
+		const message_limit::control_block_t * limit,
+		mbox_id_t mbox_id,
+		std::type_index msg_type,
+		msg_type_id_t msg_type_id,
+		message_ref_t message_ref,
+		demand_handler_pfn_t demand_handler )
+		:	m_receiver( receiver )
+		,	m_limit( limit )
+		,	m_mbox_id( mbox_id )
+		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_message_ref( std::move( message_ref ) )
 		,	m_demand_handler( demand_handler )
 		{}
@@ -112,7 +152,10 @@ class execution_hint_t
 {
 public :
 	//! Type of function for calling event handler directly.
-	using direct_func_t = std::function<
+	/*!
+	 * \note Since v.5.5.17 it is not std::function.
+	 */
+	using direct_func_t = details::small_function_t<
 				void( execution_demand_t &, current_thread_id_t ) >;
 
 	//! Initializing constructor.
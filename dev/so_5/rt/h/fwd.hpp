@@ -24,6 +24,8 @@ class coop_private_iface_t;
 class internal_env_iface_t;
 class internal_message_iface_t;
 class layer_core_t;
+class resolved_handlers_cache_t;
+class resolved_handlers_table_t;
 
 } /* namespace impl */
 
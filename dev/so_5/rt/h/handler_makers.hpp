@@ -140,6 +140,31 @@ struct event_handler_arg_maker< mhood_t< MSG > >
 	}
 };
 
+/*!
+ * \brief A helper template for create an argument for event handler
+ * in the case when argument is passed as mutable message hood.
+ * \since
+ * v.5.5.17
+ */
+template< typename MSG >
+struct event_handler_arg_maker< mutable_mhood_t< MSG > >
+{
+	using type = MSG;
+
+	static void
+	ensure_appropriate_type()
+	{
+		ensure_classical_message< MSG >();
+		ensure_not_signal< MSG >();
+	}
+
+	static mutable_mhood_t< MSG >
+	make_arg( message_ref_t & mf )
+	{
+		return mutable_mhood_t< MSG >{ mf };
+	}
+};
+
 /*!
  * \brief A helper for setting a result to a promise.
  * \since
@@ -672,6 +672,25 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 				this->do_deliver_message( msg_type, message, 1 );
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers.
+		 *
+		 * \note This is a just a wrapper for do_deliver_message_batch.
+		 */
+		inline void
+		deliver_message_batch(
+			//! Type of the messages.
+			const std::type_index & msg_type,
+			//! Pointer to the first message instance.
+			const message_ref_t * messages,
+			//! Count of message instances.
+			std::size_t count ) const
+			{
+				this->do_deliver_message_batch( msg_type, messages, count, 1 );
+			}
+
 		/*!
 		 * \since v.5.3.0.
 		 * \brief Deliver service request.
@@ -749,6 +768,28 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int overlimit_reaction_deep ) const = 0;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers with respect to message limits.
+		 *
+		 * Messages must be delivered in the order of \a messages array.
+		 *
+		 * Default implementation calls do_deliver_message() for every
+		 * message. Mboxes can redefine this method to acquire their
+		 * locks once for the whole batch.
+		 */
+		virtual void
+		do_deliver_message_batch(
+			//! Type of the messages to deliver.
+			const std::type_index & msg_type,
+			//! Pointer to the first message instance.
+			const message_ref_t * messages,
+			//! Count of message instances.
+			std::size_t count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int overlimit_reaction_deep ) const;
+
 		/*!
 		 * \since v.5.5.4
 		 * \brief Deliver service request.
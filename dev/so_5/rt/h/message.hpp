@@ -12,18 +12,39 @@
 #include <so_5/h/declspec.hpp>
 #include <so_5/h/exception.hpp>
 #include <so_5/h/atomic_refcounted.hpp>
+#include <so_5/h/types.hpp>
 
 #include <so_5/rt/h/agent_ref_fwd.hpp>
 
+#include <so_5/details/h/message_pool.hpp>
+
 #include <type_traits>
 #include <typeindex>
 #include <functional>
 #include <future>
 #include <atomic>
+#include <chrono>
+#include <memory>
 
 namespace so_5
 {
 
+//
+// message_mutability_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A enumeration with possible mutabilities of a message.
+ */
+enum class message_mutability_t
+	{
+		//! Message can't be modified by a receiver.
+		immutable_message,
+		//! Message can be modified by the only receiver.
+		//! Such message can't be sent to MPMC mboxes.
+		mutable_message
+	};
+
 //
 // message_t
 //
@@ -48,7 +69,38 @@ class SO_5_TYPE message_t : public atomic_refcounted_t
 
 		virtual ~message_t();
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Get the mutability of the message.
+		 */
+		message_mutability_t
+		so5_message_mutability() const
+			{
+				return m_mutability;
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Change the mutability of the message.
+		 *
+		 * \note This method is intended to be used only by SObjectizer
+		 * itself. Use so_5::send_mutable() for sending mutable messages.
+		 */
+		void
+		so5_change_mutability( message_mutability_t mutability )
+			{
+				m_mutability = mutability;
+			}
+
 	private :
+		/*!
+		 * \since v.5.5.17
+		 * \brief The mutability of the message.
+		 *
+		 * A message is immutable by default.
+		 */
+		message_mutability_t m_mutability;
+
 		/*!
 		 * \since v.5.5.9
 		 * \brief Get the pointer to the message payload.
@@ -385,9 +437,97 @@ struct message_payload_type< user_type_message_t< T > >
 	{
 	};
 
+//
+// use_message_pool
+//
+/*!
+ * \since v.5.5.17
+ * \brief A trait for turning on a pool of message instances for type MSG.
+ *
+ * By default every message instance is allocated in the heap and is
+ * deallocated when the last reference to it is dropped. If this trait
+ * is specialized for MSG then instances of MSG created by so_5::send(),
+ * so_5::send_delayed() and so_5::send_periodic() are allocated from
+ * a pool. Memory of the message instance returns to the pool when the last
+ * reference to the message is dropped.
+ *
+ * The pool consists of thread local caches and a shared part. The shared
+ * part holds batches of free blocks released by threads which receive
+ * messages and gives them to threads which send messages.
+ *
+ * Usage example:
+ * \code
+	struct tick { std::uint64_t m_sequence; };
+
+	namespace so_5 {
+		template<>
+		struct use_message_pool< tick > { enum { value = true }; };
+	}
+ * \endcode
+ *
+ * \note Pools are not used if thread_local keyword is not supported
+ * by the compiler.
+ *
+ * \attention A message type derived from message_t must not be declared
+ * as final if a pool is used for it.
+ *
+ * \tparam MSG type of the message payload.
+ */
+template< typename MSG >
+struct use_message_pool
+	{
+		enum { value = false };
+	};
+
 namespace details
 {
 
+/*!
+ * \since v.5.5.17
+ * \brief Envelope for a message instance which is allocated from a pool.
+ *
+ * \tparam E type of usual envelope for the message.
+ */
+template< typename E >
+class pooled_message_t final : public E
+	{
+	public :
+		template< typename... ARGS >
+		pooled_message_t( ARGS &&... args )
+			:	E( std::forward< ARGS >(args)... )
+			{}
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+		static void *
+		operator new( std::size_t )
+			{
+				return message_pool::pool_t< pooled_message_t >::allocate();
+			}
+
+		static void
+		operator delete( void * p )
+			{
+				message_pool::pool_t< pooled_message_t >::deallocate( p );
+			}
+#endif
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Detection of actual type of a message instance to be created.
+ */
+template< typename MSG >
+struct message_instance_type
+	{
+		using E = typename message_payload_type< MSG >::envelope_type;
+
+		using type = typename std::conditional<
+				use_message_pool<
+						typename message_payload_type< MSG >::payload_type >::value,
+				pooled_message_t< E >,
+				E >::type;
+	};
+
 template< bool is_signal, typename MSG >
 struct make_message_instance_impl
 	{
@@ -399,7 +539,10 @@ struct make_message_instance_impl
 			{
 				ensure_not_signal< MSG >();
 
-				return std::unique_ptr< E >( new E( std::forward< ARGS >(args)... ) );
+				using instance_type = typename message_instance_type< MSG >::type;
+
+				return std::unique_ptr< E >(
+						new instance_type( std::forward< ARGS >(args)... ) );
 			}
 	};
 
@@ -621,6 +764,90 @@ struct overlimit_context_t
  */
 using action_t = std::function< void(const overlimit_context_t&) >;
 
+//
+// rate_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Parameters of a rate-based message limit.
+ */
+struct rate_t
+	{
+		//! Max count of messages per second.
+		/*!
+		 * Value 0 means that there is no rate limit.
+		 */
+		unsigned int m_per_second = 0;
+
+		//! Max count of messages which can be accepted at once.
+		unsigned int m_burst = 0;
+
+		//! Constructor for the case without rate limit.
+		rate_t() {}
+
+		//! Initializing constructor.
+		rate_t(
+			unsigned int per_second,
+			unsigned int burst )
+			:	m_per_second( per_second )
+			,	m_burst( burst )
+			{}
+	};
+
+//
+// conflation_storage_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An interface of storage for conflation of messages.
+ *
+ * If conflation is used for a message type then there can be only
+ * one demand in the event queue of the agent for every key of
+ * the message. A new message for the same key replaces the message
+ * of that demand. The handler receives only the latest message.
+ *
+ * \note All methods are called only for events, not for service requests.
+ */
+class conflation_storage_t
+	{
+	public :
+		virtual ~conflation_storage_t() {}
+
+		//! Remember a new message.
+		/*!
+		 * \retval true if there is no demand for the key of \a message
+		 * in the event queue and a new demand must be pushed.
+		 * \retval false if \a message replaced the message of already
+		 * queued demand.
+		 */
+		virtual bool
+		put(
+			mbox_id_t mbox_id,
+			const message_ref_t & message ) = 0;
+
+		//! Replace the message of the demand by the latest one.
+		/*!
+		 * It is called when the demand is extracted from the event queue.
+		 * After that a new message for the same key leads to a new demand.
+		 */
+		virtual void
+		take(
+			mbox_id_t mbox_id,
+			message_ref_t & message ) = 0;
+
+		//! Forget about the message which cannot be pushed to the event queue.
+		virtual void
+		cancel(
+			mbox_id_t mbox_id,
+			const message_ref_t & message ) = 0;
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief A type of shared pointer to conflation_storage.
+ */
+using conflation_storage_shptr_t = std::shared_ptr< conflation_storage_t >;
+
 //
 // control_block_t
 //
@@ -633,9 +860,48 @@ struct control_block_t
 		//! Limit value.
 		unsigned int m_limit;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Type of time values for the rate limit.
+		 */
+		using rate_clock_t = std::chrono::steady_clock;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Interval between messages for the rate limit
+		 * (in rate_clock_t ticks).
+		 *
+		 * Value 0 means that there is no rate limit.
+		 */
+		rate_clock_t::rep m_emission_interval;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief How far the theoretical arrival time can be ahead
+		 * of the current time (in rate_clock_t ticks).
+		 */
+		rate_clock_t::rep m_burst_tolerance;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Optional storage for conflation of messages.
+		 *
+		 * Value nullptr means that conflation isn't used.
+		 */
+		conflation_storage_shptr_t m_conflation;
+
 		//! The current count of the messages of that type.
 		mutable std::atomic_uint m_count;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Theoretical arrival time of the next message for
+		 * the rate limit.
+		 *
+		 * It is changed by senders only.
+		 */
+		mutable std::atomic< rate_clock_t::rep > m_theoretical_arrival_time;
+
 		//! Limit overflow reaction.
 		action_t m_action;
 
@@ -643,21 +909,55 @@ struct control_block_t
 		control_block_t(
 			unsigned int limit,
 			action_t action )
+			:	control_block_t( limit, rate_t(), std::move( action ) )
+			{}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Initializing constructor for the case of rate limit.
+		 */
+		control_block_t(
+			unsigned int limit,
+			const rate_t & rate,
+			action_t action,
+			//! Optional storage for conflation of messages (since v.5.5.17).
+			conflation_storage_shptr_t conflation = conflation_storage_shptr_t() )
 			:	m_limit( limit )
+			,	m_emission_interval( 0 )
+			,	m_burst_tolerance( 0 )
+			,	m_conflation( std::move( conflation ) )
 			,	m_action( std::move( action ) )
 			{
 				m_count = 0;
+				m_theoretical_arrival_time = 0;
+
+				if( rate.m_per_second )
+					{
+						m_emission_interval = std::chrono::duration_cast<
+										rate_clock_t::duration >(
+									std::chrono::seconds( 1 ) ).count() /
+								rate.m_per_second;
+						m_burst_tolerance = m_emission_interval *
+								( rate.m_burst ? rate.m_burst - 1 : 0 );
+					}
 			}
 
 		//! Copy constructor.
 		control_block_t(
 			const control_block_t & o )
 			:	m_limit( o.m_limit )
+			,	m_emission_interval( o.m_emission_interval )
+			,	m_burst_tolerance( o.m_burst_tolerance )
+			,	m_conflation( o.m_conflation )
 			,	m_action( o.m_action )
 			{
 				m_count.store(
 						o.m_count.load( std::memory_order_acquire ),
 						std::memory_order_release );
+				m_theoretical_arrival_time.store(
+						o.m_theoretical_arrival_time.load(
+								std::memory_order_acquire ),
+						std::memory_order_release );
 			}
 
 		//! Copy operator.
@@ -665,14 +965,56 @@ struct control_block_t
 		operator=( const control_block_t & o )
 			{
 				m_limit = o.m_limit;
+				m_emission_interval = o.m_emission_interval;
+				m_burst_tolerance = o.m_burst_tolerance;
+				m_conflation = o.m_conflation;
 				m_count.store(
 						o.m_count.load( std::memory_order_acquire ),
 						std::memory_order_release );
+				m_theoretical_arrival_time.store(
+						o.m_theoretical_arrival_time.load(
+								std::memory_order_acquire ),
+						std::memory_order_release );
 				m_action = o.m_action;
 
 				return *this;
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Try to take a permission for one more message
+		 * from the rate limit.
+		 *
+		 * It is a lock-free token bucket in the form of generic cell
+		 * rate algorithm: only the theoretical arrival time of the
+		 * next message is stored and is advanced by the emission
+		 * interval for every accepted message.
+		 *
+		 * \retval true if there is no rate limit or if the message
+		 * can be accepted.
+		 */
+		bool
+		consume_rate_token() const
+			{
+				if( !m_emission_interval )
+					return true;
+
+				const auto now = rate_clock_t::now().time_since_epoch().count();
+				auto tat = m_theoretical_arrival_time.load(
+						std::memory_order_relaxed );
+				while( true )
+					{
+						const auto base = tat < now ? now : tat;
+						if( base - now > m_burst_tolerance )
+							return false;
+
+						if( m_theoretical_arrival_time.compare_exchange_weak(
+								tat, base + m_emission_interval,
+								std::memory_order_relaxed ) )
+							return true;
+					}
+			}
+
 		//! A special indicator about absence of control_block.
 		inline static const control_block_t *
 		none() { return nullptr; }
@@ -685,6 +1027,21 @@ struct control_block_t
 				if( limit )
 					--(limit->m_count);
 			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Replace the message of an event by the latest one
+		 * if conflation is used for the message.
+		 */
+		inline static void
+		take_latest_message(
+			const control_block_t * limit,
+			mbox_id_t mbox_id,
+			message_ref_t & message )
+			{
+				if( limit && limit->m_conflation )
+					limit->m_conflation->take( mbox_id, message );
+			}
 	};
 
 } /* namespace message_limit */
@@ -20,6 +20,10 @@
 #include <functional>
 #include <typeindex>
 #include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace so_5
@@ -46,6 +50,18 @@ struct description_t
 		//! Reaction to overload.
 		action_t m_action;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Parameters of the rate limit.
+		 */
+		rate_t m_rate;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Optional storage for conflation of messages.
+		 */
+		conflation_storage_shptr_t m_conflation;
+
 		//! Initializing constructor.
 		description_t(
 			std::type_index msg_type,
@@ -55,6 +71,35 @@ struct description_t
 			,	m_limit( limit )
 			,	m_action( std::move( action ) )
 			{}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Initializing constructor for the case of rate limit.
+		 */
+		description_t(
+			std::type_index msg_type,
+			unsigned int limit,
+			action_t action,
+			rate_t rate )
+			:	m_msg_type( std::move( msg_type ) )
+			,	m_limit( limit )
+			,	m_action( std::move( action ) )
+			,	m_rate( rate )
+			{}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Initializing constructor for the case of conflation.
+		 */
+		description_t(
+			std::type_index msg_type,
+			action_t action,
+			conflation_storage_shptr_t conflation )
+			:	m_msg_type( std::move( msg_type ) )
+			,	m_limit( std::numeric_limits< unsigned int >::max() )
+			,	m_action( std::move( action ) )
+			,	m_conflation( std::move( conflation ) )
+			{}
 	};
 
 //
@@ -535,6 +580,275 @@ accept_one_indicator(
 				std::move( indicator.m_action ) );
 	}
 
+namespace impl
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Check parameters of a rate limit.
+ *
+ * The interval between messages is measured in ticks of
+ * control_block_t::rate_clock_t. So \a per_second can't be greater
+ * than the count of those ticks in one second, otherwise the interval
+ * would be rounded to zero and the rate wouldn't be limited at all.
+ *
+ * \throw so_5::exception_t if parameters are invalid.
+ */
+inline rate_t
+make_valid_rate( unsigned int per_second, unsigned int burst )
+	{
+		using rate_clock_t = control_block_t::rate_clock_t;
+
+		if( !per_second )
+			SO_5_THROW_EXCEPTION( rc_invalid_rate_limit,
+					"count of messages per second must be greater than 0" );
+		if( static_cast< rate_clock_t::rep >( per_second ) >
+				std::chrono::duration_cast< rate_clock_t::duration >(
+						std::chrono::seconds( 1 ) ).count() )
+			SO_5_THROW_EXCEPTION( rc_invalid_rate_limit,
+					"count of messages per second is too big: " +
+					std::to_string( per_second ) );
+		if( !burst )
+			SO_5_THROW_EXCEPTION( rc_invalid_rate_limit,
+					"burst size must be greater than 0" );
+
+		return rate_t( per_second, burst );
+	}
+
+} /* namespace impl */
+
+//
+// rate_drop_indicator_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Message rate limit with reaction 'drop new message'.
+ */
+template< class M >
+struct rate_drop_indicator_t
+	{
+		//! Parameters of the rate limit.
+		const rate_t m_rate;
+
+		//! Initializing constructor.
+		rate_drop_indicator_t( rate_t rate )
+			:	m_rate( rate )
+			{}
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Helper function for accepting rate_drop_indicator and storing
+ * the corresponding description into the limits container.
+ */
+template< class M >
+void
+accept_one_indicator(
+	//! Container for storing new description to.
+	description_container_t & to,
+	//! An instance of rate_drop_indicator.
+	const rate_drop_indicator_t< M > & indicator )
+	{
+		to.emplace_back( message_payload_type< M >::payload_type_index(),
+				std::numeric_limits< unsigned int >::max(),
+				&impl::drop_message_reaction,
+				indicator.m_rate );
+	}
+
+//
+// rate_redirect_indicator_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Indication that a message must be redirected if the rate
+ * limit is exceeded.
+ *
+ * \tparam MSG Message type of message/signal to be redirected.
+ * \tparam LAMBDA Type of lambda- or functional object which returns
+ * actual mbox for redirection.
+ */
+template< typename MSG, typename LAMBDA >
+struct rate_redirect_indicator_t
+	{
+		//! Parameters of the rate limit.
+		const rate_t m_rate;
+
+		//! A lambda/functional object which returns mbox for redirection.
+		LAMBDA m_destination_getter;
+
+		//! Initializing constructor.
+		rate_redirect_indicator_t(
+			rate_t rate,
+			LAMBDA destination_getter )
+			:	m_rate( rate )
+			,	m_destination_getter( std::move( destination_getter ) )
+			{}
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Helper function for accepting rate_redirect_indicator and
+ * storing the corresponding description into the limits container.
+ */
+template< typename MSG, typename LAMBDA >
+void
+accept_one_indicator(
+	//! Container for storing new description to.
+	description_container_t & to,
+	//! An instance of rate_redirect_indicator to be stored.
+	rate_redirect_indicator_t< MSG, LAMBDA > indicator )
+	{
+		LAMBDA dest_getter = std::move( indicator.m_destination_getter );
+		to.emplace_back( message_payload_type< MSG >::payload_type_index(),
+				std::numeric_limits< unsigned int >::max(),
+				[dest_getter]( const overlimit_context_t & ctx ) {
+					impl::redirect_reaction( ctx, dest_getter() );
+				},
+				indicator.m_rate );
+	}
+
+namespace impl
+{
+
+//
+// conflation_storage_template_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An implementation of conflation_storage for messages
+ * with keys of type KEY.
+ *
+ * \tparam KEY type of key. Must be copyable and comparable by operator<.
+ */
+template< typename KEY >
+class conflation_storage_template_t : public conflation_storage_t
+	{
+	public :
+		//! Type of function for extraction of the key from a message.
+		using key_getter_t = std::function< KEY( const message_ref_t & ) >;
+
+		conflation_storage_template_t( key_getter_t key_getter )
+			:	m_key_getter( std::move( key_getter ) )
+			{}
+
+		virtual bool
+		put(
+			mbox_id_t mbox_id,
+			const message_ref_t & message ) override
+			{
+				auto key = make_key( mbox_id, message );
+
+				// The replaced message will be destroyed outside the lock.
+				message_ref_t replaced = message;
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto it = m_latest.find( key );
+				if( it != m_latest.end() )
+					{
+						std::swap( replaced, it->second );
+						return false;
+					}
+
+				m_latest.emplace( std::move( key ), std::move( replaced ) );
+				return true;
+			}
+
+		virtual void
+		take(
+			mbox_id_t mbox_id,
+			message_ref_t & message ) override
+			{
+				const auto key = make_key( mbox_id, message );
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				auto it = m_latest.find( key );
+				if( it != m_latest.end() )
+					{
+						std::swap( message, it->second );
+						m_latest.erase( it );
+					}
+			}
+
+		virtual void
+		cancel(
+			mbox_id_t mbox_id,
+			const message_ref_t & message ) override
+			{
+				const auto key = make_key( mbox_id, message );
+
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_latest.erase( key );
+			}
+
+	private :
+		//! Full key of a message.
+		/*!
+		 * Messages from different mboxes are not conflated because
+		 * they can be handled by different event handlers.
+		 */
+		using full_key_t = std::pair< mbox_id_t, KEY >;
+
+		//! Key extractor.
+		const key_getter_t m_key_getter;
+
+		//! Object's lock.
+		std::mutex m_lock;
+
+		//! The latest messages for keys of queued demands.
+		std::map< full_key_t, message_ref_t > m_latest;
+
+		full_key_t
+		make_key(
+			mbox_id_t mbox_id,
+			const message_ref_t & message ) const
+			{
+				return full_key_t{ mbox_id, m_key_getter( message ) };
+			}
+	};
+
+} /* namespace impl */
+
+//
+// conflate_indicator_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An indicator of conflation of messages.
+ *
+ * \tparam M type of message or signal.
+ */
+template< class M >
+struct conflate_indicator_t
+	{
+		//! Storage for the conflation.
+		conflation_storage_shptr_t m_storage;
+
+		//! Initializing constructor.
+		conflate_indicator_t( conflation_storage_shptr_t storage )
+			:	m_storage( std::move( storage ) )
+			{}
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Helper function for accepting conflate_indicator and storing
+ * the corresponding description into the limits container.
+ */
+template< class M >
+void
+accept_one_indicator(
+	//! Container for storing new description to.
+	description_container_t & to,
+	//! An instance of conflate_indicator.
+	conflate_indicator_t< M > indicator )
+	{
+		to.emplace_back( message_payload_type< M >::payload_type_index(),
+				&impl::drop_message_reaction,
+				std::move( indicator.m_storage ) );
+	}
+
 //
 // accept_indicators
 //
@@ -752,6 +1066,165 @@ struct message_limit_methods_mixin_t
 						std::move( mbox ),
 						std::forward<ARGS>( args )... );
 			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating rate_drop_indicator.
+		 *
+		 * No more than \a per_second messages per second are accepted.
+		 * Up to \a burst messages can be accepted at once if there were
+		 * no messages for some time. All other messages are dropped.
+		 *
+		 * \par Usage example:
+		 * \code
+			class a_quotes_handler_t : public so_5::agent_t
+			{
+			public :
+				a_quotes_handler_t( context_t ctx )
+					:	so_5::agent_t( ctx
+							// No more than 10000 quotes per second
+							// with bursts up to 100 quotes.
+							+ limit_rate_then_drop< quote >( 10000, 100 ) )
+					{...}
+				...
+			};
+		 * \endcode
+		 *
+		 * \note Count of waiting messages isn't limited.
+		 *
+		 * \throw so_5::exception_t if \a per_second or \a burst is 0 or if
+		 * \a per_second is greater than resolution of std::chrono::steady_clock.
+		 */
+		template< typename MSG >
+		static rate_drop_indicator_t< MSG >
+		limit_rate_then_drop(
+			unsigned int per_second,
+			unsigned int burst )
+			{
+				return rate_drop_indicator_t< MSG >(
+						impl::make_valid_rate( per_second, burst ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating rate_drop_indicator
+		 * with burst size equal to \a per_second.
+		 */
+		template< typename MSG >
+		static rate_drop_indicator_t< MSG >
+		limit_rate_then_drop( unsigned int per_second )
+			{
+				return limit_rate_then_drop< MSG >( per_second, per_second );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating rate_redirect_indicator.
+		 *
+		 * Messages which exceed the rate limit are redirected to
+		 * the mbox returned by \a dest_getter.
+		 *
+		 * \throw so_5::exception_t if \a per_second or \a burst is 0 or if
+		 * \a per_second is greater than resolution of std::chrono::steady_clock.
+		 */
+		template< typename MSG, typename LAMBDA >
+		static rate_redirect_indicator_t< MSG, LAMBDA >
+		limit_rate_then_redirect(
+			unsigned int per_second,
+			unsigned int burst,
+			LAMBDA dest_getter )
+			{
+				return rate_redirect_indicator_t< MSG, LAMBDA >(
+						impl::make_valid_rate( per_second, burst ),
+						std::move( dest_getter ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating rate_redirect_indicator
+		 * with burst size equal to \a per_second.
+		 */
+		template< typename MSG, typename LAMBDA >
+		static rate_redirect_indicator_t< MSG, LAMBDA >
+		limit_rate_then_redirect(
+			unsigned int per_second,
+			LAMBDA dest_getter )
+			{
+				return limit_rate_then_redirect< MSG >(
+						per_second, per_second, std::move( dest_getter ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating conflate_indicator.
+		 *
+		 * There can be only one demand for a message or signal of type MSG
+		 * from the same mbox in the event queue of the agent. A new message
+		 * replaces the message of the queued demand, so the event handler
+		 * receives only the latest message.
+		 *
+		 * \note Conflation is not applied to service requests.
+		 */
+		template< typename MSG >
+		static conflate_indicator_t< MSG >
+		conflate()
+			{
+				return conflate_indicator_t< MSG >(
+						std::make_shared<
+								impl::conflation_storage_template_t< int > >(
+							[]( const message_ref_t & ) { return 0; } ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief A helper function for creating conflate_indicator with
+		 * a key extractor.
+		 *
+		 * Messages are conflated only if they have the same key.
+		 *
+		 * \par Usage example:
+		 * \code
+			class a_quotes_handler_t : public so_5::agent_t
+			{
+			public :
+				a_quotes_handler_t( context_t ctx )
+					:	so_5::agent_t( ctx
+							// Only the latest quote for every instrument
+							// must be handled.
+							+ conflate< quote >( []( const quote & q ) {
+									return q.m_instrument;
+								} ) )
+					{...}
+				...
+			};
+		 * \endcode
+		 *
+		 * \tparam MSG type of message.
+		 * \tparam LAMBDA type of key extractor. Must have the prototype
+		 * KEY(const MSG &). KEY must be copyable and comparable by operator<.
+		 */
+		template<
+				typename MSG,
+				typename LAMBDA,
+				typename KEY = typename std::decay< decltype(
+						std::declval< LAMBDA & >()(
+								std::declval< const typename
+										message_payload_type< MSG >::payload_type & >() )
+						) >::type >
+		static conflate_indicator_t< MSG >
+		conflate( LAMBDA key_extractor )
+			{
+				ensure_not_signal< MSG >();
+
+				return conflate_indicator_t< MSG >(
+						std::make_shared<
+								impl::conflation_storage_template_t< KEY > >(
+							[key_extractor]( const message_ref_t & m ) {
+								return key_extractor(
+										message_payload_type< MSG >::payload_reference(
+												*m ) );
+							} ) );
+			}
 	};
 
 namespace impl
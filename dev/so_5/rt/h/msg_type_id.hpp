@@ -0,0 +1,44 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Integer identifiers of message types.
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+#include <so_5/h/types.hpp>
+
+#include <typeindex>
+
+namespace so_5
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Get the integer identifier of message type.
+ *
+ * Identifiers are assigned by a process-wide registry. The first call
+ * for a type registers it and assigns the next free identifier. So
+ * identifiers are dense and start from 1. The value 0 is never assigned
+ * (see null_msg_type_id()).
+ *
+ * Identifiers are used as keys in mboxes and subscription storages
+ * instead of std::type_index. Comparison and hashing of std::type_index
+ * can require comparison and hashing of the type's name.
+ *
+ * \note The search of already registered type uses only the pointer
+ * returned by type_info::name(). There is no lock and no string
+ * comparison in that case.
+ *
+ * \note This function is thread-safe.
+ */
+SO_5_FUNC msg_type_id_t
+query_msg_type_id( const std::type_index & msg_type );
+
+} /* namespace so_5 */
+
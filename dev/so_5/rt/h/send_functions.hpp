@@ -64,6 +64,47 @@ namespace impl
 								std::forward< ARGS >( args )...),
 							to, pause, period );
 				}
+
+			template< typename... ARGS >
+			static void
+			send_delayed(
+				so_5::timer_manager_t & timers,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause,
+				ARGS &&... args )
+				{
+					auto msg = so_5::details::make_message_instance< MESSAGE >(
+							std::forward< ARGS >( args )...);
+					ensure_message_with_actual_data( msg.get() );
+
+					timers.schedule_anonymous(
+							message_payload_type< MESSAGE >::payload_type_index(),
+							to,
+							message_ref_t( msg.release() ),
+							pause,
+							std::chrono::steady_clock::duration::zero() );
+				}
+
+			template< typename... ARGS >
+			static timer_id_t
+			send_periodic(
+				so_5::timer_manager_t & timers,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period,
+				ARGS &&... args )
+				{
+					auto msg = so_5::details::make_message_instance< MESSAGE >(
+							std::forward< ARGS >( args )...);
+					ensure_message_with_actual_data( msg.get() );
+
+					return timers.schedule(
+							message_payload_type< MESSAGE >::payload_type_index(),
+							to,
+							message_ref_t( msg.release() ),
+							pause,
+							period );
+				}
 		};
 
 	template< class MESSAGE >
@@ -93,6 +134,39 @@ namespace impl
 				{
 					return env.schedule_timer< MESSAGE >( to, pause, period );
 				}
+
+			static void
+			send_delayed(
+				so_5::timer_manager_t & timers,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause )
+				{
+					ensure_signal< MESSAGE >();
+
+					timers.schedule_anonymous(
+							message_payload_type< MESSAGE >::payload_type_index(),
+							to,
+							message_ref_t(),
+							pause,
+							std::chrono::steady_clock::duration::zero() );
+				}
+
+			static timer_id_t
+			send_periodic(
+				so_5::timer_manager_t & timers,
+				const so_5::mbox_t & to,
+				std::chrono::steady_clock::duration pause,
+				std::chrono::steady_clock::duration period )
+				{
+					ensure_signal< MESSAGE >();
+
+					return timers.schedule(
+							message_payload_type< MESSAGE >::payload_type_index(),
+							to,
+							message_ref_t(),
+							pause,
+							period );
+				}
 		};
 
 	template< class MESSAGE >
@@ -120,6 +194,13 @@ arg_to_mbox( const so_5::adhoc_agent_definition_proxy_t & agent ) { return agent
 inline so_5::mbox_t
 arg_to_mbox( const so_5::mchain_t & chain ) { return chain->as_mbox(); }
 
+/*!
+ * \since v.5.5.17
+ * \brief Max count of messages to be delivered by one call to
+ * abstract_message_box_t::deliver_message_batch() inside send_batch().
+ */
+const std::size_t send_batch_chunk_size = 64;
+
 } /* namespace send_functions_details */
 
 /*!
@@ -204,6 +285,47 @@ send( TARGET && to, ARGS&&... args )
 				std::forward<ARGS>(args)... );
 	}
 
+/*!
+ * \since v.5.5.17
+ * \brief A utility function for creating and delivering a mutable message.
+ *
+ * A mutable message can have only one receiver. Because of that it can
+ * be sent only to MPSC mboxes (like direct mboxes of agents) and
+ * mchains. An attempt to send a mutable message to MPMC mbox leads to
+ * an exception.
+ *
+ * The receiver gets the message via so_5::mutable_mhood_t and can modify
+ * it or forward the same message object further without copying.
+ *
+ * \note Only messages derived from so_5::message_t can be mutable.
+ * Signals can't be mutable.
+ *
+ * \par Usage sample:
+ * \code
+	struct order_book_snapshot : public so_5::message_t { ... };
+
+	so_5::send_mutable< order_book_snapshot >( first_stage, ... );
+ * \endcode
+ *
+ * \tparam MESSAGE type of message to be sent.
+ * \tparam TARGET identification of the receiver. The same as for send().
+ * \tparam ARGS arguments for MESSAGE's constructor.
+ */
+template< typename MESSAGE, typename TARGET, typename... ARGS >
+void
+send_mutable( TARGET && to, ARGS&&... args )
+	{
+		ensure_classical_message< MESSAGE >();
+		ensure_not_signal< MESSAGE >();
+
+		auto msg = so_5::details::make_message_instance< MESSAGE >(
+				std::forward< ARGS >( args )... );
+		msg->so5_change_mutability( message_mutability_t::mutable_message );
+
+		send_functions_details::arg_to_mbox( std::forward<TARGET>(to) )
+				->deliver_message( std::move( msg ) );
+	}
+
 /*!
  * \since v.5.5.1
  * \brief A utility function for creating and delivering a message to
@@ -230,6 +352,62 @@ send_to_agent(
 		send< MESSAGE >( receiver, std::forward<ARGS>(args)... );
 	}
 
+/*!
+ * \since v.5.5.17
+ * \brief A utility function for creating and delivering several messages
+ * of the same type at once.
+ *
+ * A message instance is created for every item of [first, last).
+ * An item is passed to the MESSAGE's constructor as the only argument.
+ *
+ * Messages are delivered by chunks via
+ * abstract_message_box_t::deliver_message_batch(). For ordinary mboxes it
+ * means that the mbox is locked once per chunk and demands are pushed
+ * into receiver's event queue by event_queue_t::push_batch().
+ *
+ * \note Signals can't be sent by this function.
+ *
+ * \tparam MESSAGE type of messages to be sent.
+ * \tparam TARGET identification of the receiver. The same as for send().
+ * \tparam IT type of input iterator.
+ *
+ * \par Usage sample:
+ * \code
+	struct price_update { std::string m_symbol; double m_price; };
+
+	std::vector< price_update > updates = receive_updates();
+	so_5::send_batch< price_update >( feed_mbox,
+			updates.begin(), updates.end() );
+ * \endcode
+ */
+template< typename MESSAGE, typename TARGET, typename IT >
+void
+send_batch( TARGET && to, IT first, IT last )
+	{
+		const so_5::mbox_t & mbox =
+				send_functions_details::arg_to_mbox( std::forward<TARGET>(to) );
+
+		message_ref_t chunk[ send_functions_details::send_batch_chunk_size ];
+		while( first != last )
+			{
+				std::size_t count = 0;
+				for( ; count != send_functions_details::send_batch_chunk_size &&
+						first != last; ++count, ++first )
+					{
+						auto msg = so_5::details::make_message_instance< MESSAGE >(
+								*first );
+						ensure_message_with_actual_data( msg.get() );
+
+						chunk[ count ] = message_ref_t( msg.release() );
+					}
+
+				mbox->deliver_message_batch(
+						message_payload_type< MESSAGE >::payload_type_index(),
+						chunk,
+						count );
+			}
+	}
+
 /*!
  * \since v.5.5.1
  * \brief A utility function for creating and delivering a delayed message.
@@ -250,6 +428,32 @@ send_delayed(
 				env, to, pause, std::forward<ARGS>(args)... );
 	}
 
+/*!
+ * \since v.5.5.17
+ * \brief A utility function for creating and delivering a delayed message
+ * via the timer manager specified.
+ *
+ * The message will be delivered on the context of the thread which
+ * serves the timer manager (for example, by the working thread of
+ * %one_thread dispatcher, see
+ * so_5::disp::one_thread::private_dispatcher_t::timer_manager()).
+ */
+template< typename MESSAGE, typename... ARGS >
+void
+send_delayed(
+	//! A timer manager to be used for timer.
+	so_5::timer_manager_t & timers,
+	//! Mbox for the message to be sent to.
+	const so_5::mbox_t & to,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Message constructor parameters.
+	ARGS&&... args )
+	{
+		so_5::impl::instantiator_and_sender< MESSAGE >::send_delayed(
+				timers, to, pause, std::forward<ARGS>(args)... );
+	}
+
 /*!
  * \since v.5.5.13
  * \brief A utility function for creating and delivering a delayed message
@@ -416,6 +620,32 @@ send_periodic(
 				env, to, pause, period, std::forward< ARGS >( args )... );
 	}
 
+/*!
+ * \since v.5.5.17
+ * \brief A utility function for creating and delivering a periodic message
+ * via the timer manager specified.
+ *
+ * The message will be delivered on the context of the thread which
+ * serves the timer manager.
+ */
+template< typename MESSAGE, typename... ARGS >
+timer_id_t
+send_periodic(
+	//! A timer manager to be used for timer.
+	so_5::timer_manager_t & timers,
+	//! Mbox for the message to be sent to.
+	const so_5::mbox_t & to,
+	//! Pause for message delaying.
+	std::chrono::steady_clock::duration pause,
+	//! Period of message repetitions.
+	std::chrono::steady_clock::duration period,
+	//! Message constructor parameters.
+	ARGS&&... args )
+	{
+		return so_5::impl::instantiator_and_sender< MESSAGE >::send_periodic(
+				timers, to, pause, period, std::forward< ARGS >( args )... );
+	}
+
 /*!
  * \since v.5.5.1
  * \brief A utility function for creating and delivering a periodic message.
@@ -19,6 +19,8 @@
 #include <so_5/h/compiler_features.hpp>
 #include <so_5/h/declspec.hpp>
 
+#include <so_5/details/h/small_function.hpp>
+
 #include <so_5/rt/h/mbox_fwd.hpp>
 #include <so_5/rt/h/fwd.hpp>
 
@@ -188,16 +190,20 @@ class SO_5_TYPE state_t final
 		 * \brief Type of function to be called on enter to the state.
 		 *
 		 * \attention Handler must be noexcept function.
+		 *
+		 * \note Since v.5.5.17 it is not std::function.
 		 */
-		using on_enter_handler_t = std::function< void() >;
+		using on_enter_handler_t = details::small_function_t< void() >;
 
 		/*!
 		 * \since v.5.5.15
 		 * \brief Type of function to be called on exit from the state.
 		 *
 		 * \attention Handler must be noexcept function.
+		 *
+		 * \note Since v.5.5.17 it is not std::function.
 		 */
-		using on_exit_handler_t = std::function< void() >;
+		using on_exit_handler_t = details::small_function_t< void() >;
 
 		/*!
 		 * \since v.5.5.15
@@ -176,6 +176,43 @@ adaptive_subscription_storage_factory(
 	//! A factory for creating large storage.
 	const subscription_storage_factory_t & large_storage_factory );
 
+/*!
+ * \since v.5.5.17
+ * \brief Factory for subscription storage with frozen perfect hash table.
+ *
+ * \par Description
+ * Most of agents do not change subscriptions after so_evt_start().
+ * This storage uses default storage until the return from so_evt_start().
+ * Then a compact perfect hash table for (mbox, message type, state)
+ * keys is built. Search of an event handler requires only one probe
+ * in that table.
+ *
+ * If subscriptions are changed after so_evt_start() then the table is
+ * destroyed and the default storage is used until the end of agent's
+ * lifetime.
+ *
+ * \par More about subscription storage tuning
+ * See \ref so_5_5_3__subscr_storage_selection for more details about selection
+ * of appropriate subscription storage type.
+ *
+ */
+SO_5_FUNC subscription_storage_factory_t
+perfect_hash_based_subscription_storage_factory();
+
+/*!
+ * \since v.5.5.17
+ * \brief Factory for subscription storage with frozen perfect hash table.
+ *
+ * The same as perfect_hash_based_subscription_storage_factory() but
+ * storage created by \a mutable_storage_factory is used before
+ * the building of the table and after changes of subscriptions.
+ *
+ */
+SO_5_FUNC subscription_storage_factory_t
+perfect_hash_based_subscription_storage_factory(
+	//! A factory for creating storage for mutable mode.
+	const subscription_storage_factory_t & mutable_storage_factory );
+
 namespace rt 
 {
 
@@ -272,10 +272,12 @@ deregistration_processor_t::initiate_abort_on_exception(
 
 agent_core_t::agent_core_t(
 	environment_t & so_environment,
-	coop_listener_unique_ptr_t coop_listener )
+	coop_listener_unique_ptr_t coop_listener,
+	bool final_dereg_thread_enabled )
 	:	m_so_environment( so_environment )
 	,	m_deregistration_started( false )
 	,	m_total_agent_count{ 0 }
+	,	m_final_dereg_thread_enabled( final_dereg_thread_enabled )
 	,	m_coop_listener( std::move( coop_listener ) )
 {
 }
@@ -289,17 +291,20 @@ agent_core_t::start()
 {
 	m_deregistration_started = false;
 
+	if( !m_final_dereg_thread_enabled )
+		return;
+
 	// mchain for final coop deregs must be created.
 	m_final_dereg_chain = m_so_environment.create_mchain(
 			make_unlimited_mchain_params().disable_msg_tracing() );
 	// A separate thread for doing the final dereg must be started.
-	m_final_dereg_thread = std::thread{ [this] {
+	m_final_dereg_thread = m_so_environment.thread_factory().start( [this] {
 		// Process dereg demands until chain will be closed.
 		receive( from( m_final_dereg_chain ),
 			[]( coop_t * coop ) {
 				coop_t::call_final_deregister_coop( coop );
 			} );
-	} };
+	} );
 }
 
 void
@@ -312,8 +317,11 @@ agent_core_t::finish()
 	wait_all_coop_to_deregister();
 
 	// Notify a dedicated thread and wait while it will be stopped.
-	close_retain_content( m_final_dereg_chain );
-	m_final_dereg_thread.join();
+	if( m_final_dereg_thread_enabled )
+	{
+		close_retain_content( m_final_dereg_chain );
+		m_final_dereg_thread->join();
+	}
 }
 
 namespace
@@ -458,19 +466,16 @@ agent_core_t::final_deregister_coop(
 void
 agent_core_t::start_deregistration()
 {
-	bool signal_deregistration_started = false;
-	{
-		std::lock_guard< std::mutex > lock( m_coop_operations_lock );
-
-		if( !m_deregistration_started )
-		{
-			m_deregistration_started = true;
-			signal_deregistration_started = true;
-		}
-	}
+	// The notification is done under the lock: the environment
+	// (and this object) can be destroyed by the waiting thread right
+	// after the release of the lock.
+	std::lock_guard< std::mutex > lock( m_coop_operations_lock );
 
-	if( signal_deregistration_started )
+	if( !m_deregistration_started )
+	{
+		m_deregistration_started = true;
 		m_deregistration_started_cond.notify_one();
+	}
 }
 
 void
@@ -511,6 +516,22 @@ agent_core_t::wait_all_coop_to_deregister()
 			[this] { return m_deregistered_coop.empty(); } );
 }
 
+bool
+agent_core_t::is_deregistration_started()
+{
+	std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+
+	return m_deregistration_started;
+}
+
+bool
+agent_core_t::is_all_coop_deregistered()
+{
+	std::lock_guard< std::mutex > lock( m_coop_operations_lock );
+
+	return m_deregistered_coop.empty();
+}
+
 environment_t &
 agent_core_t::environment()
 {
@@ -520,7 +541,8 @@ agent_core_t::environment()
 agent_core_stats_t
 agent_core_t::query_stats()
 {
-	const auto final_dereg_coops = m_final_dereg_chain->size();
+	const auto final_dereg_coops = m_final_dereg_chain ?
+			m_final_dereg_chain->size() : std::size_t{ 0 };
 
 	std::unique_lock< std::mutex > lock( m_coop_operations_lock );
 
@@ -9,8 +9,6 @@
 
 #include <so_5/rt/impl/h/disp_repository.hpp>
 
-#include <so_5/disp/one_thread/h/pub.hpp>
-
 #include <so_5/details/h/rollback_on_exception.hpp>
 
 namespace so_5
@@ -27,12 +25,10 @@ disp_repository_t::disp_repository_t(
 	environment_t & env,
 	named_dispatcher_map_t named_dispatcher_map,
 	event_exception_logger_unique_ptr_t logger,
-	so_5::disp::one_thread::disp_params_t default_disp_params )
+	dispatcher_unique_ptr_t default_dispatcher )
 	:
 		m_env( env ),
-		m_default_dispatcher(
-				so_5::disp::one_thread::create_disp(
-						std::move(default_disp_params) ) ),
+		m_default_dispatcher( std::move( default_dispatcher ) ),
 		m_named_dispatcher_map( std::move( named_dispatcher_map ) ),
 		m_event_exception_logger( std::move( logger ) ),
 		m_state( state_t::not_started )
@@ -17,6 +17,7 @@
 #include <condition_variable>
 
 #include <so_5/h/exception.hpp>
+#include <so_5/h/thread_factory.hpp>
 
 #include <so_5/rt/h/agent.hpp>
 #include <so_5/rt/h/agent_coop.hpp>
@@ -136,7 +137,16 @@ class agent_core_t
 			//! SObjectizer Environment.
 			environment_t & so_environment_impl,
 			//! Cooperation action listener.
-			coop_listener_unique_ptr_t coop_listener );
+			coop_listener_unique_ptr_t coop_listener,
+			//! Should a separate thread be used for the final
+			//! deregistration of cooperations?
+			/*!
+			 * \since v.5.5.17
+			 *
+			 * If false then all calls to ready_to_deregister_notify() must be
+			 * intercepted and handled by the environment's infrastructure.
+			 */
+			bool final_dereg_thread_enabled );
 
 		~agent_core_t();
 
@@ -205,6 +215,24 @@ class agent_core_t
 		void
 		wait_all_coop_to_deregister();
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Has the deregistration of all cooperations been started?
+		 *
+		 * Non-blocking analog of wait_for_start_deregistration().
+		 */
+		bool
+		is_deregistration_started();
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Is there no more cooperations in the deregistration state?
+		 *
+		 * Non-blocking analog of wait_all_coop_to_deregister().
+		 */
+		bool
+		is_all_coop_deregistered();
+
 		/*!
 		 * \since v.5.5.0
 		 * \brief Access to SObjectizer Environment.
@@ -396,12 +424,22 @@ class agent_core_t
 		 * \brief A separate thread for doing the final deregistration.
 		 *
 		 * \note Actual thread is started inside start() method.
+		 *
+		 * \note Since v.5.5.17 the thread is created by the thread factory
+		 * of the SObjectizer Environment.
 		 */
-		std::thread m_final_dereg_thread;
+		thread_handle_unique_ptr_t m_final_dereg_thread;
 		/*!
 		 * \}
 		 */
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Should a separate thread be used for the final
+		 * deregistration of cooperations?
+		 */
+		const bool m_final_dereg_thread_enabled;
+
 		//! Cooperation actions listener.
 		coop_listener_unique_ptr_t m_coop_listener;
 
@@ -37,7 +37,13 @@ class disp_repository_t
 			environment_t & env,
 			named_dispatcher_map_t named_dispatcher_map,
 			event_exception_logger_unique_ptr_t logger,
-			so_5::disp::one_thread::disp_params_t default_disp_params );
+			//! The default dispatcher.
+			/*!
+			 * \note Since v.5.5.17 the default dispatcher is created
+			 * by the environment because its type depends on the
+			 * environment's infrastructure.
+			 */
+			dispatcher_unique_ptr_t default_dispatcher );
 
 		virtual ~disp_repository_t();
 
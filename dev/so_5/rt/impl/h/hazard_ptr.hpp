@@ -0,0 +1,206 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Hazard pointers for protection of shared immutable objects.
+ *
+ * A reader publishes a pointer to an object in a slot of its own
+ * thread record. A writer which has replaced the object can destroy
+ * the old one only when no slot holds a pointer to it.
+ *
+ * Every thread writes only to its own record. Because of that there is
+ * no cache line which is modified by all readers.
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+
+#include <atomic>
+#include <cstddef>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace hazard_ptr
+{
+
+//
+// record_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A record with hazard slots for one thread.
+ *
+ * Slots are used as a stack. It allows nested protections (for example
+ * when a message is redirected to another mbox by overlimit reaction
+ * during the delivery).
+ *
+ * \note Records are never deallocated while the program works. A record
+ * of a finished thread is reused by a new thread.
+ *
+ * \note Records are allocated by ordinary new-expression and extended
+ * alignment can't be used in C++11. Paddings are used instead to
+ * prevent sharing of cache lines with other objects.
+ */
+struct record_t
+	{
+		//! Max count of objects protected by one thread at the same time.
+		static const std::size_t max_slots = 64;
+
+		//! Size of padding.
+		static const std::size_t padding_size = 64;
+
+		char m_padding_before[ padding_size ];
+
+		//! Protected pointers.
+		std::atomic< const void * > m_slots[ max_slots ];
+
+		//! Count of slots in use.
+		/*!
+		 * \note Is modified only by the owner thread.
+		 */
+		std::size_t m_top = 0;
+
+		//! Is record owned by some thread?
+		std::atomic< bool > m_active;
+
+		//! Next record in the global list.
+		record_t * m_next = nullptr;
+
+		char m_padding_after[ padding_size ];
+
+		record_t();
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Get the record for the current thread.
+ *
+ * \return nullptr if the record is already returned to the global list
+ * because the current thread is finishing (it is possible during
+ * the destruction of thread_local objects).
+ */
+record_t *
+current_thread_record();
+
+/*!
+ * \since v.5.5.17
+ * \brief Is object protected by some thread?
+ *
+ * Checks slots of all records.
+ */
+bool
+is_protected( const void * object );
+
+/*!
+ * \since v.5.5.17
+ * \brief Is object protected by some thread other than the current one?
+ *
+ * Slots of the record of the current thread are not checked.
+ */
+bool
+is_protected_by_other_threads( const void * object );
+
+//
+// guard_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A holder of one hazard slot of the current thread.
+ *
+ * \note If all slots of the current thread are in use or the current
+ * thread has no record anymore (see current_thread_record()) then guard
+ * is not valid and can't protect anything. The caller should use some
+ * other way of protection in that case.
+ *
+ * \par Usage sample:
+	\code
+	hazard_ptr::guard_t guard;
+	if( guard.valid() )
+	{
+		const snapshot_t * s = guard.protect( m_snapshot );
+		... // s can be safely used while guard exists.
+	}
+	\endcode
+ */
+class guard_t
+	{
+		guard_t( const guard_t & ) = delete;
+		guard_t &
+		operator=( const guard_t & ) = delete;
+
+	public :
+		guard_t()
+			:	m_record( current_thread_record() )
+			,	m_slot( nullptr )
+			{
+				if( m_record && m_record->m_top != record_t::max_slots )
+					{
+						m_slot = &m_record->m_slots[ m_record->m_top ];
+						++m_record->m_top;
+					}
+			}
+
+		~guard_t()
+			{
+				if( m_slot )
+					{
+						m_slot->store( nullptr, std::memory_order_release );
+						--m_record->m_top;
+					}
+			}
+
+		//! Is there a slot for protection?
+		bool
+		valid() const
+			{
+				return nullptr != m_slot;
+			}
+
+		//! Load and protect the current value of \a source.
+		/*!
+		 * The value is stored in the hazard slot and then \a source is
+		 * checked again. If the value is changed during that time the
+		 * procedure is repeated. A writer which replaced the value
+		 * will see it in the hazard slot.
+		 *
+		 * \attention Must be called only for valid guard.
+		 */
+		template< typename T >
+		T *
+		protect( const std::atomic< T * > & source )
+			{
+				T * p = source.load( std::memory_order_acquire );
+				for(;;)
+					{
+						m_slot->store( p, std::memory_order_seq_cst );
+						T * actual = source.load( std::memory_order_seq_cst );
+						if( actual == p )
+							return p;
+
+						p = actual;
+					}
+			}
+
+	private :
+		record_t * const m_record;
+		std::atomic< const void * > * m_slot;
+	};
+
+} /* namespace hazard_ptr */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
+#endif
+
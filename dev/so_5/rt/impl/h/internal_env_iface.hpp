@@ -65,6 +65,14 @@ class internal_env_iface_t
 		bool
 		is_msg_tracing_enabled() const;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Is the environment created with single-threaded
+		 * infrastructure?
+		 */
+		bool
+		is_single_threaded() const;
+
 		//! Get access to message delivery tracer object.
 		/*!
 		 * \throw exception_t if (!is_msg_tracing_enabled()).
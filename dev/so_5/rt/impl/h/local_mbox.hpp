@@ -9,7 +9,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <so_5/h/types.hpp>
@@ -21,8 +27,10 @@
 
 #include <so_5/rt/h/mbox.hpp>
 #include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/msg_type_id.hpp>
 
 #include <so_5/rt/impl/h/agent_ptr_compare.hpp>
+#include <so_5/rt/impl/h/hazard_ptr.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
 
@@ -35,6 +43,25 @@ namespace impl
 namespace local_mbox_details
 {
 
+/*!
+ * \since v.5.5.17
+ * \brief Ensure that a mutable message isn't delivered via MPMC mbox.
+ *
+ * \throw so_5::exception_t if \a message is mutable.
+ */
+inline void
+ensure_immutable_message(
+	const std::type_index & msg_type,
+	const message_ref_t & message )
+{
+	if( message && message_mutability_t::mutable_message ==
+			message->so5_message_mutability() )
+		SO_5_THROW_EXCEPTION(
+				so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox,
+				std::string( "an attempt to deliver mutable message via "
+						"MPMC mbox, msg_type=" ) + msg_type.name() );
+}
+
 /*!
  * \since v.5.5.4
  * \brief An information block about one subscriber.
@@ -190,6 +217,32 @@ public :
 				state_t::nothing : state_t::only_subscriptions );
 	}
 
+	/*!
+	 * \since v.5.5.17
+	 * \brief Are there subscriptions for the subscriber?
+	 *
+	 * It is false if there is only a delivery filter for the subscriber.
+	 */
+	bool
+	has_subscriptions() const
+	{
+		return state_t::only_subscriptions == m_state ||
+				state_t::subscriptions_and_filter == m_state;
+	}
+
+	/*!
+	 * \since v.5.5.17
+	 * \brief Can several messages be pushed to the subscriber at once?
+	 *
+	 * It is possible only if there is no message limit for the
+	 * subscriber. Delivery filter is checked for every message anyway.
+	 */
+	bool
+	can_receive_batch() const
+	{
+		return nullptr == m_limit;
+	}
+
 	//! Must a message be delivered to the subscriber?
 	delivery_possibility_t
 	must_be_delivered(
@@ -603,6 +656,27 @@ public :
 				return find_in_map( agent );
 		}
 
+	/*!
+	 * \since v.5.5.17
+	 * \brief Find the subscriber in a read-only container.
+	 */
+	const_iterator
+	find( agent_t * agent ) const
+		{
+			if( is_vector() )
+				{
+					subscriber_info_t info{ agent };
+					auto pos = std::lower_bound(
+							m_vector.begin(), m_vector.end(), info );
+					if( pos != m_vector.end() && pos->subscriber_pointer() == agent )
+						return const_iterator{ pos };
+					else
+						return const_iterator{ m_vector.end() };
+				}
+			else
+				return const_iterator{ m_map.find( agent ) };
+		}
+
 	iterator
 	begin()
 		{
@@ -658,6 +732,20 @@ public :
 		}
 };
 
+/*!
+ * \since v.5.4.0
+ * \brief Map from message type to subscribers.
+ *
+ * \note It is defined outside of data_t since v.5.5.17.
+ *
+ * \note Since v.5.5.17 integer identifier of message type is used
+ * as the key.
+ */
+typedef std::map<
+				msg_type_id_t,
+				subscriber_adaptive_container_t >
+		messages_table_t;
+
 //
 // data_t
 //
@@ -665,7 +753,14 @@ public :
 /*!
  * \since v.5.5.9
  * \brief A coolection of data required for local mbox implementation.
+ *
+ * \tparam LOCK_TYPE type of lock for the mbox (it is a template parameter
+ * since v.5.5.17).
+ *
+ * \note Since v.5.5.17 the access to subscribers is performed via
+ * read_subscribers() and modify_subscribers() methods.
  */
+template< typename LOCK_TYPE >
 struct data_t
 	{
 		data_t( mbox_id_t id )
@@ -676,19 +771,339 @@ struct data_t
 		const mbox_id_t m_id;
 
 		//! Object lock.
-		mutable default_rw_spinlock_t m_lock;
+		mutable LOCK_TYPE m_lock;
+
+		//! Map of subscribers to messages.
+		messages_table_t m_subscribers;
 
 		/*!
-		 * \since v.5.4.0
-		 * \brief Map from message type to subscribers.
+		 * \since v.5.5.17
+		 * \brief Call \a action for subscribers under the shared lock.
 		 */
-		typedef std::map<
-						std::type_index,
-						subscriber_adaptive_container_t >
-				messages_table_t;
+		template< typename ACTION >
+		void
+		read_subscribers( ACTION && action ) const
+			{
+				read_lock_guard_t< LOCK_TYPE > lock( m_lock );
+				action( m_subscribers );
+			}
 
-		//! Map of subscribers to messages.
-		messages_table_t m_subscribers;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Call \a action for subscribers under the exclusive lock.
+		 */
+		template< typename ACTION >
+		void
+		modify_subscribers( ACTION && action )
+			{
+				std::lock_guard< LOCK_TYPE > lock( m_lock );
+				action( m_subscribers );
+			}
+	};
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+
+//
+// cow_data_t
+//
+
+/*!
+ * \since v.5.5.17
+ * \brief A collection of data for local mbox with copy-on-write
+ * snapshots of subscribers.
+ *
+ * Subscribers are stored in an immutable snapshot. A pointer to the
+ * current snapshot is published via atomic variable. Delivery protects
+ * the snapshot by a hazard pointer of the current thread and does not
+ * modify any data shared between threads.
+ *
+ * Every modification makes a copy of the current snapshot under the lock,
+ * modifies the copy and publishes it. The old snapshot is moved to
+ * the list of retired snapshots. Retired snapshots which are not used by
+ * any thread are destroyed by subsequent modifications (or by
+ * the destructor).
+ *
+ * The modification is not finished until all other threads stop using
+ * the old snapshot. This wait is done without the lock. It guarantees
+ * that there is no delivery to an unsubscribed agent after the return
+ * from modify_subscribers() (the same guarantee is provided by data_t).
+ * The current thread is not waited for: it can modify subscribers
+ * during the delivery (for example from a delivery filter) and
+ * the snapshot used by that delivery stays alive in the retired list.
+ *
+ * \note If all hazard slots of the current thread are in use then
+ * the delivery uses the lock.
+ *
+ * \attention Every modification allocates a new snapshot. Because of that
+ * unsubscription can throw std::bad_alloc. The lack of memory during
+ * drop_delivery_filter() (which is noexcept) leads to std::terminate().
+ */
+struct cow_data_t
+	{
+		//! Immutable snapshot of subscribers.
+		struct snapshot_t
+			{
+				//! Map of subscribers to messages.
+				messages_table_t m_subscribers;
+			};
+
+		cow_data_t( mbox_id_t id )
+			:	m_id{ id }
+			,	m_snapshot{ new snapshot_t() }
+			{}
+
+		~cow_data_t()
+			{
+				delete m_snapshot.load( std::memory_order_relaxed );
+			}
+
+		//! ID of this mbox.
+		const mbox_id_t m_id;
+
+		//! Lock for modifications of subscribers.
+		mutable std::mutex m_lock;
+
+		//! The current snapshot.
+		std::atomic< snapshot_t * > m_snapshot;
+
+		//! Replaced snapshots which can still be used by some threads.
+		/*!
+		 * \note Is protected by m_lock.
+		 */
+		std::vector< std::unique_ptr< snapshot_t > > m_retired;
+
+		//! Call \a action for subscribers from the current snapshot.
+		template< typename ACTION >
+		void
+		read_subscribers( ACTION && action ) const
+			{
+				hazard_ptr::guard_t guard;
+				if( guard.valid() )
+					action( guard.protect( m_snapshot )->m_subscribers );
+				else
+					{
+						std::lock_guard< std::mutex > lock( m_lock );
+						action( m_snapshot.load( std::memory_order_acquire )->
+								m_subscribers );
+					}
+			}
+
+		//! Call \a action for a copy of subscribers and publish the copy.
+		/*!
+		 * \note If \a action throws then the current snapshot is not changed.
+		 */
+		template< typename ACTION >
+		void
+		modify_subscribers( ACTION && action )
+			{
+				snapshot_t * old = nullptr;
+				{
+					std::lock_guard< std::mutex > lock( m_lock );
+
+					std::unique_ptr< snapshot_t > fresh{ new snapshot_t(
+							*m_snapshot.load( std::memory_order_relaxed ) ) };
+					action( fresh->m_subscribers );
+
+					// There must be no exceptions after the publishing
+					// of the fresh snapshot.
+					m_retired.reserve( m_retired.size() + 1 );
+
+					old = m_snapshot.exchange(
+							fresh.release(), std::memory_order_seq_cst );
+					m_retired.emplace_back( old );
+
+					m_retired.erase(
+							std::remove_if( m_retired.begin(), m_retired.end(),
+								[]( const std::unique_ptr< snapshot_t > & s ) {
+									return !hazard_ptr::is_protected( s.get() );
+								} ),
+							m_retired.end() );
+				}
+
+				// Deliveries of other threads which use the old snapshot
+				// must be finished. The old snapshot can already be destroyed
+				// by another modification, only the address is checked here.
+				while( hazard_ptr::is_protected_by_other_threads( old ) )
+					std::this_thread::yield();
+			}
+	};
+
+#endif
+
+//
+// fanout_buffer_t
+//
+
+/*!
+ * \since v.5.5.17
+ * \brief A buffer for delivery of one message to several subscribers
+ * without message limits.
+ *
+ * Subscribers are collected by add(). Then their event queues are
+ * acquired and subscribers are grouped by event queue. Every group is
+ * pushed by one call to event_queue_t::push_batch(). The reference counter
+ * of the message is incremented once for all subscribers.
+ *
+ * It means that there is one lock and one wakeup of a working thread
+ * for all subscribers bound to the same dispatcher's queue (for example
+ * for agents of one cooperation on thread_pool dispatcher with
+ * fifo_t::cooperation or for agents on the same one_thread dispatcher).
+ *
+ * \note The buffer is flushed automatically when it becomes full.
+ */
+class fanout_buffer_t
+	{
+		fanout_buffer_t( const fanout_buffer_t & ) = delete;
+		fanout_buffer_t &
+		operator=( const fanout_buffer_t & ) = delete;
+
+	public :
+		//! Max count of subscribers in the buffer.
+		static const std::size_t capacity = 64;
+
+		fanout_buffer_t(
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type,
+			msg_type_id_t msg_type_id,
+			const message_ref_t & message )
+			:	m_mbox_id( mbox_id )
+			,	m_msg_type( msg_type )
+			,	m_msg_type_id( msg_type_id )
+			,	m_message( message )
+			{}
+
+		//! Add yet another subscriber.
+		void
+		add( agent_t * subscriber )
+			{
+				if( capacity == m_size )
+					flush();
+
+				m_items[ m_size ].m_agent = subscriber;
+				++m_size;
+			}
+
+		//! Push the message to all collected subscribers.
+		void
+		flush()
+			{
+				if( 1 == m_size )
+					{
+						// There is nothing to be grouped.
+						m_size = 0;
+						agent_t::call_push_event(
+								*(m_items[ 0 ].m_agent),
+								message_limit::control_block_t::none(),
+								m_mbox_id,
+								m_msg_type,
+								m_message );
+					}
+				else if( m_size )
+					push_by_groups();
+			}
+
+	private :
+		//! Subscriber and its event queue.
+		struct item_t
+			{
+				agent_t * m_agent;
+				event_queue_t * m_queue;
+			};
+
+		//! Releaser of acquired event queues.
+		/*!
+		 * Event queues are released group by group as soon as the group
+		 * is pushed. The rest of them are released by the destructor.
+		 */
+		struct queues_releaser_t
+			{
+				item_t * m_items;
+				//! Index of the first item with not released event queue.
+				std::size_t m_first;
+				std::size_t m_count;
+
+				~queues_releaser_t()
+					{
+						release_until( m_count );
+					}
+
+				//! Release event queues of items until \a last.
+				void
+				release_until( std::size_t last )
+					{
+						for(; m_first != last; ++m_first )
+							agent_t::call_release_event_queue(
+									*(m_items[ m_first ].m_agent) );
+					}
+			};
+
+		const mbox_id_t m_mbox_id;
+		const std::type_index & m_msg_type;
+		const msg_type_id_t m_msg_type_id;
+		const message_ref_t & m_message;
+
+		item_t m_items[ capacity ];
+		std::size_t m_size = 0;
+
+		void
+		push_by_groups()
+			{
+				// Subscribers without event queues will be skipped.
+				std::size_t count = 0;
+				for( std::size_t i = 0; i != m_size; ++i )
+					{
+						auto q = agent_t::call_acquire_event_queue(
+								*(m_items[ i ].m_agent) );
+						if( q )
+							m_items[ count++ ] = item_t{ m_items[ i ].m_agent, q };
+					}
+				m_size = 0;
+
+				// Event queues must be held from the acquisition until
+				// the push: the grouping is made by pointers to them.
+				// Only the sort of at most capacity items and the making of
+				// demands (without memory allocations) are performed before
+				// the first push. Then every group releases its event queues
+				// right after its own push.
+				queues_releaser_t releaser{ m_items, 0, count };
+
+				std::sort( m_items, m_items + count,
+						[]( const item_t & a, const item_t & b ) {
+							return std::less< event_queue_t * >()( a.m_queue, b.m_queue );
+						} );
+
+				// All references to the message are counted by one operation.
+				// Demands become owners of those references immediately.
+				// If push_batch() throws then the rest of references will be
+				// released by destructors of demands.
+				if( m_message )
+					m_message->inc_ref_count( count );
+
+				execution_demand_t demands[ capacity ];
+				for( std::size_t i = 0; i != count; ++i )
+					demands[ i ] = execution_demand_t(
+							m_items[ i ].m_agent,
+							message_limit::control_block_t::none(),
+							m_mbox_id,
+							m_msg_type,
+							m_msg_type_id,
+							message_ref_t( m_message.get(), already_counted_ref_t{} ),
+							&agent_t::demand_handler_on_message );
+
+				for( std::size_t first = 0; first != count; )
+					{
+						auto last = first + 1;
+						while( last != count &&
+								m_items[ last ].m_queue == m_items[ first ].m_queue )
+							++last;
+
+						m_items[ first ].m_queue->push_batch(
+								demands + first, last - first );
+						releaser.release_until( last );
+
+						first = last;
+					}
+			}
 	};
 
 } /* namespace local_mbox_details */
@@ -702,13 +1117,24 @@ struct data_t
  * \since v.5.5.9
  * \tparam TRACING_BASE base class with implementation of message
  * delivery tracing methods.
+ * \tparam DATA type of data with subscribers of the mbox (since v.5.5.17).
+ * It can be local_mbox_details::data_t or local_mbox_details::cow_data_t.
+ *
+ * \note Since v.5.5.17 DATA, TRACING_BASE and helper methods are protected
+ * because the template is used as a base for retained_msg_mbox_template.
  */
-template< typename TRACING_BASE >
+template<
+	typename TRACING_BASE,
+	typename DATA = local_mbox_details::data_t< default_rw_spinlock_t > >
 class local_mbox_template
 	:	public abstract_message_box_t
-	,	private local_mbox_details::data_t
-	,	private TRACING_BASE
+	,	protected DATA
+	,	protected TRACING_BASE
 	{
+		using data_type = DATA;
+
+		using data_type::m_id;
+
 	public:
 		template< typename... TRACING_ARGS >
 		local_mbox_template(
@@ -716,7 +1142,7 @@ class local_mbox_template
 			mbox_id_t id,
 			//! Optional parameters for TRACING_BASE's constructor.
 			TRACING_ARGS &&... args )
-			:	local_mbox_details::data_t{ id }
+			:	data_type{ id }
 			,	TRACING_BASE{ std::forward< TRACING_ARGS >(args)... }
 			{}
 
@@ -778,6 +1204,8 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const override
 			{
+				local_mbox_details::ensure_immutable_message( msg_type, message );
+
 				typename TRACING_BASE::deliver_op_tracer tracer{
 						*this, // as TRACING_BASE
 						*this, // as abstract_message_box_t
@@ -791,6 +1219,58 @@ class local_mbox_template
 						overlimit_reaction_deep );
 			}
 
+		/*!
+		 * \since v.5.5.17
+		 *
+		 * The mbox is locked only once. Messages are pushed to
+		 * subscribers without message limits by event_queue_t::push_batch().
+		 */
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				for( std::size_t i = 0; i != count; ++i )
+					local_mbox_details::ensure_immutable_message(
+							msg_type, messages[ i ] );
+
+				this->read_subscribers(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( query_msg_type_id( msg_type ) );
+						if( it != subscribers.end() )
+							{
+								for( const auto & a : it->second )
+									if( a.can_receive_batch() )
+										do_deliver_message_batch_to_subscriber(
+												a,
+												msg_type,
+												messages,
+												count,
+												overlimit_reaction_deep );
+									else
+										// Message limit must be checked for every message.
+										for( std::size_t i = 0; i != count; ++i )
+											do_deliver_message_to_subscriber(
+													a,
+													make_deliver_op_tracer(
+															msg_type,
+															messages[ i ],
+															overlimit_reaction_deep ),
+													msg_type,
+													messages[ i ],
+													overlimit_reaction_deep );
+							}
+						else
+							for( std::size_t i = 0; i != count; ++i )
+								make_deliver_op_tracer(
+										msg_type,
+										messages[ i ],
+										overlimit_reaction_deep ).no_subscribers();
+					} );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -841,7 +1321,7 @@ class local_mbox_template
 						} );
 			}
 
-	private :
+	protected :
 		template< typename INFO_MAKER, typename INFO_CHANGER >
 		void
 		insert_or_modify_subscriber(
@@ -850,33 +1330,36 @@ class local_mbox_template
 			INFO_MAKER maker,
 			INFO_CHANGER changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
-				{
-					// There isn't such message type yet.
-					local_mbox_details::subscriber_adaptive_container_t container;
-					container.insert( maker() );
-
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
-				}
-				else
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Agent is already in subscribers list.
-						// But its state must be updated.
-						changer( *pos );
-					}
-					else
-						// There is no subscriber in the container.
-						// It must be added.
-						agents.insert( maker() );
-				}
+				this->modify_subscribers(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( query_msg_type_id( type_wrapper ) );
+						if( it == subscribers.end() )
+						{
+							// There isn't such message type yet.
+							local_mbox_details::subscriber_adaptive_container_t container;
+							container.insert( maker() );
+
+							subscribers.emplace(
+									query_msg_type_id( type_wrapper ),
+									std::move( container ) );
+						}
+						else
+						{
+							auto & agents = it->second;
+
+							auto pos = agents.find( subscriber );
+							if( pos != agents.end() )
+							{
+								// Agent is already in subscribers list.
+								// But its state must be updated.
+								changer( *pos );
+							}
+							else
+								// There is no subscriber in the container.
+								// It must be added.
+								agents.insert( maker() );
+						}
+					} );
 			}
 
 		template< typename INFO_CHANGER >
@@ -886,28 +1369,29 @@ class local_mbox_template
 			agent_t * subscriber,
 			INFO_CHANGER changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Subscriber is found and must be modified.
-						changer( *pos );
+				this->modify_subscribers(
+					[&]( local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( query_msg_type_id( type_wrapper ) );
+						if( it != subscribers.end() )
+						{
+							auto & agents = it->second;
+
+							auto pos = agents.find( subscriber );
+							if( pos != agents.end() )
+							{
+								// Subscriber is found and must be modified.
+								changer( *pos );
 
-						// If info about subscriber becomes empty after modification
-						// then subscriber info must be removed.
-						if( pos->empty() )
-							agents.erase( pos );
-					}
+								// If info about subscriber becomes empty after
+								// modification then subscriber info must be removed.
+								if( pos->empty() )
+									agents.erase( pos );
+							}
 
-					if( agents.empty() )
-						m_subscribers.erase( it );
-				}
+							if( agents.empty() )
+								subscribers.erase( it );
+						}
+					} );
 			}
 
 		void
@@ -917,21 +1401,57 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+				this->read_subscribers(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						const auto msg_type_id = query_msg_type_id( msg_type );
+						auto it = subscribers.find( msg_type_id );
+						if( it != subscribers.end() )
+							{
+								// Since v.5.5.17 subscribers without message limits
+								// receive the message via fan-out buffer.
+								local_mbox_details::fanout_buffer_t fanout{
+										m_id, msg_type, msg_type_id, message };
+
+								for( const auto & a : it->second )
+									if( a.can_receive_batch() )
+										add_subscriber_to_fanout(
+												a,
+												tracer,
+												message,
+												fanout );
+									else
+										do_deliver_message_to_subscriber(
+												a,
+												tracer,
+												msg_type,
+												message,
+												overlimit_reaction_deep );
+
+								fanout.flush();
+							}
+						else
+							tracer.no_subscribers();
+					} );
+			}
+
+		void
+		add_subscriber_to_fanout(
+			const local_mbox_details::subscriber_info_t & agent_info,
+			typename TRACING_BASE::deliver_op_tracer const & tracer,
+			const message_ref_t & message,
+			local_mbox_details::fanout_buffer_t & fanout ) const
+			{
+				const auto delivery_status =
+						agent_info.must_be_delivered( *(message.get()) );
 
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
+				if( delivery_possibility_t::must_be_delivered == delivery_status )
 					{
-						for( const auto & a : it->second )
-							do_deliver_message_to_subscriber(
-									a,
-									tracer,
-									msg_type,
-									message,
-									overlimit_reaction_deep );
+						tracer.push_to_queue( agent_info.subscriber_pointer() );
+						fanout.add( agent_info.subscriber_pointer() );
 					}
 				else
-					tracer.no_subscribers();
+					tracer.message_rejected(
+							agent_info.subscriber_pointer(), delivery_status );
 			}
 
 		void
@@ -973,41 +1493,104 @@ class local_mbox_template
 							agent_info.subscriber_pointer(), delivery_status );
 			}
 
-		void
-		do_deliver_service_request_impl(
-			typename TRACING_BASE::deliver_op_tracer const & tracer,
+		typename TRACING_BASE::deliver_op_tracer
+		make_deliver_op_tracer(
 			const std::type_index & msg_type,
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const
 			{
-				using namespace so_5::message_limit::impl;
+				return typename TRACING_BASE::deliver_op_tracer{
+						*this, // as TRACING_BASE
+						*this, // as abstract_message_box_t
+						"deliver_message",
+						msg_type, message, overlimit_reaction_deep };
+			}
 
-				msg_service_request_base_t::dispatch_wrapper( message,
-					[&] {
-						read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+		/*!
+		 * \since v.5.5.17
+		 * \brief Push several messages to a subscriber without message limit.
+		 *
+		 * Messages rejected by the delivery filter split the batch into
+		 * continuous ranges. Every range is pushed at once.
+		 */
+		void
+		do_deliver_message_batch_to_subscriber(
+			const local_mbox_details::subscriber_info_t & agent_info,
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const
+			{
+				const auto push_range = [&]( std::size_t first, std::size_t last ) {
+						if( first != last )
+							agent_t::call_push_event_batch(
+									agent_info.subscriber_reference(),
+									m_id,
+									msg_type,
+									messages + first,
+									last - first );
+					};
 
-						auto it = m_subscribers.find( msg_type );
+				std::size_t first = 0;
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						const auto tracer = make_deliver_op_tracer(
+								msg_type, messages[ i ], overlimit_reaction_deep );
+
+						const auto delivery_status =
+								agent_info.must_be_delivered( *(messages[ i ].get()) );
 
-						if( it == m_subscribers.end() )
+						if( delivery_possibility_t::must_be_delivered == delivery_status )
+							tracer.push_to_queue( agent_info.subscriber_pointer() );
+						else
 							{
-								tracer.no_subscribers();
+								push_range( first, i );
+								first = i + 1;
 
-								SO_5_THROW_EXCEPTION(
-										so_5::rc_no_svc_handlers,
-										"no service handlers (no subscribers for message)" );
+								tracer.message_rejected(
+										agent_info.subscriber_pointer(), delivery_status );
 							}
+					}
 
-						if( 1 != it->second.size() )
-							SO_5_THROW_EXCEPTION(
-									so_5::rc_more_than_one_svc_handler,
-									"more than one service handler found" );
+				push_range( first, count );
+			}
 
-						do_deliver_service_request_to_subscriber(
-								tracer,
-								*(it->second.begin()),
-								msg_type,
-								message,
-								overlimit_reaction_deep );
+		void
+		do_deliver_service_request_impl(
+			typename TRACING_BASE::deliver_op_tracer const & tracer,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const
+			{
+				using namespace so_5::message_limit::impl;
+
+				msg_service_request_base_t::dispatch_wrapper( message,
+					[&] {
+						this->read_subscribers(
+							[&]( const local_mbox_details::messages_table_t & subscribers ) {
+								auto it = subscribers.find( query_msg_type_id( msg_type ) );
+
+								if( it == subscribers.end() )
+									{
+										tracer.no_subscribers();
+
+										SO_5_THROW_EXCEPTION(
+												so_5::rc_no_svc_handlers,
+												"no service handlers (no subscribers for message)" );
+									}
+
+								if( 1 != it->second.size() )
+									SO_5_THROW_EXCEPTION(
+											so_5::rc_more_than_one_svc_handler,
+											"more than one service handler found" );
+
+								do_deliver_service_request_to_subscriber(
+										tracer,
+										*(it->second.begin()),
+										msg_type,
+										message,
+										overlimit_reaction_deep );
+							} );
 					} );
 			}
 
@@ -1077,6 +1660,50 @@ using local_mbox_without_tracing =
 using local_mbox_with_tracing =
 	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \since v.5.5.17
+ * \brief Alias for local mbox without message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::data_t< null_rw_spinlock_t > >;
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for local mbox with message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::data_t< null_rw_spinlock_t > >;
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for local mbox without message delivery tracing
+ * and with copy-on-write snapshots of subscribers.
+ */
+using cow_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::cow_data_t >;
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for local mbox with message delivery tracing
+ * and with copy-on-write snapshots of subscribers.
+ */
+using cow_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::cow_data_t >;
+
+#endif
+
 } /* namespace impl */
 
 } /* namespace so_5 */
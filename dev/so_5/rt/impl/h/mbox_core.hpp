@@ -9,9 +9,11 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <functional>
 #include <mutex>
@@ -19,6 +21,8 @@
 #include <so_5/h/atomic_refcounted.hpp>
 #include <so_5/h/msg_tracing.hpp>
 
+#include <so_5/details/h/cache_line.hpp>
+
 #include <so_5/rt/h/mbox.hpp>
 #include <so_5/rt/h/mchain.hpp>
 #include <so_5/rt/h/nonempty_name.hpp>
@@ -69,7 +73,21 @@ class mbox_core_t
 		mbox_core_t(
 			//! Optional tracer for message delivery tracing.
 			//! Value nullptr means that message delivery tracing is disabled.
-			so_5::msg_tracing::tracer_t * tracer );
+			so_5::msg_tracing::tracer_t * tracer,
+			//! Are mboxes created for single-threaded environment?
+			/*!
+			 * \since v.5.5.17
+			 *
+			 * If true then local and MPSC mboxes do not use locks.
+			 */
+			bool single_threaded,
+			//! Must local mboxes use copy-on-write snapshots of subscribers?
+			/*!
+			 * \since v.5.5.17
+			 *
+			 * Ignored if \a single_threaded is true.
+			 */
+			bool cow_subscribers );
 		virtual ~mbox_core_t();
 
 		//! Create local anonymous mbox.
@@ -91,6 +109,14 @@ class mbox_core_t
 			//! Mbox name.
 			const nonempty_name_t & mbox_name );
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Create anonymous mbox which retains the last message
+		 * of every type.
+		 */
+		mbox_t
+		create_retained_msg_mbox();
+
 		/*!
 		 * \since v.5.4.0
 		 * \brief Create anonymous mpsc_mbox.
@@ -143,8 +169,17 @@ class mbox_core_t
 		 */
 		so_5::msg_tracing::tracer_t * const m_tracer;
 
-		//! Named mbox map's lock.
-		std::mutex m_dictionary_lock;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Are mboxes created for single-threaded environment?
+		 */
+		const bool m_single_threaded;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Must local mboxes use copy-on-write snapshots of subscribers?
+		 */
+		const bool m_cow_subscribers;
 
 		//! Named mbox information.
 		struct named_mbox_info_t
@@ -168,11 +203,54 @@ class mbox_core_t
 		};
 
 		//! Typedef for the map from the mbox name to the mbox information.
-		typedef std::map< std::string, named_mbox_info_t >
+		/*!
+		 * \note Since v.5.5.17 it is a hash table.
+		 */
+		typedef std::unordered_map< std::string, named_mbox_info_t >
 			named_mboxes_dictionary_t;
 
-		//! Named mboxes.
-		named_mboxes_dictionary_t m_named_mboxes_dictionary;
+		/*!
+		 * \since v.5.5.17
+		 * \brief A part of the dictionary of named mboxes with its own lock.
+		 *
+		 * Named mboxes are distributed between shards by hash of the name.
+		 * Creation and destruction of named mboxes with different names
+		 * from different threads do not contend on the same lock.
+		 */
+		struct named_mboxes_shard_t
+		{
+			//! Shard's lock.
+			std::mutex m_lock;
+
+			//! Named mboxes of the shard.
+			named_mboxes_dictionary_t m_dictionary;
+
+			//! Locks of neighboring shards must not share a cache line.
+			so_5::details::cache_line_padding_t m_padding;
+		};
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Count of shards of the named mboxes dictionary.
+		 */
+		static const std::size_t named_mboxes_shards_count = 32;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Named mboxes.
+		 *
+		 * \note Before v.5.5.17 there was one std::map protected by
+		 * one mutex.
+		 */
+		std::array< named_mboxes_shard_t, named_mboxes_shards_count >
+			m_named_mboxes_shards;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Find the shard for the mbox name.
+		 */
+		named_mboxes_shard_t &
+		shard_for_name( const std::string & name );
 
 		/*!
 		 * \since v.5.4.0
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <so_5/rt/h/message_limit.hpp>
+#include <so_5/rt/h/msg_type_id.hpp>
 
 #include <vector>
 #include <algorithm>
@@ -38,6 +39,12 @@ struct info_block_t
 		//! Type of the message.
 		std::type_index m_msg_type;
 
+		//! Integer identifier of the message type.
+		/*!
+		 * \since v.5.5.17
+		 */
+		msg_type_id_t m_msg_type_id;
+
 		//! Run-time data for the message type.
 		control_block_t m_control_block;
 
@@ -48,9 +55,15 @@ struct info_block_t
 			//! Limit for that message type.
 			unsigned int limit,
 			//! Reaction to the limit overflow.
-			action_t action )
+			action_t action,
+			//! Parameters of the rate limit.
+			const rate_t & rate,
+			//! Optional storage for conflation of messages.
+			conflation_storage_shptr_t conflation )
 			:	m_msg_type( std::move( msg_type ) )
-			,	m_control_block( limit, std::move( action ) )
+			,	m_msg_type_id( query_msg_type_id( m_msg_type ) )
+			,	m_control_block(
+					limit, rate, std::move( action ), std::move( conflation ) )
 			{}
 	};
 
@@ -87,7 +100,17 @@ class info_storage_t
 		inline const control_block_t *
 		find( const std::type_index & msg_type ) const
 			{
-				auto r = find_block( msg_type );
+				return find( query_msg_type_id( msg_type ) );
+			}
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Search by integer identifier of the message type.
+		 */
+		inline const control_block_t *
+		find( msg_type_id_t msg_type_id ) const
+			{
+				auto r = find_block( msg_type_id );
 
 				if( r )
 					return &(r->m_control_block);
@@ -131,20 +154,22 @@ class info_storage_t
 							return info_block_t{
 									d.m_msg_type,
 									d.m_limit,
-									std::move( d.m_action )
+									std::move( d.m_action ),
+									d.m_rate,
+									std::move( d.m_conflation )
 								};
 						} );
 
 				// Result must be sorted.
 				sort( begin( result ), end( result ),
 						[]( const info_block_t & a, const info_block_t & b ) {
-							return a.m_msg_type < b.m_msg_type;
+							return a.m_msg_type_id < b.m_msg_type_id;
 						} );
 
 				// There must not be duplicates.
 				auto duplicate = adjacent_find( begin( result ), end( result ),
 						[]( const info_block_t & a, const info_block_t & b ) {
-							return a.m_msg_type == b.m_msg_type;
+							return a.m_msg_type_id == b.m_msg_type_id;
 						} );
 				if( duplicate != end( result ) )
 					SO_5_THROW_EXCEPTION( rc_several_limits_for_one_message_type,
@@ -156,19 +181,19 @@ class info_storage_t
 
 		//! Search for info_block.
 		inline const info_block_t *
-		find_block( const std::type_index & msg_type ) const
+		find_block( msg_type_id_t msg_type_id ) const
 			{
 				if( m_small_container )
-					return find_block_in_small_container( msg_type );
+					return find_block_in_small_container( msg_type_id );
 				else
-					return find_block_in_large_container( msg_type );
+					return find_block_in_large_container( msg_type_id );
 			}
 
 
 		//! Search for info_block in the small container.
 		inline const info_block_t *
 		find_block_in_small_container(
-			const std::type_index & msg_type ) const
+			msg_type_id_t msg_type_id ) const
 			{
 				using namespace std;
 
@@ -176,7 +201,7 @@ class info_storage_t
 				// on a small containers.
 				auto r = find_if( begin( m_blocks ), end( m_blocks ),
 						[&]( const info_block_t & blk ) {
-							return blk.m_msg_type == msg_type;
+							return blk.m_msg_type_id == msg_type_id;
 						} );
 				if( r != end( m_blocks ) )
 					return &(*r);
@@ -187,7 +212,7 @@ class info_storage_t
 		//! Search for info_block in the large container.
 		inline const info_block_t *
 		find_block_in_large_container(
-			const std::type_index & msg_type ) const
+			msg_type_id_t msg_type_id ) const
 			{
 				using namespace std;
 
@@ -199,9 +224,9 @@ class info_storage_t
 					{
 						auto step = count / 2;
 						auto middle = left + step;
-						if( middle->m_msg_type == msg_type )
+						if( middle->m_msg_type_id == msg_type_id )
 							return &(*middle);
-						else if( middle->m_msg_type < msg_type )
+						else if( middle->m_msg_type_id < msg_type_id )
 							{
 								left = middle + 1;
 								count -= step + 1;
@@ -279,7 +304,11 @@ try_to_deliver_to_agent(
 	//! Actual delivery action.
 	LAMBDA delivery_action )
 {
-	if( limit && ( limit->m_limit < ++(limit->m_count) ) )
+	// Since v.5.5.17 the rate limit is checked too. The rate limit is
+	// checked after the count limit because a token must not be
+	// consumed for a message which will be rejected anyway.
+	if( limit && ( limit->m_limit < ++(limit->m_count) ||
+			!limit->consume_rate_token() ) )
 	{
 		--(limit->m_count);
 
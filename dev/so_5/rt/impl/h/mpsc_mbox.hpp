@@ -39,8 +39,14 @@ namespace impl
  * without controling message limits.
  * \note Renamed from limitless_mpsc_mbox_t to limitless_mpsc_mbox_template
  * in v.5.5.9.
+ *
+ * \tparam TRACING_BASE base class with implementation of message
+ * delivery tracing methods.
+ * \tparam LOCK_TYPE type of lock for the mbox (since v.5.5.17).
  */
-template< typename TRACING_BASE >
+template<
+	typename TRACING_BASE,
+	typename LOCK_TYPE = default_rw_spinlock_t >
 class limitless_mpsc_mbox_template
 	:	public abstract_message_box_t
 	,	protected TRACING_BASE
@@ -68,7 +74,7 @@ class limitless_mpsc_mbox_template
 			const message_limit::control_block_t * /*limit*/,
 			agent_t * subscriber ) override
 			{
-				std::lock_guard< default_rw_spinlock_t > lock{ m_lock };
+				std::lock_guard< LOCK_TYPE > lock{ m_lock };
 
 				if( subscriber != m_single_consumer )
 					SO_5_THROW_EXCEPTION(
@@ -82,7 +88,7 @@ class limitless_mpsc_mbox_template
 			const std::type_index & /*msg_type*/,
 			agent_t * subscriber ) override
 			{
-				std::lock_guard< default_rw_spinlock_t > lock{ m_lock };
+				std::lock_guard< LOCK_TYPE > lock{ m_lock };
 
 				if( subscriber != m_single_consumer )
 					SO_5_THROW_EXCEPTION(
@@ -133,6 +139,38 @@ class limitless_mpsc_mbox_template
 				} );
 			}
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				read_lock_guard_t< LOCK_TYPE > lock{ m_lock };
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						typename TRACING_BASE::deliver_op_tracer tracer{
+								*this, // as TRACING_BASE
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, messages[ i ], overlimit_reaction_deep };
+
+						if( m_subscriptions_count )
+							tracer.push_to_queue( m_single_consumer );
+						else
+							tracer.no_subscribers();
+					}
+
+				if( m_subscriptions_count )
+					agent_t::call_push_event_batch(
+							*m_single_consumer,
+							m_id,
+							msg_type,
+							messages,
+							count );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -194,7 +232,7 @@ class limitless_mpsc_mbox_template
 		 * \since v.5.5.9
 		 * \brief Protection of object from modification.
 		 */
-		mutable default_rw_spinlock_t m_lock;
+		mutable LOCK_TYPE m_lock;
 
 		/*!
 		 * \since v.5.5.9
@@ -219,7 +257,7 @@ class limitless_mpsc_mbox_template
 			//! Lambda with actual delivery actions.
 			L l ) const
 		{
-			read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+			read_lock_guard_t< LOCK_TYPE > lock{ m_lock };
 
 			if( m_subscriptions_count )
 				l();
@@ -242,6 +280,26 @@ using limitless_mpsc_mbox_without_tracing =
 using limitless_mpsc_mbox_with_tracing =
 	limitless_mpsc_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \since v.5.5.17
+ * \brief Alias for limitless_mpsc_mbox without message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_limitless_mpsc_mbox_without_tracing =
+	limitless_mpsc_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			null_rw_spinlock_t >;
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for limitless_mpsc_mbox with message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_limitless_mpsc_mbox_with_tracing =
+	limitless_mpsc_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			null_rw_spinlock_t >;
+
 //
 // limitful_mpsc_mbox_template
 //
@@ -257,12 +315,17 @@ using limitless_mpsc_mbox_with_tracing =
  * \attention Stores a reference to message limits storage. Because of that
  * this reference must remains correct till the end of the mbox's lifetime.
  *
+ * \tparam TRACING_BASE base class with implementation of message
+ * delivery tracing methods.
+ * \tparam LOCK_TYPE type of lock for the mbox (since v.5.5.17).
  */
-template< typename TRACING_BASE >
+template<
+	typename TRACING_BASE,
+	typename LOCK_TYPE = default_rw_spinlock_t >
 class limitful_mpsc_mbox_template
-	:	public limitless_mpsc_mbox_template< TRACING_BASE >
+	:	public limitless_mpsc_mbox_template< TRACING_BASE, LOCK_TYPE >
 {
-		using base_type = limitless_mpsc_mbox_template< TRACING_BASE >;
+		using base_type = limitless_mpsc_mbox_template< TRACING_BASE, LOCK_TYPE >;
 	public:
 		template< typename... TRACING_ARGS >
 		limitful_mpsc_mbox_template(
@@ -320,6 +383,22 @@ class limitful_mpsc_mbox_template
 				} );
 			}
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				if( m_limits.find( msg_type ) )
+					// Message limit must be checked for every message.
+					abstract_message_box_t::do_deliver_message_batch(
+							msg_type, messages, count, overlimit_reaction_deep );
+				else
+					base_type::do_deliver_message_batch(
+							msg_type, messages, count, overlimit_reaction_deep );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -379,6 +458,26 @@ using limitful_mpsc_mbox_without_tracing =
 using limitful_mpsc_mbox_with_tracing =
 	limitful_mpsc_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \since v.5.5.17
+ * \brief Alias for limitful_mpsc_mbox without message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_limitful_mpsc_mbox_without_tracing =
+	limitful_mpsc_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			null_rw_spinlock_t >;
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for limitful_mpsc_mbox with message delivery tracing
+ * and without locking (for single-threaded environment).
+ */
+using st_limitful_mpsc_mbox_with_tracing =
+	limitful_mpsc_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			null_rw_spinlock_t >;
+
 } /* namespace impl */
 
 } /* namespace so_5 */
@@ -73,6 +73,13 @@ class named_local_mbox_t
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const override;
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override;
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
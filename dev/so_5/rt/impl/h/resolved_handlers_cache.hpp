@@ -0,0 +1,230 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Tables of event handlers resolved with respect to
+ * parent states.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// resolved_handlers_table_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A table of event handlers for one state.
+ *
+ * Contains handlers from the state itself and handlers inherited from
+ * all parent states. So the search of event handler is performed by
+ * one lookup without walking through parent states.
+ */
+class resolved_handlers_table_t
+	{
+	public :
+		//! Find a handler.
+		/*!
+		 * \return nullptr if there is no handler.
+		 */
+		const event_handler_data_t *
+		find( mbox_id_t mbox_id, msg_type_id_t msg_type_id ) const
+			{
+				auto it = m_handlers.find( key_t{ mbox_id, msg_type_id } );
+				if( it != m_handlers.end() )
+					return it->second;
+				else
+					return nullptr;
+			}
+
+		//! Build the table for the state.
+		/*!
+		 * The state is specified by the path from the root state.
+		 */
+		void
+		build(
+			const state_t::path_t & path_from_root,
+			std::size_t nested_level,
+			const subscription_storage_t & storage )
+			{
+				using namespace std;
+
+				// All states which are visible from the state.
+				// The nearest state goes first.
+				vector< const state_t * > path;
+				path.reserve( nested_level + 1 );
+				for( auto i = nested_level + 1; i; --i )
+					path.push_back( path_from_root[ i - 1 ] );
+
+				const auto content = storage.query_content();
+
+				handlers_map_t handlers;
+				for( const auto & i : content )
+					{
+						if( path.end() == std::find( path.begin(), path.end(), i.m_state ) )
+							continue;
+
+						const key_t key{ i.m_mbox->id(), i.m_msg_type_id };
+						if( handlers.count( key ) )
+							continue;
+
+						// Handler from the nearest state must be used.
+						for( auto s : path )
+							{
+								auto h = storage.find_handler(
+										key.m_mbox_id, key.m_msg_type_id, *s );
+								if( h )
+									{
+										handlers.emplace( key, h );
+										break;
+									}
+							}
+					}
+
+				m_handlers.swap( handlers );
+			}
+
+	private :
+		//! Key for the table.
+		struct key_t
+			{
+				mbox_id_t m_mbox_id;
+				msg_type_id_t m_msg_type_id;
+
+				bool
+				operator==( const key_t & o ) const
+					{
+						return m_mbox_id == o.m_mbox_id &&
+								m_msg_type_id == o.m_msg_type_id;
+					}
+			};
+
+		//! Hash function for the key.
+		struct hash_t
+			{
+				std::size_t
+				operator()( const key_t & k ) const
+					{
+						const std::size_t h1 = std::hash< mbox_id_t >()( k.m_mbox_id );
+						return h1 ^ (std::hash< msg_type_id_t >()( k.m_msg_type_id ) +
+								0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+					}
+			};
+
+		using handlers_map_t = std::unordered_map<
+				key_t,
+				const event_handler_data_t *,
+				hash_t >;
+
+		//! Handlers for the state.
+		/*!
+		 * \note Pointers to handlers are owned by subscription storage.
+		 * They are valid until the first change of subscriptions.
+		 */
+		handlers_map_t m_handlers;
+	};
+
+//
+// resolved_handlers_cache_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A cache of resolved handler tables for agent's states.
+ *
+ * A table is built only for a state with parent states and only when
+ * the state is entered several times without changes of subscriptions.
+ * It prevents the building of tables for states which subscribe to
+ * something in on_enter handlers (for example states with time limits).
+ *
+ * All tables are destroyed when subscriptions are changed.
+ */
+class resolved_handlers_cache_t
+	{
+	public :
+		//! How many times a state must be entered before the building
+		//! of its table.
+		static const unsigned int entries_before_build = 2;
+
+		//! Get a table for the state which is entered.
+		/*!
+		 * The state is specified by the path from the root state.
+		 *
+		 * \return nullptr if there is no table for the state yet.
+		 */
+		const resolved_handlers_table_t *
+		on_enter(
+			const state_t::path_t & path_from_root,
+			std::size_t nested_level,
+			const subscription_storage_t & storage )
+			{
+				auto & item = m_items[ path_from_root[ nested_level ] ];
+				if( !item.m_table && ++item.m_entries >= entries_before_build )
+					build( item, path_from_root, nested_level, storage );
+
+				return item.m_table.get();
+			}
+
+		//! Get a table for the state without waiting for several entries.
+		const resolved_handlers_table_t *
+		query_table(
+			const state_t::path_t & path_from_root,
+			std::size_t nested_level,
+			const subscription_storage_t & storage )
+			{
+				auto & item = m_items[ path_from_root[ nested_level ] ];
+				if( !item.m_table )
+					build( item, path_from_root, nested_level, storage );
+
+				return item.m_table.get();
+			}
+
+		//! Destroy all tables.
+		void
+		invalidate() SO_5_NOEXCEPT
+			{
+				m_items.clear();
+			}
+
+	private :
+		//! Information about one state.
+		struct item_t
+			{
+				unsigned int m_entries = 0;
+				std::unique_ptr< resolved_handlers_table_t > m_table;
+			};
+
+		std::unordered_map< const state_t *, item_t > m_items;
+
+		static void
+		build(
+			item_t & item,
+			const state_t::path_t & path_from_root,
+			std::size_t nested_level,
+			const subscription_storage_t & storage )
+			{
+				std::unique_ptr< resolved_handlers_table_t > table{
+						new resolved_handlers_table_t() };
+				table->build( path_from_root, nested_level, storage );
+
+				item.m_table = std::move( table );
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
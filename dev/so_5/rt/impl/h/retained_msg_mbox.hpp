@@ -0,0 +1,243 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+	\file
+	\brief A definition of local mbox which retains the last message
+	of every type.
+
+	\since
+	v.5.5.17
+*/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <typeindex>
+
+#include <so_5/rt/impl/h/local_mbox.hpp>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// retained_msg_mbox_template
+//
+
+//! A template with implementation of local mbox which retains
+//! the last message of every type.
+/*!
+ * The last message (or signal) of every type is stored inside the mbox.
+ * When a new subscriber subscribes to a message type the retained
+ * message of that type is delivered to the new subscriber immediately.
+ *
+ * The retained message is delivered with respect to delivery filters
+ * and message limits of the new subscriber. If the subscription is made
+ * before the binding of the subscriber to a dispatcher (for example
+ * in so_define_agent()) then the message will be handled right after
+ * so_evt_start().
+ *
+ * The retained message is updated under the lock before the delivery
+ * of a new message. A new subscription is made before the retained
+ * message is read under the same lock. The deliveries are done without
+ * that lock. So nothing is lost for a new subscriber which subscribes
+ * while a new message is sent: it receives the new message either as
+ * the retained one or as an ordinary one. But it can receive the new
+ * message twice or receive the previous retained message after
+ * the new one.
+ *
+ * \note Service requests are not retained.
+ *
+ * \tparam TRACING_BASE base class with implementation of message
+ * delivery tracing methods.
+ *
+ * \since
+ * v.5.5.17
+ */
+template< typename TRACING_BASE >
+class retained_msg_mbox_template
+	:	public local_mbox_template< TRACING_BASE >
+	{
+		using base_type = local_mbox_template< TRACING_BASE >;
+
+	public:
+		template< typename... TRACING_ARGS >
+		retained_msg_mbox_template(
+			//! ID of this mbox.
+			mbox_id_t id,
+			//! Optional parameters for TRACING_BASE's constructor.
+			TRACING_ARGS &&... args )
+			:	base_type{ id, std::forward< TRACING_ARGS >(args)... }
+			{}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & type_wrapper,
+			const so_5::message_limit::control_block_t * limit,
+			agent_t * subscriber ) override
+			{
+				bool is_new_subscriber = false;
+				this->insert_or_modify_subscriber(
+						type_wrapper,
+						subscriber,
+						[&] {
+							is_new_subscriber = true;
+							return local_mbox_details::subscriber_info_t{
+									subscriber, limit };
+						},
+						[&]( local_mbox_details::subscriber_info_t & info ) {
+							is_new_subscriber = !info.has_subscriptions();
+							info.set_limit( limit );
+						} );
+
+				if( !is_new_subscriber )
+					return;
+
+				// The retained message is read after the subscription is made.
+				// A message which isn't retained yet will be delivered to
+				// the new subscriber by an ordinary delivery.
+				message_ref_t retained;
+				{
+					std::lock_guard< std::mutex > lock{ m_retained_lock };
+
+					auto it = m_retained_messages.find( type_wrapper );
+					if( it == m_retained_messages.end() )
+						return;
+					retained = it->second;
+				}
+
+				deliver_retained_message( type_wrapper, retained, *subscriber );
+			}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mbox:type=MPMC:retained:id=" << this->id() << ">";
+
+				return s.str();
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				{
+					std::lock_guard< std::mutex > lock{ m_retained_lock };
+					m_retained_messages[ msg_type ] = message;
+				}
+
+				base_type::do_deliver_message(
+						msg_type, message, overlimit_reaction_deep );
+			}
+
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				if( count )
+					{
+						std::lock_guard< std::mutex > lock{ m_retained_lock };
+						m_retained_messages[ msg_type ] = messages[ count - 1 ];
+					}
+
+				base_type::do_deliver_message_batch(
+						msg_type, messages, count, overlimit_reaction_deep );
+			}
+
+	private :
+		//! Lock for retained messages.
+		/*!
+		 * It is acquired only for access to m_retained_messages.
+		 * No other locks are acquired and no messages are delivered
+		 * while it is held.
+		 */
+		mutable std::mutex m_retained_lock;
+
+		//! The last messages of every type.
+		mutable std::map< std::type_index, message_ref_t > m_retained_messages;
+
+		//! Deliver the retained message to the new subscriber.
+		/*!
+		 * \note Must be called without m_retained_lock.
+		 */
+		void
+		deliver_retained_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			agent_t & subscriber ) const
+			{
+				this->read_subscribers(
+					[&]( const local_mbox_details::messages_table_t & subscribers ) {
+						auto it = subscribers.find( query_msg_type_id( msg_type ) );
+						if( it == subscribers.end() )
+							return;
+
+						auto pos = it->second.find( &subscriber );
+						if( pos == it->second.end() )
+							return;
+
+						const auto & agent_info = *pos;
+						const auto tracer = this->make_deliver_op_tracer(
+								msg_type, message, 0u );
+
+						const auto delivery_status =
+								agent_info.must_be_delivered( *(message.get()) );
+
+						if( delivery_possibility_t::must_be_delivered ==
+								delivery_status )
+							{
+								using namespace so_5::message_limit::impl;
+
+								try_to_deliver_to_agent(
+										invocation_type_t::event,
+										subscriber,
+										agent_info.limit(),
+										msg_type,
+										message,
+										0u,
+										tracer.overlimit_tracer(),
+										[&] {
+											tracer.push_to_queue( &subscriber );
+
+											agent_t::call_push_event_allowing_deferral(
+													subscriber,
+													agent_info.limit(),
+													this->id(),
+													msg_type,
+													message );
+										} );
+							}
+						else
+							tracer.message_rejected( &subscriber, delivery_status );
+					} );
+			}
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for retained message mbox without message delivery tracing.
+ */
+using retained_msg_mbox_without_tracing =
+	retained_msg_mbox_template< msg_tracing_helpers::tracing_disabled_base >;
+
+/*!
+ * \since v.5.5.17
+ * \brief Alias for retained message mbox with message delivery tracing.
+ */
+using retained_msg_mbox_with_tracing =
+	retained_msg_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
+
+} /* namespace impl */
+
+} /* namespace so_5 */
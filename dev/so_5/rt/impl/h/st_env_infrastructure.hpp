@@ -0,0 +1,190 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Infrastructure for single-threaded SObjectizer Environment.
+ */
+
+#pragma once
+
+#include <so_5/rt/h/disp.hpp>
+#include <so_5/rt/h/disp_binder.hpp>
+#include <so_5/rt/h/event_queue.hpp>
+
+#include <so_5/h/timers.hpp>
+#include <so_5/h/current_thread_id.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace so_5
+{
+
+class coop_t;
+
+namespace impl
+{
+
+namespace st_env
+{
+
+//
+// infrastructure_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Infrastructure for single-threaded SObjectizer Environment.
+ *
+ * Holds the event queue for all agents bound to the default dispatcher,
+ * the timer manager and the queue of cooperations waiting for the final
+ * deregistration. All of them are served on the thread which calls
+ * run_until(). It is the thread where environment_t::run() is called.
+ *
+ * There is no locks for the event queue and for the final deregistration
+ * queue. Because of that all agents must be bound to the default
+ * dispatcher and messages must not be sent from other threads.
+ *
+ * \note The only exception is environment_t::stop(). It can be called
+ * from any thread. The working thread is woken up by stop() method.
+ */
+class infrastructure_t
+	{
+		infrastructure_t( const infrastructure_t & ) = delete;
+		infrastructure_t &
+		operator=( const infrastructure_t & ) = delete;
+
+	public :
+		infrastructure_t(
+			//! Timer manager for delayed and periodic messages.
+			timer_manager_unique_ptr_t timer_manager );
+		~infrastructure_t();
+
+		//! Create the default dispatcher for the environment.
+		/*!
+		 * All agents bound to this dispatcher use the event queue of
+		 * the infrastructure.
+		 */
+		dispatcher_unique_ptr_t
+		make_default_dispatcher();
+
+		//! Create the timer thread for the environment.
+		/*!
+		 * There is no separate thread. Timers are handled inside
+		 * run_until().
+		 */
+		timer_thread_unique_ptr_t
+		make_timer_thread();
+
+		//! Store a cooperation for the final deregistration.
+		void
+		ready_to_deregister_notify(
+			//! Cooperation which is ready to be deregistered.
+			coop_t * coop );
+
+		//! Serve events, timers and final deregistrations until
+		//! \a stop_condition returns true.
+		void
+		run_until( const std::function< bool() > & stop_condition );
+
+		//! Initiate the stop and wake up the working thread if it sleeps.
+		/*!
+		 * \a stop_action is called under the lock used for waking up.
+		 * run_until() acquires that lock before the return. So the
+		 * environment can't be destroyed until the end of stop().
+		 *
+		 * \note This method is thread-safe.
+		 */
+		void
+		stop(
+			//! Action which makes the stop condition true.
+			const std::function< void() > & stop_action );
+
+	private :
+		//! Timer manager for delayed and periodic messages.
+		timer_manager_unique_ptr_t m_timer_manager;
+
+		//! Demands for agents bound to the default dispatcher.
+		std::deque< execution_demand_t > m_demands;
+
+		//! Event queue to be used by agents.
+		std::unique_ptr< so_5::event_queue_t > m_event_queue;
+
+		//! Cooperations waiting for the final deregistration.
+		std::deque< coop_t * > m_final_dereg_coops;
+
+		//! ID of the thread where run_until() is working.
+		current_thread_id_t m_thread_id;
+
+		/*!
+		 * \name Stuff for waking up the working thread.
+		 * \{
+		 */
+		std::mutex m_wakeup_lock;
+		std::condition_variable m_wakeup_cond;
+		bool m_wakeup_requested = { false };
+		/*!
+		 * \}
+		 */
+
+		//! Handle the demands which are in the queue at the moment.
+		/*!
+		 * New demands which are pushed during this call will be handled
+		 * on the next iteration. It allows to check timers and the stop
+		 * condition on a regular basis.
+		 */
+		void
+		process_demands();
+
+		//! Do the final deregistration for all waiting cooperations.
+		void
+		process_final_deregs();
+
+		//! Sleep until the nearest timer or a call to stop().
+		void
+		wait_for_timer_or_wakeup();
+	};
+
+//
+// default_disp_binder_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Binder to the default dispatcher.
+ *
+ * Binds agents to the default dispatcher of single-threaded environment
+ * if such dispatcher is used. Otherwise delegates all actions to
+ * the binder for the ordinary one_thread default dispatcher.
+ */
+class default_disp_binder_t : public so_5::disp_binder_t
+	{
+	public :
+		default_disp_binder_t(
+			//! Binder to be used in multi-threaded environment.
+			disp_binder_unique_ptr_t mt_binder );
+
+		virtual disp_binding_activator_t
+		bind_agent(
+			environment_t & env,
+			agent_ref_t agent_ref ) override;
+
+		virtual void
+		unbind_agent(
+			environment_t & env,
+			agent_ref_t agent_ref ) override;
+
+	private :
+		//! Binder to be used in multi-threaded environment.
+		const disp_binder_unique_ptr_t m_mt_binder;
+	};
+
+} /* namespace st_env */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
@@ -37,6 +37,13 @@ namespace impl
 struct event_handler_data_t
 	{
 		//! Method for handling event.
+		/*!
+		 * \note Since v.5.5.17 it is so_5::details::small_function_t.
+		 * Handlers for agent's methods and lambdas with small captures
+		 * are stored inside event_handler_data_t without dynamic
+		 * allocation. So the copying of subscriptions between
+		 * subscription storages allocates nothing for them.
+		 */
 		event_handler_method_t m_method;
 		//! Is event handler thread safe or not.
 		thread_safety_t m_thread_safety;
@@ -70,17 +77,24 @@ struct subscr_info_t
 		 */
 		mbox_t m_mbox;
 		std::type_index m_msg_type;
+		/*!
+		 * \since v.5.5.17
+		 * \brief Integer identifier of the message type.
+		 */
+		msg_type_id_t m_msg_type_id;
 		const state_t * m_state;
 		event_handler_data_t m_handler;
 
 		subscr_info_t(
 			mbox_t mbox,
 			std::type_index msg_type,
+			msg_type_id_t msg_type_id,
 			const state_t & state,
 			const event_handler_method_t & method,
 			thread_safety_t thread_safety )
 			:	m_mbox( std::move( mbox ) )
 			,	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( msg_type_id )
 			,	m_state( &state )
 			,	m_handler( method, thread_safety )
 			{}
@@ -153,10 +167,14 @@ class subscription_storage_t
 			const mbox_t & mbox,
 			const std::type_index & msg_type ) = 0;
 
+		/*!
+		 * \note Since v.5.5.17 message type is specified by
+		 * its integer identifier.
+		 */
 		virtual const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			msg_type_id_t msg_type_id,
 			const state_t & current_state ) const = 0;
 
 		virtual void
@@ -187,6 +205,19 @@ class subscription_storage_t
 		virtual std::size_t
 		query_subscriptions_count() const = 0;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief A hint that subscriptions are not likely to be changed.
+		 *
+		 * Is called after the return from agent's so_evt_start().
+		 * A storage can prepare a structure for more efficient
+		 * search of event handlers.
+		 *
+		 * \note Must not throw. Default implementation does nothing.
+		 */
+		virtual void
+		freeze();
+
 	protected :
 		agent_t *
 		owner() const;
@@ -0,0 +1,156 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Hazard pointers for protection of shared immutable objects.
+ */
+
+#include <so_5/rt/impl/h/hazard_ptr.hpp>
+
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace hazard_ptr
+{
+
+namespace
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Head of the global list of records.
+ *
+ * \note New records are added to the head only. Records are never removed.
+ */
+std::atomic< record_t * > g_records{ nullptr };
+
+/*!
+ * \since v.5.5.17
+ * \brief Is the owner of the record for the current thread destroyed?
+ *
+ * The owner is a thread_local object and it can be destroyed before
+ * other thread_local objects which can deliver messages in their
+ * destructors. The record is returned to the global list at that moment
+ * and can't be used by the current thread anymore.
+ *
+ * \note This variable has a trivial destructor and can be used during
+ * the destruction of any thread_local object.
+ */
+thread_local bool g_owner_destroyed = false;
+
+/*!
+ * \since v.5.5.17
+ * \brief Find a free record or create a new one.
+ */
+record_t *
+acquire_record()
+	{
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			{
+				bool expected = false;
+				if( r->m_active.compare_exchange_strong( expected, true ) )
+					return r;
+			}
+
+		auto r = new record_t();
+		r->m_active.store( true, std::memory_order_relaxed );
+
+		auto head = g_records.load( std::memory_order_relaxed );
+		do
+			{
+				r->m_next = head;
+			}
+		while( !g_records.compare_exchange_weak( head, r,
+				std::memory_order_release,
+				std::memory_order_relaxed ) );
+
+		return r;
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief An owner of the record for the current thread.
+ *
+ * The record is returned to the global list when thread finishes.
+ */
+struct record_owner_t
+	{
+		record_t * const m_record;
+
+		record_owner_t()
+			:	m_record( acquire_record() )
+			{}
+
+		~record_owner_t()
+			{
+				g_owner_destroyed = true;
+				m_record->m_active.store( false, std::memory_order_release );
+			}
+	};
+
+} /* namespace anonymous */
+
+//
+// record_t
+//
+record_t::record_t()
+	:	m_active{ false }
+	{
+		for( auto & s : m_slots )
+			s.store( nullptr, std::memory_order_relaxed );
+	}
+
+record_t *
+current_thread_record()
+	{
+		if( g_owner_destroyed )
+			return nullptr;
+
+		static thread_local record_owner_t owner;
+		return owner.m_record;
+	}
+
+bool
+is_protected( const void * object )
+	{
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			for( const auto & s : r->m_slots )
+				if( object == s.load( std::memory_order_seq_cst ) )
+					return true;
+
+		return false;
+	}
+
+bool
+is_protected_by_other_threads( const void * object )
+	{
+		const record_t * own = current_thread_record();
+
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			if( r != own )
+				for( const auto & s : r->m_slots )
+					if( object == s.load( std::memory_order_seq_cst ) )
+						return true;
+
+		return false;
+	}
+
+} /* namespace hazard_ptr */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
+#endif
+
@@ -8,6 +8,7 @@
 
 #include <so_5/rt/impl/h/local_mbox.hpp>
 #include <so_5/rt/impl/h/named_local_mbox.hpp>
+#include <so_5/rt/impl/h/retained_msg_mbox.hpp>
 #include <so_5/rt/impl/h/mpsc_mbox.hpp>
 #include <so_5/rt/impl/h/mbox_core.hpp>
 #include <so_5/rt/impl/h/mchain_details.hpp>
@@ -23,8 +24,12 @@ namespace impl
 //
 
 mbox_core_t::mbox_core_t(
-	so_5::msg_tracing::tracer_t * tracer )
+	so_5::msg_tracing::tracer_t * tracer,
+	bool single_threaded,
+	bool cow_subscribers )
 	:	m_tracer{ tracer }
+	,	m_single_threaded{ single_threaded }
+	,	m_cow_subscribers{ cow_subscribers }
 	,	m_mbox_id_counter{ 1 }
 {
 }
@@ -38,10 +43,29 @@ mbox_t
 mbox_core_t::create_mbox()
 {
 	auto id = ++m_mbox_id_counter;
-	if( !m_tracer )
-		return mbox_t{ new local_mbox_without_tracing{ id } };
+	if( m_single_threaded )
+	{
+		if( !m_tracer )
+			return mbox_t{ new st_local_mbox_without_tracing{ id } };
+		else
+			return mbox_t{ new st_local_mbox_with_tracing{ id, *m_tracer } };
+	}
+#if !defined( SO_5_NO_THREAD_LOCAL_KEYWORD )
+	else if( m_cow_subscribers )
+	{
+		if( !m_tracer )
+			return mbox_t{ new cow_local_mbox_without_tracing{ id } };
+		else
+			return mbox_t{ new cow_local_mbox_with_tracing{ id, *m_tracer } };
+	}
+#endif
 	else
-		return mbox_t{ new local_mbox_with_tracing{ id, *m_tracer } };
+	{
+		if( !m_tracer )
+			return mbox_t{ new local_mbox_without_tracing{ id } };
+		else
+			return mbox_t{ new local_mbox_with_tracing{ id, *m_tracer } };
+	}
 }
 
 mbox_t
@@ -53,6 +77,16 @@ mbox_core_t::create_mbox(
 			[this]() { return create_mbox(); } );
 }
 
+mbox_t
+mbox_core_t::create_retained_msg_mbox()
+{
+	auto id = ++m_mbox_id_counter;
+	if( !m_tracer )
+		return mbox_t{ new retained_msg_mbox_without_tracing{ id } };
+	else
+		return mbox_t{ new retained_msg_mbox_with_tracing{ id, *m_tracer } };
+}
+
 namespace {
 
 template< typename M1, typename M2, typename... A >
@@ -81,24 +115,43 @@ mbox_core_t::create_mpsc_mbox(
 	std::unique_ptr< abstract_message_box_t > actual_mbox;
 	if( limits_storage )
 	{
-		actual_mbox =
-				make_actual_mbox<
-						limitful_mpsc_mbox_without_tracing,
-						limitful_mpsc_mbox_with_tracing >(
-					m_tracer,
-					id,
-					single_consumer,
-					*limits_storage );
+		if( m_single_threaded )
+			actual_mbox =
+					make_actual_mbox<
+							st_limitful_mpsc_mbox_without_tracing,
+							st_limitful_mpsc_mbox_with_tracing >(
+						m_tracer,
+						id,
+						single_consumer,
+						*limits_storage );
+		else
+			actual_mbox =
+					make_actual_mbox<
+							limitful_mpsc_mbox_without_tracing,
+							limitful_mpsc_mbox_with_tracing >(
+						m_tracer,
+						id,
+						single_consumer,
+						*limits_storage );
 	}
 	else
 	{
-		actual_mbox =
-				make_actual_mbox<
-						limitless_mpsc_mbox_without_tracing,
-						limitless_mpsc_mbox_with_tracing >(
-					m_tracer,
-					id,
-					single_consumer );
+		if( m_single_threaded )
+			actual_mbox =
+					make_actual_mbox<
+							st_limitless_mpsc_mbox_without_tracing,
+							st_limitless_mpsc_mbox_with_tracing >(
+						m_tracer,
+						id,
+						single_consumer );
+		else
+			actual_mbox =
+					make_actual_mbox<
+							limitless_mpsc_mbox_without_tracing,
+							limitless_mpsc_mbox_with_tracing >(
+						m_tracer,
+						id,
+						single_consumer );
 	}
 
 	return mbox_t{ actual_mbox.release() };
@@ -108,16 +161,18 @@ void
 mbox_core_t::destroy_mbox(
 	const std::string & name )
 {
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
+	auto & shard = shard_for_name( name );
+
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
 	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( name );
+		shard.m_dictionary.find( name );
 
-	if( m_named_mboxes_dictionary.end() != it )
+	if( shard.m_dictionary.end() != it )
 	{
 		const unsigned int ref_count = --(it->second.m_external_ref_count);
 		if( 0 == ref_count )
-			m_named_mboxes_dictionary.erase( it );
+			shard.m_dictionary.erase( it );
 	}
 }
 
@@ -173,9 +228,14 @@ mbox_core_t::create_mchain(
 mbox_core_stats_t
 mbox_core_t::query_stats()
 {
-	std::lock_guard< std::mutex > lock{ m_dictionary_lock };
+	std::size_t named_mbox_count = 0;
+	for( auto & shard : m_named_mboxes_shards )
+	{
+		std::lock_guard< std::mutex > lock{ shard.m_lock };
+		named_mbox_count += shard.m_dictionary.size();
+	}
 
-	return mbox_core_stats_t{ m_named_mboxes_dictionary.size() };
+	return mbox_core_stats_t{ named_mbox_count };
 }
 
 mbox_t
@@ -184,12 +244,14 @@ mbox_core_t::create_named_mbox(
 	const std::function< mbox_t() > & factory )
 {
 	const std::string & name = nonempty_name.query_name();
-	std::lock_guard< std::mutex > lock( m_dictionary_lock );
+	auto & shard = shard_for_name( name );
+
+	std::lock_guard< std::mutex > lock( shard.m_lock );
 
 	named_mboxes_dictionary_t::iterator it =
-		m_named_mboxes_dictionary.find( name );
+		shard.m_dictionary.find( name );
 
-	if( m_named_mboxes_dictionary.end() != it )
+	if( shard.m_dictionary.end() != it )
 	{
 		++(it->second.m_external_ref_count);
 		return mbox_t(
@@ -202,11 +264,18 @@ mbox_core_t::create_named_mbox(
 	// There is no mbox with such name. New mbox should be created.
 	mbox_t mbox_ref = factory();
 
-	m_named_mboxes_dictionary[ name ] = named_mbox_info_t( mbox_ref );
+	shard.m_dictionary.emplace( name, named_mbox_info_t( mbox_ref ) );
 
 	return mbox_t( new named_local_mbox_t( name, mbox_ref, *this ) );
 }
 
+mbox_core_t::named_mboxes_shard_t &
+mbox_core_t::shard_for_name( const std::string & name )
+{
+	return m_named_mboxes_shards[
+			std::hash< std::string >()( name ) % named_mboxes_shards_count ];
+}
+
 //
 // mbox_core_ref_t
 //
@@ -0,0 +1,318 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Infrastructure for single-threaded SObjectizer Environment.
+ */
+
+#include <so_5/rt/impl/h/st_env_infrastructure.hpp>
+
+#include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/agent_coop.hpp>
+#include <so_5/rt/h/environment.hpp>
+
+#include <iterator>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace st_env
+{
+
+namespace
+{
+
+//
+// event_queue_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Event queue for agents in single-threaded environment.
+ *
+ * Demands are stored without any locking.
+ */
+class event_queue_t : public so_5::event_queue_t
+	{
+	public :
+		event_queue_t( std::deque< execution_demand_t > & demands )
+			:	m_demands( demands )
+			{}
+
+		virtual void
+		push( execution_demand_t demand ) override
+			{
+				m_demands.push_back( std::move( demand ) );
+			}
+
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				m_demands.insert( m_demands.end(),
+						std::make_move_iterator( demands ),
+						std::make_move_iterator( demands + count ) );
+			}
+
+	private :
+		std::deque< execution_demand_t > & m_demands;
+	};
+
+//
+// default_dispatcher_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief The default dispatcher for single-threaded environment.
+ *
+ * There is no working thread. All events are handled by
+ * infrastructure_t::run_until().
+ */
+class default_dispatcher_t : public so_5::dispatcher_t
+	{
+	public :
+		default_dispatcher_t( so_5::event_queue_t & queue )
+			:	m_queue( queue )
+			{}
+
+		virtual void
+		start( environment_t & ) override {}
+
+		virtual void
+		shutdown() override {}
+
+		virtual void
+		wait() override {}
+
+		disp_binding_activator_t
+		bind_agent( agent_ref_t agent )
+			{
+				auto & queue = m_queue;
+				return [agent, &queue]() {
+					agent->so_bind_to_dispatcher( queue );
+				};
+			}
+
+	private :
+		so_5::event_queue_t & m_queue;
+	};
+
+//
+// timer_thread_adapter_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An adapter of timer_manager to timer_thread interface.
+ *
+ * There is no separate thread. Elapsed timers are processed by
+ * infrastructure_t::run_until().
+ */
+class timer_thread_adapter_t : public so_5::timer_thread_t
+	{
+	public :
+		timer_thread_adapter_t( timer_manager_t & manager )
+			:	m_manager( manager )
+			{}
+
+		virtual void
+		start() override {}
+
+		virtual void
+		finish() override {}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				return m_manager.schedule( type_index, mbox, msg, pause, period );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				m_manager.schedule_anonymous(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				return m_manager.query_stats();
+			}
+
+	private :
+		timer_manager_t & m_manager;
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Max time to sleep if there is no timers.
+ *
+ * Working thread can be woken up earlier by infrastructure_t::stop().
+ */
+const std::chrono::steady_clock::duration max_idle_sleep =
+		std::chrono::seconds( 1 );
+
+} /* namespace anonymous */
+
+//
+// infrastructure_t
+//
+infrastructure_t::infrastructure_t(
+	timer_manager_unique_ptr_t timer_manager )
+	:	m_timer_manager( std::move( timer_manager ) )
+	,	m_event_queue( new event_queue_t( m_demands ) )
+	,	m_thread_id( query_current_thread_id() )
+	{}
+
+infrastructure_t::~infrastructure_t()
+	{}
+
+dispatcher_unique_ptr_t
+infrastructure_t::make_default_dispatcher()
+	{
+		return dispatcher_unique_ptr_t(
+				new default_dispatcher_t( *m_event_queue ) );
+	}
+
+timer_thread_unique_ptr_t
+infrastructure_t::make_timer_thread()
+	{
+		return timer_thread_unique_ptr_t(
+				new timer_thread_adapter_t( *m_timer_manager ) );
+	}
+
+void
+infrastructure_t::ready_to_deregister_notify(
+	coop_t * coop )
+	{
+		m_final_dereg_coops.push_back( coop );
+	}
+
+void
+infrastructure_t::run_until(
+	const std::function< bool() > & stop_condition )
+	{
+		m_thread_id = query_current_thread_id();
+
+		while( !stop_condition() )
+			{
+				m_timer_manager->process_expired_timers();
+
+				if( m_final_dereg_coops.empty() && m_demands.empty() )
+					wait_for_timer_or_wakeup();
+				else
+					{
+						process_final_deregs();
+						process_demands();
+					}
+			}
+
+		// A thread inside stop() must leave the lock before
+		// the destruction of the environment.
+		std::lock_guard< std::mutex > lock( m_wakeup_lock );
+	}
+
+void
+infrastructure_t::stop(
+	const std::function< void() > & stop_action )
+	{
+		// Nothing can be touched after the release of the lock.
+		// So the notification is done under the lock.
+		std::lock_guard< std::mutex > lock( m_wakeup_lock );
+
+		stop_action();
+
+		m_wakeup_requested = true;
+		m_wakeup_cond.notify_one();
+	}
+
+void
+infrastructure_t::process_demands()
+	{
+		for( auto n = m_demands.size(); n; --n )
+			{
+				execution_demand_t demand = std::move( m_demands.front() );
+				m_demands.pop_front();
+
+				demand.call_handler( m_thread_id );
+			}
+	}
+
+void
+infrastructure_t::process_final_deregs()
+	{
+		while( !m_final_dereg_coops.empty() )
+			{
+				auto coop = m_final_dereg_coops.front();
+				m_final_dereg_coops.pop_front();
+
+				coop_t::call_final_deregister_coop( coop );
+			}
+	}
+
+void
+infrastructure_t::wait_for_timer_or_wakeup()
+	{
+		const auto timeout =
+				m_timer_manager->timeout_before_nearest_timer( max_idle_sleep );
+
+		std::unique_lock< std::mutex > lock( m_wakeup_lock );
+		m_wakeup_cond.wait_for( lock, timeout,
+				[this] { return m_wakeup_requested; } );
+		m_wakeup_requested = false;
+	}
+
+//
+// default_disp_binder_t
+//
+default_disp_binder_t::default_disp_binder_t(
+	disp_binder_unique_ptr_t mt_binder )
+	:	m_mt_binder( std::move( mt_binder ) )
+	{}
+
+disp_binding_activator_t
+default_disp_binder_t::bind_agent(
+	environment_t & env,
+	agent_ref_t agent_ref )
+	{
+		auto disp = dynamic_cast< default_dispatcher_t * >(
+				&env.query_default_dispatcher() );
+		if( disp )
+			return disp->bind_agent( std::move( agent_ref ) );
+		else
+			return m_mt_binder->bind_agent( env, std::move( agent_ref ) );
+	}
+
+void
+default_disp_binder_t::unbind_agent(
+	environment_t & env,
+	agent_ref_t agent_ref )
+	{
+		// There is nothing to do for single-threaded default dispatcher.
+		if( !dynamic_cast< default_dispatcher_t * >(
+				&env.query_default_dispatcher() ) )
+			m_mt_binder->unbind_agent( env, std::move( agent_ref ) );
+	}
+
+} /* namespace st_env */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
+
@@ -67,10 +67,13 @@ class storage_t : public subscription_storage_t
 			const mbox_t & mbox,
 			const std::type_index & msg_type ) override;
 
+		void
+		freeze() override;
+
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			msg_type_id_t msg_type_id,
 			const state_t & current_state ) const override;
 
 		void
@@ -175,15 +178,21 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	msg_type_id_t msg_type_id,
 	const state_t & current_state ) const
 	{
 		return m_current_storage->find_handler(
 				mbox_id,
-				msg_type,
+				msg_type_id,
 				current_state );
 	}
 
+void
+storage_t::freeze()
+	{
+		m_current_storage->freeze();
+	}
+
 void
 storage_t::debug_dump( std::ostream & to ) const
 	{
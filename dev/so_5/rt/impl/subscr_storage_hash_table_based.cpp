@@ -31,12 +31,22 @@ namespace hash_table_subscr_storage
 {
 
 //! Subscription key type.
+/*!
+ * \note Since v.5.5.17 keys are compared and hashed by integer identifier
+ * of message type. Message type itself is stored only for
+ * unsubscription and diagnostic purposes.
+ */
 struct key_t
 {
 	//! Unique ID of mbox.
 	mbox_id_t m_mbox_id;
 	//! Message type.
 	std::type_index m_msg_type;
+	//! Integer identifier of message type.
+	/*!
+	 * \since v.5.5.17
+	 */
+	msg_type_id_t m_msg_type_id;
 	//! State of agent.
 	const state_t * m_state;
 
@@ -44,6 +54,7 @@ struct key_t
 	inline key_t()
 		:	m_mbox_id( null_mbox_id() )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_msg_type_id() )
 		,	m_state( nullptr )
 		{}
 
@@ -51,9 +62,11 @@ struct key_t
 	//! find all keys with (mbox_id, msg_type) prefix.
 	inline key_t(
 		mbox_id_t mbox_id,
-		std::type_index msg_type )
+		std::type_index msg_type,
+		msg_type_id_t msg_type_id )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( nullptr )
 		{}
 
@@ -61,9 +74,25 @@ struct key_t
 	inline key_t(
 		mbox_id_t mbox_id,
 		std::type_index msg_type,
+		msg_type_id_t msg_type_id,
 		const state_t & state )
 		:	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( msg_type_id )
+		,	m_state( &state )
+		{}
+
+	//! Constructor for the search of event handler.
+	/*!
+	 * \since v.5.5.17
+	 */
+	inline key_t(
+		mbox_id_t mbox_id,
+		msg_type_id_t msg_type_id,
+		const state_t & state )
+		:	m_mbox_id( mbox_id )
+		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( msg_type_id )
 		,	m_state( &state )
 		{}
 
@@ -74,9 +103,9 @@ struct key_t
 				return true;
 			else if( m_mbox_id == o.m_mbox_id )
 				{
-					if( m_msg_type < o.m_msg_type )
+					if( m_msg_type_id < o.m_msg_type_id )
 						return true;
-					else if( m_msg_type == o.m_msg_type )
+					else if( m_msg_type_id == o.m_msg_type_id )
 						return m_state < o.m_state;
 				}
 
@@ -87,7 +116,7 @@ struct key_t
 	operator==( const key_t & o ) const
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type &&
+					m_msg_type_id == o.m_msg_type_id &&
 					m_state == o.m_state;
 		}
 
@@ -95,7 +124,7 @@ struct key_t
 	is_same_mbox_msg_pair( const key_t & o ) const
 		{
 			return m_mbox_id == o.m_mbox_id &&
-					m_msg_type == o.m_msg_type;
+					m_msg_type_id == o.m_msg_type_id;
 		}
 };
 
@@ -120,7 +149,7 @@ struct hash_t
 				const value_type h1 =
 					std::hash< so_5::mbox_id_t >()( ptr->m_mbox_id );
 				const value_type h2 = h1 ^
-					(std::hash< std::type_index >()( ptr->m_msg_type ) +
+					(std::hash< so_5::msg_type_id_t >()( ptr->m_msg_type_id ) +
 					 	0x9e3779b9 + (h1 << 6) + (h1 >> 2));
 
 				return h2 ^ (std::hash< const state_t * >()(
@@ -225,7 +254,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			msg_type_id_t msg_type_id,
 			const state_t & current_state ) const override;
 
 		void
@@ -291,7 +320,8 @@ storage_t::create_event_subscription(
 	{
 		using namespace subscription_storage_common;
 
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key( mbox_ref->id(), type_index,
+				query_msg_type_id( type_index ), target_state );
 
 		auto insertion_result = m_map.emplace( key, mbox_ref );
 
@@ -331,7 +361,8 @@ storage_t::drop_subscription(
 	const std::type_index & type_index,
 	const state_t & target_state )
 	{
-		key_t key( mbox_ref->id(), type_index, target_state );
+		key_t key( mbox_ref->id(), type_index,
+				query_msg_type_id( type_index ), target_state );
 
 		auto it = m_map.find( key );
 
@@ -354,7 +385,8 @@ storage_t::drop_subscription_for_all_states(
 	const mbox_t & mbox_ref,
 	const std::type_index & type_index )
 	{
-		const key_t key( mbox_ref->id(), type_index );
+		const key_t key( mbox_ref->id(), type_index,
+				query_msg_type_id( type_index ) );
 
 		auto it = m_map.lower_bound( key );
 		auto need_erase = [&] {
@@ -378,10 +410,10 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	msg_type_id_t msg_type_id,
 	const state_t & current_state ) const
 	{
-		key_t k( mbox_id, msg_type, current_state );
+		key_t k( mbox_id, msg_type_id, current_state );
 		auto it = m_hash_table.find( &k );
 		if( it != m_hash_table.end() )
 			return &(it->second);
@@ -453,6 +485,7 @@ storage_t::query_content() const
 							return subscr_info_t {
 									map_item->second,
 									map_item->first.m_msg_type,
+									map_item->first.m_msg_type_id,
 									*(map_item->first.m_state),
 									i.second.m_method,
 									i.second.m_thread_safety
@@ -476,7 +509,8 @@ storage_t::setup_content(
 		for_each( begin(info), end(info),
 			[&]( const subscr_info_t & i )
 			{
-				key_t k{ i.m_mbox->id(), i.m_msg_type, *(i.m_state) };
+				key_t k{ i.m_mbox->id(), i.m_msg_type, i.m_msg_type_id,
+						*(i.m_state) };
 
 				auto ins_result = fresh_map.emplace( k, i.m_mbox );
 
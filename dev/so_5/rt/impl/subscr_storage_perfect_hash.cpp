@@ -0,0 +1,503 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief A storage for agent's subscriptions information with
+ * a frozen perfect hash table for handler lookup.
+ */
+
+#include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief A storage for agent's subscriptions information with
+ * a frozen perfect hash table for handler lookup.
+ */
+namespace perfect_hash_subscr_storage
+{
+
+namespace
+{
+
+//! Final mixing of hash value.
+/*!
+ * It is the finalizer from MurmurHash3.
+ */
+inline std::uint64_t
+mix( std::uint64_t v )
+	{
+		v ^= v >> 33;
+		v *= 0xff51afd7ed558ccdull;
+		v ^= v >> 33;
+		v *= 0xc4ceb9fe1a85ec53ull;
+		v ^= v >> 33;
+		return v;
+	}
+
+//! Hash value for (mbox_id, msg_type, state) key.
+inline std::uint64_t
+key_hash(
+	mbox_id_t mbox_id,
+	msg_type_id_t msg_type_id,
+	const state_t * state )
+	{
+		return mix(
+				mix( mbox_id ) ^
+				(static_cast< std::uint64_t >( msg_type_id ) << 40) ^
+				static_cast< std::uint64_t >(
+						reinterpret_cast< std::uintptr_t >( state ) ) );
+	}
+
+//! Index of slot for the key's hash and displacement of key's bucket.
+inline std::size_t
+slot_index(
+	std::uint64_t hash,
+	std::uint32_t displacement,
+	std::size_t slot_mask )
+	{
+		return static_cast< std::size_t >(
+				mix( hash ^ ( (displacement + 1ull) * 0x9e3779b97f4a7c15ull ) ) &
+				slot_mask );
+	}
+
+//! Round up to the power of 2.
+inline std::size_t
+round_up_to_pow2( std::size_t v )
+	{
+		std::size_t r = 1;
+		while( r < v )
+			r <<= 1;
+		return r;
+	}
+
+} /* namespace anonymous */
+
+/*!
+ * \since v.5.5.17
+ * \brief A storage for agent's subscriptions information with
+ * a frozen perfect hash table for handler lookup.
+ *
+ * Most of agents do not change their subscriptions after the start.
+ * This storage has two modes:
+ * - mutable mode. All operations are delegated to an ordinary storage.
+ *   This mode is used until the end of so_evt_start();
+ * - frozen mode. A perfect hash table is built from the content of the
+ *   ordinary storage when freeze() is called. Every search of event handler
+ *   is a calculation of hash value, a read of bucket's displacement and a
+ *   comparison of key in the one slot of the table.
+ *
+ * The table is built by "hash and displace" method: keys are distributed
+ * between buckets, then for every bucket (from largest to smallest)
+ * a displacement is selected which places all keys of the bucket into
+ * free slots.
+ *
+ * Any change of subscriptions in frozen mode destroys the table and
+ * the storage returns to mutable mode forever.
+ *
+ * \note If the table can't be built (it is possible only for very unlikely
+ * collisions of 64-bit hash values) then the storage stays in mutable mode.
+ */
+class storage_t : public subscription_storage_t
+	{
+	public :
+		storage_t(
+			agent_t * owner,
+			subscription_storage_unique_ptr_t mutable_storage );
+		~storage_t();
+
+		virtual void
+		create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const message_limit::control_block_t * limit,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety ) override;
+
+		virtual void
+		drop_subscription(
+			const mbox_t & mbox,
+			const std::type_index & msg_type,
+			const state_t & target_state ) override;
+
+		void
+		drop_subscription_for_all_states(
+			const mbox_t & mbox,
+			const std::type_index & msg_type ) override;
+
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			msg_type_id_t msg_type_id,
+			const state_t & current_state ) const override;
+
+		void
+		debug_dump( std::ostream & to ) const override;
+
+		void
+		drop_content() override;
+
+		subscription_storage_common::subscr_info_vector_t
+		query_content() const override;
+
+		void
+		setup_content(
+			subscription_storage_common::subscr_info_vector_t && info ) override;
+
+		std::size_t
+		query_subscriptions_count() const override;
+
+		void
+		freeze() override;
+
+	private :
+		//! One slot of the table.
+		struct slot_t
+			{
+				mbox_id_t m_mbox_id;
+				const state_t * m_state;
+				msg_type_id_t m_msg_type_id;
+				event_handler_data_t m_handler;
+
+				slot_t()
+					:	m_mbox_id( null_mbox_id() )
+					,	m_state( nullptr )
+					,	m_msg_type_id( null_msg_type_id() )
+					,	m_handler( event_handler_method_t(), not_thread_safe )
+					{}
+			};
+
+		using slot_vector_t = std::vector< slot_t >;
+		using displacement_vector_t = std::vector< std::uint32_t >;
+
+		//! Max count of attempts to find displacement for one bucket.
+		static const std::uint32_t max_displacement = 1u << 16;
+
+		//! Max count of table enlargements during the build.
+		static const unsigned int max_enlargements = 4;
+
+		//! Storage for mutable mode.
+		/*!
+		 * \note It is the owner of all subscriptions in both modes.
+		 */
+		subscription_storage_unique_ptr_t m_mutable_storage;
+
+		//! Is the storage in frozen mode?
+		bool m_frozen = false;
+
+		//! Was the frozen mode ever turned off?
+		bool m_thawed = false;
+
+		//! Displacements for buckets.
+		displacement_vector_t m_displacements;
+		//! Mask for calculation of bucket index.
+		std::size_t m_bucket_mask = 0;
+
+		//! Slots of the table.
+		slot_vector_t m_slots;
+		//! Mask for calculation of slot index.
+		std::size_t m_slot_mask = 0;
+
+		//! Return to mutable mode.
+		void
+		thaw();
+
+		//! Try to build the table for the specified content.
+		/*!
+		 * \retval true if table is built.
+		 */
+		bool
+		try_build(
+			const subscription_storage_common::subscr_info_vector_t & info,
+			std::size_t slots_count );
+	};
+
+storage_t::storage_t(
+	agent_t * owner,
+	subscription_storage_unique_ptr_t mutable_storage )
+	:	subscription_storage_t( owner )
+	,	m_mutable_storage( std::move( mutable_storage ) )
+	{}
+
+storage_t::~storage_t()
+	{}
+
+void
+storage_t::create_event_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const message_limit::control_block_t * limit,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety )
+	{
+		m_mutable_storage->create_event_subscription(
+				mbox, msg_type, limit, target_state, method, thread_safety );
+
+		thaw();
+	}
+
+void
+storage_t::drop_subscription(
+	const mbox_t & mbox,
+	const std::type_index & msg_type,
+	const state_t & target_state )
+	{
+		m_mutable_storage->drop_subscription( mbox, msg_type, target_state );
+
+		thaw();
+	}
+
+void
+storage_t::drop_subscription_for_all_states(
+	const mbox_t & mbox,
+	const std::type_index & msg_type )
+	{
+		m_mutable_storage->drop_subscription_for_all_states( mbox, msg_type );
+
+		thaw();
+	}
+
+const event_handler_data_t *
+storage_t::find_handler(
+	mbox_id_t mbox_id,
+	msg_type_id_t msg_type_id,
+	const state_t & current_state ) const
+	{
+		if( !m_frozen )
+			return m_mutable_storage->find_handler(
+					mbox_id, msg_type_id, current_state );
+
+		if( m_slots.empty() )
+			return nullptr;
+
+		const auto hash = key_hash( mbox_id, msg_type_id, &current_state );
+		const auto & slot = m_slots[ slot_index(
+				hash,
+				m_displacements[ static_cast< std::size_t >( hash ) & m_bucket_mask ],
+				m_slot_mask ) ];
+
+		if( slot.m_mbox_id == mbox_id &&
+				slot.m_msg_type_id == msg_type_id &&
+				slot.m_state == &current_state )
+			return &(slot.m_handler);
+		else
+			return nullptr;
+	}
+
+void
+storage_t::debug_dump( std::ostream & to ) const
+	{
+		m_mutable_storage->debug_dump( to );
+	}
+
+void
+storage_t::drop_content()
+	{
+		m_mutable_storage->drop_content();
+
+		thaw();
+	}
+
+subscription_storage_common::subscr_info_vector_t
+storage_t::query_content() const
+	{
+		return m_mutable_storage->query_content();
+	}
+
+void
+storage_t::setup_content(
+	subscription_storage_common::subscr_info_vector_t && info )
+	{
+		m_mutable_storage->setup_content( std::move( info ) );
+
+		thaw();
+	}
+
+std::size_t
+storage_t::query_subscriptions_count() const
+	{
+		return m_mutable_storage->query_subscriptions_count();
+	}
+
+void
+storage_t::freeze()
+	{
+		if( m_frozen || m_thawed )
+			return;
+
+		// All exceptions are ignored because the storage can
+		// work in mutable mode.
+		try
+			{
+				const auto info = m_mutable_storage->query_content();
+
+				auto slots_count = round_up_to_pow2(
+						info.size() + info.size() / 4 );
+				for( unsigned int i = 0; i != max_enlargements; ++i )
+					{
+						if( try_build( info, slots_count ) )
+							{
+								m_frozen = true;
+								return;
+							}
+
+						slots_count <<= 1;
+					}
+			}
+		catch( ... )
+			{}
+
+		displacement_vector_t().swap( m_displacements );
+		slot_vector_t().swap( m_slots );
+	}
+
+void
+storage_t::thaw()
+	{
+		if( m_frozen )
+			{
+				m_frozen = false;
+				m_thawed = true;
+
+				displacement_vector_t().swap( m_displacements );
+				slot_vector_t().swap( m_slots );
+			}
+	}
+
+bool
+storage_t::try_build(
+	const subscription_storage_common::subscr_info_vector_t & info,
+	std::size_t slots_count )
+	{
+		using namespace std;
+
+		if( info.empty() )
+			{
+				displacement_vector_t().swap( m_displacements );
+				slot_vector_t().swap( m_slots );
+				return true;
+			}
+
+		const size_t buckets_count = round_up_to_pow2( info.size() );
+		const size_t bucket_mask = buckets_count - 1;
+		const size_t slot_mask = slots_count - 1;
+
+		vector< uint64_t > hashes;
+		hashes.reserve( info.size() );
+		for( const auto & i : info )
+			hashes.push_back(
+					key_hash( i.m_mbox->id(), i.m_msg_type_id, i.m_state ) );
+
+		// Distribution of keys between buckets.
+		vector< vector< size_t > > buckets( buckets_count );
+		for( size_t i = 0; i != hashes.size(); ++i )
+			buckets[ static_cast< size_t >( hashes[ i ] ) & bucket_mask ]
+					.push_back( i );
+
+		vector< size_t > order( buckets_count );
+		for( size_t i = 0; i != buckets_count; ++i )
+			order[ i ] = i;
+		stable_sort( begin( order ), end( order ),
+				[&buckets]( size_t a, size_t b ) {
+					return buckets[ a ].size() > buckets[ b ].size();
+				} );
+
+		displacement_vector_t displacements( buckets_count, 0u );
+		vector< size_t > owners( slots_count, info.size() );
+		vector< size_t > candidates;
+
+		for( auto b : order )
+			{
+				const auto & keys = buckets[ b ];
+				if( keys.empty() )
+					// All other buckets are empty too.
+					break;
+
+				bool placed = false;
+				for( uint32_t d = 0; !placed && d != max_displacement; ++d )
+					{
+						candidates.clear();
+						placed = true;
+						for( auto k : keys )
+							{
+								const auto s = slot_index( hashes[ k ], d, slot_mask );
+								if( owners[ s ] != info.size() ||
+										end( candidates ) != find(
+												begin( candidates ), end( candidates ), s ) )
+									{
+										placed = false;
+										break;
+									}
+								candidates.push_back( s );
+							}
+
+						if( placed )
+							{
+								displacements[ b ] = d;
+								for( size_t i = 0; i != keys.size(); ++i )
+									owners[ candidates[ i ] ] = keys[ i ];
+							}
+					}
+
+				if( !placed )
+					return false;
+			}
+
+		slot_vector_t slots( slots_count );
+		for( size_t s = 0; s != slots_count; ++s )
+			if( owners[ s ] != info.size() )
+				{
+					const auto & i = info[ owners[ s ] ];
+					auto & slot = slots[ s ];
+					slot.m_mbox_id = i.m_mbox->id();
+					slot.m_state = i.m_state;
+					slot.m_msg_type_id = i.m_msg_type_id;
+					slot.m_handler = i.m_handler;
+				}
+
+		m_displacements.swap( displacements );
+		m_bucket_mask = bucket_mask;
+		m_slots.swap( slots );
+		m_slot_mask = slot_mask;
+
+		return true;
+	}
+
+} /* namespace perfect_hash_subscr_storage */
+
+} /* namespace impl */
+
+SO_5_FUNC subscription_storage_factory_t
+perfect_hash_based_subscription_storage_factory()
+	{
+		return perfect_hash_based_subscription_storage_factory(
+				default_subscription_storage_factory() );
+	}
+
+SO_5_FUNC subscription_storage_factory_t
+perfect_hash_based_subscription_storage_factory(
+	const subscription_storage_factory_t & mutable_storage_factory )
+	{
+		return [mutable_storage_factory]( agent_t * owner ) {
+			return impl::subscription_storage_unique_ptr_t(
+					new impl::perfect_hash_subscr_storage::storage_t(
+							owner,
+							mutable_storage_factory( owner ) ) );
+		};
+	}
+
+} /* namespace so_5 */
@@ -71,7 +71,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			msg_type_id_t msg_type_id,
 			const state_t & current_state ) const override;
 
 		void
@@ -100,13 +100,13 @@ class storage_t : public subscription_storage_t
 		struct is_same_mbox_msg
 			{
 				const mbox_id_t m_id;
-				const std::type_index & m_type;
+				const msg_type_id_t m_type_id;
 
 				bool
 				operator()( const info_t & info ) const
 					{
 						return m_id == info.m_mbox->id() &&
-								m_type == info.m_msg_type;
+								m_type_id == info.m_msg_type_id;
 					}
 			};
 
@@ -123,7 +123,7 @@ namespace
 	auto
 	find( Container & c,
 		const mbox_id_t & mbox_id,
-		const std::type_index & msg_type,
+		msg_type_id_t msg_type_id,
 		const state_t & target_state ) -> decltype( c.begin() )
 		{
 			using namespace std;
@@ -131,7 +131,7 @@ namespace
 			return find_if( begin( c ), end( c ),
 				[&]( typename Container::value_type const & o ) {
 					return ( o.m_mbox->id() == mbox_id &&
-						o.m_msg_type == msg_type &&
+						o.m_msg_type_id == msg_type_id &&
 						o.m_state == &target_state );
 				} );
 		}
@@ -164,10 +164,11 @@ storage_t::create_event_subscription(
 		using namespace subscription_storage_common;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = query_msg_type_id( msg_type );
 
 		// Check that this subscription is new.
 		auto existed_position = find(
-				m_events, mbox_id, msg_type, target_state );
+				m_events, mbox_id, msg_type_id, target_state );
 
 		if( existed_position != m_events.end() )
 			SO_5_THROW_EXCEPTION(
@@ -177,7 +178,7 @@ storage_t::create_event_subscription(
 
 		// Just add subscription to the end.
 		m_events.emplace_back(
-				mbox, msg_type, target_state, method, thread_safety );
+				mbox, msg_type, msg_type_id, target_state, method, thread_safety );
 
 		// Note: since v.5.5.9 mbox subscription is initiated even if
 		// it is MPSC mboxes. It is important for the case of message
@@ -189,7 +190,7 @@ storage_t::create_event_subscription(
 		auto last_to_check = --end( m_events );
 		if( last_to_check == find_if(
 				begin( m_events ), last_to_check,
-				is_same_mbox_msg{ mbox_id, msg_type } ) )
+				is_same_mbox_msg{ mbox_id, msg_type_id } ) )
 			{
 				// Mbox must create subscription.
 				so_5::details::do_with_rollback_on_exception(
@@ -214,9 +215,10 @@ storage_t::drop_subscription(
 		using namespace std;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = query_msg_type_id( msg_type );
 
 		auto existed_position = find(
-				m_events, mbox_id, msg_type, target_state );
+				m_events, mbox_id, msg_type_id, target_state );
 		if( existed_position != m_events.end() )
 			{
 				m_events.erase( existed_position );
@@ -229,7 +231,7 @@ storage_t::drop_subscription(
 				// the mbox must remove information about that agent.
 				if( end( m_events ) == find_if(
 						begin( m_events ), end( m_events ),
-						is_same_mbox_msg{ mbox_id, msg_type } ) )
+						is_same_mbox_msg{ mbox_id, msg_type_id } ) )
 					{
 						// If we are here then there is no more references
 						// to the mbox. And mbox must not hold reference
@@ -247,14 +249,15 @@ storage_t::drop_subscription_for_all_states(
 		using namespace std;
 
 		const auto mbox_id = mbox->id();
+		const auto msg_type_id = query_msg_type_id( msg_type );
 
 		const auto old_size = m_events.size();
 
 		m_events.erase(
 				remove_if( begin( m_events ), end( m_events ),
-						[mbox_id, &msg_type]( const info_t & i ) {
+						[mbox_id, msg_type_id]( const info_t & i ) {
 							return i.m_mbox->id() == mbox_id &&
-									i.m_msg_type == msg_type;
+									i.m_msg_type_id == msg_type_id;
 						} ),
 				end( m_events ) );
 
@@ -269,10 +272,10 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	msg_type_id_t msg_type_id,
 	const state_t & current_state ) const
 	{
-		auto it = find( m_events, mbox_id, msg_type, current_state );
+		auto it = find( m_events, mbox_id, msg_type_id, current_state );
 
 		if( it != std::end( m_events ) )
 			return &(it->m_handler);
@@ -302,21 +305,21 @@ storage_t::destroy_all_subscriptions()
 		struct mbox_msg_type_pair_t
 			{
 				abstract_message_box_t * m_mbox;
-				const type_index * m_msg_type;
+				const info_t * m_info;
 
 				bool
 				operator<( const mbox_msg_type_pair_t & o ) const
 					{
 						return m_mbox < o.m_mbox ||
 								( m_mbox == o.m_mbox &&
-								 (*m_msg_type) < (*o.m_msg_type) );
+								 m_info->m_msg_type_id < o.m_info->m_msg_type_id );
 					}
 
 				bool
 				operator==( const mbox_msg_type_pair_t & o ) const
 					{
 						return m_mbox == o.m_mbox &&
-								(*m_msg_type) == (*o.m_msg_type);
+								m_info->m_msg_type_id == o.m_info->m_msg_type_id;
 					}
 			};
 
@@ -328,7 +331,7 @@ storage_t::destroy_all_subscriptions()
 				begin( m_events ), end( m_events ),
 				back_inserter( mboxes ),
 				[]( info_t & i ) {
-					return mbox_msg_type_pair_t{ i.m_mbox.get(), &i.m_msg_type };
+					return mbox_msg_type_pair_t{ i.m_mbox.get(), &i };
 				} );
 
 		// Second step: remove duplicates.
@@ -339,7 +342,8 @@ storage_t::destroy_all_subscriptions()
 
 		// Third step: destroy subscription in mboxes.
 		for( auto m : mboxes )
-			m.m_mbox->unsubscribe_event_handlers( *m.m_msg_type, owner() );
+			m.m_mbox->unsubscribe_event_handlers(
+					m.m_info->m_msg_type, owner() );
 
 		// Fourth step: cleanup subscription vector.
 		drop_content();
@@ -23,6 +23,10 @@ subscription_storage_t::subscription_storage_t( agent_t * owner )
 subscription_storage_t::~subscription_storage_t()
 	{}
 
+void
+subscription_storage_t::freeze()
+	{}
+
 agent_t *
 subscription_storage_t::owner() const
 	{
@@ -24,6 +24,17 @@ abstract_message_box_t::~abstract_message_box_t()
 {
 }
 
+void
+abstract_message_box_t::do_deliver_message_batch(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep ) const
+{
+	for( std::size_t i = 0; i != count; ++i )
+		do_deliver_message( msg_type, messages[ i ], overlimit_reaction_deep );
+}
+
 bool
 abstract_message_box_t::operator==( const abstract_message_box_t & o ) const
 {
@@ -12,11 +12,13 @@ namespace so_5
 //
 
 message_t::message_t()
+	:	m_mutability( message_mutability_t::immutable_message )
 {
 }
 
 message_t::message_t( const message_t & )
 	:	atomic_refcounted_t()
+	,	m_mutability( message_mutability_t::immutable_message )
 {
 }
 
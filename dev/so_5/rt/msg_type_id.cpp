@@ -0,0 +1,144 @@
+/*
+	SObjectizer 5.
+*/
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Integer identifiers of message types.
+ */
+
+#include <so_5/rt/h/msg_type_id.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace so_5
+{
+
+namespace
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Process-wide registry of message types.
+ *
+ * There are two parts of the registry:
+ * - the map from std::type_index to identifier. It is protected by
+ *   the mutex and is used when a type is seen for the first time;
+ * - the fast table from the pointer returned by type_info::name() to
+ *   identifier. It is an open addressing hash table with atomic items.
+ *   Items are only added (under the mutex) and never removed. So
+ *   the search in the table requires no locks.
+ *
+ * The same type can have several type_info objects (for example in
+ * different shared libraries). Every of them gets its own item in
+ * the fast table, but all of them have the same identifier.
+ *
+ * \note If the fast table has no free place then the map is used.
+ */
+class registry_t
+	{
+	public :
+		registry_t() = default;
+		registry_t( const registry_t & ) = delete;
+		registry_t &
+		operator=( const registry_t & ) = delete;
+
+		msg_type_id_t
+		query( const std::type_index & msg_type )
+			{
+				const char * name = msg_type.name();
+
+				const auto start = index_of( name );
+				for( std::size_t i = 0; i != max_probes; ++i )
+					{
+						const auto & item = m_fast_table[ (start + i) & mask ];
+						const char * n = item.m_name.load( std::memory_order_acquire );
+						if( n == name )
+							return item.m_id.load( std::memory_order_relaxed );
+						else if( !n )
+							break;
+					}
+
+				return query_and_register( msg_type, name );
+			}
+
+	private :
+		//! Size of the fast table (must be a power of 2).
+		static const std::size_t table_size = 4096;
+		static const std::size_t mask = table_size - 1;
+		//! Max count of items to be checked during the search.
+		static const std::size_t max_probes = 16;
+
+		//! An item of the fast table.
+		struct item_t
+			{
+				std::atomic< const char * > m_name{ nullptr };
+				std::atomic< msg_type_id_t > m_id{ null_msg_type_id() };
+			};
+
+		item_t m_fast_table[ table_size ];
+
+		std::mutex m_lock;
+		std::unordered_map< std::type_index, msg_type_id_t > m_ids;
+		msg_type_id_t m_last_id = null_msg_type_id();
+
+		static std::size_t
+		index_of( const char * name )
+			{
+				const auto v = reinterpret_cast< std::uintptr_t >( name );
+				return static_cast< std::size_t >( (v >> 3) ^ (v >> 15) );
+			}
+
+		msg_type_id_t
+		query_and_register(
+			const std::type_index & msg_type,
+			const char * name )
+			{
+				std::lock_guard< std::mutex > lock( m_lock );
+
+				auto it = m_ids.find( msg_type );
+				if( it == m_ids.end() )
+					it = m_ids.emplace( msg_type, ++m_last_id ).first;
+				const auto id = it->second;
+
+				// Name must be stored into the fast table if it isn't here yet.
+				const auto start = index_of( name );
+				for( std::size_t i = 0; i != max_probes; ++i )
+					{
+						auto & item = m_fast_table[ (start + i) & mask ];
+						const char * n = item.m_name.load( std::memory_order_relaxed );
+						if( n == name )
+							break;
+						else if( !n )
+							{
+								item.m_id.store( id, std::memory_order_relaxed );
+								item.m_name.store( name, std::memory_order_release );
+								break;
+							}
+					}
+
+				return id;
+			}
+	};
+
+registry_t &
+registry()
+	{
+		static registry_t r;
+		return r;
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC msg_type_id_t
+query_msg_type_id( const std::type_index & msg_type )
+	{
+		return registry().query( msg_type );
+	}
+
+} /* namespace so_5 */
+
@@ -37,6 +37,11 @@ class SO_5_TYPE controller_t
 		mbox() const = 0;
 
 		//! Turn the monitoring on.
+		/*!
+		 * \note Since v.5.5.17 an exception with
+		 * rc_not_allowed_in_single_threaded_env is thrown if
+		 * the environment is single-threaded.
+		 */
 		virtual void
 		turn_on() = 0;
 
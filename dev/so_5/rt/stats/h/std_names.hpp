@@ -128,6 +128,38 @@ timer_periodic_count();
 SO_5_FUNC suffix_t
 demand_quote();
 
+/*!
+ * \since v.5.5.17
+ * \brief Suffix for data source with count of demands which nodes
+ * were reused from a pool of nodes of a dispatcher.
+ */
+SO_5_FUNC suffix_t
+demands_pool_hits();
+
+/*!
+ * \since v.5.5.17
+ * \brief Suffix for data source with count of demands which nodes
+ * were allocated because a pool of nodes of a dispatcher was empty.
+ */
+SO_5_FUNC suffix_t
+demands_pool_misses();
+
+/*!
+ * \since v.5.5.17
+ * \brief Suffix for data source with total count of working threads
+ * added to a dispatcher in elastic mode.
+ */
+SO_5_FUNC suffix_t
+disp_threads_grown();
+
+/*!
+ * \since v.5.5.17
+ * \brief Suffix for data source with total count of working threads
+ * retired by a dispatcher in elastic mode.
+ */
+SO_5_FUNC suffix_t
+disp_threads_retired();
+
 } /* namespace suffixes */
 
 } /* namespace stats */
@@ -13,9 +13,10 @@
 #include <so_5/rt/stats/h/controller.hpp>
 #include <so_5/rt/stats/h/repository.hpp>
 
+#include <so_5/h/thread_factory.hpp>
+
 #include <condition_variable>
 #include <mutex>
-#include <thread>
 #include <memory>
 #include <chrono>
 
@@ -43,7 +44,11 @@ class std_controller_t
 	{
 	public :
 		std_controller_t(
-			mbox_t mbox );
+			mbox_t mbox,
+			//! Factory for data-distribution thread.
+			thread_factory_t & thread_factory,
+			//! Is the controller created for single-threaded environment?
+			bool single_threaded );
 		~std_controller_t();
 
 		// Implementation of controller_t interface.
@@ -71,6 +76,20 @@ class std_controller_t
 		//! Mbox for sending monitoring data.
 		const mbox_t m_mbox;
 
+		/*!
+		 * \since v.5.5.17
+		 * \brief Factory for data-distribution thread.
+		 */
+		thread_factory_t & m_thread_factory;
+
+		/*!
+		 * \since v.5.5.17
+		 * \brief Is the controller created for single-threaded environment?
+		 *
+		 * Data-distribution thread cannot be started in that case.
+		 */
+		const bool m_single_threaded;
+
 		//! Object lock for start/stop operations.
 		std::mutex m_start_stop_lock;
 		//! Object lock for data-related operations.
@@ -83,7 +102,7 @@ class std_controller_t
 		 * This thread is created in turn_on() and is destroyed in turn_off().
 		 * It is not exists if run-time monitoring is switched off.
 		 */
-		std::unique_ptr< std::thread > m_distribution_thread;
+		thread_handle_unique_ptr_t m_distribution_thread;
 
 		//! Shutdown signal.
 		/*!
@@ -10,6 +10,9 @@
 
 #include <so_5/rt/stats/impl/h/std_controller.hpp>
 
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
 namespace so_5
 {
 
@@ -24,8 +27,12 @@ namespace impl
 //
 
 std_controller_t::std_controller_t(
-	mbox_t mbox )
+	mbox_t mbox,
+	thread_factory_t & thread_factory,
+	bool single_threaded )
 	:	m_mbox( std::move( mbox ) )
+	,	m_thread_factory( thread_factory )
+	,	m_single_threaded( single_threaded )
 	{}
 
 std_controller_t::~std_controller_t()
@@ -40,14 +47,20 @@ std_controller_t::mbox() const
 void
 std_controller_t::turn_on()
 	{
+		if( m_single_threaded )
+			SO_5_THROW_EXCEPTION(
+					rc_not_allowed_in_single_threaded_env,
+					"run-time monitoring cannot be turned on in "
+					"single-threaded environment" );
+
 		std::lock_guard< std::mutex > lock{ m_start_stop_lock };
 
 		if( !m_distribution_thread )
 			{
 				// Distribution thread must be started.
 				m_shutdown_initiated = false;
-				m_distribution_thread.reset(
-						new std::thread( [this] { body(); } ) );
+				m_distribution_thread = m_thread_factory.start(
+						[this] { body(); } );
 			}
 	}
 
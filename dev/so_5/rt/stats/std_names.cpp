@@ -108,6 +108,30 @@ demand_quote()
 		IMPL_SUFFIX( "/demands.quote" )
 	}
 
+SO_5_FUNC suffix_t
+demands_pool_hits()
+	{
+		IMPL_SUFFIX( "/demands_pool.hits" )
+	}
+
+SO_5_FUNC suffix_t
+demands_pool_misses()
+	{
+		IMPL_SUFFIX( "/demands_pool.misses" )
+	}
+
+SO_5_FUNC suffix_t
+disp_threads_grown()
+	{
+		IMPL_SUFFIX( "/threads.grown" )
+	}
+
+SO_5_FUNC suffix_t
+disp_threads_retired()
+	{
+		IMPL_SUFFIX( "/threads.retired" )
+	}
+
 #undef IMPL_SUFFIX
 
 } /* namespace suffixes */
@@ -0,0 +1,371 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since v.5.5.17
+ * \file
+ * \brief Tools for creation of threads for dispatchers and other
+ * parts of SObjectizer.
+ */
+
+#include <so_5/h/thread_factory.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <atomic>
+#include <exception>
+#include <string>
+#include <thread>
+
+#if !defined( _WIN32 )
+	#define SO_5_THREAD_FACTORY_USES_PTHREADS
+
+	#include <pthread.h>
+	#include <limits.h>
+	#include <unistd.h>
+
+	#if defined( __linux__ )
+		#include <sched.h>
+	#endif
+#endif
+
+namespace so_5
+{
+
+//
+// thread_handle_t
+//
+thread_handle_t::thread_handle_t()
+	{}
+
+thread_handle_t::~thread_handle_t()
+	{}
+
+//
+// thread_factory_t
+//
+thread_factory_t::thread_factory_t()
+	{}
+
+thread_factory_t::~thread_factory_t()
+	{}
+
+namespace
+{
+
+#if defined( SO_5_THREAD_FACTORY_USES_PTHREADS )
+
+/*!
+ * \since v.5.5.17
+ * \brief Everything what a new thread needs for its startup.
+ */
+struct thread_startup_info_t
+	{
+		//! Function to be executed.
+		thread_body_t m_body;
+
+		//! Name for the thread.
+		/*!
+		 * Empty name means that name is not changed.
+		 */
+		std::string m_name;
+
+		//! CPUs for the thread.
+		/*!
+		 * Empty set means that affinity is not changed.
+		 */
+		std::vector< unsigned int > m_cpus;
+	};
+
+/*!
+ * \since v.5.5.17
+ * \brief Max length of thread name (without terminating zero).
+ */
+const std::size_t max_thread_name_length = 15;
+
+/*!
+ * \since v.5.5.17
+ * \brief Set name for the current thread.
+ */
+void
+set_current_thread_name( const std::string & name )
+	{
+#if defined( __APPLE__ )
+		pthread_setname_np( name.c_str() );
+#elif defined( __linux__ )
+		pthread_setname_np( pthread_self(), name.c_str() );
+#else
+		(void)name;
+#endif
+	}
+
+/*!
+ * \since v.5.5.17
+ * \brief Set CPU affinity for the current thread.
+ *
+ * \note Errors are ignored: CPU affinity is just a hint for the scheduler.
+ */
+void
+set_current_thread_affinity( const std::vector< unsigned int > & cpus )
+	{
+#if defined( __linux__ )
+		cpu_set_t set;
+		CPU_ZERO( &set );
+		for( auto c : cpus )
+			if( c < CPU_SETSIZE )
+				CPU_SET( c, &set );
+
+		// Zero pid means the calling thread.
+		sched_setaffinity( 0, sizeof( set ), &set );
+#else
+		(void)cpus;
+#endif
+	}
+
+extern "C"
+{
+
+/*!
+ * \since v.5.5.17
+ * \brief Entry point for threads created via pthread_create.
+ */
+static void *
+so_5__thread_factory_entry( void * arg )
+	{
+		std::unique_ptr< thread_startup_info_t > info{
+				static_cast< thread_startup_info_t * >( arg ) };
+
+		if( !info->m_name.empty() )
+			set_current_thread_name( info->m_name );
+		if( !info->m_cpus.empty() )
+			set_current_thread_affinity( info->m_cpus );
+
+		thread_body_t body{ std::move( info->m_body ) };
+		info.reset();
+
+		// The behaviour must be the same as for std::thread.
+		try
+			{
+				body();
+			}
+		catch( ... )
+			{
+				std::terminate();
+			}
+
+		return nullptr;
+	}
+
+} /* extern "C" */
+
+//
+// pthread_handle_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Handle for a thread created via pthread_create.
+ */
+class pthread_handle_t : public thread_handle_t
+	{
+	public :
+		pthread_handle_t( pthread_t thread )
+			:	m_thread( thread )
+			{}
+
+		~pthread_handle_t()
+			{
+				// Not joined thread must not be left in zombie state.
+				if( !m_joined )
+					pthread_detach( m_thread );
+			}
+
+		virtual void
+		join() override
+			{
+				if( !m_joined )
+					{
+						pthread_join( m_thread, nullptr );
+						m_joined = true;
+					}
+			}
+
+	private :
+		pthread_t m_thread;
+		bool m_joined = { false };
+	};
+
+//
+// std_thread_factory_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A standard implementation of thread_factory interface.
+ */
+class std_thread_factory_t : public thread_factory_t
+	{
+	public :
+		std_thread_factory_t( thread_params_t params )
+			:	m_params( std::move( params ) )
+			{}
+
+		virtual thread_handle_unique_ptr_t
+		start( thread_body_t body ) override
+			{
+				const auto ordinal = m_threads_started++;
+
+				std::unique_ptr< thread_startup_info_t > info{
+						new thread_startup_info_t };
+				info->m_body = std::move( body );
+				info->m_name = make_thread_name( ordinal );
+				info->m_cpus = make_thread_cpus( ordinal );
+
+				pthread_attr_t attr;
+				pthread_attr_init( &attr );
+
+				if( m_params.stack_size() )
+					pthread_attr_setstacksize( &attr,
+							adjust_stack_size( m_params.stack_size() ) );
+
+				pthread_t thread;
+				const int rc = pthread_create(
+						&thread, &attr, &so_5__thread_factory_entry, info.get() );
+				pthread_attr_destroy( &attr );
+
+				if( rc )
+					SO_5_THROW_EXCEPTION( rc_unable_to_start_thread,
+							"pthread_create failed, error code: " +
+							std::to_string( rc ) );
+
+				// Now the new thread is the owner of startup info.
+				info.release();
+
+				return thread_handle_unique_ptr_t{
+						new pthread_handle_t{ thread } };
+			}
+
+	private :
+		//! Parameters for new threads.
+		const thread_params_t m_params;
+
+		//! Count of started threads.
+		std::atomic< std::size_t > m_threads_started = { 0 };
+
+		std::string
+		make_thread_name( std::size_t ordinal ) const
+			{
+				if( m_params.name().empty() )
+					return std::string();
+
+				const auto suffix = std::to_string( ordinal );
+				auto prefix = m_params.name();
+				if( prefix.size() + suffix.size() > max_thread_name_length )
+					prefix.resize( suffix.size() < max_thread_name_length ?
+							max_thread_name_length - suffix.size() : 0 );
+
+				return prefix + suffix;
+			}
+
+		std::vector< unsigned int >
+		make_thread_cpus( std::size_t ordinal ) const
+			{
+				const auto & cpus = m_params.cpus();
+				if( cpus.empty() ||
+						affinity_mode_t::whole_set == m_params.affinity_mode() )
+					return cpus;
+
+				return std::vector< unsigned int >(
+						1u, cpus[ ordinal % cpus.size() ] );
+			}
+
+		//! Stack size must be no less than PTHREAD_STACK_MIN and
+		//! must be a multiple of page size on some platforms.
+		static std::size_t
+		adjust_stack_size( std::size_t size )
+			{
+				if( size < static_cast< std::size_t >( PTHREAD_STACK_MIN ) )
+					size = static_cast< std::size_t >( PTHREAD_STACK_MIN );
+
+				const long page_size = sysconf( _SC_PAGESIZE );
+				if( page_size > 0 )
+					{
+						const auto page = static_cast< std::size_t >( page_size );
+						size = ( size + page - 1 ) / page * page;
+					}
+
+				return size;
+			}
+	};
+
+#else
+
+//
+// std_thread_handle_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief Handle for a thread created via std::thread.
+ */
+class std_thread_handle_t : public thread_handle_t
+	{
+	public :
+		std_thread_handle_t( std::thread thread )
+			:	m_thread( std::move( thread ) )
+			{}
+
+		~std_thread_handle_t()
+			{
+				if( m_thread.joinable() )
+					m_thread.detach();
+			}
+
+		virtual void
+		join() override
+			{
+				if( m_thread.joinable() )
+					m_thread.join();
+			}
+
+	private :
+		std::thread m_thread;
+	};
+
+//
+// std_thread_factory_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief A standard implementation of thread_factory interface.
+ *
+ * \note Parameters for threads are not supported on that platform.
+ */
+class std_thread_factory_t : public thread_factory_t
+	{
+	public :
+		std_thread_factory_t( thread_params_t )
+			{}
+
+		virtual thread_handle_unique_ptr_t
+		start( thread_body_t body ) override
+			{
+				return thread_handle_unique_ptr_t{
+						new std_thread_handle_t{ std::thread{ std::move( body ) } } };
+			}
+	};
+
+#endif
+
+} /* namespace anonymous */
+
+//
+// create_std_thread_factory
+//
+SO_5_FUNC thread_factory_shptr_t
+create_std_thread_factory( thread_params_t params )
+	{
+		return thread_factory_shptr_t(
+				new std_thread_factory_t( std::move( params ) ) );
+	}
+
+} /* namespace so_5 */
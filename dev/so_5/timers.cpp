@@ -10,6 +10,8 @@
 
 #include <so_5/h/timers.hpp>
 
+#include <so_5/h/thread_factory.hpp>
+
 #include <so_5/details/h/abort_on_fatal_error.hpp>
 
 #include <timertt/all.hpp>
@@ -92,6 +94,22 @@ timer_thread_t::timer_thread_t()
 timer_thread_t::~timer_thread_t()
 	{}
 
+void
+timer_thread_t::start_with_factory( thread_factory_t & )
+	{
+		start();
+	}
+
+//
+// timer_manager_t
+//
+
+timer_manager_t::timer_manager_t()
+	{}
+
+timer_manager_t::~timer_manager_t()
+	{}
+
 namespace timers_details
 {
 
@@ -103,14 +121,19 @@ namespace timers_details
  * \brief An actual implementation of timer interface.
  * 
  * \tparam TIMER_THREAD A type of timertt-based thread which implements timers.
+ * \tparam THREAD_PTR A type of pointer to TIMER_THREAD.
+ * Since v.5.5.17 it can be a shared pointer. It is necessary for timer
+ * managers which can be destroyed before timer identifiers.
  */
-template< class TIMER_THREAD >
+template<
+	class TIMER_THREAD,
+	class THREAD_PTR = TIMER_THREAD * >
 class actual_timer_t : public timer_t
 	{
 	public :
 		//! Initialized constructor.
 		actual_timer_t(
-			TIMER_THREAD * thread )
+			THREAD_PTR thread )
 			:	m_thread( thread )
 			,	m_timer( thread->allocate() )
 			{}
@@ -147,7 +170,7 @@ class actual_timer_t : public timer_t
 		/*!
 		 * nullptr means that timer is deactivated.
 		 */
-		TIMER_THREAD * m_thread;
+		THREAD_PTR m_thread;
 
 		//! Underlying timer object reference.
 		timertt::timer_holder_t m_timer;
@@ -181,6 +204,17 @@ class actual_thread_t : public timer_thread_t
 				m_thread->start();
 			}
 
+		virtual void
+		start_with_factory( thread_factory_t & factory ) override
+			{
+				m_thread->start(
+					[&factory]( std::function< void() > body ) {
+						std::shared_ptr< thread_handle_t > handle{
+								factory.start( std::move( body ) ) };
+						return [handle] { handle->join(); };
+					} );
+			}
+
 		virtual void
 		finish() override
 			{
@@ -243,6 +277,106 @@ class actual_thread_t : public timer_thread_t
 		std::unique_ptr< TIMER_THREAD > m_thread;
 	};
 
+//
+// actual_manager_t
+//
+/*!
+ * \since v.5.5.17
+ * \brief An actual implementation of timer manager.
+ * 
+ * \tparam TIMER_MANAGER A type of timertt-based manager which implements timers.
+ */
+template< class TIMER_MANAGER >
+class actual_manager_t : public timer_manager_t
+	{
+		// A timer holds the manager alive. Timer manager can be owned
+		// by a private dispatcher and can be destroyed before
+		// the timer identifiers.
+		typedef actual_timer_t<
+				TIMER_MANAGER,
+				std::shared_ptr< TIMER_MANAGER > > timer_demand_t;
+
+	public :
+		//! Initializing constructor.
+		actual_manager_t(
+			//! Real timer manager.
+			std::unique_ptr< TIMER_MANAGER > manager )
+			:	m_manager( std::move( manager ) )
+			{}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox_r,
+			const message_ref_t & msg_r,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				std::unique_ptr< timer_demand_t > timer(
+						new timer_demand_t( m_manager ) );
+
+				mbox_t mbox{ mbox_r };
+				message_ref_t msg{ msg_r };
+				m_manager->activate( timer->timer_holder(),
+						pause,
+						period,
+						[type_index, mbox, msg]()
+						{
+							mbox->deliver_message( type_index, msg );
+						} );
+
+				return timer_id_t( timer.release() );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				m_manager->activate(
+						pause,
+						period,
+						[type_index, mbox, msg]()
+						{
+							mbox->deliver_message( type_index, msg );
+						} );
+			}
+
+		virtual void
+		process_expired_timers() override
+			{
+				m_manager->process_expired_timers();
+			}
+
+		virtual std::chrono::steady_clock::duration
+		timeout_before_nearest_timer(
+			std::chrono::steady_clock::duration default_timeout ) override
+			{
+				return m_manager->timeout_before_nearest_timer( default_timeout );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				auto d = m_manager->get_timer_quantities();
+
+				return timer_thread_stats_t{
+						d.m_single_shot_count,
+						d.m_periodic_count
+					};
+			}
+
+	private :
+		//! Real timer manager.
+		/*!
+		 * \note It is shared with all timer identifiers.
+		 */
+		std::shared_ptr< TIMER_MANAGER > m_manager;
+	};
+
 //
 // error_logger_for_timertt_t
 //
@@ -330,6 +464,52 @@ using timer_heap_thread_t = timertt::timer_heap_thread_template<
 using timer_list_thread_t = timertt::timer_list_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel thread type.
+/*!
+ * \since v.5.5.17
+ */
+using timer_hierarchical_wheel_thread_t =
+	timertt::timer_hierarchical_wheel_thread_template<
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
+
+//! timer_wheel manager type.
+/*!
+ * \since v.5.5.17
+ */
+using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
+		timertt::thread_safety::safe,
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
+
+//! timer_heap manager type.
+/*!
+ * \since v.5.5.17
+ */
+using timer_heap_manager_t = timertt::timer_heap_manager_template<
+		timertt::thread_safety::safe,
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
+
+//! timer_list manager type.
+/*!
+ * \since v.5.5.17
+ */
+using timer_list_manager_t = timertt::timer_list_manager_template<
+		timertt::thread_safety::safe,
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel manager type.
+/*!
+ * \since v.5.5.17
+ */
+using timer_hierarchical_wheel_manager_t =
+	timertt::timer_hierarchical_wheel_manager_template<
+		timertt::thread_safety::safe,
+		error_logger_for_timertt_t,
+		exception_handler_for_timertt_t >;
 /*!
  * \}
  */
@@ -413,5 +593,144 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+
+		return create_timer_hierarchical_wheel_thread(
+				logger,
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t =
+				timers_details::timer_hierarchical_wheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_wheel_manager(
+	error_logger_shptr_t logger )
+	{
+		using timertt_manager_t = timers_details::timer_wheel_manager_t;
+
+		return create_timer_wheel_manager(
+				logger,
+				timertt_manager_t::default_wheel_size(),
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_wheel_manager(
+	error_logger_shptr_t logger,
+	unsigned int wheel_size,
+	std::chrono::steady_clock::duration granuality )
+	{
+		using timertt_manager_t = timers_details::timer_wheel_manager_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_manager_t > manager(
+				new timertt_manager_t(
+						wheel_size,
+						granuality,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt( logger ) ) );
+
+		return timer_manager_unique_ptr_t(
+				new actual_manager_t< timertt_manager_t >( std::move( manager ) ) );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_heap_manager(
+	error_logger_shptr_t logger )
+	{
+		using timertt_manager_t = timers_details::timer_heap_manager_t;
+
+		return create_timer_heap_manager(
+				logger,
+				timertt_manager_t::default_initial_heap_capacity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_heap_manager(
+	error_logger_shptr_t logger,
+	std::size_t initial_heap_capacity )
+	{
+		using timertt_manager_t = timers_details::timer_heap_manager_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_manager_t > manager(
+				new timertt_manager_t(
+						initial_heap_capacity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt( logger ) ) );
+
+		return timer_manager_unique_ptr_t(
+				new actual_manager_t< timertt_manager_t >( std::move( manager ) ) );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_list_manager(
+	error_logger_shptr_t logger )
+	{
+		using timertt_manager_t = timers_details::timer_list_manager_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_manager_t > manager(
+				new timertt_manager_t(
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt( logger ) ) );
+
+		return timer_manager_unique_ptr_t(
+				new actual_manager_t< timertt_manager_t >( std::move( manager ) ) );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+
+		return create_timer_hierarchical_wheel_manager(
+				logger,
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_manager_t > manager(
+				new timertt_manager_t(
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt( logger ) ) );
+
+		return timer_manager_unique_ptr_t(
+				new actual_manager_t< timertt_manager_t >( std::move( manager ) ) );
+	}
+
 } /* namespace so_5 */
 
@@ -0,0 +1,138 @@
+/*
+ * A benchmark for creation and destruction of named mboxes
+ * from several threads.
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/benchmark_helpers.hpp>
+#include <various_helpers_1/cmd_line_args_helpers.hpp>
+
+struct cfg_t
+	{
+		std::size_t m_threads = 4;
+		std::size_t m_mboxes = 10000;
+		std::size_t m_iterations = 10;
+	};
+
+cfg_t
+try_parse_cmdline(
+	int argc,
+	char ** argv )
+{
+	cfg_t tmp_cfg;
+
+	for( char ** current = &argv[ 1 ], **last = argv + argc;
+			current != last;
+			++current )
+		{
+			if( is_arg( *current, "-h", "--help" ) )
+				{
+					std::cout << "usage:\n"
+							"_test.bench.so_5.named_mboxes <options>\n"
+							"\noptions:\n"
+							"-t, --threads     count of working threads\n"
+							"-m, --mboxes      count of named mboxes for every thread\n"
+							"-i, --iterations  count of iterations\n"
+							"-h, --help        show this description\n"
+							<< std::endl;
+					std::exit(1);
+				}
+			else if( is_arg( *current, "-t", "--threads" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_threads, ++current, last,
+						"-t", "count of working threads" );
+			else if( is_arg( *current, "-m", "--mboxes" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_mboxes, ++current, last,
+						"-m", "count of named mboxes for every thread" );
+			else if( is_arg( *current, "-i", "--iterations" ) )
+				mandatory_arg_to_value(
+						tmp_cfg.m_iterations, ++current, last,
+						"-i", "count of iterations" );
+			else
+				throw std::runtime_error(
+						std::string( "unknown argument: " ) + *current );
+		}
+
+	return tmp_cfg;
+}
+
+// Every thread creates its own set of named mboxes (like per-session
+// mboxes) and then destroys them all.
+void
+thread_body(
+	so_5::environment_t & env,
+	const cfg_t & cfg,
+	std::size_t thread_index )
+	{
+		std::vector< std::string > names;
+		names.reserve( cfg.m_mboxes );
+		for( std::size_t i = 0; i != cfg.m_mboxes; ++i )
+			names.push_back( "session-" + std::to_string( thread_index ) +
+					"-" + std::to_string( i ) );
+
+		std::vector< so_5::mbox_t > mboxes;
+		mboxes.reserve( cfg.m_mboxes );
+
+		for( std::size_t it = 0; it != cfg.m_iterations; ++it )
+			{
+				for( const auto & n : names )
+					mboxes.push_back( env.create_mbox( n ) );
+
+				mboxes.clear();
+			}
+	}
+
+void
+run_benchmark( so_5::environment_t & env, const cfg_t & cfg )
+	{
+		std::cout << "* threads: " << cfg.m_threads << "\n"
+				<< "* mboxes: " << cfg.m_mboxes << "\n"
+				<< "* iterations: " << cfg.m_iterations << std::endl;
+
+		benchmarker_t benchmark;
+		benchmark.start();
+
+		std::vector< std::thread > threads;
+		threads.reserve( cfg.m_threads );
+		for( std::size_t i = 0; i != cfg.m_threads; ++i )
+			threads.emplace_back( [&env, &cfg, i] {
+					thread_body( env, cfg, i );
+				} );
+
+		for( auto & t : threads )
+			t.join();
+
+		benchmark.finish_and_show_stats(
+				static_cast< unsigned long long >( cfg.m_threads ) *
+						cfg.m_mboxes * cfg.m_iterations,
+				"mboxes" );
+	}
+
+int
+main( int argc, char ** argv )
+{
+	try
+	{
+		const cfg_t cfg = try_parse_cmdline( argc, argv );
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				run_benchmark( env, cfg );
+				env.stop();
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
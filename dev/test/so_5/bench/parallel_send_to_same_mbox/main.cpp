@@ -9,6 +9,7 @@
 #include <iterator>
 #include <numeric>
 #include <cstdlib>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -92,8 +93,10 @@ init(
 void
 print_usage()
 {
-	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count>\n\n"
-			"<agent_count> and <send_count> must not be 0"
+	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count> "
+			"[cow]\n\n"
+			"<agent_count> and <send_count> must not be 0\n"
+			"cow means local mboxes with copy-on-write snapshots of subscribers"
 			<< std::endl;
 }
 
@@ -112,7 +115,8 @@ main( int argc, char ** argv )
 		auto ensure_args_validity = []( bool p, const char * msg ) {
 			if( !p ) throw cmd_line_exception( msg );
 		};
-		ensure_args_validity( 3 == argc, "wrong number of arguments" );
+		ensure_args_validity( 3 == argc || 4 == argc,
+				"wrong number of arguments" );
 
 		const unsigned int agent_count = std::atoi( argv[1] );
 		ensure_args_validity( agent_count != 0, "agent_count must not be 0" );
@@ -120,6 +124,10 @@ main( int argc, char ** argv )
 		const unsigned int send_count = std::atoi( argv[2] );
 		ensure_args_validity( send_count != 0, "send_count must not be 0" );
 
+		const bool cow = 4 == argc;
+		ensure_args_validity( !cow || std::string( "cow" ) == argv[3],
+				"unknown mbox type" );
+
 		benchmarker_t benchmark;
 		benchmark.start();
 
@@ -128,10 +136,14 @@ main( int argc, char ** argv )
 			{
 				init( env, agent_count, send_count );
 			},
-			[]( so_5::environment_params_t & params )
+			[cow]( so_5::environment_params_t & params )
 			{
 				params.add_named_dispatcher( "active_obj",
 					so_5::disp::active_obj::create_disp() );
+
+				if( cow )
+					params.local_mbox_subscribers(
+							so_5::local_mbox_subscribers_t::copy_on_write );
 			} );
 
 		benchmark.finish_and_show_stats(
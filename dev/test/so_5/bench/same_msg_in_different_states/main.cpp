@@ -6,6 +6,7 @@
 #include <numeric>
 #include <chrono>
 #include <cstdlib>
+#include <string>
 
 #include <so_5/all.hpp>
 
@@ -21,14 +22,30 @@ class a_test_t
 		a_test_t(
 			so_5::environment_t & env,
 			std::size_t states_count,
-			int tick_count )
-			:	so_5::agent_t( env )
+			int tick_count,
+			so_5::subscription_storage_factory_t factory,
+			bool nested )
+			:	so_5::agent_t( env + std::move( factory ) )
 			,	m_self_mbox( env.create_mbox() )
 			,	m_tick_count( tick_count )
 			,	m_messages_received( 0 )
 			{
+				if( nested )
+				{
+					// All states are substates of one subscribed state.
+					m_parents.emplace_back(
+							std::make_shared< so_5::state_t >( self_ptr(), "root" ) );
+					for( const char * name : { "middle", "leaf_parent" } )
+						m_parents.emplace_back(
+								std::make_shared< so_5::state_t >(
+										so_5::substate_of{ *(m_parents.back()) }, name ) );
+				}
+
 				for( size_t i = 0; i != states_count; ++i )
-					m_states.emplace_back(
+					m_states.emplace_back( nested ?
+							std::make_shared< so_5::state_t >(
+									so_5::substate_of{ *(m_parents.back()) },
+									"noname" ) :
 							std::make_shared< so_5::state_t >(
 									self_ptr(), "noname" ) );
 
@@ -38,10 +55,15 @@ class a_test_t
 		virtual void
 		so_define_agent()
 			{
-				for( auto s : m_states )
+				if( !m_parents.empty() )
 					so_subscribe( m_self_mbox )
-							.in( *s )
+							.in( *(m_parents.front()) )
 							.event( &a_test_t::evt_tick );
+				else
+					for( auto s : m_states )
+						so_subscribe( m_self_mbox )
+								.in( *s )
+								.event( &a_test_t::evt_tick );
 			}
 
 		virtual void
@@ -87,6 +109,7 @@ class a_test_t
 		int m_tick_count;
 		std::uint_fast64_t m_messages_received;
 
+		std::vector< std::shared_ptr< so_5::state_t > > m_parents;
 		std::vector< std::shared_ptr< so_5::state_t > > m_states;
 		std::vector< std::shared_ptr< so_5::state_t > >::iterator m_it_current_state;
 
@@ -101,13 +124,28 @@ main( int argc, char ** argv )
 		std::size_t max_states = 16;
 		int tick_count = 100000;
 
-		if( 3 == argc )
+		auto factory = so_5::default_subscription_storage_factory();
+		bool nested = false;
+
+		if( 3 <= argc )
 		{
 			max_states = std::atoi( argv[1] );
 			ensure( max_states > 0, "max_states must be >= 1" );
 
 			tick_count = std::atoi( argv[2] );
 			ensure( tick_count > 0, "tick_count must be >= 1" );
+
+			for( int i = 3; i < argc; ++i )
+			{
+				const std::string arg = argv[ i ];
+				if( "perfect_hash" == arg )
+					factory = so_5::perfect_hash_based_subscription_storage_factory();
+				else if( "nested" == arg )
+					nested = true;
+				else
+					ensure( false, "unknown argument: " + arg +
+							" (only perfect_hash and nested are allowed)" );
+			}
 		}
 
 		for( std::size_t states = 1; states <= max_states; states *= 2 )
@@ -116,10 +154,11 @@ main( int argc, char ** argv )
 				<< std::endl;
 
 			so_5::launch(
-				[states, tick_count]( so_5::environment_t & env )
+				[states, tick_count, &factory, nested]( so_5::environment_t & env )
 				{
 					env.register_agent_as_coop( "test",
-							new a_test_t( env, states, tick_count ) );
+							new a_test_t(
+									env, states, tick_count, factory, nested ) );
 				} );
 
 			tick_count /= 2;
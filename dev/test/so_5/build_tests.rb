@@ -18,6 +18,8 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/environment/add_disp_after_start/prj.ut.rb"
 	required_prj "#{path}/environment/reg_coop_after_stop/prj.ut.rb"
 	required_prj "#{path}/environment/autoname_coop/prj.ut.rb"
+	required_prj "#{path}/environment/thread_factory/prj.ut.rb"
+	required_prj "#{path}/environment/single_threaded/prj.ut.rb"
 
 	required_prj "#{path}/wrapped_env/build_tests.rb"
 
@@ -27,6 +29,8 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/timer_thread/single_periodic/prj.ut.rb" 
 	required_prj "#{path}/timer_thread/single_timer_zero_delay/prj.ut.rb" 
 	required_prj "#{path}/timer_thread/timers_cancelation/prj.ut.rb" 
+	required_prj "#{path}/timer_thread/disp_timer_manager/prj.ut.rb" 
+	required_prj "#{path}/timer_thread/hierarchical_wheel/prj.ut.rb" 
 
 	required_prj "#{path}/mpsc_queue_traits/build_tests.rb"
 
@@ -68,6 +72,7 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/bench/agent_ring/prj.rb" 
 	required_prj "#{path}/bench/coop_dereg/prj.rb" 
 	required_prj "#{path}/bench/skynet1m/prj.rb" 
+	required_prj "#{path}/bench/named_mboxes/prj.rb" 
 
 	required_prj "#{path}/samples_as_unit_tests/build_tests.rb" 
 }
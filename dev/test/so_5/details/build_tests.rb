@@ -6,4 +6,5 @@ MxxRu::Cpp::composite_target {
 	path = 'test/so_5/details'
 
 	required_prj( "#{path}/invoke_noexcept_code/prj.ut.rb" )
+	required_prj( "#{path}/small_function/prj.ut.rb" )
 }
@@ -0,0 +1,186 @@
+/*
+ * A test for so_5::details::small_function_t.
+ */
+
+#include <so_5/details/h/small_function.hpp>
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+using func_t = so_5::details::small_function_t< int(int) >;
+
+void
+ensure( bool condition, const string & what )
+	{
+		if( !condition )
+			throw runtime_error( what );
+	}
+
+struct agent_like_t
+	{
+		int m_base = 0;
+
+		int
+		add( int v ) { return m_base + v; }
+	};
+
+// Counter of live objects for checking copy and destruction.
+int live_objects = 0;
+
+struct counted_t
+	{
+		int m_value;
+
+		counted_t( int v ) : m_value( v ) { ++live_objects; }
+		counted_t( const counted_t & o ) : m_value( o.m_value ) { ++live_objects; }
+		counted_t( counted_t && o ) SO_5_NOEXCEPT : m_value( o.m_value ) { ++live_objects; }
+		~counted_t() { --live_objects; }
+	};
+
+void
+test_empty()
+	{
+		func_t f;
+		ensure( !f, "default constructed object must be empty" );
+		ensure( f == nullptr, "default constructed object must be equal to nullptr" );
+
+		bool thrown = false;
+		try { f( 0 ); }
+		catch( const std::bad_function_call & ) { thrown = true; }
+		ensure( thrown, "bad_function_call expected" );
+	}
+
+void
+test_member_function()
+	{
+		agent_like_t agent;
+		agent.m_base = 10;
+
+		auto pfn = &agent_like_t::add;
+		func_t f = [&agent, pfn]( int v ) { return (agent.*pfn)( v ); };
+		ensure( static_cast< bool >( f ), "object must not be empty" );
+		ensure( 15 == f( 5 ), "unexpected result for member function" );
+
+		func_t copy = f;
+		agent.m_base = 20;
+		ensure( 25 == copy( 5 ), "unexpected result for copy" );
+
+		func_t moved = std::move( f );
+		ensure( !f, "moved-from object must be empty" );
+		ensure( 21 == moved( 1 ), "unexpected result for moved object" );
+	}
+
+template< std::size_t SIZE >
+void
+test_counted( const string & name )
+	{
+		struct big_t { char m_data[ SIZE ]; };
+
+		{
+			counted_t counted( 3 );
+			big_t big{};
+			func_t f = [counted, big]( int v ) {
+					return counted.m_value * v + big.m_data[ 0 ];
+				};
+			ensure( 12 == f( 4 ), name + ": unexpected result" );
+
+			func_t copy = f;
+			func_t moved = std::move( copy );
+			func_t assigned;
+			assigned = moved;
+			ensure( 6 == assigned( 2 ), name + ": unexpected result for assigned" );
+
+			moved = nullptr;
+			ensure( !moved, name + ": object must be empty after reset" );
+
+			f.swap( moved );
+			ensure( !f && static_cast< bool >( moved ),
+					name + ": unexpected state after swap" );
+		}
+
+		ensure( 0 == live_objects, name + ": all objects must be destroyed" );
+	}
+
+void
+test_mutable()
+	{
+		auto shared = make_shared< int >( 0 );
+
+		func_t f = [shared]( int v ) mutable { *shared += v; return *shared; };
+		f( 1 );
+		f( 2 );
+		ensure( 3 == *shared, "state of mutable lambda must be kept" );
+
+		int counter = 0;
+		func_t g = [counter]( int v ) mutable { counter += v; return counter; };
+		g( 1 );
+		ensure( 3 == g( 2 ), "captured value must be changed" );
+	}
+
+int
+free_function( int v ) { return v * 2; }
+
+void
+test_function_pointer()
+	{
+		func_t f = &free_function;
+		ensure( 8 == f( 4 ), "unexpected result for function pointer" );
+
+		f = []( int v ) { return v + 1; };
+		ensure( 5 == f( 4 ), "unexpected result after assignment" );
+	}
+
+template< std::size_t SIZE >
+struct big_functor_t
+	{
+		int * m_last;
+		char m_payload[ SIZE ];
+
+		int
+		operator()( int v ) const { *m_last = v; return v * 2; }
+	};
+
+void
+test_void_result()
+	{
+		using void_func_t = so_5::details::small_function_t< void(int) >;
+
+		int last = 0;
+		void_func_t f = [&last]( int v ) { last = v; return v * 2; };
+		f( 3 );
+		ensure( 3 == last, "unexpected value for void result (inline)" );
+
+		void_func_t g = big_functor_t< 128 >{ &last, {} };
+		g( 7 );
+		ensure( 7 == last, "unexpected value for void result (heap)" );
+
+		g = f;
+		g( 9 );
+		ensure( 9 == last, "unexpected value for void result after copy" );
+	}
+
+int
+main()
+{
+	try
+	{
+		test_empty();
+		test_member_function();
+		test_counted< 1 >( "small object" );
+		test_counted< 128 >( "big object" );
+		test_mutable();
+		test_function_pointer();
+		test_void_result();
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
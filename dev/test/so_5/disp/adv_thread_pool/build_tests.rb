@@ -11,4 +11,5 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/so_5/disp/adv_thread_pool/cooperation_fifo/prj.ut.rb" )
 	required_prj( "test/so_5/disp/adv_thread_pool/individual_fifo/prj.ut.rb" )
 	required_prj( "test/so_5/disp/adv_thread_pool/unsafe_after_safe/prj.ut.rb" )
+	required_prj( "test/so_5/disp/adv_thread_pool/work_stealing/prj.ut.rb" )
 }
@@ -31,5 +31,13 @@ for_each_lock_factory( L && action )
 		run_with_lock_factory( "simple_lock",
 				simple_lock_factory(),
 				std::forward<L>(action) );
+
+		run_with_lock_factory( "futex_lock()",
+				futex_lock_factory(),
+				std::forward<L>(action) );
+
+		run_with_lock_factory( "futex_lock(0)",
+				futex_lock_factory( 0 ),
+				std::forward<L>(action) );
 	}
 
@@ -0,0 +1,145 @@
+/*
+ * Test for adv_thread_pool dispatcher in work stealing mode.
+ */
+
+#include <so_5/all.hpp>
+
+#include <sstream>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+using namespace std;
+
+using namespace so_5;
+using namespace so_5::disp::adv_thread_pool;
+
+struct msg_seq
+	{
+		std::size_t m_seq;
+	};
+
+struct msg_agent_finished : public signal_t {};
+
+class a_test_t final : public agent_t
+	{
+	public :
+		a_test_t( context_t ctx, mbox_t shutdowner, std::size_t messages )
+			:	agent_t{ ctx }
+			,	m_shutdowner{ move(shutdowner) }
+			,	m_messages{ messages }
+			{
+				so_subscribe_self().event( &a_test_t::on_seq );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				// Demands will be scheduled from a working thread.
+				for( std::size_t i = 0; i != m_messages; ++i )
+					send< msg_seq >( *this, i );
+			}
+
+	private :
+		const mbox_t m_shutdowner;
+		const std::size_t m_messages;
+
+		std::size_t m_expected = 0;
+
+		void
+		on_seq( const msg_seq & msg )
+			{
+				if( msg.m_seq != m_expected )
+					{
+						ostringstream ss;
+						ss << "unexpected sequence number: " << msg.m_seq
+								<< ", expected: " << m_expected;
+						throw runtime_error( ss.str() );
+					}
+
+				++m_expected;
+				if( m_expected == m_messages )
+					send< msg_agent_finished >( m_shutdowner );
+			}
+	};
+
+class a_shutdowner_t final : public agent_t
+	{
+	public :
+		a_shutdowner_t( context_t ctx, std::size_t working_agents )
+			:	agent_t{ ctx }
+			,	m_working_agents{ working_agents }
+			{
+				so_subscribe_self().event< msg_agent_finished >( [this] {
+						--m_working_agents;
+						if( !m_working_agents )
+							so_environment().stop();
+					} );
+			}
+
+	private :
+		std::size_t m_working_agents;
+	};
+
+const std::size_t coop_count = 64;
+const std::size_t coop_size = 16;
+const std::size_t messages_per_agent = 100;
+
+void
+do_test( queue_traits::lock_factory_t factory, fifo_t fifo )
+	{
+		so_5::launch( [&]( environment_t & env ) {
+				auto disp = create_private_disp( env,
+						"ws",
+						disp_params_t{}
+							.thread_count( 8 )
+							.set_queue_params( queue_traits::queue_params_t{}
+								.lock_factory( factory )
+								.work_stealing( true ) ) );
+
+				mbox_t shutdowner;
+				env.introduce_coop( [&]( coop_t & coop ) {
+						shutdowner = coop.make_agent< a_shutdowner_t >(
+								coop_count * coop_size )->so_direct_mbox();
+					} );
+
+				for( std::size_t i = 0; i != coop_count; ++i )
+					env.introduce_coop(
+						disp->binder( bind_params_t{}.fifo( fifo ) ),
+						[&]( coop_t & coop ) {
+							for( std::size_t a = 0; a != coop_size; ++a )
+								coop.make_agent< a_test_t >(
+										shutdowner, messages_per_agent );
+						} );
+			} );
+	}
+
+int
+main()
+	{
+		try
+			{
+				for_each_lock_factory( []( queue_traits::lock_factory_t factory ) {
+					run_with_time_limit( [&] {
+							do_test( factory, fifo_t::cooperation );
+						},
+						60,
+						"adv_thread_pool work_stealing test (cooperation fifo)" );
+
+					run_with_time_limit( [&] {
+							do_test( factory, fifo_t::individual );
+						},
+						60,
+						"adv_thread_pool work_stealing test (individual fifo)" );
+				} );
+			}
+		catch( const exception & ex )
+			{
+				cerr << "Error: " << ex.what() << endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
@@ -14,6 +14,7 @@ MxxRu::Cpp::composite_target {
 
 	add_test[ 'prio_ot_strictly_ordered/build_tests.rb' ]
 	add_test[ 'prio_ot_quoted_round_robin/build_tests.rb' ]
+	add_test[ 'prio_one_thread/build_tests.rb' ]
 
 	add_test[ 'prio_dt_one_per_prio/build_tests.rb' ]
 }
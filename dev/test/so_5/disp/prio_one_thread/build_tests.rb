@@ -0,0 +1,9 @@
+#!/usr/local/bin/ruby
+require 'mxx_ru/cpp'
+
+path = 'test/so_5/disp/prio_one_thread'
+
+MxxRu::Cpp::composite_target {
+
+	required_prj "#{path}/priority_bitmap/prj.ut.rb"
+}
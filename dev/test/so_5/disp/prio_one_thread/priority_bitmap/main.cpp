@@ -0,0 +1,164 @@
+/*
+ * A test for so_5::disp::prio_one_thread::reuse::priority_bitmap_t.
+ *
+ * Results of the bitmap are compared with results of a naive search
+ * over all priorities.
+ */
+
+#include <so_5/disp/prio_one_thread/reuse/h/priority_bitmap.hpp>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+using bitmap_t = so_5::disp::prio_one_thread::reuse::priority_bitmap_t;
+
+const std::size_t priorities = so_5::prio::total_priorities_count;
+
+void
+ensure( bool condition, const string & what )
+	{
+		if( !condition )
+			throw runtime_error( what );
+	}
+
+bool
+is_set( unsigned int mask, std::size_t index )
+	{
+		return 0 != ( mask & ( 1u << index ) );
+	}
+
+std::size_t
+naive_highest( unsigned int mask )
+	{
+		for( std::size_t i = priorities; i != 0; --i )
+			if( is_set( mask, i - 1 ) )
+				return i - 1;
+
+		throw runtime_error( "naive_highest: empty mask" );
+	}
+
+std::size_t
+naive_next_lower_or_highest( unsigned int mask, std::size_t index )
+	{
+		for( std::size_t i = index; i != 0; --i )
+			if( is_set( mask, i - 1 ) )
+				return i - 1;
+
+		return naive_highest( mask );
+	}
+
+// Compare the state of the bitmap with the expected mask.
+void
+check_state( const bitmap_t & bitmap, unsigned int mask )
+	{
+		const string name = "mask " + to_string( mask ) + ": ";
+
+		ensure( bitmap.empty() == ( 0 == mask ), name + "unexpected empty()" );
+		if( !mask )
+			return;
+
+		ensure( naive_highest( mask ) == bitmap.highest(),
+				name + "unexpected highest()" );
+
+		for( std::size_t index = 0; index != priorities; ++index )
+			ensure( naive_next_lower_or_highest( mask, index ) ==
+					bitmap.next_lower_or_highest( index ),
+					name + "unexpected next_lower_or_highest(" +
+							to_string( index ) + ")" );
+	}
+
+// Every subset of priorities is built by set() and then cleared by reset()
+// in ascending and descending order.
+void
+test_all_subsets()
+	{
+		for( unsigned int mask = 0; mask != ( 1u << priorities ); ++mask )
+			{
+				for( bool ascending : { true, false } )
+					{
+						bitmap_t bitmap;
+						unsigned int current = 0;
+						for( std::size_t i = 0; i != priorities; ++i )
+							{
+								const std::size_t index =
+										ascending ? i : priorities - 1 - i;
+								if( is_set( mask, index ) )
+									{
+										bitmap.set( index );
+										current |= 1u << index;
+										check_state( bitmap, current );
+									}
+							}
+
+						// set() for the already set bit doesn't change anything.
+						for( std::size_t index = 0; index != priorities; ++index )
+							if( is_set( mask, index ) )
+								{
+									bitmap.set( index );
+									check_state( bitmap, current );
+								}
+
+						for( std::size_t i = 0; i != priorities; ++i )
+							{
+								const std::size_t index =
+										ascending ? priorities - 1 - i : i;
+								bitmap.reset( index );
+								current &= ~( 1u << index );
+								check_state( bitmap, current );
+							}
+
+						ensure( bitmap.empty(), "bitmap must be empty at the end" );
+					}
+			}
+	}
+
+// Transitions between empty and non-empty states for every pair
+// of different priorities.
+void
+test_empty_transitions()
+	{
+		for( std::size_t first = 0; first != priorities; ++first )
+			for( std::size_t second = 0; second != priorities; ++second )
+				{
+					if( first == second )
+						continue;
+
+					bitmap_t bitmap;
+
+					bitmap.set( first );
+					check_state( bitmap, 1u << first );
+
+					bitmap.reset( first );
+					check_state( bitmap, 0 );
+
+					bitmap.set( second );
+					bitmap.set( first );
+					check_state( bitmap, ( 1u << first ) | ( 1u << second ) );
+
+					bitmap.reset( second );
+					check_state( bitmap, 1u << first );
+
+					bitmap.reset( first );
+					check_state( bitmap, 0 );
+				}
+	}
+
+int
+main()
+{
+	try
+	{
+		test_all_subsets();
+		test_empty_transitions();
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
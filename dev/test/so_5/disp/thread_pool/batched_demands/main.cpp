@@ -0,0 +1,245 @@
+/*
+ * A test for thread_pool dispatcher with processing of demands
+ * by batches (max_demands_at_once greater than 1).
+ *
+ * Checks the order of demands for every agent and the exclusive
+ * processing of demands of agents from one cooperation if
+ * cooperation FIFO is used.
+ */
+
+#include <iostream>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <sstream>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+const std::size_t thread_count = 4;
+const std::size_t coop_count = 8;
+const std::size_t agents_per_coop = 4;
+const std::size_t sender_count = 4;
+const std::size_t messages_per_sender = 500;
+
+struct msg_seq : public so_5::message_t
+{
+	std::size_t m_sender;
+	std::size_t m_seq;
+
+	msg_seq( std::size_t sender, std::size_t seq )
+		:	m_sender( sender ), m_seq( seq )
+	{}
+};
+
+struct msg_done : public so_5::signal_t {};
+
+// Detector of simultaneous processing of demands.
+struct exclusivity_checker_t
+{
+	std::atomic< unsigned int > m_active = { 0 };
+};
+
+std::atomic< bool > g_failed = { false };
+
+void
+failure( const char * what )
+{
+	if( !g_failed.exchange( true ) )
+		std::cerr << "Failure: " << what << std::endl;
+}
+
+class a_receiver_t : public so_5::agent_t
+{
+	public :
+		a_receiver_t(
+			so_5::environment_t & env,
+			exclusivity_checker_t & checker,
+			so_5::mbox_t shutdowner )
+			:	so_5::agent_t( env )
+			,	m_checker( checker )
+			,	m_shutdowner( std::move( shutdowner ) )
+			,	m_expected( sender_count, 0u )
+		{}
+
+		virtual void
+		so_define_agent() override
+		{
+			so_subscribe_self().event( &a_receiver_t::evt_seq );
+		}
+
+	private :
+		exclusivity_checker_t & m_checker;
+		const so_5::mbox_t m_shutdowner;
+
+		std::vector< std::size_t > m_expected;
+		std::size_t m_received = 0;
+
+		void
+		evt_seq( const msg_seq & msg )
+		{
+			if( 0 != m_checker.m_active.fetch_add( 1 ) )
+				failure( "simultaneous processing of demands" );
+
+			if( m_expected[ msg.m_sender ] != msg.m_seq )
+				failure( "wrong order of demands" );
+			m_expected[ msg.m_sender ] = msg.m_seq + 1;
+
+			// Give a chance to other working threads.
+			if( 0 == msg.m_seq % 64 )
+				std::this_thread::yield();
+
+			m_checker.m_active.fetch_sub( 1 );
+
+			if( sender_count * messages_per_sender == ++m_received )
+				so_5::send< msg_done >( m_shutdowner );
+		}
+};
+
+class a_shutdowner_t : public so_5::agent_t
+{
+	public :
+		a_shutdowner_t( so_5::environment_t & env )
+			:	so_5::agent_t( env )
+		{}
+
+		virtual void
+		so_define_agent() override
+		{
+			so_subscribe_self().event< msg_done >( [this] {
+					if( !--m_remaining )
+						so_environment().stop();
+				} );
+		}
+
+	private :
+		std::size_t m_remaining = coop_count * agents_per_coop;
+};
+
+class a_sender_t : public so_5::agent_t
+{
+	public :
+		a_sender_t(
+			so_5::environment_t & env,
+			std::size_t index,
+			std::vector< so_5::mbox_t > receivers )
+			:	so_5::agent_t( env )
+			,	m_index( index )
+			,	m_receivers( std::move( receivers ) )
+		{}
+
+		virtual void
+		so_evt_start() override
+		{
+			for( std::size_t i = 0; i != messages_per_sender; ++i )
+				for( const auto & r : m_receivers )
+					so_5::send< msg_seq >( r, m_index, i );
+		}
+
+	private :
+		const std::size_t m_index;
+		const std::vector< so_5::mbox_t > m_receivers;
+};
+
+void
+run_test(
+	tp_disp::queue_traits::lock_factory_t factory,
+	tp_disp::fifo_t fifo,
+	std::size_t max_demands_at_once )
+{
+	std::cout << "fifo: "
+			<< (tp_disp::fifo_t::cooperation == fifo ?
+					"cooperation" : "individual")
+			<< ", max_demands_at_once: " << max_demands_at_once
+			<< std::endl;
+
+	// Checkers for every cooperation (in the case of cooperation FIFO)
+	// or for every agent (in the case of individual FIFO).
+	std::vector< exclusivity_checker_t > checkers(
+			tp_disp::fifo_t::cooperation == fifo ?
+					coop_count : coop_count * agents_per_coop );
+
+	so_5::launch(
+		[&]( so_5::environment_t & env )
+		{
+			auto disp = tp_disp::create_private_disp(
+					env,
+					tp_disp::disp_params_t{}
+						.thread_count( thread_count )
+						.tune_queue_params(
+							[&]( tp_disp::queue_traits::queue_params_t & p ) {
+								p.lock_factory( factory );
+							} ),
+					"batched" );
+
+			so_5::mbox_t shutdowner;
+			env.introduce_coop( [&]( so_5::coop_t & coop ) {
+				shutdowner = coop.add_agent( new a_shutdowner_t( env ) )
+						->so_direct_mbox();
+			} );
+
+			std::vector< so_5::mbox_t > receivers;
+			for( std::size_t c = 0; c != coop_count; ++c )
+				env.introduce_coop(
+					disp->binder( tp_disp::bind_params_t{}
+							.fifo( fifo )
+							.max_demands_at_once( max_demands_at_once ) ),
+					[&]( so_5::coop_t & coop ) {
+						for( std::size_t a = 0; a != agents_per_coop; ++a )
+						{
+							auto & checker = tp_disp::fifo_t::cooperation == fifo ?
+									checkers[ c ] :
+									checkers[ c * agents_per_coop + a ];
+							receivers.push_back(
+									coop.add_agent(
+											new a_receiver_t( env, checker, shutdowner ) )
+										->so_direct_mbox() );
+						}
+					} );
+
+			env.introduce_coop(
+				so_5::disp::active_obj::create_private_disp( env )->binder(),
+				[&]( so_5::coop_t & coop ) {
+					for( std::size_t s = 0; s != sender_count; ++s )
+						coop.add_agent( new a_sender_t( env, s, receivers ) );
+				} );
+		} );
+
+	if( g_failed )
+		throw std::runtime_error( "test failed" );
+}
+
+int
+main()
+{
+	try
+	{
+		for_each_lock_factory( []( tp_disp::queue_traits::lock_factory_t factory ) {
+			run_with_time_limit(
+				[&]()
+				{
+					for( auto fifo : { tp_disp::fifo_t::cooperation,
+							tp_disp::fifo_t::individual } )
+						for( std::size_t max_demands : { 4u, 64u } )
+							run_test( factory, fifo, max_demands );
+				},
+				240,
+				"thread_pool batched_demands test" );
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,235 @@
+/*
+ * Test for thread_pool dispatcher in elastic mode.
+ */
+
+#include <so_5/all.hpp>
+
+#include <set>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <sstream>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+using namespace std;
+
+using namespace so_5;
+using namespace so_5::disp::thread_pool;
+
+struct msg_work : public signal_t {};
+
+struct msg_work_done : public signal_t {};
+
+//! Set of IDs of working threads used by workers.
+class thread_ids_t
+	{
+	public :
+		void
+		add( std::thread::id id )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				m_ids.insert( id );
+			}
+
+		std::size_t
+		size()
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				return m_ids.size();
+			}
+
+	private :
+		std::mutex m_lock;
+		std::set< std::thread::id > m_ids;
+	};
+
+class a_worker_t final : public agent_t
+	{
+	public :
+		a_worker_t( context_t ctx, mbox_t monitor, thread_ids_t & ids )
+			:	agent_t{ ctx }
+			,	m_monitor{ move(monitor) }
+			,	m_ids( ids )
+			{
+				so_subscribe_self().event< msg_work >( &a_worker_t::on_work );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				send< msg_work >( *this );
+			}
+
+	private :
+		const mbox_t m_monitor;
+		thread_ids_t & m_ids;
+
+		void
+		on_work()
+			{
+				m_ids.add( std::this_thread::get_id() );
+
+				// Imitation of long-running work.
+				std::this_thread::sleep_for( std::chrono::milliseconds(20) );
+
+				send< msg_work_done >( m_monitor );
+			}
+	};
+
+class a_monitor_t final : public agent_t
+	{
+	public :
+		a_monitor_t( context_t ctx, std::size_t workers )
+			:	agent_t{ ctx }
+			,	m_workers{ workers }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event< msg_work_done >( &a_monitor_t::on_work_done )
+					.event(
+						so_environment().stats_controller().mbox(),
+						&a_monitor_t::on_quantity );
+			}
+
+	private :
+		std::size_t m_workers;
+
+		std::size_t m_thread_count = { 0 };
+		std::size_t m_threads_grown = { 0 };
+		std::size_t m_threads_retired = { 0 };
+
+		void
+		on_work_done()
+			{
+				if( !--m_workers )
+					{
+						so_environment().stats_controller().set_distribution_period(
+								std::chrono::milliseconds(50) );
+						so_environment().stats_controller().turn_on();
+					}
+			}
+
+		void
+		on_quantity( const stats::messages::quantity< std::size_t > & evt )
+			{
+				if( std::string( evt.m_prefix.c_str() ).find( "/tp/elastic" ) ==
+						std::string::npos )
+					return;
+
+				if( stats::suffixes::disp_thread_count() == evt.m_suffix )
+					m_thread_count = evt.m_value;
+				else if( stats::suffixes::disp_threads_grown() == evt.m_suffix )
+					m_threads_grown = evt.m_value;
+				else if( stats::suffixes::disp_threads_retired() == evt.m_suffix )
+					{
+						m_threads_retired = evt.m_value;
+
+						std::cout << "threads: " << m_thread_count
+								<< ", grown: " << m_threads_grown
+								<< ", retired: " << m_threads_retired << std::endl;
+
+						// All added threads must be retired after idle period.
+						if( m_threads_grown && 1 == m_thread_count &&
+								m_threads_grown == m_threads_retired )
+							so_environment().stop();
+					}
+			}
+	};
+
+const std::size_t workers = 16;
+const std::size_t max_threads = 4;
+
+void
+do_test( queue_traits::lock_factory_t factory )
+	{
+		thread_ids_t ids;
+
+		so_5::launch( [&]( environment_t & env ) {
+				auto disp = create_private_disp( env,
+						disp_params_t{}
+							.tune_queue_params( [&]( queue_traits::queue_params_t & p ) {
+									p.lock_factory( factory );
+								} )
+							.elastic( elastic_params_t{}
+								.min_threads( 1 )
+								.max_threads( max_threads )
+								.backlog_threshold( 1 )
+								.wait_time_threshold( std::chrono::milliseconds(5) )
+								.idle_timeout( std::chrono::milliseconds(50) ) ),
+						"elastic" );
+
+				mbox_t monitor;
+				env.introduce_coop( [&]( coop_t & coop ) {
+						monitor = coop.make_agent< a_monitor_t >( workers )
+								->so_direct_mbox();
+					} );
+
+				env.introduce_coop(
+					disp->binder( bind_params_t{}.fifo( fifo_t::individual ) ),
+					[&]( coop_t & coop ) {
+						for( std::size_t i = 0; i != workers; ++i )
+							coop.make_agent< a_worker_t >( monitor, ids );
+					} );
+			} );
+
+		// Count of working threads must grow under the load.
+		if( ids.size() < 2 )
+			{
+				ostringstream ss;
+				ss << "unexpected count of working threads used: " << ids.size();
+				throw runtime_error( ss.str() );
+			}
+	}
+
+void
+check_invalid_params( elastic_params_t params )
+	{
+		try
+			{
+				create_disp( disp_params_t{}.elastic( params ) );
+			}
+		catch( const so_5::exception_t & x )
+			{
+				if( rc_disp_create_failed == x.error_code() )
+					return;
+				throw;
+			}
+
+		throw runtime_error( "an exception expected for invalid "
+				"elastic params" );
+	}
+
+int
+main()
+	{
+		try
+			{
+				for_each_lock_factory( []( queue_traits::lock_factory_t factory ) {
+					run_with_time_limit( [&] {
+							do_test( factory );
+						},
+						20,
+						"thread_pool elastic test" );
+				} );
+
+				check_invalid_params( elastic_params_t{}
+						.min_threads( 0 )
+						.max_threads( max_threads ) );
+				check_invalid_params( elastic_params_t{}
+						.min_threads( max_threads + 1 )
+						.max_threads( max_threads ) );
+			}
+		catch( const exception & ex )
+			{
+				cerr << "Error: " << ex.what() << endl;
+				return 1;
+			}
+
+		return 0;
+	}
@@ -0,0 +1,357 @@
+/*
+ * A test for single-threaded environment infrastructure.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+class counting_factory_t : public so_5::thread_factory_t
+	{
+	public :
+		counting_factory_t()
+			:	m_actual( so_5::create_std_thread_factory() )
+			{}
+
+		virtual so_5::thread_handle_unique_ptr_t
+		start( so_5::thread_body_t body ) override
+			{
+				++m_started;
+				return m_actual->start( std::move(body) );
+			}
+
+		std::size_t
+		started() const
+			{
+				return m_started.load();
+			}
+
+	private :
+		so_5::thread_factory_shptr_t m_actual;
+		std::atomic< std::size_t > m_started = { 0 };
+	};
+
+struct msg_ping { unsigned int m_value; };
+struct msg_pong { unsigned int m_value; };
+
+struct msg_tick : public so_5::signal_t {};
+struct msg_timeout : public so_5::signal_t {};
+
+class a_base_t : public so_5::agent_t
+	{
+	public :
+		a_base_t( context_t ctx, std::thread::id main_thread )
+			:	so_5::agent_t( ctx )
+			,	m_main_thread( main_thread )
+			{}
+
+	protected :
+		void
+		ensure_main_thread() const
+			{
+				if( m_main_thread != std::this_thread::get_id() )
+					throw std::runtime_error( "event is handled on unexpected thread" );
+			}
+
+	private :
+		const std::thread::id m_main_thread;
+	};
+
+class a_ponger_t final : public a_base_t
+	{
+	public :
+		using a_base_t::a_base_t;
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe( so_environment().create_mbox( "ping" ) )
+					.event( [this]( const msg_ping & msg ) {
+						ensure_main_thread();
+						so_5::send< msg_pong >(
+								so_environment().create_mbox( "pong" ), msg.m_value );
+					} );
+			}
+	};
+
+class a_pinger_t final : public a_base_t
+	{
+	public :
+		using a_base_t::a_base_t;
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe( so_environment().create_mbox( "pong" ) )
+					.event( &a_pinger_t::on_pong );
+
+				so_default_state()
+					.event< msg_tick >( &a_pinger_t::on_tick )
+					.event< msg_timeout >( [this] {
+						throw std::runtime_error( "timeout" );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				ensure_main_thread();
+
+				m_tick_timer = so_5::send_periodic< msg_tick >(
+						*this,
+						std::chrono::milliseconds( 5 ),
+						std::chrono::milliseconds( 5 ) );
+				so_5::send_delayed< msg_timeout >(
+						*this, std::chrono::seconds( 10 ) );
+
+				send_ping( 0 );
+			}
+
+	private :
+		static const unsigned int pings = 10000;
+		static const unsigned int ticks = 3;
+
+		so_5::timer_id_t m_tick_timer;
+
+		unsigned int m_pongs = { 0 };
+		unsigned int m_ticks = { 0 };
+
+		void
+		send_ping( unsigned int value )
+			{
+				so_5::send< msg_ping >(
+						so_environment().create_mbox( "ping" ), value );
+			}
+
+		void
+		on_pong( const msg_pong & msg )
+			{
+				ensure_main_thread();
+
+				if( msg.m_value != m_pongs )
+					throw std::runtime_error( "unexpected pong value: " +
+							std::to_string( msg.m_value ) );
+
+				if( ++m_pongs < pings )
+					send_ping( m_pongs );
+				else
+					try_finish();
+			}
+
+		void
+		on_tick()
+			{
+				ensure_main_thread();
+
+				if( ++m_ticks == ticks )
+					{
+						m_tick_timer.release();
+						try_finish();
+					}
+			}
+
+		void
+		try_finish()
+			{
+				if( pings == m_pongs && ticks <= m_ticks )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+do_ping_pong_test()
+	{
+		const auto main_thread = std::this_thread::get_id();
+
+		std::shared_ptr< counting_factory_t > env_factory{
+				new counting_factory_t{} };
+
+		so_5::launch(
+			[&]( so_5::environment_t & env )
+			{
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_ponger_t >( main_thread );
+						coop.make_agent< a_pinger_t >( main_thread );
+					} );
+			},
+			[&]( so_5::environment_params_t & params )
+			{
+				params.thread_factory( env_factory );
+				params.infrastructure( so_5::env_infrastructure_t::single_threaded );
+			} );
+
+		if( 0 != env_factory->started() )
+			throw std::runtime_error( "no threads expected, started: " +
+					std::to_string( env_factory->started() ) );
+	}
+
+void
+do_stop_from_another_thread_test()
+	{
+		so_5::launch(
+			[&]( so_5::environment_t & env )
+			{
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.define_agent().on_start( [&env] {
+							std::thread{ [&env] {
+									std::this_thread::sleep_for(
+											std::chrono::milliseconds( 50 ) );
+									env.stop();
+								} }.detach();
+						} );
+					} );
+			},
+			[&]( so_5::environment_params_t & params )
+			{
+				params.disable_autoshutdown();
+				params.infrastructure( so_5::env_infrastructure_t::single_threaded );
+			} );
+	}
+
+template< typename LAMBDA >
+void
+ensure_not_allowed(
+	const char * case_name,
+	LAMBDA && lambda,
+	int expected_error = so_5::rc_disp_not_allowed_in_single_threaded_env )
+	{
+		try
+			{
+				lambda();
+			}
+		catch( const so_5::exception_t & x )
+			{
+				if( expected_error == x.error_code() )
+					return;
+				throw;
+			}
+
+		throw std::runtime_error( std::string( "an exception expected: " ) +
+				case_name );
+	}
+
+void
+do_non_default_disp_test()
+	{
+		so_5::launch(
+			[&]( so_5::environment_t & env )
+			{
+				ensure_not_allowed( "private dispatcher", [&env] {
+						so_5::disp::one_thread::create_private_disp( env );
+					} );
+
+				ensure_not_allowed( "add_dispatcher_if_not_exists", [&env] {
+						env.add_dispatcher_if_not_exists( "another", [] {
+								return so_5::disp::one_thread::create_disp();
+							} );
+					} );
+
+				ensure_not_allowed( "binder to named dispatcher", [&env] {
+						env.introduce_coop(
+							so_5::disp::one_thread::create_disp_binder( "another" ),
+							[]( so_5::coop_t & coop ) {
+								coop.define_agent();
+							} );
+					} );
+
+				env.stop();
+			},
+			[&]( so_5::environment_params_t & params )
+			{
+				params.infrastructure( so_5::env_infrastructure_t::single_threaded );
+			} );
+	}
+
+void
+do_additional_threads_test()
+	{
+		std::shared_ptr< counting_factory_t > env_factory{
+				new counting_factory_t{} };
+
+		so_5::launch(
+			[&]( so_5::environment_t & env )
+			{
+				ensure_not_allowed( "run-time monitoring", [&env] {
+						env.stats_controller().turn_on();
+					},
+					so_5::rc_not_allowed_in_single_threaded_env );
+
+				env.stop();
+			},
+			[&]( so_5::environment_params_t & params )
+			{
+				params.thread_factory( env_factory );
+				params.infrastructure( so_5::env_infrastructure_t::single_threaded );
+			} );
+
+		if( 0 != env_factory->started() )
+			throw std::runtime_error( "no threads expected, started: " +
+					std::to_string( env_factory->started() ) );
+
+		ensure_not_allowed( "timer_thread factory", [] {
+				so_5::launch(
+					[]( so_5::environment_t & env ) { env.stop(); },
+					[]( so_5::environment_params_t & params )
+					{
+						params.timer_thread( so_5::timer_list_factory() );
+						params.infrastructure(
+								so_5::env_infrastructure_t::single_threaded );
+					} );
+			},
+			so_5::rc_not_allowed_in_single_threaded_env );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				do_ping_pong_test();
+			},
+			20,
+			"ping-pong in single-threaded environment" );
+
+		run_with_time_limit(
+			[]()
+			{
+				do_stop_from_another_thread_test();
+			},
+			20,
+			"stop single-threaded environment from another thread" );
+
+		run_with_time_limit(
+			[]()
+			{
+				do_non_default_disp_test();
+			},
+			20,
+			"non-default dispatchers in single-threaded environment" );
+
+		run_with_time_limit(
+			[]()
+			{
+				do_additional_threads_test();
+			},
+			20,
+			"additional threads in single-threaded environment" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+
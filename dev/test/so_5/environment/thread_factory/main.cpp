@@ -0,0 +1,162 @@
+/*
+ * A test for usage of thread factories by the SObjectizer Environment
+ * and by dispatchers.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <atomic>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+class counting_factory_t : public so_5::thread_factory_t
+	{
+	public :
+		counting_factory_t( so_5::thread_params_t params )
+			:	m_actual( so_5::create_std_thread_factory( std::move(params) ) )
+			{}
+
+		virtual so_5::thread_handle_unique_ptr_t
+		start( so_5::thread_body_t body ) override
+			{
+				++m_started;
+				return m_actual->start( std::move(body) );
+			}
+
+		std::size_t
+		started() const
+			{
+				return m_started.load();
+			}
+
+	private :
+		so_5::thread_factory_shptr_t m_actual;
+		std::atomic< std::size_t > m_started = { 0 };
+	};
+
+class a_worker_t : public so_5::agent_t
+	{
+	public :
+		struct msg_done : public so_5::signal_t {};
+
+		a_worker_t( context_t ctx, so_5::mbox_t manager )
+			:	so_5::agent_t( ctx )
+			,	m_manager( std::move(manager) )
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_done >( m_manager );
+			}
+
+	private :
+		const so_5::mbox_t m_manager;
+	};
+
+class a_manager_t : public so_5::agent_t
+	{
+	public :
+		a_manager_t(
+			context_t ctx,
+			std::shared_ptr< counting_factory_t > disp_factory )
+			:	so_5::agent_t( ctx )
+			,	m_disp_factory( std::move(disp_factory) )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state().event< a_worker_t::msg_done >(
+						[this] {
+							if( ++m_done == workers )
+								so_deregister_agent_coop_normally();
+						} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				using namespace so_5::disp::thread_pool;
+
+				auto disp = create_private_disp(
+						so_environment(),
+						disp_params_t{}
+							.thread_count( pool_size )
+							.thread_factory( m_disp_factory ),
+						"workers" );
+
+				so_5::introduce_child_coop( *this,
+						disp->binder( bind_params_t{}.fifo( fifo_t::individual ) ),
+						[this]( so_5::coop_t & coop ) {
+							for( std::size_t i = 0; i != workers; ++i )
+								coop.make_agent< a_worker_t >( so_direct_mbox() );
+						} );
+			}
+
+	private :
+		static const std::size_t pool_size = 3;
+		static const std::size_t workers = 10;
+
+		const std::shared_ptr< counting_factory_t > m_disp_factory;
+
+		std::size_t m_done = { 0 };
+	};
+
+int
+main()
+{
+	try
+	{
+		std::shared_ptr< counting_factory_t > env_factory{
+				new counting_factory_t{
+						so_5::thread_params_t{}
+							.name( "env" )
+							.stack_size( 128 * 1024 ) } };
+
+		std::shared_ptr< counting_factory_t > disp_factory{
+				new counting_factory_t{
+						so_5::thread_params_t{}
+							.name( "workers-" )
+							.cpu_affinity( { 0 }, so_5::affinity_mode_t::round_robin ) } };
+
+		run_with_time_limit(
+			[&]()
+			{
+				so_5::launch(
+					[&]( so_5::environment_t & env )
+					{
+						env.introduce_coop( [&]( so_5::coop_t & coop ) {
+								coop.make_agent< a_manager_t >( disp_factory );
+							} );
+					},
+					[&]( so_5::environment_params_t & params )
+					{
+						params.thread_factory( env_factory );
+					} );
+			},
+			20,
+			"thread factory test" );
+
+		// The default dispatcher, the final deregistration thread and
+		// the timer thread at least.
+		if( env_factory->started() < 3 )
+			throw std::runtime_error( "env_factory is not used, started: " +
+					std::to_string( env_factory->started() ) );
+
+		if( 3 != disp_factory->started() )
+			throw std::runtime_error( "unexpected disp_factory usage, started: " +
+					std::to_string( disp_factory->started() ) );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
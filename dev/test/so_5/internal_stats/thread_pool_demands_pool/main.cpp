@@ -0,0 +1,110 @@
+/*
+ * A test for run-time monitoring of demands freelist of
+ * thread_pool dispatcher.
+ */
+
+#include <iostream>
+#include <map>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <thread>
+#include <chrono>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+class a_test_t : public so_5::agent_t
+	{
+	public :
+		struct msg_ping : so_5::signal_t {};
+
+		a_test_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event< msg_ping >( &a_test_t::evt_ping )
+					.event(
+						so_environment().stats_controller().mbox(),
+						&a_test_t::evt_monitor_quantity );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_ping >( *this );
+			}
+
+	private :
+		unsigned int m_pings = { 0 };
+
+		void
+		evt_ping()
+			{
+				// Every new demand must reuse node of the previous one.
+				if( ++m_pings < 1000 )
+					so_5::send< msg_ping >( *this );
+				else
+					so_environment().stats_controller().turn_on();
+			}
+
+		void
+		evt_monitor_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				namespace stats = so_5::stats;
+
+				if( stats::suffixes::demands_pool_hits() == evt.m_suffix ||
+						stats::suffixes::demands_pool_misses() == evt.m_suffix )
+					std::cout << evt.m_prefix.c_str()
+							<< evt.m_suffix.c_str()
+							<< ": " << evt.m_value << std::endl;
+
+				if( stats::suffixes::demands_pool_hits() == evt.m_suffix &&
+						std::string( evt.m_prefix.c_str() ).find( "/tp/test" ) !=
+								std::string::npos &&
+						evt.m_value >= m_pings - 1 )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+init( so_5::environment_t & env )
+	{
+		using namespace so_5::disp::thread_pool;
+
+		auto disp = create_private_disp(
+				env, disp_params_t{}.thread_count( 2 ), "test" );
+		env.introduce_coop(
+			disp->binder( bind_params_t{}.fifo( fifo_t::individual ) ),
+			[]( so_5::coop_t & coop ) {
+				coop.make_agent< a_test_t >();
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"thread_pool demands freelist monitoring test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -15,4 +15,9 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/hanging_subscriptions/prj.ut.rb" )
 	required_prj( "#{path}/delivery_filters/build_tests.rb" )
 	required_prj( "#{path}/local_mbox_growth/prj.ut.rb" )
+	required_prj( "#{path}/send_batch/prj.ut.rb" )
+	required_prj( "#{path}/fanout_delivery/prj.ut.rb" )
+	required_prj( "#{path}/cow_subscribers/prj.ut.rb" )
+	required_prj( "#{path}/perfect_hash_subscr_storage/prj.ut.rb" )
+	required_prj( "#{path}/retained_msg/prj.ut.rb" )
 }
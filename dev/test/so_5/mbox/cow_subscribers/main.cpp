@@ -0,0 +1,356 @@
+/*
+ * A test for local mboxes with copy-on-write snapshots of subscribers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <sstream>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_data : public so_5::message_t
+	{
+		const unsigned int m_value;
+
+		msg_data( unsigned int value ) : m_value( value ) {}
+	};
+
+struct msg_sender_done : public so_5::signal_t {};
+
+struct msg_churn : public so_5::signal_t {};
+
+struct msg_stop_churn : public so_5::signal_t {};
+
+struct msg_get_sum : public so_5::signal_t {};
+
+const unsigned int senders_count = 4;
+const unsigned int messages_count = 20000;
+
+void
+tune_params( so_5::environment_params_t & params )
+	{
+		params.local_mbox_subscribers(
+				so_5::local_mbox_subscribers_t::copy_on_write );
+	}
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t(
+			context_t ctx,
+			so_5::mbox_t data_mbox,
+			so_5::mbox_t receiver )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			,	m_receiver{ std::move(receiver) }
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( unsigned int i = 0; i != messages_count; ++i )
+					so_5::send< msg_data >( m_data_mbox, i );
+
+				so_5::send< msg_sender_done >( m_receiver );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+		const so_5::mbox_t m_receiver;
+	};
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t(
+			context_t ctx,
+			so_5::mbox_t data_mbox,
+			so_5::mbox_t churner )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			,	m_churner{ std::move(churner) }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe( m_data_mbox ).event( [this]( const msg_data & ) {
+						++m_received;
+					} );
+
+				so_subscribe_self().event< msg_sender_done >(
+						&a_receiver_t::on_sender_done );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+		const so_5::mbox_t m_churner;
+
+		unsigned int m_received = 0;
+		unsigned int m_senders_done = 0;
+
+		void
+		on_sender_done()
+			{
+				// All messages of that sender are already handled.
+				if( ++m_senders_done != senders_count )
+					return;
+
+				const auto expected = senders_count * messages_count;
+				if( expected != m_received )
+					{
+						ostringstream ss;
+						ss << "unexpected count of messages: " << m_received
+								<< ", expected: " << expected;
+						throw runtime_error( ss.str() );
+					}
+
+				// Cooperation will be deregistered by churner.
+				so_5::send< msg_stop_churn >( m_churner );
+			}
+	};
+
+// An agent which is subscribed only while its cooperation exists.
+class a_transient_t final : public so_5::agent_t
+	{
+	public :
+		a_transient_t( context_t ctx, so_5::mbox_t data_mbox )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe( m_data_mbox ).event( []( const msg_data & ) {} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_deregister_agent_coop_normally();
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+	};
+
+// An agent which changes the list of subscribers of data mbox all the time.
+class a_churner_t final : public so_5::agent_t
+	{
+	public :
+		a_churner_t( context_t ctx, so_5::mbox_t data_mbox )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_subscribe_self()
+					.event< msg_churn >( &a_churner_t::on_churn )
+					.event< msg_stop_churn >( [this] {
+							m_stopped = true;
+							so_deregister_agent_coop_normally();
+						} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_churn >( *this );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+
+		bool m_stopped = false;
+		bool m_subscribed = false;
+
+		void
+		on_churn()
+			{
+				if( m_stopped )
+					return;
+
+				if( m_subscribed )
+					so_drop_subscription< msg_data >( m_data_mbox );
+				else
+					so_subscribe( m_data_mbox ).event( []( const msg_data & ) {} );
+				m_subscribed = !m_subscribed;
+
+				introduce_child_coop( *this, [this]( so_5::coop_t & coop ) {
+						coop.make_agent< a_transient_t >( m_data_mbox );
+					} );
+
+				so_5::send< msg_churn >( *this );
+			}
+	};
+
+void
+do_subscribe_while_sending_test()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					[&]( so_5::coop_t & coop ) {
+						auto data_mbox = env.create_mbox();
+
+						auto churner = coop.make_agent< a_churner_t >( data_mbox );
+						auto receiver = coop.make_agent< a_receiver_t >(
+								data_mbox, churner->so_direct_mbox() );
+
+						for( unsigned int i = 0; i != senders_count; ++i )
+							coop.make_agent< a_sender_t >(
+									data_mbox, receiver->so_direct_mbox() );
+					} );
+			},
+			&tune_params );
+	}
+
+class a_summator_t final : public so_5::agent_t
+	{
+	public :
+		a_summator_t( context_t ctx, so_5::mbox_t data_mbox )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_set_delivery_filter( m_data_mbox, []( const msg_data & msg ) {
+						return 0 == msg.m_value % 2;
+					} );
+
+				so_subscribe( m_data_mbox )
+					.event( [this]( const msg_data & msg ) {
+							m_sum += msg.m_value;
+						} )
+					.event< msg_get_sum >( [this] { return m_sum; } );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+
+		unsigned int m_sum = 0;
+	};
+
+void
+do_filter_and_service_request_test()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					[&]( so_5::coop_t & coop ) {
+						auto data_mbox = env.create_mbox( "data" );
+
+						coop.make_agent< a_summator_t >( data_mbox );
+
+						coop.define_agent().on_start( [&env, data_mbox] {
+								for( unsigned int i = 0; i != 10; ++i )
+									so_5::send< msg_data >( data_mbox, i );
+
+								const auto sum = so_5::request_value<
+												unsigned int, msg_get_sum >(
+										data_mbox, so_5::infinite_wait );
+								if( 0 + 2 + 4 + 6 + 8 != sum )
+									throw runtime_error(
+											"unexpected sum: " + to_string( sum ) );
+
+								env.stop();
+							} );
+					} );
+			},
+			&tune_params );
+	}
+
+struct msg_subscribed : public so_5::signal_t {};
+
+// An agent which makes a subscription to the data mbox from
+// the delivery filter, i.e. during the delivery of a message from
+// that mbox on the same thread.
+class a_self_modifier_t final : public so_5::agent_t
+	{
+	public :
+		a_self_modifier_t( context_t ctx )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ so_environment().create_mbox() }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_set_delivery_filter( m_data_mbox, [this]( const msg_data & ) {
+						if( !m_subscribed )
+							{
+								m_subscribed = true;
+								so_subscribe( m_data_mbox ).event< msg_subscribed >(
+										[this] { so_deregister_agent_coop_normally(); } );
+							}
+						return true;
+					} );
+
+				so_subscribe( m_data_mbox ).event( [this]( const msg_data & ) {
+						so_5::send< msg_subscribed >( m_data_mbox );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_data >( m_data_mbox, 0u );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+
+		bool m_subscribed = false;
+	};
+
+void
+do_modify_during_delivery_test()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				env.introduce_coop( []( so_5::coop_t & coop ) {
+						coop.make_agent< a_self_modifier_t >();
+					} );
+			},
+			&tune_params );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				do_subscribe_while_sending_test();
+			},
+			60,
+			"subscribe and unsubscribe while sending" );
+
+		run_with_time_limit( [] {
+				do_filter_and_service_request_test();
+			},
+			20,
+			"delivery filter and service request" );
+
+		run_with_time_limit( [] {
+				do_modify_during_delivery_test();
+			},
+			20,
+			"modification of subscribers during delivery" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
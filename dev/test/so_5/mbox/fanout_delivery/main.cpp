@@ -0,0 +1,196 @@
+/*
+ * A test for delivery of one message to many subscribers of local mbox.
+ */
+
+#include <so_5/all.hpp>
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+// Count of live message instances.
+std::atomic< std::size_t > g_live_messages{ 0 };
+
+struct msg_seq : public so_5::message_t
+	{
+		const std::size_t m_seq;
+
+		msg_seq( std::size_t seq ) : m_seq( seq ) { ++g_live_messages; }
+		~msg_seq() { --g_live_messages; }
+	};
+
+struct msg_done : public so_5::signal_t {};
+
+const std::size_t subscribers_count = 200;
+const std::size_t messages_count = 1000;
+
+class a_subscriber_t final : public so_5::agent_t
+	{
+	public :
+		a_subscriber_t(
+			context_t ctx,
+			std::size_t index,
+			so_5::mbox_t data_mbox,
+			so_5::mbox_t done_mbox )
+			:	so_5::agent_t{ 0 == index % 3 ?
+					ctx + limit_then_abort< msg_seq >( messages_count ) :
+					ctx }
+			,	m_with_filter{ 0 == index % 5 }
+			,	m_data_mbox{ std::move(data_mbox) }
+			,	m_done_mbox{ std::move(done_mbox) }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				if( m_with_filter )
+					so_set_delivery_filter( m_data_mbox, []( const msg_seq & msg ) {
+							return 0 == msg.m_seq % 2;
+						} );
+
+				so_subscribe( m_data_mbox ).event( &a_subscriber_t::on_seq );
+			}
+
+	private :
+		const bool m_with_filter;
+		const so_5::mbox_t m_data_mbox;
+		const so_5::mbox_t m_done_mbox;
+
+		std::size_t m_expected = 0;
+
+		void
+		on_seq( const msg_seq & msg )
+			{
+				if( msg.m_seq != m_expected )
+					{
+						ostringstream ss;
+						ss << "unexpected sequence number: " << msg.m_seq
+								<< ", expected: " << m_expected;
+						throw runtime_error( ss.str() );
+					}
+
+				m_expected += m_with_filter ? 2 : 1;
+				if( messages_count <= m_expected )
+					so_5::send< msg_done >( m_done_mbox );
+			}
+	};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t( context_t ctx, so_5::mbox_t data_mbox )
+			:	so_5::agent_t{ ctx }
+			,	m_data_mbox{ std::move(data_mbox) }
+			,	m_subscribers{ subscribers_count }
+			{
+				so_subscribe_self().event< msg_done >( [this] {
+						if( !--m_subscribers )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( std::size_t i = 0; i != messages_count; ++i )
+					so_5::send< msg_seq >( m_data_mbox, i );
+			}
+
+	private :
+		const so_5::mbox_t m_data_mbox;
+		std::size_t m_subscribers;
+	};
+
+// Type of function which returns a binder for subscriber with index.
+using binder_maker_t = std::function<
+		so_5::disp_binder_unique_ptr_t( std::size_t ) >;
+
+template< typename DISP_MAKER >
+void
+run_case( const char * case_name, DISP_MAKER && disp_maker )
+	{
+		cout << "--- " << case_name << " ---" << endl;
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto data_mbox = env.create_mbox();
+						binder_maker_t binder_maker = disp_maker( env );
+
+						// Sender must be started after all subscribers.
+						auto sender_disp = so_5::disp::one_thread::create_private_disp( env );
+						auto sender = coop.make_agent_with_binder< a_sender_t >(
+								sender_disp->binder(), data_mbox );
+
+						for( std::size_t i = 0; i != subscribers_count; ++i )
+							coop.make_agent_with_binder< a_subscriber_t >(
+									binder_maker( i ),
+									i,
+									data_mbox,
+									sender->so_direct_mbox() );
+					} );
+			} );
+
+		if( g_live_messages.load() )
+			throw runtime_error( "message instances are not destroyed: " +
+					to_string( g_live_messages.load() ) );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				run_case( "one_thread", []( so_5::environment_t & env ) {
+						auto disp = so_5::disp::one_thread::create_private_disp( env );
+						return [disp]( std::size_t ) { return disp->binder(); };
+					} );
+
+				run_case( "thread_pool(cooperation fifo)",
+					[]( so_5::environment_t & env ) {
+						using namespace so_5::disp::thread_pool;
+						auto disp = create_private_disp( env, 3 );
+						return [disp]( std::size_t ) {
+							return disp->binder(
+									bind_params_t{}.fifo( fifo_t::cooperation ) );
+						};
+					} );
+
+				run_case( "mixed", []( so_5::environment_t & env ) {
+						namespace tp = so_5::disp::thread_pool;
+						namespace atp = so_5::disp::adv_thread_pool;
+
+						auto ao_disp = so_5::disp::active_obj::create_private_disp( env );
+						auto tp_disp = tp::create_private_disp( env, 2 );
+						auto atp_disp = atp::create_private_disp( env, 2 );
+
+						return [=]( std::size_t i ) -> so_5::disp_binder_unique_ptr_t {
+							switch( i % 4 )
+								{
+								case 0 : return ao_disp->binder();
+								case 1 : return tp_disp->binder(
+										tp::bind_params_t{}.fifo( tp::fifo_t::individual ) );
+								case 2 : return atp_disp->binder(
+										atp::bind_params_t{}.fifo( atp::fifo_t::individual ) );
+								default : return so_5::create_default_disp_binder();
+								}
+						};
+					} );
+			},
+			120,
+			"fan-out delivery test" );
+
+		return 0;
+	}
+	catch( const std::exception & x )
+	{
+		std::cerr << "*** Exception caught: " << x.what() << std::endl;
+	}
+
+	return 2;
+}
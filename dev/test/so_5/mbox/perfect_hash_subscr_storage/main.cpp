@@ -0,0 +1,179 @@
+/*
+ * A test for subscription storage with frozen perfect hash table.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_data : public so_5::message_t {};
+
+struct msg_signal : public so_5::signal_t {};
+
+struct msg_switch : public so_5::signal_t {};
+
+struct msg_check : public so_5::signal_t {};
+
+struct msg_finish : public so_5::signal_t {};
+
+const std::size_t mbox_count = 100;
+
+class a_test_t final : public so_5::agent_t
+	{
+		const state_t st_one{ this, "one" };
+		const state_t st_two{ this, "two" };
+
+	public :
+		a_test_t(
+			context_t ctx,
+			so_5::subscription_storage_factory_t factory )
+			:	so_5::agent_t{ ctx + factory }
+			,	m_counters( mbox_count, 0u )
+			{
+				for( std::size_t i = 0; i != mbox_count; ++i )
+					m_mboxes.push_back( so_environment().create_mbox() );
+			}
+
+		virtual void
+		so_define_agent() override
+			{
+				this >>= st_one;
+
+				for( std::size_t i = 0; i != mbox_count; ++i )
+					{
+						st_one.event( m_mboxes[ i ], [this, i]( const msg_data & ) {
+								m_counters[ i ] += 1;
+							} );
+						st_two.event( m_mboxes[ i ], [this, i]( const msg_data & ) {
+								m_counters[ i ] += 100;
+							} );
+					}
+
+				st_one.event< msg_switch >( &a_test_t::evt_switch );
+				st_two
+					.event< msg_check >( &a_test_t::evt_check )
+					.event< msg_finish >( &a_test_t::evt_finish );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				send_data_to_all();
+				so_5::send< msg_switch >( *this );
+			}
+
+	private :
+		vector< so_5::mbox_t > m_mboxes;
+		vector< unsigned int > m_counters;
+
+		unsigned int m_signals = 0;
+
+		void
+		send_data_to_all()
+			{
+				for( auto & m : m_mboxes )
+					so_5::send< msg_data >( m );
+			}
+
+		void
+		ensure_counters( unsigned int expected, std::size_t from )
+			{
+				for( std::size_t i = from; i != mbox_count; ++i )
+					if( expected != m_counters[ i ] )
+						{
+							ostringstream ss;
+							ss << "unexpected value of counter #" << i << ": "
+									<< m_counters[ i ] << ", expected: " << expected;
+							throw runtime_error( ss.str() );
+						}
+			}
+
+		void
+		evt_switch()
+			{
+				this >>= st_two;
+
+				send_data_to_all();
+				so_5::send< msg_check >( *this );
+			}
+
+		void
+		evt_check()
+			{
+				ensure_counters( 101, 0 );
+
+				// Subscriptions are changed after the start.
+				so_subscribe( m_mboxes[ 0 ] ).in( st_two )
+						.event< msg_signal >( [this] { ++m_signals; } );
+				so_drop_subscription< msg_data >( m_mboxes[ 1 ], st_two );
+
+				send_data_to_all();
+				so_5::send< msg_signal >( m_mboxes[ 0 ] );
+				so_5::send< msg_finish >( *this );
+			}
+
+		void
+		evt_finish()
+			{
+				if( 201 != m_counters[ 0 ] || 101 != m_counters[ 1 ] )
+					throw runtime_error( "unexpected value of counters #0 and #1" );
+				ensure_counters( 201, 2 );
+
+				if( 1 != m_signals )
+					throw runtime_error( "msg_signal is not received" );
+
+				so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+do_test( so_5::subscription_storage_factory_t factory )
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >( factory );
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		using factory_info_t =
+				pair< string, so_5::subscription_storage_factory_t >;
+
+		const factory_info_t factories[] = {
+			{ "default",
+				so_5::perfect_hash_based_subscription_storage_factory() }
+		,	{ "vector",
+				so_5::perfect_hash_based_subscription_storage_factory(
+						so_5::vector_based_subscription_storage_factory( 16 ) ) }
+		,	{ "hash_table",
+				so_5::perfect_hash_based_subscription_storage_factory(
+						so_5::hash_table_based_subscription_storage_factory() ) }
+		};
+
+		for( const auto & f : factories )
+			run_with_time_limit( [&f] {
+					do_test( f.second );
+				},
+				20,
+				"perfect hash storage with " + f.first + " mutable storage" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
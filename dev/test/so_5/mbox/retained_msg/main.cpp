@@ -0,0 +1,181 @@
+/*
+ * A test for retained message mbox.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+struct msg_value : public so_5::message_t
+{
+	int m_value;
+
+	msg_value( int value ) : m_value( value ) {}
+};
+
+struct msg_signal : public so_5::signal_t {};
+
+struct msg_done : public so_5::signal_t {};
+
+void
+ensure( bool condition, const char * what )
+{
+	if( !condition )
+		throw std::runtime_error( what );
+}
+
+// This agent subscribes to the retained mbox after the creation
+// of the mbox and the sending of messages to it.
+// The subscription is made in so_evt_start().
+class a_late_t : public so_5::agent_t
+{
+public :
+	a_late_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t( ctx )
+		,	m_mbox( std::move( mbox ) )
+	{}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_subscribe( m_mbox ).event( &a_late_t::evt_value );
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+
+	int m_received = 0;
+
+	void
+	evt_value( const msg_value & msg )
+	{
+		++m_received;
+		if( 1 == m_received )
+		{
+			ensure( 2 == msg.m_value, "a_late: retained value 2 expected" );
+			so_5::send< msg_value >( m_mbox, 3 );
+		}
+		else
+		{
+			ensure( 3 == msg.m_value, "a_late: new value 3 expected" );
+			so_5::send< msg_done >( m_mbox );
+		}
+	}
+};
+
+// This agent subscribes to the retained mbox in so_define_agent().
+// Retained messages must be handled after so_evt_start().
+class a_first_t : public so_5::agent_t
+{
+public :
+	a_first_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t( ctx )
+		,	m_mbox( std::move( mbox ) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( m_mbox )
+			.event( &a_first_t::evt_value )
+			.event< msg_signal >( &a_first_t::evt_signal )
+			.event< msg_done >( &a_first_t::evt_done );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		m_started = true;
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+
+	bool m_started = false;
+	int m_values_received = 0;
+	int m_signals_received = 0;
+
+	void
+	evt_value( const msg_value & msg )
+	{
+		ensure( m_started, "a_first: retained message before so_evt_start" );
+
+		++m_values_received;
+		if( 1 == m_values_received )
+		{
+			ensure( 2 == msg.m_value, "a_first: retained value 2 expected" );
+			try_start_late_agent();
+		}
+		else
+			ensure( 3 == msg.m_value, "a_first: new value 3 expected" );
+	}
+
+	void
+	evt_signal()
+	{
+		ensure( m_started, "a_first: retained signal before so_evt_start" );
+
+		++m_signals_received;
+		try_start_late_agent();
+	}
+
+	void
+	evt_done()
+	{
+		ensure( 2 == m_values_received, "a_first: 2 values expected" );
+		ensure( 1 == m_signals_received, "a_first: 1 signal expected" );
+
+		so_environment().stop();
+	}
+
+	void
+	try_start_late_agent()
+	{
+		if( 1 == m_values_received && 1 == m_signals_received )
+			so_environment().introduce_coop( [this]( so_5::coop_t & coop ) {
+					coop.make_agent< a_late_t >( m_mbox );
+				} );
+	}
+};
+
+void
+init( so_5::environment_t & env )
+{
+	auto mbox = env.create_retained_msg_mbox();
+
+	// There are no subscribers yet.
+	so_5::send< msg_value >( mbox, 1 );
+	so_5::send< msg_signal >( mbox );
+	so_5::send< msg_value >( mbox, 2 );
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			coop.make_agent< a_first_t >( mbox );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"retained message mbox test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
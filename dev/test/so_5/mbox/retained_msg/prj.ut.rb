@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"test/so_5/mbox/retained_msg/prj.ut.rb",
+		"test/so_5/mbox/retained_msg/prj.rb" )
+)
@@ -0,0 +1,252 @@
+/*
+ * A test for delivery of messages by so_5::send_batch.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_seq
+	{
+		std::size_t m_producer;
+		std::size_t m_seq;
+	};
+
+struct msg_start : public so_5::signal_t {};
+struct msg_done : public so_5::signal_t {};
+
+const std::size_t producers_count = 4;
+const std::size_t messages_per_producer = 5000;
+
+// Sizes of batches vary from 1 to that value.
+const std::size_t max_batch_size = 150;
+
+class a_consumer_t final : public so_5::agent_t
+	{
+	public :
+		enum class mode_t { plain, with_filter, with_limit };
+
+		a_consumer_t(
+			context_t ctx,
+			mode_t mode,
+			so_5::mbox_t data_mbox,
+			so_5::mbox_t done_mbox )
+			:	so_5::agent_t{ mode_t::with_limit == mode ?
+					ctx + limit_then_abort< msg_seq >(
+							producers_count * messages_per_producer ) :
+					ctx }
+			,	m_mode{ mode }
+			,	m_data_mbox{ std::move(data_mbox) }
+			,	m_done_mbox{ std::move(done_mbox) }
+			,	m_expected( producers_count, 0u )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				if( mode_t::with_filter == m_mode )
+					so_set_delivery_filter( m_data_mbox, []( const msg_seq & msg ) {
+							return 0 == msg.m_seq % 2;
+						} );
+
+				if( m_data_mbox )
+					so_subscribe( m_data_mbox ).event( &a_consumer_t::on_seq );
+				else
+					so_subscribe_self().event( &a_consumer_t::on_seq );
+			}
+
+	private :
+		const mode_t m_mode;
+		const so_5::mbox_t m_data_mbox;
+		const so_5::mbox_t m_done_mbox;
+
+		std::vector< std::size_t > m_expected;
+		std::size_t m_received = 0;
+
+		void
+		on_seq( const msg_seq & msg )
+			{
+				auto & expected = m_expected[ msg.m_producer ];
+				if( msg.m_seq != expected )
+					{
+						ostringstream ss;
+						ss << "producer: " << msg.m_producer
+								<< ", unexpected sequence number: " << msg.m_seq
+								<< ", expected: " << expected;
+						throw runtime_error( ss.str() );
+					}
+
+				const std::size_t step = mode_t::with_filter == m_mode ? 2 : 1;
+				expected += step;
+				++m_received;
+				if( producers_count * messages_per_producer / step == m_received )
+					so_5::send< msg_done >( m_done_mbox );
+			}
+	};
+
+class a_producer_t final : public so_5::agent_t
+	{
+	public :
+		a_producer_t(
+			context_t ctx,
+			std::size_t index,
+			so_5::mbox_t target )
+			:	so_5::agent_t{ ctx }
+			,	m_index{ index }
+			,	m_target{ std::move(target) }
+			{
+				so_subscribe_self().event< msg_start >( &a_producer_t::on_start );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_start >( *this );
+			}
+
+	private :
+		const std::size_t m_index;
+		const so_5::mbox_t m_target;
+
+		void
+		on_start()
+			{
+				std::vector< msg_seq > batch;
+				std::size_t seq = 0;
+				for( std::size_t size = 1; seq != messages_per_producer; ++size )
+					{
+						batch.clear();
+						const auto last = std::min( seq + ( size % max_batch_size + 1 ),
+								messages_per_producer );
+						for( ; seq != last; ++seq )
+							batch.push_back( msg_seq{ m_index, seq } );
+
+						so_5::send_batch< msg_seq >(
+								m_target, batch.begin(), batch.end() );
+					}
+			}
+	};
+
+class a_finisher_t final : public so_5::agent_t
+	{
+	public :
+		a_finisher_t( context_t ctx, std::size_t consumers )
+			:	so_5::agent_t{ ctx }
+			,	m_consumers{ consumers }
+			{
+				so_subscribe_self().event< msg_done >( [this] {
+						if( !--m_consumers )
+							so_deregister_agent_coop_normally();
+					} );
+			}
+
+	private :
+		std::size_t m_consumers;
+	};
+
+template< typename BINDER_MAKER >
+void
+run_case( const char * case_name, BINDER_MAKER && binder_maker )
+	{
+		cout << "--- " << case_name << " ---" << endl;
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						using mode_t = a_consumer_t::mode_t;
+
+						auto finisher = coop.make_agent< a_finisher_t >( 4u );
+						const auto done = finisher->so_direct_mbox();
+
+						// Messages to that agent go through MPSC-mbox.
+						auto direct_consumer =
+								coop.make_agent_with_binder< a_consumer_t >(
+										binder_maker( env ),
+										mode_t::plain, so_5::mbox_t{}, done );
+
+						// Messages to those agents go through MPMC-mbox.
+						auto data_mbox = env.create_mbox();
+						for( auto mode :
+								{ mode_t::plain, mode_t::with_filter, mode_t::with_limit } )
+							coop.make_agent_with_binder< a_consumer_t >(
+									binder_maker( env ), mode, data_mbox, done );
+
+						auto producers_disp =
+								so_5::disp::active_obj::create_private_disp( env );
+						for( std::size_t i = 0; i != producers_count; ++i )
+							{
+								coop.make_agent_with_binder< a_producer_t >(
+										producers_disp->binder(),
+										i,
+										direct_consumer->so_direct_mbox() );
+								coop.make_agent_with_binder< a_producer_t >(
+										producers_disp->binder(),
+										i,
+										data_mbox );
+							}
+					} );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				namespace queue_traits = so_5::disp::mpsc_queue_traits;
+
+				run_case( "one_thread", []( so_5::environment_t & env ) {
+						return so_5::disp::one_thread::create_private_disp( env )
+								->binder();
+					} );
+
+				run_case( "one_thread+lock_free", []( so_5::environment_t & env ) {
+						using namespace so_5::disp::one_thread;
+						return create_private_disp( env, std::string(),
+								disp_params_t{}.set_queue_params(
+										queue_traits::queue_params_t{}.lock_free( true ) ) )
+								->binder();
+					} );
+
+				run_case( "thread_pool", []( so_5::environment_t & env ) {
+						using namespace so_5::disp::thread_pool;
+						return create_private_disp( env, 2 )->binder(
+								bind_params_t{}.fifo( fifo_t::individual ) );
+					} );
+
+				run_case( "adv_thread_pool", []( so_5::environment_t & env ) {
+						using namespace so_5::disp::adv_thread_pool;
+						return create_private_disp( env, 2 )->binder(
+								bind_params_t{}.fifo( fifo_t::individual ) );
+					} );
+
+				run_case( "prio_one_thread::strictly_ordered",
+					[]( so_5::environment_t & env ) {
+						using namespace so_5::disp::prio_one_thread::strictly_ordered;
+						return create_private_disp( env )->binder();
+					} );
+
+				run_case( "prio_one_thread::quoted_round_robin",
+					[]( so_5::environment_t & env ) {
+						using namespace so_5::disp::prio_one_thread::quoted_round_robin;
+						return create_private_disp( env, quotes_t{ 10 } )->binder();
+					} );
+			},
+			120,
+			"send_batch test" );
+
+		return 0;
+	}
+	catch( const std::exception & x )
+	{
+		std::cerr << "*** Exception caught: " << x.what() << std::endl;
+	}
+
+	return 2;
+}
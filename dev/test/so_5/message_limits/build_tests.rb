@@ -9,6 +9,8 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/duplicate_limit/prj.ut.rb"
 	required_prj "#{path}/drop/prj.ut.rb"
 	required_prj "#{path}/drop_at_peaks/prj.ut.rb"
+	required_prj "#{path}/rate_limit/prj.ut.rb"
+	required_prj "#{path}/conflate/prj.ut.rb"
 	required_prj "#{path}/abort_app/mc_mbox/prj.ut.rb"
 	required_prj "#{path}/abort_app/sc_mbox/prj.ut.rb"
 
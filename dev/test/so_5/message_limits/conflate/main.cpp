@@ -0,0 +1,172 @@
+/*
+ * A test for conflation of messages.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <map>
+
+#include <so_5/all.hpp>
+
+#include <so_5/disp/adv_thread_pool/h/pub.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+struct quote : public so_5::message_t
+{
+	int m_instrument;
+	int m_price;
+
+	quote( int instrument, int price )
+		:	m_instrument( instrument )
+		,	m_price( price )
+	{}
+};
+
+struct msg_tick : public so_5::signal_t {};
+
+struct msg_check : public so_5::signal_t {};
+
+const int instruments = 3;
+const int quotes_to_send = 1000;
+const int ticks_to_send = 100;
+
+class a_test_t : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t( ctx
+				+ conflate< quote >( []( const quote & q ) {
+						return q.m_instrument;
+					} )
+				+ conflate< msg_tick >()
+				+ limit_then_drop< msg_check >( 1 ) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state()
+			.event( [&]( const quote & q ) {
+				++m_quotes_handled;
+				m_last_prices[ q.m_instrument ] = q.m_price;
+			} )
+			.event< msg_tick >( [&] { ++m_ticks_handled; } )
+			.event< msg_check >( &a_test_t::evt_check );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		// The agent is busy, so all quotes except the last ones
+		// for every instrument must be conflated.
+		for( int i = 0; i != quotes_to_send; ++i )
+			so_5::send< quote >( *this, i % instruments, i );
+
+		for( int i = 0; i != ticks_to_send; ++i )
+			so_5::send< msg_tick >( *this );
+
+		so_5::send< msg_check >( *this );
+	}
+
+private :
+	int m_quotes_handled = 0;
+	int m_ticks_handled = 0;
+	std::map< int, int > m_last_prices;
+
+	int m_checks = 0;
+
+	void
+	evt_check()
+	{
+		++m_checks;
+		if( 1 == m_checks )
+		{
+			ensure( instruments, 1 );
+			// The last sent quote for every instrument is expected.
+			for( int i = quotes_to_send - instruments; i != quotes_to_send; ++i )
+				ensure_price( i % instruments, i );
+
+			// New demands must be created after the handling of
+			// the conflated ones.
+			so_5::send< quote >( *this, 0, -1 );
+			so_5::send< quote >( *this, 0, -2 );
+			so_5::send< msg_tick >( *this );
+			so_5::send< msg_check >( *this );
+		}
+		else
+		{
+			ensure( instruments + 1, 2 );
+			ensure_price( 0, -2 );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+
+	void
+	ensure( int expected_quotes, int expected_ticks ) const
+	{
+		if( expected_quotes != m_quotes_handled )
+			throw std::runtime_error( "unexpected count of handled quotes: " +
+					std::to_string( m_quotes_handled ) + ", expected: " +
+					std::to_string( expected_quotes ) );
+
+		if( expected_ticks != m_ticks_handled )
+			throw std::runtime_error( "unexpected count of handled ticks: " +
+					std::to_string( m_ticks_handled ) + ", expected: " +
+					std::to_string( expected_ticks ) );
+	}
+
+	void
+	ensure_price( int instrument, int expected ) const
+	{
+		auto it = m_last_prices.find( instrument );
+		if( it == m_last_prices.end() || expected != it->second )
+			throw std::runtime_error( "unexpected price for instrument " +
+					std::to_string( instrument ) );
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.introduce_coop( []( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >();
+							} );
+					} );
+			},
+			20,
+			"conflation with the default dispatcher" );
+
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						using namespace so_5::disp::adv_thread_pool;
+						env.introduce_coop(
+							create_private_disp( env, 2 )->binder(
+									bind_params_t{} ),
+							[]( so_5::coop_t & coop ) {
+								coop.make_agent< a_test_t >();
+							} );
+					} );
+			},
+			20,
+			"conflation with adv_thread_pool dispatcher" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
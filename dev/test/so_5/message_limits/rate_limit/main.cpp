@@ -0,0 +1,171 @@
+/*
+ * A test for rate-based message limits.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <chrono>
+#include <limits>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+struct msg_one : public so_5::signal_t {};
+
+struct msg_two : public so_5::message_t
+{
+	int m_value;
+
+	msg_two( int value ) : m_value( value ) {}
+};
+
+struct msg_finish : public so_5::signal_t {};
+
+// Count of messages sent at once.
+// All of them are sent much faster than one second.
+const unsigned int messages_to_send = 20;
+
+const unsigned int burst_one = 5;
+const unsigned int burst_two = 3;
+
+class a_redirect_receiver_t : public so_5::agent_t
+{
+public :
+	a_redirect_receiver_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state()
+			.event( [&]( const msg_two & ) { ++m_received; } )
+			.event< msg_finish >( [&] {
+				if( messages_to_send - burst_two != m_received )
+					throw std::runtime_error( "unexpected count of "
+							"redirected msg_two instances: " +
+							std::to_string( m_received ) );
+
+				so_deregister_agent_coop_normally();
+			} );
+	}
+
+private :
+	unsigned int m_received = 0;
+};
+
+class a_test_t : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, so_5::mbox_t redirect_to )
+		:	so_5::agent_t( ctx
+				+ limit_rate_then_drop< msg_one >( 1, burst_one )
+				+ limit_rate_then_redirect< msg_two >( 1, burst_two,
+					[this] { return m_redirect_to; } )
+				+ limit_then_drop< msg_finish >( 1 ) )
+		,	m_redirect_to( std::move( redirect_to ) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_default_state()
+			.event< msg_one >( [&]{ ++m_received_one; } )
+			.event( [&]( const msg_two & ) { ++m_received_two; } )
+			.event< msg_finish >( [&]{
+				if( burst_one != m_received_one )
+					throw std::runtime_error( "unexpected count of "
+							"received msg_one instances: " +
+							std::to_string( m_received_one ) );
+
+				if( burst_two != m_received_two )
+					throw std::runtime_error( "unexpected count of "
+							"received msg_two instances: " +
+							std::to_string( m_received_two ) );
+
+				so_5::send< msg_finish >( m_redirect_to );
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		for( unsigned int i = 0; i != messages_to_send; ++i )
+		{
+			so_5::send< msg_one >( *this );
+			so_5::send< msg_two >( *this, static_cast< int >( i ) );
+		}
+
+		so_5::send< msg_finish >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_redirect_to;
+
+	unsigned int m_received_one = 0;
+	unsigned int m_received_two = 0;
+};
+
+void
+ensure_invalid_rate( unsigned int per_second, unsigned int burst )
+{
+	try
+	{
+		so_5::agent_t::limit_rate_then_drop< msg_one >( per_second, burst );
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		if( so_5::rc_invalid_rate_limit == ex.error_code() )
+			return;
+		throw;
+	}
+
+	throw std::runtime_error( "an exception expected for rate " +
+			std::to_string( per_second ) + "/" + std::to_string( burst ) );
+}
+
+void
+init( so_5::environment_t & env )
+{
+	env.introduce_coop( []( so_5::coop_t & coop ) {
+			auto receiver = coop.make_agent< a_redirect_receiver_t >();
+			coop.make_agent< a_test_t >( receiver->so_direct_mbox() );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		ensure_invalid_rate( 0, 1 );
+		ensure_invalid_rate( 1, 0 );
+
+		// The interval between messages can't be rounded to zero.
+		const auto ticks_per_second = std::chrono::duration_cast<
+				std::chrono::steady_clock::duration >(
+						std::chrono::seconds( 1 ) ).count();
+		if( ticks_per_second <
+				std::numeric_limits< unsigned int >::max() )
+			ensure_invalid_rate(
+					static_cast< unsigned int >( ticks_per_second ) + 1, 1 );
+
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( &init );
+			},
+			20,
+			"rate-based message limits test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
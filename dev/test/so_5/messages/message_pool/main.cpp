@@ -0,0 +1,272 @@
+/*
+ * A test for message instances allocated from pools.
+ */
+
+#include <so_5/all.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+//! Count of live instances of messages.
+atomic< int > g_live_instances{ 0 };
+
+struct msg_classical : public so_5::message_t
+	{
+		const unsigned int m_value;
+
+		msg_classical( unsigned int value )
+			:	m_value( value )
+			{
+				++g_live_instances;
+			}
+
+		~msg_classical()
+			{
+				--g_live_instances;
+			}
+	};
+
+struct msg_user_type
+	{
+		unsigned int m_value;
+		string m_text;
+
+		msg_user_type( unsigned int value, string text )
+			:	m_value( value ), m_text( move(text) )
+			{
+				++g_live_instances;
+			}
+
+		msg_user_type( const msg_user_type & o )
+			:	m_value( o.m_value ), m_text( o.m_text )
+			{
+				++g_live_instances;
+			}
+
+		msg_user_type( msg_user_type && o )
+			:	m_value( o.m_value ), m_text( move(o.m_text) )
+			{
+				++g_live_instances;
+			}
+
+		~msg_user_type()
+			{
+				--g_live_instances;
+			}
+	};
+
+struct msg_not_pooled : public so_5::message_t
+	{
+		const unsigned int m_value;
+
+		msg_not_pooled( unsigned int value ) : m_value( value ) {}
+	};
+
+namespace so_5 {
+
+template<>
+struct use_message_pool< msg_classical > { enum { value = true }; };
+
+template<>
+struct use_message_pool< msg_user_type > { enum { value = true }; };
+
+} /* namespace so_5 */
+
+struct msg_done : public so_5::signal_t {};
+
+const unsigned int messages_to_send = 10000;
+
+class a_receiver_t final : public so_5::agent_t
+	{
+	public :
+		a_receiver_t( context_t ctx )
+			:	so_5::agent_t{ ctx }
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event( &a_receiver_t::on_classical )
+					.event( &a_receiver_t::on_user_type )
+					.event( &a_receiver_t::on_not_pooled )
+					.event< msg_done >( &a_receiver_t::on_done );
+			}
+
+	private :
+		unsigned int m_classical = 0;
+		unsigned int m_user_type = 0;
+		unsigned int m_delayed = 0;
+
+		void
+		on_classical( const msg_classical & msg )
+			{
+				using pooled_t = so_5::details::pooled_message_t< msg_classical >;
+				if( !dynamic_cast< const pooled_t * >( &msg ) )
+					throw runtime_error( "msg_classical is not allocated from pool" );
+
+				if( messages_to_send == msg.m_value )
+					++m_delayed;
+				else
+					ensure_value( "msg_classical", m_classical++, msg.m_value );
+			}
+
+		void
+		on_user_type( const msg_user_type & msg )
+			{
+				ensure_value( "msg_user_type", m_user_type++, msg.m_value );
+				if( to_string( msg.m_value ) != msg.m_text )
+					throw runtime_error( "unexpected text in msg_user_type" );
+			}
+
+		void
+		on_not_pooled( const msg_not_pooled & msg )
+			{
+				using pooled_t = so_5::details::pooled_message_t< msg_not_pooled >;
+				if( dynamic_cast< const pooled_t * >( &msg ) )
+					throw runtime_error( "msg_not_pooled is allocated from pool" );
+			}
+
+		void
+		on_done()
+			{
+				if( messages_to_send != m_classical ||
+						messages_to_send != m_user_type ||
+						1 != m_delayed )
+					{
+						ostringstream ss;
+						ss << "unexpected count of messages: classical="
+								<< m_classical << ", user_type=" << m_user_type
+								<< ", delayed=" << m_delayed;
+						throw runtime_error( ss.str() );
+					}
+
+				so_deregister_agent_coop_normally();
+			}
+
+		static void
+		ensure_value( const char * what, unsigned int expected, unsigned int actual )
+			{
+				if( expected != actual )
+					{
+						ostringstream ss;
+						ss << what << ": unexpected value " << actual
+								<< ", expected " << expected;
+						throw runtime_error( ss.str() );
+					}
+			}
+	};
+
+class a_sender_t final : public so_5::agent_t
+	{
+	public :
+		a_sender_t( context_t ctx, so_5::mbox_t target )
+			:	so_5::agent_t{ ctx }
+			,	m_target{ move(target) }
+			{}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_not_pooled >( m_target, 0u );
+
+				for( unsigned int i = 0; i != messages_to_send; ++i )
+					{
+						so_5::send< msg_classical >( m_target, i );
+						so_5::send< msg_user_type >( m_target, i, to_string( i ) );
+					}
+
+				so_5::send_delayed< msg_classical >(
+						so_environment(), m_target,
+						chrono::milliseconds( 20 ),
+						messages_to_send );
+				so_5::send_delayed< msg_done >(
+						so_environment(), m_target,
+						chrono::milliseconds( 100 ) );
+			}
+
+	private :
+		const so_5::mbox_t m_target;
+	};
+
+void
+do_test()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				// Sender and receiver work on different threads.
+				env.introduce_coop(
+					so_5::disp::active_obj::create_private_disp( env )->binder(),
+					[]( so_5::coop_t & coop ) {
+						auto receiver = coop.make_agent< a_receiver_t >();
+						coop.make_agent< a_sender_t >( receiver->so_direct_mbox() );
+					} );
+			} );
+
+		if( 0 != g_live_instances )
+			{
+				ostringstream ss;
+				ss << "some message instances are not destroyed: "
+						<< g_live_instances;
+				throw runtime_error( ss.str() );
+			}
+	}
+
+// A message is destroyed after the destruction of the thread local
+// cache of the pool.
+void
+do_thread_exit_test()
+	{
+		struct holder_t
+			{
+				unique_ptr< msg_classical > m_msg;
+			};
+
+		thread t{ [] {
+				// The holder is constructed before the thread local cache
+				// of the pool. So it is destroyed after the cache.
+				static thread_local holder_t holder;
+				holder.m_msg =
+						so_5::details::make_message_instance< msg_classical >( 0u );
+			} };
+		t.join();
+
+		if( 0 != g_live_instances )
+			throw runtime_error( "message instance is not destroyed "
+					"on thread exit" );
+	}
+
+int
+main()
+	{
+		try
+			{
+				run_with_time_limit( [] {
+						// Several runs to reuse blocks from the pools.
+						for( int i = 0; i != 3; ++i )
+							do_test();
+					},
+					20,
+					"message pool test" );
+
+				run_with_time_limit( [] {
+						do_thread_exit_test();
+					},
+					20,
+					"message pool thread exit test" );
+			}
+		catch( const exception & ex )
+			{
+				cerr << "Error: " << ex.what() << endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
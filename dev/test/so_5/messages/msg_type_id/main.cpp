@@ -0,0 +1,174 @@
+/*
+ * A test for integer identifiers of message types.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_one : public so_5::message_t {};
+struct msg_two : public so_5::message_t {};
+struct msg_three : public so_5::signal_t {};
+struct msg_four : public so_5::signal_t {};
+
+struct msg_finish : public so_5::signal_t {};
+
+void
+ensure( bool condition, const string & what )
+	{
+		if( !condition )
+			throw runtime_error( what );
+	}
+
+vector< so_5::msg_type_id_t >
+query_ids()
+	{
+		return vector< so_5::msg_type_id_t >{
+				so_5::query_msg_type_id( typeid(msg_one) ),
+				so_5::query_msg_type_id( typeid(msg_two) ),
+				so_5::query_msg_type_id( typeid(msg_three) ),
+				so_5::query_msg_type_id( typeid(msg_four) ),
+				so_5::query_msg_type_id( typeid(int) ),
+				so_5::query_msg_type_id( typeid(string) )
+			};
+	}
+
+void
+do_registry_test()
+	{
+		const unsigned int threads_count = 4;
+
+		vector< vector< so_5::msg_type_id_t > > results( threads_count );
+		vector< thread > threads;
+		for( unsigned int i = 0; i != threads_count; ++i )
+			threads.emplace_back( [i, &results] { results[ i ] = query_ids(); } );
+		for( auto & t : threads )
+			t.join();
+
+		const auto & first = results.front();
+		for( const auto & r : results )
+			ensure( first == r, "different ids from different threads" );
+
+		ensure( first == query_ids(), "ids are changed" );
+
+		const set< so_5::msg_type_id_t > unique( first.begin(), first.end() );
+		ensure( first.size() == unique.size(), "ids are not unique" );
+		ensure( 0 == unique.count( so_5::null_msg_type_id() ),
+				"null_msg_type_id is assigned" );
+	}
+
+class a_test_t final : public so_5::agent_t
+	{
+		state_t st_parent{ this, "parent" };
+		const state_t st_child{ initial_substate_of{ st_parent }, "child" };
+
+	public :
+		a_test_t(
+			context_t ctx,
+			so_5::subscription_storage_factory_t factory,
+			string & trace )
+			:	so_5::agent_t{ ctx + factory
+					+ limit_then_drop< msg_one >( 10 )
+					+ limit_then_drop< msg_two >( 10 )
+					+ limit_then_drop< msg_three >( 10 )
+					+ limit_then_drop< msg_four >( 10 )
+					+ limit_then_drop< msg_finish >( 1 ) }
+			,	m_trace( trace )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				this >>= st_child;
+
+				st_parent
+					.event( [this]( const msg_one & ) { m_trace += "p1;"; } )
+					.event< msg_three >( [this] { m_trace += "p3;"; } )
+					.event< msg_finish >( [this] {
+							so_deregister_agent_coop_normally();
+						} );
+
+				st_child
+					.event( [this]( const msg_one & ) { m_trace += "c1;"; } )
+					.event( [this]( const msg_two & ) { m_trace += "c2;"; } )
+					.event< msg_four >( [this] { m_trace += "c4;"; } );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_one >( *this );
+				so_5::send< msg_two >( *this );
+				so_5::send< msg_three >( *this );
+				so_5::send< msg_four >( *this );
+				so_5::send< msg_finish >( *this );
+			}
+
+	private :
+		string & m_trace;
+	};
+
+void
+do_dispatch_test(
+	const string & name,
+	so_5::subscription_storage_factory_t factory )
+	{
+		string trace;
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >( factory, trace );
+					} );
+			} );
+
+		const string expected = "c1;c2;p3;c4;";
+		ensure( expected == trace,
+				name + ": unexpected trace: " + trace + ", expected: " + expected );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				do_registry_test();
+			},
+			20,
+			"registry of message types" );
+
+		using factory_info_t =
+				pair< string, so_5::subscription_storage_factory_t >;
+
+		const factory_info_t factories[] = {
+			{ "vector", so_5::vector_based_subscription_storage_factory( 4 ) }
+		,	{ "map", so_5::map_based_subscription_storage_factory() }
+		,	{ "hash_table",
+				so_5::hash_table_based_subscription_storage_factory() }
+		,	{ "adaptive", so_5::adaptive_subscription_storage_factory( 2 ) }
+		};
+
+		for( const auto & f : factories )
+			run_with_time_limit( [&f] {
+					do_dispatch_test( f.first, f.second );
+				},
+				20,
+				"dispatch with " + f.first + " subscription storage" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * A test for mutable messages.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+struct big_msg : public so_5::message_t
+{
+	std::vector< int > m_stages;
+
+	// Address of the message seen by the first stage.
+	const void * m_origin = nullptr;
+
+	big_msg( std::size_t capacity )
+	{
+		m_stages.reserve( capacity );
+	}
+};
+
+const int stages_count = 5;
+
+void
+ensure( bool condition, const char * what )
+{
+	if( !condition )
+		throw std::runtime_error( what );
+}
+
+// A stage of the pipeline. It modifies the message and forwards the
+// same message object to the next stage.
+class a_stage_t : public so_5::agent_t
+{
+public :
+	a_stage_t( context_t ctx, int index, so_5::mbox_t next )
+		:	so_5::agent_t( ctx )
+		,	m_index( index )
+		,	m_next( std::move( next ) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_stage_t::evt_msg );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		if( 0 == m_index )
+			so_5::send_mutable< big_msg >( *this, 1024u );
+	}
+
+private :
+	const int m_index;
+	const so_5::mbox_t m_next;
+
+	void
+	evt_msg( mutable_mhood_t< big_msg > cmd )
+	{
+		if( 0 == m_index )
+			cmd->m_origin = cmd.get();
+		else
+			ensure( cmd->m_origin == cmd.get(), "the message was copied" );
+
+		cmd->m_stages.push_back( m_index );
+
+		if( m_next )
+			m_next->deliver_message( cmd.make_reference() );
+		else
+		{
+			ensure( static_cast< std::size_t >( stages_count ) ==
+					cmd->m_stages.size(), "unexpected count of stages" );
+			for( int i = 0; i != stages_count; ++i )
+				ensure( i == cmd->m_stages[ static_cast< std::size_t >( i ) ],
+						"unexpected stage index" );
+
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+pipeline_test()
+{
+	so_5::launch( []( so_5::environment_t & env ) {
+			env.introduce_coop( []( so_5::coop_t & coop ) {
+					so_5::mbox_t next;
+					for( int i = stages_count - 1; i >= 0; --i )
+						next = coop.make_agent< a_stage_t >( i, next )
+								->so_direct_mbox();
+				} );
+		} );
+}
+
+void
+mchain_test()
+{
+	so_5::wrapped_env_t env;
+
+	auto ch = so_5::create_mchain( env );
+	so_5::send_mutable< big_msg >( ch, 16u );
+
+	bool handled = false;
+	so_5::receive( so_5::from( ch ).handle_n( 1 ).empty_timeout( so_5::no_wait ),
+		[&handled]( so_5::mutable_mhood_t< big_msg > cmd ) {
+			cmd->m_stages.push_back( 42 );
+			handled = true;
+		} );
+
+	ensure( handled, "the message from mchain isn't handled" );
+}
+
+void
+mpmc_mbox_test()
+{
+	so_5::wrapped_env_t env;
+
+	try
+	{
+		so_5::send_mutable< big_msg >( env.environment().create_mbox(), 16u );
+	}
+	catch( const so_5::exception_t & ex )
+	{
+		if( so_5::rc_mutable_msg_cannot_be_delivered_via_mpmc_mbox ==
+				ex.error_code() )
+			return;
+		throw;
+	}
+
+	throw std::runtime_error( "an exception expected for MPMC mbox" );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				pipeline_test();
+				mchain_test();
+				mpmc_mbox_test();
+			},
+			20,
+			"mutable messages test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
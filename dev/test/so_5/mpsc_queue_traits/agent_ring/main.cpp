@@ -364,6 +364,12 @@ do_test()
 		factories.push_back( lock_factory_info_t{
 				"simple_lock",
 				so_5::disp::mpsc_queue_traits::simple_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"futex_lock",
+				so_5::disp::mpsc_queue_traits::futex_lock_factory() } );
+		factories.push_back( lock_factory_info_t{
+				"futex_lock(0)",
+				so_5::disp::mpsc_queue_traits::futex_lock_factory( 0 ) } );
 
 		for( const auto & c : cases )
 			for( const auto & f : factories )
@@ -0,0 +1,172 @@
+/*
+ * A test for lock-free demand queue of work_thread-based dispatchers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+namespace queue_traits = so_5::disp::mpsc_queue_traits;
+
+struct msg_seq
+	{
+		std::size_t m_producer;
+		std::size_t m_seq;
+	};
+
+struct msg_start : public so_5::signal_t {};
+
+const std::size_t producers_count = 8;
+const std::size_t messages_per_producer = 10000;
+
+class a_consumer_t final : public so_5::agent_t
+	{
+	public :
+		a_consumer_t( context_t ctx )
+			:	so_5::agent_t{ ctx }
+			,	m_expected( producers_count, 0u )
+			{
+				so_subscribe_self().event( &a_consumer_t::on_seq );
+			}
+
+	private :
+		std::vector< std::size_t > m_expected;
+		std::size_t m_received = 0;
+
+		void
+		on_seq( const msg_seq & msg )
+			{
+				auto & expected = m_expected[ msg.m_producer ];
+				if( msg.m_seq != expected )
+					{
+						ostringstream ss;
+						ss << "producer: " << msg.m_producer
+								<< ", unexpected sequence number: " << msg.m_seq
+								<< ", expected: " << expected;
+						throw runtime_error( ss.str() );
+					}
+
+				++expected;
+				++m_received;
+				if( producers_count * messages_per_producer == m_received )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+class a_producer_t final : public so_5::agent_t
+	{
+	public :
+		a_producer_t(
+			context_t ctx,
+			std::size_t index,
+			so_5::mbox_t consumer )
+			:	so_5::agent_t{ ctx }
+			,	m_index{ index }
+			,	m_consumer{ std::move(consumer) }
+			{
+				so_subscribe_self().event< msg_start >( [this] {
+						for( std::size_t i = 0; i != messages_per_producer; ++i )
+							so_5::send< msg_seq >( m_consumer, m_index, i );
+					} );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				so_5::send< msg_start >( *this );
+			}
+
+	private :
+		const std::size_t m_index;
+		const so_5::mbox_t m_consumer;
+	};
+
+template< typename BINDER_MAKER >
+void
+run_case( BINDER_MAKER && binder_maker )
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						auto consumer = coop.make_agent_with_binder< a_consumer_t >(
+								binder_maker( env ) );
+
+						auto producers_disp =
+								so_5::disp::active_obj::create_private_disp( env );
+						for( std::size_t i = 0; i != producers_count; ++i )
+							coop.make_agent_with_binder< a_producer_t >(
+									producers_disp->binder(),
+									i,
+									consumer->so_direct_mbox() );
+					} );
+			} );
+	}
+
+void
+do_test( const char * factory_name, queue_traits::lock_factory_t factory )
+	{
+		auto queue_params = queue_traits::queue_params_t{}
+				.lock_factory( factory )
+				.lock_free( true );
+
+		cout << "--- one_thread+" << factory_name << " ---" << endl;
+		run_case( [&]( so_5::environment_t & env ) {
+				using namespace so_5::disp::one_thread;
+				return create_private_disp( env, std::string(),
+						disp_params_t{}.set_queue_params( queue_params ) )->binder();
+			} );
+
+		cout << "--- active_obj+" << factory_name << " ---" << endl;
+		run_case( [&]( so_5::environment_t & env ) {
+				using namespace so_5::disp::active_obj;
+				return create_private_disp( env, std::string(),
+						disp_params_t{}.set_queue_params( queue_params ) )->binder();
+			} );
+
+		cout << "--- active_group+" << factory_name << " ---" << endl;
+		run_case( [&]( so_5::environment_t & env ) {
+				using namespace so_5::disp::active_group;
+				return create_private_disp( env, std::string(),
+						disp_params_t{}.set_queue_params( queue_params ) )->binder(
+								"consumer" );
+			} );
+
+		cout << "--- prio::one_per_prio+" << factory_name << " ---" << endl;
+		run_case( [&]( so_5::environment_t & env ) {
+				using namespace so_5::disp::prio_dedicated_threads::one_per_prio;
+				return create_private_disp( env, std::string(),
+						disp_params_t{}.set_queue_params( queue_params ) )->binder();
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit( [] {
+				do_test( "combined_lock",
+						queue_traits::combined_lock_factory() );
+				do_test( "combined_lock(1s)",
+						queue_traits::combined_lock_factory( std::chrono::seconds(1) ) );
+				do_test( "simple_lock",
+						queue_traits::simple_lock_factory() );
+			},
+			120,
+			"lock-free demand queue test" );
+
+		return 0;
+	}
+	catch( const std::exception & x )
+	{
+		std::cerr << "*** Exception caught: " << x.what() << std::endl;
+	}
+
+	return 2;
+}
+
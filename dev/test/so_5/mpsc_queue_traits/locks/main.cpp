@@ -114,6 +114,29 @@ serie_of_pair_tests_with_different_intervals( lock_factory_t factory )
 
 }
 
+void
+wait_with_timeout( lock_factory_t factory )
+{
+	std::cout << "wait with timeout: " << std::flush;
+
+	run_with_time_limit( [factory] {
+			lock_unique_ptr_t lock{ factory() };
+
+			const auto started_at = std::chrono::steady_clock::now();
+			{
+				unique_lock_t guard{ *lock };
+				// There is no one to notify. Only timeout can wake us up.
+				while( std::chrono::steady_clock::now() - started_at <
+						std::chrono::milliseconds( 100 ) )
+					guard.wait_for_notify_for( std::chrono::milliseconds( 100 ) );
+			}
+		},
+		20,
+		"wait_with_timeout" );
+
+	std::cout << "OK" << std::endl;
+}
+
 void
 bunch_of_threads( lock_factory_t factory )
 {
@@ -151,6 +174,8 @@ main()
 		cases.push_back( case_info_t{ "combined_lock(1us)",
 				combined_lock_factory( std::chrono::microseconds(1) ) } );
 		cases.push_back( case_info_t{ "simple_lock", simple_lock_factory() } );
+		cases.push_back( case_info_t{ "futex_lock(default)", futex_lock_factory() } );
+		cases.push_back( case_info_t{ "futex_lock(0)", futex_lock_factory( 0 ) } );
 
 		for( const auto & c : cases )
 		{
@@ -159,6 +184,7 @@ main()
 			single_pair_test_case( c.m_factory );
 			serie_of_pair_tests_with_equal_intervals( c.m_factory );
 			serie_of_pair_tests_with_different_intervals( c.m_factory );
+			wait_with_timeout( c.m_factory );
 			bunch_of_threads( c.m_factory );
 
 			std::cout << "--- DONE ---" << std::endl;
@@ -0,0 +1,159 @@
+/*
+ * A test for searching event handlers in parent states when
+ * handlers for nested states are resolved in advance.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_hello : public so_5::signal_t {};
+struct msg_other : public so_5::signal_t {};
+struct msg_switch : public so_5::signal_t {};
+struct msg_change : public so_5::signal_t {};
+struct msg_finish : public so_5::signal_t {};
+
+// Count of switches before the change of subscriptions.
+// It must be greater than count of entries required for
+// building of the table of handlers.
+const int iterations = 4;
+
+class a_test_t final : public so_5::agent_t
+	{
+		state_t st_parent{ this, "parent" };
+		state_t st_a{ initial_substate_of{ st_parent }, "a" };
+		state_t st_b{ substate_of{ st_parent }, "b" };
+		state_t st_b_child{ initial_substate_of{ st_b }, "b_child" };
+
+	public :
+		a_test_t(
+			context_t ctx,
+			so_5::subscription_storage_factory_t factory,
+			string & trace )
+			:	so_5::agent_t{ ctx + factory }
+			,	m_trace( trace )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				this >>= st_a;
+
+				st_parent
+					.event< msg_hello >( [this] { m_trace += "p;"; } )
+					.event< msg_other >( [this] { m_trace += "o;"; } )
+					.event< msg_switch >( [this] {
+							if( st_a.is_active() )
+								this >>= st_b;
+							else
+								this >>= st_a;
+						} )
+					.event< msg_change >( &a_test_t::evt_change )
+					.event< msg_finish >( [this] {
+							so_deregister_agent_coop_normally();
+						} );
+
+				st_a.event< msg_hello >( [this] { m_trace += "a;"; } );
+
+				st_b_child.suppress< msg_other >();
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				for( int i = 0; i != iterations; ++i )
+					send_round();
+
+				so_5::send< msg_change >( *this );
+				send_round();
+
+				so_5::send< msg_finish >( *this );
+			}
+
+	private :
+		string & m_trace;
+
+		void
+		send_round()
+			{
+				so_5::send< msg_hello >( *this );
+				so_5::send< msg_other >( *this );
+				so_5::send< msg_switch >( *this );
+				so_5::send< msg_hello >( *this );
+				so_5::send< msg_other >( *this );
+				so_5::send< msg_switch >( *this );
+			}
+
+		void
+		evt_change()
+			{
+				m_trace += "|";
+
+				so_drop_subscription< msg_hello >( so_direct_mbox(), st_a );
+				st_b_child.event< msg_hello >( [this] { m_trace += "b;"; } );
+				st_b.event< msg_other >( [this] { m_trace += "x;"; } );
+			}
+	};
+
+void
+do_test(
+	const string & name,
+	so_5::subscription_storage_factory_t factory )
+	{
+		string trace;
+
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				env.introduce_coop( [&]( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >( factory, trace );
+					} );
+			} );
+
+		string expected;
+		for( int i = 0; i != iterations; ++i )
+			expected += "a;o;p;";
+		expected += "|p;o;b;";
+
+		if( expected != trace )
+			throw runtime_error( name + ": unexpected trace: " + trace +
+					", expected: " + expected );
+	}
+
+int
+main()
+{
+	try
+	{
+		using factory_info_t =
+				pair< string, so_5::subscription_storage_factory_t >;
+
+		const factory_info_t factories[] = {
+			{ "vector", so_5::vector_based_subscription_storage_factory( 4 ) }
+		,	{ "map", so_5::map_based_subscription_storage_factory() }
+		,	{ "hash_table",
+				so_5::hash_table_based_subscription_storage_factory() }
+		,	{ "adaptive", so_5::adaptive_subscription_storage_factory( 2 ) }
+		,	{ "perfect_hash",
+				so_5::perfect_hash_based_subscription_storage_factory() }
+		};
+
+		for( const auto & f : factories )
+			run_with_time_limit( [&f] {
+					do_test( f.first, f.second );
+				},
+				20,
+				"resolved handlers with " + f.first + " subscription storage" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
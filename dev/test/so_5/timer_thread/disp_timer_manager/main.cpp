@@ -0,0 +1,235 @@
+/*
+ * A test for timer manager served by one_thread dispatcher.
+ */
+
+#include <so_5/all.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+struct msg_delayed : public so_5::signal_t {};
+
+struct msg_tick : public so_5::signal_t {};
+
+struct msg_from_outside : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+	{
+	public :
+		a_test_t( context_t ctx, so_5::timer_manager_t & timers )
+			:	so_5::agent_t{ ctx }
+			,	m_timers( timers )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event< msg_delayed >( &a_test_t::on_delayed )
+					.event< msg_tick >( &a_test_t::on_tick )
+					.event< msg_from_outside >( &a_test_t::on_from_outside );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				m_thread = this_thread::get_id();
+
+				so_5::send_delayed< msg_delayed >(
+						m_timers, so_direct_mbox(), chrono::milliseconds( 20 ) );
+			}
+
+	private :
+		so_5::timer_manager_t & m_timers;
+
+		thread::id m_thread;
+
+		so_5::timer_id_t m_tick_timer;
+		unsigned int m_ticks = { 0 };
+
+		bool m_from_outside_received = { false };
+
+		void
+		ensure_same_thread()
+			{
+				if( m_thread != this_thread::get_id() )
+					throw runtime_error( "event is handled on unexpected thread" );
+			}
+
+		void
+		on_delayed()
+			{
+				ensure_same_thread();
+
+				m_tick_timer = so_5::send_periodic< msg_tick >(
+						m_timers, so_direct_mbox(),
+						chrono::milliseconds( 10 ),
+						chrono::milliseconds( 10 ) );
+			}
+
+		void
+		on_tick()
+			{
+				ensure_same_thread();
+
+				if( 3 == ++m_ticks )
+					{
+						m_tick_timer.release();
+						try_finish();
+					}
+			}
+
+		void
+		on_from_outside()
+			{
+				ensure_same_thread();
+
+				m_from_outside_received = true;
+				try_finish();
+			}
+
+		void
+		try_finish()
+			{
+				if( 3 <= m_ticks && m_from_outside_received )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+do_test(
+	so_5::timer_manager_factory_t factory,
+	bool lock_free )
+	{
+		so_5::launch( [&]( so_5::environment_t & env ) {
+				using namespace so_5::disp::one_thread;
+
+				auto disp = create_private_disp( env, "timers",
+						disp_params_t{}
+							.tune_queue_params( [lock_free]( queue_traits::queue_params_t & p ) {
+									p.lock_free( lock_free );
+								} )
+							.timer_manager( factory ) );
+
+				so_5::mbox_t target;
+				env.introduce_coop( disp->binder(), [&]( so_5::coop_t & coop ) {
+						target = coop.make_agent< a_test_t >( disp->timer_manager() )
+								->so_direct_mbox();
+					} );
+
+				// This timer is scheduled outside of the working thread
+				// of the dispatcher.
+				this_thread::sleep_for( chrono::milliseconds( 10 ) );
+				so_5::send_delayed< msg_from_outside >(
+						disp->timer_manager(), target, chrono::milliseconds( 50 ) );
+			} );
+	}
+
+void
+check_no_timer_manager()
+	{
+		so_5::launch( []( so_5::environment_t & env ) {
+				auto disp = so_5::disp::one_thread::create_private_disp( env );
+
+				try
+					{
+						disp->timer_manager();
+						throw runtime_error( "an exception expected for "
+								"dispatcher without timer manager" );
+					}
+				catch( const so_5::exception_t & x )
+					{
+						if( so_5::rc_disp_has_no_timer_manager != x.error_code() )
+							throw;
+					}
+
+				env.stop();
+			} );
+	}
+
+void
+check_timer_id_outlives_disp()
+	{
+		so_5::timer_id_t timer;
+
+		so_5::launch( [&timer]( so_5::environment_t & env ) {
+				auto disp = so_5::disp::one_thread::create_private_disp(
+						env, "timers",
+						so_5::disp::one_thread::disp_params_t{}.timer_manager(
+								so_5::timer_heap_manager_factory() ) );
+
+				timer = so_5::send_periodic< msg_tick >(
+						disp->timer_manager(), env.create_mbox(),
+						chrono::hours( 1 ),
+						chrono::hours( 1 ) );
+
+				env.stop();
+			} );
+
+		// The dispatcher and its timer manager are destroyed already.
+		if( !timer.is_active() )
+			throw runtime_error( "timer is expected to be active" );
+		timer.release();
+	}
+
+int
+main()
+	{
+		try
+			{
+				struct case_info_t
+					{
+						string m_name;
+						so_5::timer_manager_factory_t m_factory;
+					};
+
+				const case_info_t cases[] = {
+						{ "timer_wheel", so_5::timer_wheel_manager_factory() },
+						{ "timer_heap", so_5::timer_heap_manager_factory() },
+						{ "timer_list", so_5::timer_list_manager_factory() },
+						{ "timer_hierarchical_wheel",
+								so_5::timer_hierarchical_wheel_manager_factory() }
+					};
+
+				for( const auto & c : cases )
+					for( const bool lock_free : { false, true } )
+						{
+							cout << c.m_name << ", lock_free=" << lock_free
+									<< ": " << flush;
+
+							run_with_time_limit( [&] {
+									do_test( c.m_factory, lock_free );
+								},
+								20,
+								c.m_name );
+
+							cout << "OK" << endl;
+						}
+
+				run_with_time_limit( [] {
+						check_no_timer_manager();
+					},
+					20,
+					"check_no_timer_manager" );
+
+				run_with_time_limit( [] {
+						check_timer_id_outlives_disp();
+					},
+					20,
+					"check_timer_id_outlives_disp" );
+			}
+		catch( const exception & ex )
+			{
+				cerr << "Error: " << ex.what() << endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
@@ -0,0 +1,177 @@
+/*
+ * A test for cascading of timers between wheels of
+ * hierarchical timer_wheel engine.
+ */
+
+#include <so_5/all.hpp>
+
+#include <timertt/all.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+using namespace std;
+
+using manager_t = timertt::timer_hierarchical_wheel_manager_template<
+		timertt::thread_safety::unsafe >;
+
+using clock_type = timertt::monotonic_clock;
+
+struct timer_info_t
+	{
+		clock_type::duration m_pause;
+		clock_type::time_point m_activated_at;
+		bool m_cancel = false;
+		unsigned int m_executions = 0;
+		timertt::timer_object_holder< timertt::thread_safety::unsafe > m_timer;
+	};
+
+void
+do_test()
+	{
+		// Very small granularity is used to force timers to pass
+		// through several wheels in a short time.
+		manager_t manager{ chrono::microseconds( 1 ) };
+
+		const clock_type::duration pauses[] = {
+				chrono::microseconds( 50 ),
+				chrono::microseconds( 300 ),
+				chrono::milliseconds( 5 ),
+				chrono::milliseconds( 20 ),
+				chrono::milliseconds( 150 ),
+				chrono::milliseconds( 400 )
+			};
+
+		vector< timer_info_t > timers;
+		for( const auto & p : pauses )
+			for( const bool cancel : { false, true } )
+				{
+					timer_info_t info;
+					info.m_pause = p;
+					info.m_cancel = cancel;
+					timers.push_back( info );
+				}
+
+		for( auto & t : timers )
+			{
+				t.m_timer = manager.allocate();
+				t.m_activated_at = clock_type::now();
+				manager.activate( t.m_timer, t.m_pause, [&t] {
+						const auto elapsed = clock_type::now() - t.m_activated_at;
+						if( elapsed + chrono::milliseconds( 1 ) < t.m_pause )
+							{
+								ostringstream ss;
+								ss << "timer is executed too early, pause: "
+										<< chrono::duration_cast< chrono::microseconds >(
+												t.m_pause ).count()
+										<< "us, elapsed: "
+										<< chrono::duration_cast< chrono::microseconds >(
+												elapsed ).count()
+										<< "us";
+								throw runtime_error( ss.str() );
+							}
+						++t.m_executions;
+					} );
+			}
+
+		// Timer which pause is longer than the range of all wheels.
+		// It must not be executed during the test.
+		unsigned int very_long_executions = 0;
+		manager.activate( chrono::hours( 3 ),
+				[&very_long_executions] { ++very_long_executions; } );
+
+		for( auto & t : timers )
+			if( t.m_cancel )
+				manager.deactivate( t.m_timer );
+
+		const auto all_executed = [&timers] {
+				for( const auto & t : timers )
+					if( !t.m_cancel && !t.m_executions )
+						return false;
+				return true;
+			};
+
+		// Cancelled timers have a chance to be executed for some time
+		// after the last normal timer.
+		const auto finish_at = clock_type::now() + chrono::milliseconds( 450 );
+		while( clock_type::now() < finish_at || !all_executed() )
+			manager.process_expired_timers();
+
+		for( const auto & t : timers )
+			{
+				const unsigned int expected = t.m_cancel ? 0u : 1u;
+				if( expected != t.m_executions )
+					{
+						ostringstream ss;
+						ss << "unexpected count of executions for timer with pause "
+								<< chrono::duration_cast< chrono::microseconds >(
+										t.m_pause ).count()
+								<< "us, cancel: " << t.m_cancel
+								<< ", expected: " << expected
+								<< ", actual: " << t.m_executions;
+						throw runtime_error( ss.str() );
+					}
+			}
+
+		if( very_long_executions )
+			throw runtime_error( "very long timer is executed" );
+
+		const auto q = manager.get_timer_quantities();
+		if( 1 != q.m_single_shot_count || 0 != q.m_periodic_count )
+			throw runtime_error( "unexpected quantities of timers" );
+	}
+
+void
+do_periodic_test()
+	{
+		manager_t manager{ chrono::microseconds( 1 ) };
+
+		// Period of that timer is longer than the size of the first wheel.
+		unsigned int executions = 0;
+		manager.activate(
+				chrono::milliseconds( 1 ),
+				chrono::milliseconds( 30 ),
+				[&executions] { ++executions; } );
+
+		const auto started_at = clock_type::now();
+		while( executions < 4 )
+			manager.process_expired_timers();
+
+		// Timer must be executed at 1ms, 31ms, 61ms and 91ms.
+		const auto elapsed = clock_type::now() - started_at;
+		if( elapsed < chrono::milliseconds( 90 ) )
+			{
+				ostringstream ss;
+				ss << "periodic timer is executed too often, elapsed: "
+						<< chrono::duration_cast< chrono::milliseconds >(
+								elapsed ).count()
+						<< "ms";
+				throw runtime_error( ss.str() );
+			}
+	}
+
+int
+main()
+	{
+		try
+			{
+				run_with_time_limit( [] {
+						do_test();
+						do_periodic_test();
+					},
+					20,
+					"hierarchical timer_wheel test" );
+			}
+		catch( const exception & ex )
+			{
+				cerr << "Error: " << ex.what() << endl;
+				return 1;
+			}
+
+		return 0;
+	}
+
@@ -2150,6 +2150,665 @@ private :
 	 */
 };
 
+//
+// timer_hierarchical_wheel_engine_defaults
+//
+/*!
+ * \since v.1.1.2
+ * \brief Container for static method with default values for
+ * timer_hierarchical_wheel engine.
+ */
+struct timer_hierarchical_wheel_engine_defaults
+{
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
+};
+
+//
+// timer_hierarchical_wheel_engine
+//
+/*!
+ * \since v.1.1.2
+ * \brief An engine for hierarchical timer wheel mechanism.
+ *
+ * This engine uses several timer wheels of different granularity.
+ * The first (the finest) wheel has 256 slots and each slot is one
+ * time step. Every next wheel has 64 slots and each its slot covers
+ * the whole turn of the previous wheel. There are five wheels and
+ * they cover 2^32 time steps (about 497 days for the default
+ * granularity of 10ms). Timers with longer pauses are placed to the
+ * last slot of the last wheel and are replaced at every turn of it.
+ *
+ * A timer is placed into the finest wheel which can hold its pause.
+ * Activation and deactivation of a timer are O(1) operations: the timer
+ * is added to or removed from a double-linked list of a wheel slot.
+ *
+ * Timers are moved from coarse wheels to finer ones lazily: a slot of
+ * the next wheel is emptied only when the previous wheel completes a
+ * full turn. So there is no need to scan the whole list of timers at
+ * every time step (unlike timer_wheel engine with small wheel and
+ * many long timers).
+ *
+ * This engine is intended for cases where there are a lot of timers
+ * with very different pauses: from several time steps to several days.
+ *
+ * \note Like timer_wheel engine this engine requires that timer thread
+ * works at every time step while there is at least one timer.
+ *
+ * \tparam THREAD_SAFETY Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename THREAD_SAFETY,
+	typename ERROR_LOGGER,
+	typename ACTOR_EXCEPTION_HANDLER >
+class timer_hierarchical_wheel_engine
+	:	public engine_common<
+			THREAD_SAFETY, ERROR_LOGGER, ACTOR_EXCEPTION_HANDLER >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			THREAD_SAFETY, ERROR_LOGGER, ACTOR_EXCEPTION_HANDLER >;
+
+public :
+	//! Type with default parameters for this engine.
+	typedef timer_hierarchical_wheel_engine_defaults defaults_type;
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_engine(
+		//! Size of time step for the timer wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_granularity( granularity )
+		,	m_wheels( first_wheel_size + ( wheels_count - 1 ) * next_wheel_size )
+	{
+		m_current_tick_border = monotonic_clock::now() + m_granularity;
+	}
+
+	//! Destructor.
+	~timer_hierarchical_wheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< THREAD_SAFETY >
+	allocate()
+	{
+		return timer_object_holder< THREAD_SAFETY >( new timer_type() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned only when the first timer is added to
+	 * the empty wheels.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam DURATION_1 actual type which represents time duration.
+	 * \tparam DURATION_2 actual type which represents time duration.
+	 */
+	template< class DURATION_1, class DURATION_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< THREAD_SAFETY > timer,
+		//! Pause for timer execution.
+		DURATION_1 pause,
+		//! Repetition period.
+		//! If <tt>DURATION_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		DURATION_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		// If there is no timers then time steps could be missed
+		// while timer thread was sleeping. Those steps must not be
+		// processed for the new timer.
+		if( empty() )
+			restart_time_steps();
+
+		wheel_timer->m_action = std::move(action);
+
+		// Timer must be taken under control.
+		timer_object< THREAD_SAFETY >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		wheel_timer->m_expiration_tick = m_current_tick +
+				duration_to_ticks( pause );
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		insert_demand_to_wheels( wheel_timer );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+
+		// If wheels were empty and this is the first timer added
+		// the value of timer_count must be exactly 1.
+		return 1 == this->m_timer_quantities.m_single_shot_count +
+				this->m_timer_quantities.m_periodic_count;
+	}
+
+	//! Deactivate timer and remove it from the wheels.
+	void
+	deactivate( timer_object_holder< THREAD_SAFETY > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_slot( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< THREAD_SAFETY >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Build sublist of elapsed timers and process them all.
+	 */
+	template< typename UNIQUE_LOCK >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		UNIQUE_LOCK & lock )
+	{
+		/*
+		 * NOTE: like in timer_wheel engine it is possible that several
+		 * time steps must be processed at once.
+		 */
+		const auto now = monotonic_clock::now();
+		for(;;)
+		{
+			if( !m_current_tick_processed )
+			{
+				cascade_if_necessary();
+
+				process_current_tick( lock );
+
+				m_current_tick += 1;
+				m_current_tick_processed = true;
+			}
+
+			if( now >= m_current_tick_border )
+			{
+				// A switch to next tick is necessary.
+				m_current_tick_border += m_granularity;
+				m_current_tick_processed = false;
+			}
+			else
+				break;
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next timer.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		if( !m_current_tick_processed )
+			return monotonic_clock::now();
+		else
+			return m_current_tick_border;
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & slot : m_wheels )
+		{
+			timer_type * timer = slot.m_head;
+			slot = wheel_slot();
+
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				t->m_status = timer_status::deactivated;
+				timer_object< THREAD_SAFETY >::decrement_references( t );
+			}
+		}
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_current_tick = 0;
+		restart_time_steps();
+	}
+
+private :
+	//! Type for time step counter.
+	using tick_type = std::uint64_t;
+
+	/*!
+	 * \name Geometry of the wheels.
+	 * \{
+	 */
+	//! Count of bits in time step index for the first wheel.
+	static const unsigned int first_wheel_bits = 8;
+	//! Count of bits in time step index for every next wheel.
+	static const unsigned int next_wheel_bits = 6;
+	//! Total count of wheels.
+	static const unsigned int wheels_count = 5;
+
+	//! Size of the first wheel.
+	static const unsigned int first_wheel_size = 1u << first_wheel_bits;
+	//! Size of every next wheel.
+	static const unsigned int next_wheel_size = 1u << next_wheel_bits;
+
+	//! The max pause (in time steps) which can be handled by the wheels.
+	static const tick_type max_pause =
+			( tick_type{1} <<
+				( first_wheel_bits + ( wheels_count - 1 ) * next_wheel_bits ) ) - 1;
+	/*!
+	 * \}
+	 */
+
+	struct wheel_slot;
+
+	//! Type of wheel timer.
+	struct timer_type : public timer_object< THREAD_SAFETY >
+	{
+		//! Status of the timer.
+		typename threading_traits< THREAD_SAFETY >::status_holder_type m_status;
+
+		//! Index of time step at which timer must be executed.
+		tick_type m_expiration_tick = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		tick_type m_period = 0;
+
+		//! Timer action.
+		timer_action m_action;
+
+		//! The slot in which timer is stored.
+		wheel_slot * m_slot = nullptr;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		//! Detect type of the timer (single-shot or periodic).
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's slot.
+	struct wheel_slot
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! Index of the current time step.
+	tick_type m_current_tick = 0;
+
+	//! Right border of the current tick.
+	/*!
+	 * This is the time point at which new tick must be started.
+	 */
+	monotonic_clock::time_point m_current_tick_border;
+
+	//! Has the current tick been processed?
+	bool m_current_tick_processed = false;
+
+	//! Slots of all wheels.
+	/*!
+	 * Slots of the first wheel go first. Then slots of the second wheel
+	 * and so on.
+	 */
+	std::vector< wheel_slot > m_wheels;
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note Rounding is the same as for timer_wheel engine. And 0 is
+	 * never returned.
+	 *
+	 * \tparam DURATION actual type for duration representation.
+	 */
+	template< class DURATION >
+	tick_type
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		DURATION d ) const
+	{
+		auto d_units = 
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		tick_type r = static_cast< tick_type >( (d_units + g_units/2) / g_units );
+		if( !r )
+			r = 1;
+		return r;
+	}
+
+	//! Start counting of time steps from the current time point.
+	void
+	restart_time_steps()
+	{
+		m_current_tick_border = monotonic_clock::now() + m_granularity;
+		m_current_tick_processed = false;
+	}
+
+	/*!
+	 * \brief Find the slot for the timer.
+	 *
+	 * The slot is selected in the finest wheel which can hold
+	 * the rest of the timer's pause.
+	 */
+	wheel_slot &
+	slot_for( tick_type expiration_tick )
+	{
+		tick_type pause = expiration_tick - m_current_tick;
+		if( pause < first_wheel_size )
+			return m_wheels[ static_cast< std::size_t >(
+					expiration_tick & ( first_wheel_size - 1 ) ) ];
+
+		if( pause > max_pause )
+		{
+			// Timer will be placed into the last slot of the last wheel.
+			// It will be replaced during cascading.
+			pause = max_pause;
+			expiration_tick = m_current_tick + pause;
+		}
+
+		unsigned int bits = first_wheel_bits;
+		std::size_t offset = first_wheel_size;
+		while( pause >= ( tick_type{1} << ( bits + next_wheel_bits ) ) )
+		{
+			bits += next_wheel_bits;
+			offset += next_wheel_size;
+		}
+
+		return m_wheels[ offset + static_cast< std::size_t >(
+				( expiration_tick >> bits ) & ( next_wheel_size - 1 ) ) ];
+	}
+
+	/*!
+	 * \brief Insert timer to the appropriate slot.
+	 *
+	 * Timer is added to the end of slot's list.
+	 */
+	void
+	insert_demand_to_wheels( timer_type * wheel_timer )
+	{
+		wheel_slot & slot = slot_for( wheel_timer->m_expiration_tick );
+		wheel_timer->m_slot = &slot;
+
+		wheel_timer->m_next = nullptr;
+		wheel_timer->m_prev = slot.m_tail;
+		if( slot.m_tail )
+			slot.m_tail->m_next = wheel_timer;
+		else
+			slot.m_head = wheel_timer;
+		slot.m_tail = wheel_timer;
+	}
+
+	/*!
+	 * \brief Remove timer from its slot.
+	 */
+	void
+	remove_timer_from_slot( timer_type * wheel_timer )
+	{
+		wheel_slot & slot = *(wheel_timer->m_slot);
+
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			slot.m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			slot.m_tail = wheel_timer->m_prev;
+
+		wheel_timer->m_slot = nullptr;
+	}
+
+	/*!
+	 * \brief Move timers from coarse wheels to finer ones.
+	 *
+	 * The slot of the next wheel is emptied only when the previous
+	 * wheel completes a full turn.
+	 */
+	void
+	cascade_if_necessary()
+	{
+		unsigned int bits = first_wheel_bits;
+		std::size_t offset = first_wheel_size;
+		for( unsigned int w = 1; w != wheels_count; ++w )
+		{
+			// Previous wheel didn't complete its turn yet.
+			if( m_current_tick & ( ( tick_type{1} << bits ) - 1 ) )
+				break;
+
+			const auto index = static_cast< std::size_t >(
+					( m_current_tick >> bits ) & ( next_wheel_size - 1 ) );
+
+			wheel_slot & slot = m_wheels[ offset + index ];
+			timer_type * timer = slot.m_head;
+			slot = wheel_slot();
+
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				insert_demand_to_wheels( t );
+			}
+
+			bits += next_wheel_bits;
+			offset += next_wheel_size;
+		}
+	}
+
+	/*!
+	 * \brief Detect elapsed timers for the current time step and
+	 * process them all.
+	 *
+	 * Object \a lock will be unlocked and then locked back.
+	 */
+	template< class UNIQUE_LOCK >
+	void
+	process_current_tick(
+		UNIQUE_LOCK & lock )
+	{
+		// All timers from the current slot of the first wheel
+		// are elapsed.
+		wheel_slot & slot = m_wheels[ static_cast< std::size_t >(
+				m_current_tick & ( first_wheel_size - 1 ) ) ];
+
+		timer_type * head = slot.m_head;
+		if( head )
+		{
+			slot = wheel_slot();
+
+			for( timer_type * t = head; t; t = t->m_next )
+			{
+				t->m_slot = nullptr;
+				t->m_status = timer_status::wait_for_execution;
+			}
+
+			exec_actions( lock, head );
+
+			utilize_exec_list( head );
+		}
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class UNIQUE_LOCK >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		UNIQUE_LOCK & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head )
+	{
+		lock.unlock();
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+					head->m_action();
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__ 
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				t->m_expiration_tick = m_current_tick + t->m_period;
+
+				insert_demand_to_wheels( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< THREAD_SAFETY >::decrement_references( t );
+			}
+		}
+	}
+};
+
 //
 // thread_unsafe_manager_mixin
 //
@@ -2235,12 +2894,22 @@ struct thread_mixin
 	//! Condition variable for waiting for next event.
 	std::condition_variable m_condition;
 
-	//! Underlying thread object.
+	/*!
+	 * \since v.1.1.2
+	 * \brief Type of function which waits for completion of
+	 * the underlying thread.
+	 */
+	using thread_joiner = std::function< void() >;
+
+	//! Joiner of the underlying thread.
 	/*!
 	 * \note Will be created during timer thread start and
 	 * destroyed after timer thread shutdown.
+	 *
+	 * \note Since v.1.1.2 it is a function instead of std::thread object
+	 * because the thread can be created by a custom launcher.
 	 */
-	std::shared_ptr< std::thread > m_thread;
+	std::shared_ptr< thread_joiner > m_thread_joiner;
 
 	//! A special wrapper around actual std::unique_lock.
 	class lock_guard
@@ -2267,7 +2936,7 @@ struct thread_mixin
 	void
 	ensure_started()
 	{
-		if( !m_thread )
+		if( !m_thread_joiner )
 			throw std::runtime_error( "timer thread is not started" );
 	}
 
@@ -2658,16 +3327,40 @@ public :
 	 */
 	void
 	start()
+	{
+		start( []( std::function< void() > body ) {
+				auto t = std::make_shared< std::thread >( std::move( body ) );
+				return thread_mixin::thread_joiner( [t] { t->join(); } );
+			} );
+	}
+
+	//! Start timer thread by a custom launcher.
+	/*!
+	 * \since v.1.1.2
+	 *
+	 * The \a launcher is called as
+	 * \code
+	 * thread_mixin::thread_joiner launcher(std::function<void()> body);
+	 * \endcode
+	 * It must start a new thread for \a body and return a function
+	 * which waits for completion of that thread.
+	 *
+	 * \throw std::runtime_error if thread is already started.
+	 */
+	template< typename LAUNCHER >
+	void
+	start( LAUNCHER && launcher )
 	{
 		typename base_type::lock_guard locker{ *this };
 
-		if( this->m_thread )
+		if( this->m_thread_joiner )
 			throw std::runtime_error( "timer thread is already started" );
 		else
 			this->m_shutdown = false;
 
-		this->m_thread = std::make_shared< std::thread >(
-				std::bind( &thread_impl_template::body, this ) );
+		this->m_thread_joiner = std::make_shared< thread_mixin::thread_joiner >(
+				launcher( std::function< void() >(
+						std::bind( &thread_impl_template::body, this ) ) ) );
 	}
 
 	//! Initiate shutdown for the timer thread without waiting for completion.
@@ -2676,7 +3369,7 @@ public :
 	{
 		typename base_type::lock_guard locker{ *this };
 
-		if( this->m_thread && !this->m_shutdown )
+		if( this->m_thread_joiner && !this->m_shutdown )
 		{
 			this->m_shutdown = true;
 			this->notify();
@@ -2690,17 +3383,17 @@ public :
 	void
 	join()
 	{
-		std::shared_ptr< std::thread > t;
+		std::shared_ptr< thread_mixin::thread_joiner > joiner;
 		{
 			typename base_type::lock_guard locker{ *this };
-			t = this->m_thread;
+			joiner = this->m_thread_joiner;
 		}
-		if( t )
+		if( joiner )
 		{
-			t->join();
+			(*joiner)();
 
 			typename base_type::lock_guard locker{ *this };
-			this->m_thread.reset();
+			this->m_thread_joiner.reset();
 		}
 	}
 
@@ -3218,5 +3911,151 @@ public :
 	{}
 };
 
+//
+// timer_hierarchical_wheel_thread_template
+//
+
+/*!
+ * \since v.1.1.2
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * \note Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of this timer mechanism.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename ERROR_LOGGER,
+	typename ACTOR_EXCEPTION_HANDLER >
+class timer_hierarchical_wheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						thread_safety::safe,
+						ERROR_LOGGER,
+						ACTOR_EXCEPTION_HANDLER > > 
+{
+	using base_type =
+			details::thread_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							thread_safety::safe,
+							ERROR_LOGGER,
+							ACTOR_EXCEPTION_HANDLER > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_thread_template()
+		:	timer_hierarchical_wheel_thread_template(
+				base_type::default_granularity(),
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with granularity parameter.
+	timer_hierarchical_wheel_thread_template(
+		//! Size of time step for the timer wheels.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_thread_template(
+				granularity,
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_thread_template(
+		//! Size of time step for the timer wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// timer_hierarchical_wheel_manager_template
+//
+/*!
+ * \since v.1.1.2
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::timer_hierarchical_wheel_engine
+ * for the details of this timer mechanism.
+ *
+ * \tparam THREAD_SAFETY Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam ERROR_LOGGER type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam ACTOR_EXCEPTION_HANDLER type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ */
+template<
+	typename THREAD_SAFETY,
+	typename ERROR_LOGGER = default_error_logger,
+	typename ACTOR_EXCEPTION_HANDLER = default_actor_exception_handler >
+class timer_hierarchical_wheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::timer_hierarchical_wheel_engine<
+						THREAD_SAFETY,
+						ERROR_LOGGER,
+						ACTOR_EXCEPTION_HANDLER > > 
+{
+	//! Shorthand for base type.
+	using base_type = 
+			details::manager_impl_template<
+					details::timer_hierarchical_wheel_engine<
+							THREAD_SAFETY,
+							ERROR_LOGGER,
+							ACTOR_EXCEPTION_HANDLER > >;
+
+public :
+	//! Default constructor.
+	timer_hierarchical_wheel_manager_template()
+		:	timer_hierarchical_wheel_manager_template(
+				base_type::default_granularity(),
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with granularity parameter.
+	timer_hierarchical_wheel_manager_template(
+		//! Size of time step for the timer wheels.
+		monotonic_clock::duration granularity )
+		:	timer_hierarchical_wheel_manager_template(
+				granularity,
+				ERROR_LOGGER(),
+				ACTOR_EXCEPTION_HANDLER() )
+	{}
+
+	//! Constructor with all parameters.
+	timer_hierarchical_wheel_manager_template(
+		//! Size of time step for the timer wheels.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		ERROR_LOGGER error_logger,
+		//! An actor exception handler for timer thread.
+		ACTOR_EXCEPTION_HANDLER exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
 } /* namespace timertt */
 